@@ -0,0 +1,484 @@
+/*
+ *	buftrace_replay.cpp
+ *		replays shared buffer traces written with buffer_trace_directory
+ *		against the replacement policies of buffer_replacement_policy and
+ *		reports the hit rate each of them would have reached
+ *
+ * The trace files of all threads are interleaved round-robin, one access at
+ * a time, since the records carry no timestamps.  The simulation has no
+ * concurrency, so no buffer is ever pinned while the hand passes it.
+ * Accesses made through a ring buffer strategy go through a ring of
+ * --ring buffers per trace file, as GetBufferFromRing() does.
+ */
+
+#include "postgres_fe.h"
+
+#include <dirent.h>
+
+#include "getopt_long.h"
+#include "storage/buf_trace.h"
+
+/* as in buf_internals.h and freelist.cpp */
+#define MAX_USAGE_COUNT 5
+#define GHOST_ENTRIES_PER_BUFFER 0.5
+#define GHOST_HIT_USAGE_COUNT 2
+
+#define DEFAULT_RING_SIZE 32
+#define READ_BATCH 1024
+
+typedef enum { POLICY_CLOCK, POLICY_2Q, POLICY_NUM } ReplayPolicy;
+
+static const char* policy_names[POLICY_NUM] = {"clock", "2q"};
+
+/* one trace file being replayed */
+typedef struct TraceStream {
+    const char* path;
+    FILE* file;
+    BufferTraceRecord records[READ_BATCH];
+    int nrecords;
+    int next;
+    int* ring;                /* buffer ids of the strategy rings of all policies */
+    int ring_next[POLICY_NUM]; /* ring slot last used by each policy */
+} TraceStream;
+
+/* simulated buffer pool */
+typedef struct SimPool {
+    ReplayPolicy policy;
+    int nbuffers;
+    BufferTraceRecord* tags; /* tag of each buffer, flags unused */
+    bool* valid;
+    int* usage;
+    int* hash_next; /* next buffer of the same hash bucket */
+    int* buckets;   /* first buffer of each hash bucket, -1 if empty */
+    uint32 nbuckets;
+    int hand;
+    uint32* ghosts;
+    int nghosts;
+    uint64 hits;
+    uint64 misses;
+} SimPool;
+
+static const char* progname;
+static int nbuffers = 0;
+static int ring_size = DEFAULT_RING_SIZE;
+
+static void usage(void);
+static void* replay_malloc(size_t size);
+static void add_trace_path(const char* path, TraceStream** streams, int* nstreams, int* maxstreams);
+static void open_stream(TraceStream* stream);
+static bool next_record(TraceStream* stream, BufferTraceRecord* record);
+static uint32 tag_hash(const BufferTraceRecord* tag);
+static bool tag_equal(const BufferTraceRecord* a, const BufferTraceRecord* b);
+static void pool_init(SimPool* pool, ReplayPolicy policy);
+static void pool_access(SimPool* pool, TraceStream* stream, const BufferTraceRecord* record);
+
+int main(int argc, char* argv[])
+{
+    static struct option long_options[] = {
+        {"buffers", required_argument, NULL, 'b'}, {"ring", required_argument, NULL, 'r'}, {NULL, 0, NULL, 0}};
+    int option;
+    int optindex = 0;
+    TraceStream* streams = NULL;
+    int nstreams = 0;
+    int maxstreams = 0;
+    int active;
+    uint64 accesses = 0;
+    uint64 recorded_hits = 0;
+    SimPool pools[POLICY_NUM];
+    int i;
+    int p;
+
+    progname = get_progname(argv[0]);
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "-?") == 0) {
+            usage();
+            exit(0);
+        }
+        if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-V") == 0) {
+            puts("buftrace_replay (PostgreSQL) " PG_VERSION);
+            exit(0);
+        }
+    }
+
+    while ((option = getopt_long(argc, argv, "b:r:", long_options, &optindex)) != -1) {
+        switch (option) {
+            case 'b':
+                nbuffers = atoi(optarg);
+                if (nbuffers <= 0) {
+                    fprintf(stderr, "%s: number of buffers must be a positive integer\n", progname);
+                    exit(1);
+                }
+                break;
+
+            case 'r':
+                ring_size = atoi(optarg);
+                if (ring_size <= 0) {
+                    fprintf(stderr, "%s: ring size must be a positive integer\n", progname);
+                    exit(1);
+                }
+                break;
+
+            default:
+                fprintf(stderr, "Try \"%s --help\" for more information.\n", progname);
+                exit(1);
+                break;
+        }
+    }
+
+    if (optind >= argc) {
+        fprintf(stderr, "%s: no trace file or directory specified\n", progname);
+        fprintf(stderr, "Try \"%s --help\" for more information.\n", progname);
+        exit(1);
+    }
+
+    for (i = optind; i < argc; i++) {
+        add_trace_path(argv[i], &streams, &nstreams, &maxstreams);
+    }
+    if (nstreams == 0) {
+        fprintf(stderr, "%s: no trace files found\n", progname);
+        exit(1);
+    }
+
+    for (i = 0; i < nstreams; i++) {
+        open_stream(&streams[i]);
+    }
+
+    /* nbuffers is taken from the first trace unless given */
+    for (p = 0; p < POLICY_NUM; p++) {
+        pool_init(&pools[p], (ReplayPolicy)p);
+    }
+
+    /* interleave the streams round-robin until all of them are exhausted */
+    do {
+        active = 0;
+        for (i = 0; i < nstreams; i++) {
+            BufferTraceRecord record;
+
+            if (!next_record(&streams[i], &record)) {
+                continue;
+            }
+            active++;
+            accesses++;
+            if (record.flags & BUFFER_TRACE_HIT) {
+                recorded_hits++;
+            }
+            for (p = 0; p < POLICY_NUM; p++) {
+                pool_access(&pools[p], &streams[i], &record);
+            }
+        }
+    } while (active > 0);
+
+    printf("trace files: %d\n", nstreams);
+    printf("accesses:    " UINT64_FORMAT "\n", accesses);
+    printf("buffers:     %d\n", nbuffers);
+    printf("recorded hit rate: %.2f%%\n\n", accesses > 0 ? 100.0 * recorded_hits / accesses : 0.0);
+    printf("%-8s %16s %16s %10s\n", "policy", "hits", "misses", "hit rate");
+    for (p = 0; p < POLICY_NUM; p++) {
+        printf("%-8s %16lu %16lu %9.2f%%\n",
+            policy_names[p],
+            (unsigned long)pools[p].hits,
+            (unsigned long)pools[p].misses,
+            accesses > 0 ? 100.0 * pools[p].hits / accesses : 0.0);
+    }
+
+    return 0;
+}
+
+static void usage(void)
+{
+    printf("%s replays shared buffer traces against the buffer replacement policies.\n\n", progname);
+    printf("Usage:\n");
+    printf("  %s [OPTION]... TRACE...\n\n", progname);
+    printf("TRACE is a trace file or a buffer_trace_directory holding trace files.\n\n");
+    printf("Options:\n");
+    printf("  -b, --buffers=NUM    number of shared buffers to simulate (default: as traced)\n");
+    printf("  -r, --ring=NUM       ring size of bulk reads (default: %d)\n", DEFAULT_RING_SIZE);
+    printf("  -?, --help           show this help, then exit\n");
+    printf("  -V, --version        output version information, then exit\n");
+}
+
+static void* replay_malloc(size_t size)
+{
+    void* result = malloc(size);
+
+    if (result == NULL) {
+        fprintf(stderr, "%s: out of memory\n", progname);
+        exit(1);
+    }
+    return result;
+}
+
+static bool is_trace_file(const char* name)
+{
+    size_t len = strlen(name);
+    size_t prefix_len = strlen(BUFFER_TRACE_FILE_PREFIX);
+    size_t suffix_len = strlen(BUFFER_TRACE_FILE_SUFFIX);
+
+    return len > prefix_len + suffix_len && strncmp(name, BUFFER_TRACE_FILE_PREFIX, prefix_len) == 0 &&
+           strcmp(name + len - suffix_len, BUFFER_TRACE_FILE_SUFFIX) == 0;
+}
+
+static void add_stream(const char* path, TraceStream** streams, int* nstreams, int* maxstreams)
+{
+    if (*nstreams == *maxstreams) {
+        TraceStream* enlarged = NULL;
+
+        *maxstreams = (*maxstreams == 0) ? 16 : *maxstreams * 2;
+        enlarged = (TraceStream*)realloc(*streams, sizeof(TraceStream) * (*maxstreams));
+        if (enlarged == NULL) {
+            fprintf(stderr, "%s: out of memory\n", progname);
+            exit(1);
+        }
+        *streams = enlarged;
+    }
+    (*streams)[(*nstreams)++].path = strdup(path);
+}
+
+/*
+ * add_trace_path -- add a trace file, or all trace files of a directory
+ */
+static void add_trace_path(const char* path, TraceStream** streams, int* nstreams, int* maxstreams)
+{
+    DIR* dir = opendir(path);
+    struct dirent* de = NULL;
+
+    if (dir == NULL) {
+        add_stream(path, streams, nstreams, maxstreams);
+        return;
+    }
+
+    while ((de = readdir(dir)) != NULL) {
+        char file[MAXPGPATH];
+
+        if (!is_trace_file(de->d_name)) {
+            continue;
+        }
+        snprintf(file, sizeof(file), "%s/%s", path, de->d_name);
+        add_stream(file, streams, nstreams, maxstreams);
+    }
+    (void)closedir(dir);
+}
+
+static void open_stream(TraceStream* stream)
+{
+    BufferTraceHeader header;
+
+    stream->file = fopen(stream->path, PG_BINARY_R);
+    if (stream->file == NULL) {
+        fprintf(stderr, "%s: could not open trace file \"%s\": %s\n", progname, stream->path, strerror(errno));
+        exit(1);
+    }
+
+    if (fread(&header, sizeof(header), 1, stream->file) != 1 || header.magic != BUFFER_TRACE_MAGIC) {
+        fprintf(stderr, "%s: \"%s\" is not a buffer trace file\n", progname, stream->path);
+        exit(1);
+    }
+    if (header.version != BUFFER_TRACE_VERSION || header.record_size != sizeof(BufferTraceRecord)) {
+        fprintf(stderr, "%s: trace file \"%s\" has unsupported version %u\n", progname, stream->path,
+            header.version);
+        exit(1);
+    }
+
+    if (nbuffers == 0) {
+        nbuffers = header.nbuffers;
+    }
+
+    stream->nrecords = 0;
+    stream->next = 0;
+    stream->ring = NULL;
+    for (int p = 0; p < POLICY_NUM; p++) {
+        stream->ring_next[p] = 0;
+    }
+}
+
+static bool next_record(TraceStream* stream, BufferTraceRecord* record)
+{
+    if (stream->file == NULL) {
+        return false;
+    }
+
+    if (stream->next == stream->nrecords) {
+        stream->nrecords = (int)fread(stream->records, sizeof(BufferTraceRecord), READ_BATCH, stream->file);
+        stream->next = 0;
+        if (stream->nrecords == 0) {
+            (void)fclose(stream->file);
+            stream->file = NULL;
+            return false;
+        }
+    }
+
+    *record = stream->records[stream->next++];
+    return true;
+}
+
+static uint32 tag_hash(const BufferTraceRecord* tag)
+{
+    uint32 h = tag->relNode;
+
+    h = h * 0x9E3779B1 ^ tag->blockNum;
+    h = h * 0x9E3779B1 ^ tag->dbNode;
+    h = h * 0x9E3779B1 ^ tag->spcNode;
+    h = h * 0x9E3779B1 ^ (uint32)tag->bucketNode;
+    h = h * 0x9E3779B1 ^ tag->forkNum;
+    h ^= h >> 16;
+    return h * 0x85EBCA6B;
+}
+
+static bool tag_equal(const BufferTraceRecord* a, const BufferTraceRecord* b)
+{
+    return a->relNode == b->relNode && a->blockNum == b->blockNum && a->dbNode == b->dbNode &&
+           a->spcNode == b->spcNode && a->bucketNode == b->bucketNode && a->forkNum == b->forkNum;
+}
+
+static void pool_init(SimPool* pool, ReplayPolicy policy)
+{
+    int i;
+
+    pool->policy = policy;
+    pool->nbuffers = nbuffers;
+    pool->tags = (BufferTraceRecord*)replay_malloc(sizeof(BufferTraceRecord) * nbuffers);
+    pool->valid = (bool*)replay_malloc(sizeof(bool) * nbuffers);
+    pool->usage = (int*)replay_malloc(sizeof(int) * nbuffers);
+    pool->hash_next = (int*)replay_malloc(sizeof(int) * nbuffers);
+    for (i = 0; i < nbuffers; i++) {
+        pool->valid[i] = false;
+        pool->usage[i] = 0;
+        pool->hash_next[i] = -1;
+    }
+
+    for (pool->nbuckets = 1; pool->nbuckets < (uint32)nbuffers; pool->nbuckets <<= 1) {
+    }
+    pool->buckets = (int*)replay_malloc(sizeof(int) * pool->nbuckets);
+    for (i = 0; i < (int)pool->nbuckets; i++) {
+        pool->buckets[i] = -1;
+    }
+
+    pool->hand = 0;
+    pool->ghosts = NULL;
+    pool->nghosts = 0;
+    if (policy == POLICY_2Q) {
+        pool->nghosts = Max((int)(nbuffers * GHOST_ENTRIES_PER_BUFFER), 1);
+        pool->ghosts = (uint32*)replay_malloc(sizeof(uint32) * pool->nghosts);
+        for (i = 0; i < pool->nghosts; i++) {
+            pool->ghosts[i] = 0;
+        }
+    }
+    pool->hits = 0;
+    pool->misses = 0;
+}
+
+static int pool_lookup(SimPool* pool, const BufferTraceRecord* tag, uint32 hash)
+{
+    int buf_id;
+
+    for (buf_id = pool->buckets[hash & (pool->nbuckets - 1)]; buf_id >= 0; buf_id = pool->hash_next[buf_id]) {
+        if (tag_equal(&pool->tags[buf_id], tag)) {
+            return buf_id;
+        }
+    }
+    return -1;
+}
+
+/*
+ * drop the current tag of buf_id, remembering it in the ghost history unless
+ * the buffer is reused from a ring, see StrategyRecordEviction()
+ */
+static void pool_evict(SimPool* pool, int buf_id, bool from_ring)
+{
+    uint32 hash;
+    int* link = NULL;
+
+    if (!pool->valid[buf_id]) {
+        return;
+    }
+
+    hash = tag_hash(&pool->tags[buf_id]);
+    for (link = &pool->buckets[hash & (pool->nbuckets - 1)]; *link != buf_id; link = &pool->hash_next[*link]) {
+    }
+    *link = pool->hash_next[buf_id];
+    pool->valid[buf_id] = false;
+
+    if (pool->ghosts != NULL && !from_ring) {
+        pool->ghosts[hash % (uint32)pool->nghosts] = hash | 1;
+    }
+}
+
+/* the clock sweep of StrategyGetBuffer() */
+static int pool_sweep(SimPool* pool)
+{
+    for (;;) {
+        int buf_id = pool->hand;
+
+        pool->hand = (pool->hand + 1) % pool->nbuffers;
+        if (pool->policy == POLICY_2Q && pool->usage[buf_id] > 0) {
+            pool->usage[buf_id]--;
+            continue;
+        }
+        return buf_id;
+    }
+}
+
+static void pool_access(SimPool* pool, TraceStream* stream, const BufferTraceRecord* record)
+{
+    uint32 hash = tag_hash(record);
+    int buf_id = pool_lookup(pool, record, hash);
+    bool from_ring = false;
+
+    if (buf_id >= 0) {
+        pool->hits++;
+        if (pool->usage[buf_id] < MAX_USAGE_COUNT) {
+            pool->usage[buf_id]++;
+        }
+        return;
+    }
+    pool->misses++;
+
+    /*
+     * Ring accesses reuse the buffer of their ring slot unless it was used
+     * by someone else meanwhile, see GetBufferFromRing(). Each policy has
+     * its own ring in the stream, -1 marking unused slots.
+     */
+    if ((record->flags & BUFFER_TRACE_STRATEGY) && ring_size > 0) {
+        int* ring = NULL;
+        int slot;
+
+        if (stream->ring == NULL) {
+            stream->ring = (int*)replay_malloc(sizeof(int) * ring_size * POLICY_NUM);
+            for (slot = 0; slot < ring_size * POLICY_NUM; slot++) {
+                stream->ring[slot] = -1;
+            }
+        }
+        ring = stream->ring + ring_size * pool->policy;
+        slot = stream->ring_next[pool->policy] = (stream->ring_next[pool->policy] + 1) % ring_size;
+
+        buf_id = ring[slot];
+        if (buf_id < 0 || pool->usage[buf_id] > 1) {
+            buf_id = pool_sweep(pool);
+            ring[slot] = buf_id;
+        } else {
+            from_ring = true;
+        }
+    } else {
+        buf_id = pool_sweep(pool);
+    }
+
+    pool_evict(pool, buf_id, from_ring);
+    pool->tags[buf_id] = *record;
+    pool->valid[buf_id] = true;
+    pool->hash_next[buf_id] = pool->buckets[hash & (pool->nbuckets - 1)];
+    pool->buckets[hash & (pool->nbuckets - 1)] = buf_id;
+
+    /* the initial usage count of StrategyInitialUsage() */
+    if (pool->policy == POLICY_2Q) {
+        uint32* ghost = &pool->ghosts[hash % (uint32)pool->nghosts];
+
+        pool->usage[buf_id] = 0;
+        if (*ghost == (hash | 1)) {
+            *ghost = 0;
+            pool->usage[buf_id] = GHOST_HIT_USAGE_COUNT;
+        }
+    } else {
+        pool->usage[buf_id] = 1;
+    }
+}
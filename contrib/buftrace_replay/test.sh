@@ -0,0 +1,42 @@
+#!/bin/sh
+
+# contrib/buftrace_replay/test.sh
+#
+# Test driver for buftrace_replay.  Writes a trace of 64 shared buffers in
+# which a hot set of 40 blocks is read in turn with a 48 block sequential
+# scan that is repeated 16 times through a ring, and a block never read
+# again is looked up every 8 scan blocks.  The replayed hit counts of both
+# policies are compared with expected/replay.out: "clock" loses the hot set
+# to the lookups, "2q" keeps it, and does so only as long as the blocks the
+# ring reuses are not taken as recently evicted when the scan comes back.
+
+set -e
+
+temp_root=$PWD/tmp_check
+rm -rf "$temp_root"
+mkdir -p "$temp_root"
+
+perl -e '
+	# BufferTraceHeader and BufferTraceRecord of storage/buf_trace.h
+	print pack("LLLlq", 0x43525442, 1, 24, 64, 0);
+	my ($step, $cold) = (0, 0);
+	for my $pass (1 .. 16) {
+		for my $block (0 .. 47) {
+			print pack("LLLlLSS", 1663, 16384, 2, -1, $block, 0, 2);
+			print pack("LLLlLSS", 1663, 16384, 1, -1, $step % 40, 0, 0);
+			$step++;
+			print pack("LLLlLSS", 1663, 16384, 3, -1, $cold++, 0, 0) if $step % 8 == 0;
+		}
+	}
+' > "$temp_root/buftrace_1_0.trc"
+
+./buftrace_replay --buffers=64 --ring=8 "$temp_root" > "$temp_root/replay.out"
+
+if diff expected/replay.out "$temp_root/replay.out" > "$temp_root/replay.diffs"; then
+	echo PASSED
+	rm -rf "$temp_root"
+else
+	cat "$temp_root/replay.diffs"
+	echo "Replayed hit counts differ, see $temp_root."
+	exit 1
+fi
@@ -0,0 +1,18 @@
+/* contrib/unique_sql_bench/unique_sql_bench--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION unique_sql_bench" to load this file. \quit
+
+-- Counts loops statements in the unique sql entry of the calling statement,
+-- compare SET instr_unique_sql_batch_size = 1 against the default.
+CREATE FUNCTION unique_sql_bench(IN loops int4,
+    OUT statements int8,
+    OUT ns_per_stmt_without float8,
+    OUT ns_per_stmt_with float8,
+    OUT overhead_ns float8)
+RETURNS record
+AS 'MODULE_PATHNAME', 'unique_sql_bench'
+LANGUAGE C STRICT;
+
+-- Don't want this to be available to public, it adds to gs_instr_unique_sql.
+REVOKE ALL ON FUNCTION unique_sql_bench(int4) FROM PUBLIC;
@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------
+ *
+ * unique_sql_bench.cpp
+ *	  measure what the unique sql statistics cost a statement
+ *
+ * The statement end update of unique sql statistics is run loops times
+ * against the entry of the calling statement, and timed against the same
+ * loop without it.
+ *
+ *	  contrib/unique_sql_bench/unique_sql_bench.cpp
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "funcapi.h"
+#include "instruments/instr_unique_sql.h"
+#include "miscadmin.h"
+#include "portability/instr_time.h"
+#include "utils/builtins.h"
+#include "utils/timestamp.h"
+
+#define UNIQUE_SQL_BENCH_ATTRNUM 4
+
+PG_MODULE_MAGIC;
+
+Datum unique_sql_bench(PG_FUNCTION_ARGS);
+
+PG_FUNCTION_INFO_V1(unique_sql_bench);
+
+static double ns_per_loop(instr_time duration, int32 loops)
+{
+    return INSTR_TIME_GET_DOUBLE(duration) * 1000000000.0 / loops;
+}
+
+Datum unique_sql_bench(PG_FUNCTION_ARGS)
+{
+    int32 loops = PG_GETARG_INT32(0);
+    TupleDesc tupdesc;
+    Datum values[UNIQUE_SQL_BENCH_ATTRNUM];
+    bool nulls[UNIQUE_SQL_BENCH_ATTRNUM] = {false};
+    instr_time start;
+    instr_time duration;
+    volatile int64 sink = 0;
+    int64 stmt_start;
+    double without;
+    double with;
+
+    if (!superuser()) {
+        ereport(ERROR,
+            (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE), errmsg("must be system admin to run unique_sql_bench")));
+    }
+
+    if (loops <= 0) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("loops must be greater than zero")));
+    }
+
+    if (!is_unique_sql_enabled() || isUniqueSQLContextInvalid()) {
+        ereport(ERROR,
+            (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("unique sql statistics are not collected"),
+                errhint("Set enable_resource_track to on and instr_unique_sql_count above zero.")));
+    }
+
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("return type must be a row type")));
+    }
+
+    /* without instrumentation, the loop and the statement end timestamp */
+    INSTR_TIME_SET_CURRENT(start);
+    for (int32 i = 0; i < loops; i++) {
+        sink += GetCurrentTimestamp();
+    }
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, start);
+    without = ns_per_loop(duration, loops);
+
+    /* with instrumentation, which reads the timestamp itself */
+    stmt_start = GetCurrentTimestamp();
+    INSTR_TIME_SET_CURRENT(start);
+    for (int32 i = 0; i < loops; i++) {
+        UpdateUniqueSQLStat(NULL, NULL, stmt_start);
+    }
+    FlushUniqueSQLStat();
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, start);
+    with = ns_per_loop(duration, loops);
+
+    values[0] = Int64GetDatum(loops);
+    values[1] = Float8GetDatum(without);
+    values[2] = Float8GetDatum(with);
+    values[3] = Float8GetDatum(with - without);
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc), values, nulls)));
+}
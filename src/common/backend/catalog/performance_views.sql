@@ -4169,6 +4169,18 @@ CREATE VIEW DBE_PERF.global_get_bgwriter_status AS
         SELECT node_name,bgwr_actual_flush_total_num,bgwr_last_flush_num,candidate_slots,get_buffer_from_list,get_buf_clock_sweep
         FROM pg_catalog.local_bgwriter_stat();
 
+CREATE VIEW DBE_PERF.global_buffer_numa_status AS
+        SELECT node_name,numa_node,buffers,hits,remote_hits,allocs,remote_allocs
+        FROM pg_catalog.local_buffer_numa_stat();
+
+CREATE VIEW DBE_PERF.global_cu_cache_status AS
+        SELECT node_name,cache_size,used_size,compressed_limit,compressed_size,compressed_cus,demotions,compressed_hits,compressed_evictions,evictions
+        FROM pg_catalog.local_cu_cache_stat();
+
+CREATE VIEW DBE_PERF.global_threadpool_queue_status AS
+        SELECT node_name,group_id,bind_numa_id,stolen_sessions,lent_sessions,served_sessions,queue_time_p50_us,queue_time_p99_us
+        FROM pg_catalog.local_threadpool_queue_stat();
+
 CREATE VIEW DBE_PERF.global_pagewriter_status AS
         SELECT node_name,pgwr_actual_flush_total_num,pgwr_last_flush_num,remain_dirty_page_num,queue_head_page_rec_lsn,queue_rec_lsn,current_xlog_insert_lsn,ckpt_redo_point
         FROM pg_catalog.local_pagewriter_stat();
@@ -266,6 +266,26 @@ Dlelem* DllistWithLock::RemoveHead()
     return head;
 }
 
+/*
+ * Remove and return the head only if cond holds for it, NULL otherwise.
+ * cond is called with the spinlock held and must be cheap.
+ */
+Dlelem* DllistWithLock::RemoveHeadIf(bool (*cond)(Dlelem* e, void* arg), void* arg)
+{
+    Dlelem* head = NULL;
+    START_CRIT_SECTION();
+    SpinLockAcquire(&(m_lock));
+    head = DLGetHead(&m_list);
+    if (head != NULL && cond(head, arg)) {
+        DLRemove(head);
+    } else {
+        head = NULL;
+    }
+    SpinLockRelease(&(m_lock));
+    END_CRIT_SECTION();
+    return head;
+}
+
 bool DllistWithLock::IsEmpty()
 {
     START_CRIT_SECTION();
@@ -164,6 +164,38 @@ double estimateHyperLogLog(hyperLogLogState* cState)
     return result;
 }
 
+/*
+ * Merges the estimate from one HyperLogLog state to another, returning the
+ * estimate of their union.
+ *
+ * The number of registers in each must match.
+ */
+void mergeHyperLogLog(hyperLogLogState* cState, const hyperLogLogState* oState)
+{
+    Size r;
+
+    if (cState->arrSize != oState->arrSize)
+        ereport(ERROR, (errcode(ERRCODE_DATATYPE_MISMATCH), errmsg("source and target states are not compatible")));
+
+    for (r = 0; r < oState->arrSize; ++r) {
+        /* Use the largest value of each register */
+        cState->hashesArr[r] = Max(cState->hashesArr[r], oState->hashesArr[r]);
+    }
+}
+
+/*
+ * Free HyperLogLog track state
+ *
+ * Releases allocated resources, but not the state itself (in case it's not
+ * allocated by palloc).
+ */
+void freeHyperLogLog(hyperLogLogState* cState)
+{
+    Assert(cState->hashesArr != NULL);
+    pfree(cState->hashesArr);
+    cState->hashesArr = NULL;
+}
+
 /*
  * Worker for addHyperLogLog().
  *
@@ -1329,6 +1329,7 @@ static Agg* _copyAgg(const Agg* from)
     COPY_SCALAR_FIELD(is_sonichash);
     COPY_SCALAR_FIELD(is_dummy);
     COPY_SCALAR_FIELD(skew_optimize);
+    COPY_SCALAR_FIELD(is_partial);
     return newnode;
 }
 
@@ -2796,6 +2796,7 @@ static Agg* _readAgg(Agg* local_node)
     READ_BOOL_FIELD(is_sonichash);
     READ_BOOL_FIELD(is_dummy);
     READ_UINT_FIELD(skew_optimize);
+    READ_BOOL_FIELD(is_partial);
 
     READ_DONE();
 }
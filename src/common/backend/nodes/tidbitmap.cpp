@@ -44,6 +44,7 @@
 #include "access/htup.h"
 #include "nodes/bitmapset.h"
 #include "nodes/tidbitmap.h"
+#include "storage/spin.h"
 #include "utils/hsearch.h"
 
 /*
@@ -168,6 +169,30 @@ struct TBMIterator {
     TBMIterateResult output; /* MUST BE LAST (because variable-size) */
 };
 
+/*
+ * Iteration state shared by the participants of a parallel bitmap heap scan.
+ * It carries its own copy of the sorted page lists, so that it does not
+ * depend on the lifetime of the TIDBitmap (or of the thread) it came from.
+ */
+struct TBMSharedIteratorState {
+    int npages;               /* number of exact entries in spages */
+    int nchunks;              /* number of lossy entries in schunks */
+    PagetableEntry** spages;  /* sorted exact-page list, or NULL */
+    PagetableEntry** schunks; /* sorted lossy-chunk list, or NULL */
+    slock_t mutex;            /* protects the pointers below */
+    int spageptr;             /* next spages index */
+    int schunkptr;            /* next schunks index */
+    int schunkbit;            /* next bit to check in current schunk */
+};
+
+/*
+ * A participant's handle on a shared iteration; the output is private.
+ */
+struct TBMSharedIterator {
+    TBMSharedIteratorState* state; /* shared iteration pointers */
+    TBMIterateResult output;       /* MUST BE LAST (because variable-size) */
+};
+
 /* Local function prototypes */
 static void tbm_union_page(TIDBitmap* a, const PagetableEntry* bpage);
 static bool tbm_intersect_page(TIDBitmap* a, PagetableEntry* apage, const TIDBitmap* b);
@@ -534,42 +559,14 @@ bool tbm_is_empty(const TIDBitmap* tbm)
 }
 
 /*
- * tbm_begin_iterate - prepare to iterate through a TIDBitmap
+ * tbm_prepare_sorted_lists - create and fill the sorted page lists
  *
- * The TBMIterator struct is created in the caller's memory context.
- * For a clean shutdown of the iteration, call tbm_end_iterate; but it's
- * okay to just allow the memory context to be released, too.  It is caller's
- * responsibility not to touch the TBMIterator anymore once the TIDBitmap
- * is freed.
- *
- * NB: after this is called, it is no longer allowed to modify the contents
- * of the bitmap.  However, you can call this multiple times to scan the
- * contents repeatedly, including parallel scans.
+ * Nothing to do unless we have a hashtable, or if we already did that for a
+ * previous iterator.  Note that the lists are attached to the bitmap not the
+ * iterator, so they can be used by more than one iterator.
  */
-TBMIterator* tbm_begin_iterate(TIDBitmap* tbm)
+static void tbm_prepare_sorted_lists(TIDBitmap* tbm)
 {
-    TBMIterator* iterator = NULL;
-
-    /*
-     * Create the TBMIterator struct, with enough trailing space to serve the
-     * needs of the TBMIterateResult sub-struct.
-     */
-    iterator = (TBMIterator*)palloc(sizeof(TBMIterator) + MAX_TUPLES_PER_PAGE * sizeof(OffsetNumber));
-    iterator->tbm = tbm;
-
-    /*
-     * Initialize iteration pointers.
-     */
-    iterator->spageptr = 0;
-    iterator->schunkptr = 0;
-    iterator->schunkbit = 0;
-
-    /*
-     * If we have a hashtable, create and fill the sorted page lists, unless
-     * we already did that for a previous iterator.  Note that the lists are
-     * attached to the bitmap not the iterator, so they can be used by more
-     * than one iterator.
-     */
     if (tbm->status == TBM_HASH && !tbm->iterating) {
         HASH_SEQ_STATUS status;
         PagetableEntry* page = NULL;
@@ -603,115 +600,174 @@ TBMIterator* tbm_begin_iterate(TIDBitmap* tbm)
     }
 
     tbm->iterating = true;
-
-    return iterator;
 }
 
 /*
- * tbm_iterate - scan through next page of a TIDBitmap
+ * tbm_begin_iterate - prepare to iterate through a TIDBitmap
  *
- * Returns a TBMIterateResult representing one page, or NULL if there are
- * no more pages to scan.  Pages are guaranteed to be delivered in numerical
- * order.  If result->ntuples < 0, then the bitmap is "lossy" and failed to
- * remember the exact tuples to look at on this page --- the caller must
- * examine all tuples on the page and check if they meet the intended
- * condition.  If result->recheck is true, only the indicated tuples need
- * be examined, but the condition must be rechecked anyway.  (For ease of
- * testing, recheck is always set true when ntuples < 0.)
+ * The TBMIterator struct is created in the caller's memory context.
+ * For a clean shutdown of the iteration, call tbm_end_iterate; but it's
+ * okay to just allow the memory context to be released, too.  It is caller's
+ * responsibility not to touch the TBMIterator anymore once the TIDBitmap
+ * is freed.
+ *
+ * NB: after this is called, it is no longer allowed to modify the contents
+ * of the bitmap.  However, you can call this multiple times to scan the
+ * contents repeatedly, including parallel scans.
  */
-TBMIterateResult* tbm_iterate(TBMIterator* iterator)
+TBMIterator* tbm_begin_iterate(TIDBitmap* tbm)
 {
-    TIDBitmap* tbm = iterator->tbm;
-    TBMIterateResult* output = &(iterator->output);
+    TBMIterator* iterator = NULL;
 
-    Assert(tbm->iterating);
+    /*
+     * Create the TBMIterator struct, with enough trailing space to serve the
+     * needs of the TBMIterateResult sub-struct.
+     */
+    iterator = (TBMIterator*)palloc(sizeof(TBMIterator) + MAX_TUPLES_PER_PAGE * sizeof(OffsetNumber));
+    iterator->tbm = tbm;
+
+    /*
+     * Initialize iteration pointers.
+     */
+    iterator->spageptr = 0;
+    iterator->schunkptr = 0;
+    iterator->schunkbit = 0;
+
+    tbm_prepare_sorted_lists(tbm);
 
+    return iterator;
+}
+
+/*
+ * tbm_advance_iterate - advance a set of iteration pointers by one page
+ *
+ * spages and schunks are the sorted page lists being iterated over.  Returns
+ * false if there are no more pages.  If the next page is a lossy one, output
+ * is filled in and *page is set to NULL; otherwise *page is set to the exact
+ * page entry, whose tuples the caller extracts with tbm_extract_page_tuples.
+ */
+static bool tbm_advance_iterate(PagetableEntry* const* spages, int npages, PagetableEntry* const* schunks,
+    int nchunks, int* spageptr, int* schunkptr, int* schunkbit, TBMIterateResult* output, const PagetableEntry** page)
+{
     /*
      * If lossy chunk pages remain, make sure we've advanced schunkptr/
      * schunkbit to the next set bit.
      */
-    while (iterator->schunkptr < tbm->nchunks) {
-        PagetableEntry* chunk = tbm->schunks[iterator->schunkptr];
-        int schunkbit = iterator->schunkbit;
+    while (*schunkptr < nchunks) {
+        PagetableEntry* chunk = schunks[*schunkptr];
+        int bit = *schunkbit;
 
-        while (schunkbit < PAGES_PER_CHUNK) {
-            int wordnum = WORDNUM(schunkbit);
-            int bitnum = BITNUM(schunkbit);
+        while (bit < PAGES_PER_CHUNK) {
+            int wordnum = WORDNUM(bit);
+            int bitnum = BITNUM(bit);
 
             if ((chunk->words[wordnum] & ((bitmapword)1 << (unsigned int)bitnum)) != 0) {
                 break;
             }
-            schunkbit++;
+            bit++;
         }
-        if (schunkbit < PAGES_PER_CHUNK) {
-            iterator->schunkbit = schunkbit;
+        if (bit < PAGES_PER_CHUNK) {
+            *schunkbit = bit;
             break;
         }
         /* advance to next chunk */
-        iterator->schunkptr++;
-        iterator->schunkbit = 0;
+        (*schunkptr)++;
+        *schunkbit = 0;
     }
 
     /*
      * If both chunk and per-page data remain, must output the numerically
      * earlier page.
      */
-    if (iterator->schunkptr < tbm->nchunks) {
-        PagetableEntry* chunk = tbm->schunks[iterator->schunkptr];
+    if (*schunkptr < nchunks) {
+        PagetableEntry* chunk = schunks[*schunkptr];
         PagetableEntryNode pnode;
-        pnode.blockNo = chunk->entryNode.blockNo + iterator->schunkbit;
+        pnode.blockNo = chunk->entryNode.blockNo + *schunkbit;
         pnode.partitionOid = chunk->entryNode.partitionOid;
-        if (iterator->spageptr >= tbm->npages ||
-            IS_CHUNK_BEFORE_PAGE(pnode, tbm->spages[iterator->spageptr]->entryNode)) {
+        if (*spageptr >= npages || IS_CHUNK_BEFORE_PAGE(pnode, spages[*spageptr]->entryNode)) {
             /* Return a lossy page indicator from the chunk */
             output->blockno = pnode.blockNo;
             output->partitionOid = pnode.partitionOid;
             output->ntuples = -1;
             output->recheck = true;
-            iterator->schunkbit++;
-            return output;
+            (*schunkbit)++;
+            *page = NULL;
+            return true;
         }
     }
 
-    if (iterator->spageptr < tbm->npages) {
-        PagetableEntry* page = NULL;
-        int ntuples;
-        int wordnum;
+    if (*spageptr < npages) {
+        *page = spages[*spageptr];
+        (*spageptr)++;
+        return true;
+    }
 
-        /* In ONE_PAGE state, we don't allocate an spages[] array */
-        if (tbm->status == TBM_ONE_PAGE) {
-            page = &tbm->entry1;
-        } else {
-            page = tbm->spages[iterator->spageptr];
-        }
+    /* Nothing more in the bitmap */
+    return false;
+}
 
-        /* scan bitmap to extract individual offset numbers */
-        ntuples = 0;
-        for (wordnum = 0; wordnum < WORDS_PER_PAGE; wordnum++) {
-            bitmapword w = page->words[wordnum];
+/*
+ * tbm_extract_page_tuples - fill output from an exact page entry
+ */
+static void tbm_extract_page_tuples(const PagetableEntry* page, TBMIterateResult* output)
+{
+    int ntuples;
+    int wordnum;
 
-            if (w != 0) {
-                int off = wordnum * BITS_PER_BITMAPWORD + 1;
+    /* scan bitmap to extract individual offset numbers */
+    ntuples = 0;
+    for (wordnum = 0; wordnum < WORDS_PER_PAGE; wordnum++) {
+        bitmapword w = page->words[wordnum];
 
-                while (w != 0) {
-                    if (w & 1) {
-                        output->offsets[ntuples++] = (OffsetNumber)off;
-                    }
-                    off++;
-                    w >>= 1;
+        if (w != 0) {
+            int off = wordnum * BITS_PER_BITMAPWORD + 1;
+
+            while (w != 0) {
+                if (w & 1) {
+                    output->offsets[ntuples++] = (OffsetNumber)off;
                 }
+                off++;
+                w >>= 1;
             }
         }
-        output->blockno = page->entryNode.blockNo;
-        output->partitionOid = page->entryNode.partitionOid;
-        output->ntuples = ntuples;
-        output->recheck = page->recheck;
-        iterator->spageptr++;
-        return output;
     }
+    output->blockno = page->entryNode.blockNo;
+    output->partitionOid = page->entryNode.partitionOid;
+    output->ntuples = ntuples;
+    output->recheck = page->recheck;
+}
 
-    /* Nothing more in the bitmap */
-    return NULL;
+/*
+ * tbm_iterate - scan through next page of a TIDBitmap
+ *
+ * Returns a TBMIterateResult representing one page, or NULL if there are
+ * no more pages to scan.  Pages are guaranteed to be delivered in numerical
+ * order.  If result->ntuples < 0, then the bitmap is "lossy" and failed to
+ * remember the exact tuples to look at on this page --- the caller must
+ * examine all tuples on the page and check if they meet the intended
+ * condition.  If result->recheck is true, only the indicated tuples need
+ * be examined, but the condition must be rechecked anyway.  (For ease of
+ * testing, recheck is always set true when ntuples < 0.)
+ */
+TBMIterateResult* tbm_iterate(TBMIterator* iterator)
+{
+    TIDBitmap* tbm = iterator->tbm;
+    TBMIterateResult* output = &(iterator->output);
+    const PagetableEntry* page = NULL;
+    PagetableEntry* entry1 = &tbm->entry1;
+
+    Assert(tbm->iterating);
+
+    /* In ONE_PAGE state, we don't allocate an spages[] array */
+    if (!tbm_advance_iterate((tbm->status == TBM_ONE_PAGE) ? &entry1 : tbm->spages, tbm->npages, tbm->schunks,
+        tbm->nchunks, &iterator->spageptr, &iterator->schunkptr, &iterator->schunkbit, output, &page)) {
+        return NULL;
+    }
+    if (page != NULL) {
+        tbm_extract_page_tuples(page, output);
+    }
+
+    return output;
 }
 
 /*
@@ -726,6 +782,110 @@ void tbm_end_iterate(TBMIterator* iterator)
     pfree_ext(iterator);
 }
 
+/*
+ * tbm_prepare_shared_iterate - prepare a TIDBitmap to be iterated by several
+ *		threads of one parallel query
+ *
+ * The page entries are copied, in sorted order, into mcxt, which must be
+ * visible to all participants and outlive all of them; the TIDBitmap itself
+ * may be freed afterwards.  Each participant then attaches its own iterator
+ * with tbm_attach_shared_iterate, and every page of the bitmap is returned to
+ * exactly one of them.
+ */
+TBMSharedIteratorState* tbm_prepare_shared_iterate(TIDBitmap* tbm, MemoryContext mcxt)
+{
+    TBMSharedIteratorState* istate =
+        (TBMSharedIteratorState*)MemoryContextAllocZero(mcxt, sizeof(TBMSharedIteratorState));
+    PagetableEntry* entries = NULL;
+    int i;
+
+    tbm_prepare_sorted_lists(tbm);
+
+    istate->npages = tbm->npages;
+    istate->nchunks = tbm->nchunks;
+    if (tbm->nentries > 0) {
+        entries = (PagetableEntry*)MemoryContextAlloc(mcxt, tbm->nentries * sizeof(PagetableEntry));
+    }
+    if (istate->npages > 0) {
+        istate->spages = (PagetableEntry**)MemoryContextAlloc(mcxt, istate->npages * sizeof(PagetableEntry*));
+    }
+    if (istate->nchunks > 0) {
+        istate->schunks = (PagetableEntry**)MemoryContextAlloc(mcxt, istate->nchunks * sizeof(PagetableEntry*));
+    }
+
+    /* In ONE_PAGE state, we don't allocate an spages[] array */
+    for (i = 0; i < istate->npages; i++) {
+        entries[i] = (tbm->status == TBM_ONE_PAGE) ? tbm->entry1 : *tbm->spages[i];
+        istate->spages[i] = &entries[i];
+    }
+    for (i = 0; i < istate->nchunks; i++) {
+        entries[istate->npages + i] = *tbm->schunks[i];
+        istate->schunks[i] = &entries[istate->npages + i];
+    }
+
+    SpinLockInit(&istate->mutex);
+    istate->spageptr = 0;
+    istate->schunkptr = 0;
+    istate->schunkbit = 0;
+
+    return istate;
+}
+
+/*
+ * tbm_attach_shared_iterate - create a participant's iterator over a shared
+ *		iteration state, in the caller's memory context
+ */
+TBMSharedIterator* tbm_attach_shared_iterate(TBMSharedIteratorState* istate)
+{
+    TBMSharedIterator* iterator =
+        (TBMSharedIterator*)palloc(sizeof(TBMSharedIterator) + MAX_TUPLES_PER_PAGE * sizeof(OffsetNumber));
+
+    iterator->state = istate;
+
+    return iterator;
+}
+
+/*
+ * tbm_shared_iterate - scan through next page of a shared TIDBitmap
+ *
+ * As above, but the iteration pointers are shared.  Only advancing them
+ * happens under the spinlock; the offsets are extracted outside it.  Pages
+ * are delivered in numerical order overall, though each participant sees
+ * only some of them.
+ */
+TBMIterateResult* tbm_shared_iterate(TBMSharedIterator* iterator)
+{
+    TBMSharedIteratorState* istate = iterator->state;
+    TBMIterateResult* output = &(iterator->output);
+    const PagetableEntry* page = NULL;
+    bool found = false;
+
+    SpinLockAcquire(&istate->mutex);
+    found = tbm_advance_iterate(istate->spages, istate->npages, istate->schunks, istate->nchunks,
+        &istate->spageptr, &istate->schunkptr, &istate->schunkbit, output, &page);
+    SpinLockRelease(&istate->mutex);
+
+    if (!found) {
+        return NULL;
+    }
+    if (page != NULL) {
+        tbm_extract_page_tuples(page, output);
+    }
+
+    return output;
+}
+
+/*
+ * tbm_end_shared_iterate - finish a participant's shared iteration
+ *
+ * The shared state itself goes away with the memory context it was
+ * prepared in.
+ */
+void tbm_end_shared_iterate(TBMSharedIterator* iterator)
+{
+    pfree_ext(iterator);
+}
+
 /*
  * tbm_find_pageentry - find a PagetableEntry for the pageno
  *
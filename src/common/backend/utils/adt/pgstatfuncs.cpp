@@ -51,6 +51,7 @@
 #include "storage/proc.h"
 #include "storage/procarray.h"
 #include "storage/buf_internals.h"
+#include "storage/cucache_mgr.h"
 #include "workload/cpwlm.h"
 #include "workload/workload.h"
 #include "pgxc/pgxcnode.h"
@@ -11902,6 +11903,106 @@ Datum local_bgwriter_stat(PG_FUNCTION_ARGS)
     PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
 }
 
+#define BUFFER_NUMA_STAT_COL_NUM 7
+
+/*
+ * local_buffer_numa_stat
+ *		Hits and allocations of every NUMA partition of the shared buffer pool.
+ */
+Datum local_buffer_numa_stat(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc = NULL;
+        MemoryContext old_context = NULL;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        tup_desc = CreateTemplateTupleDesc(BUFFER_NUMA_STAT_COL_NUM, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "node_name", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "numa_node", INT4OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "buffers", INT4OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "hits", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "remote_hits", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "allocs", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)7, "remote_allocs", INT8OID, -1, 0);
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        func_ctx->max_calls = StrategyNumPartitions();
+
+        /* include the accesses of this thread up to now */
+        StrategyFlushCounts();
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[BUFFER_NUMA_STAT_COL_NUM];
+        bool nulls[BUFFER_NUMA_STAT_COL_NUM] = {false};
+        BufferPartitionStatus status;
+        HeapTuple tuple = NULL;
+        int partition = (int)func_ctx->call_cntr;
+
+        StrategyGetPartitionStatus(partition, &status);
+        values[0] = CStringGetTextDatum(g_instance.attr.attr_common.PGXCNodeName);
+        values[1] = Int32GetDatum(partition);
+        values[2] = Int32GetDatum(status.buf_num);
+        values[3] = Int64GetDatum(status.hits);
+        values[4] = Int64GetDatum(status.remote_hits);
+        values[5] = Int64GetDatum(status.allocs);
+        values[6] = Int64GetDatum(status.remote_allocs);
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    }
+    SRF_RETURN_DONE(func_ctx);
+}
+
+#define CU_CACHE_STAT_COL_NUM 10
+
+/*
+ * local_cu_cache_stat
+ *		Memory of the CU cache and of its compressed tier, and how CUs moved through them.
+ */
+Datum local_cu_cache_stat(PG_FUNCTION_ARGS)
+{
+    TupleDesc tup_desc = NULL;
+    Datum values[CU_CACHE_STAT_COL_NUM];
+    bool nulls[CU_CACHE_STAT_COL_NUM] = {false};
+    CacheTierStat stat;
+    HeapTuple tuple = NULL;
+
+    tup_desc = CreateTemplateTupleDesc(CU_CACHE_STAT_COL_NUM, false);
+    TupleDescInitEntry(tup_desc, (AttrNumber)1, "node_name", TEXTOID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)2, "cache_size", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)3, "used_size", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)4, "compressed_limit", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)5, "compressed_size", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)6, "compressed_cus", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)7, "demotions", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)8, "compressed_hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)9, "compressed_evictions", INT8OID, -1, 0);
+    TupleDescInitEntry(tup_desc, (AttrNumber)10, "evictions", INT8OID, -1, 0);
+    tup_desc = BlessTupleDesc(tup_desc);
+
+    CUCache->GetCacheTierStat(&stat);
+    values[0] = CStringGetTextDatum(g_instance.attr.attr_common.PGXCNodeName);
+    values[1] = Int64GetDatum(stat.cache_size);
+    values[2] = Int64GetDatum(stat.used_size);
+    values[3] = Int64GetDatum(stat.compressed_limit);
+    values[4] = Int64GetDatum(stat.compressed_size);
+    values[5] = Int64GetDatum(stat.compressed_blocks);
+    values[6] = Int64GetDatum((int64)stat.demotions);
+    values[7] = Int64GetDatum((int64)stat.compressed_hits);
+    values[8] = Int64GetDatum((int64)stat.compressed_evictions);
+    values[9] = Int64GetDatum((int64)stat.evictions);
+
+    tuple = heap_form_tuple(tup_desc, values, nulls);
+    PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
 void xc_stat_view(FuncCallContext* funcctx, int col_num, FuncName name)
 {
     MemoryContext old_context = NULL;
@@ -12374,6 +12475,103 @@ Datum gs_threadpool_status(PG_FUNCTION_ARGS)
     }
 }
 
+#define THREADPOOL_QUEUE_STAT_COL_NUM 8
+
+/*
+ * Upper bound in microseconds of the queueing delay of percent of the
+ * sessions counted in hist.  The last bucket has no upper bound, its lower
+ * one is returned for it.
+ */
+static int64 ThreadPoolQueueTimePercentile(const uint64* hist, uint64 total, int percent)
+{
+    uint64 target = (total * percent + 99) / 100;
+    uint64 count = 0;
+    int i;
+
+    for (i = 0; i < THREAD_QUEUE_TIME_BUCKETS - 1; i++) {
+        count += hist[i];
+        if (count >= target) {
+            return (i == 0) ? 0 : ((int64)1 << i);
+        }
+    }
+    return (int64)1 << (THREAD_QUEUE_TIME_BUCKETS - 2);
+}
+
+/*
+ * local_threadpool_queue_stat
+ *		Work stealing between the thread pool groups and how long their sessions
+ *		waited for a worker.
+ */
+Datum local_threadpool_queue_stat(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    ThreadPoolQueueStat* entry = NULL;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc = NULL;
+        MemoryContext old_context = NULL;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        tup_desc = CreateTemplateTupleDesc(THREADPOOL_QUEUE_STAT_COL_NUM, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "node_name", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "group_id", INT4OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "bind_numa_id", INT4OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "stolen_sessions", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "lent_sessions", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "served_sessions", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)7, "queue_time_p50_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)8, "queue_time_p99_us", INT8OID, -1, 0);
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+
+        if (ENABLE_THREAD_POOL) {
+            func_ctx->user_fctx = (void*)g_threadPoolControler->GetThreadPoolQueueStat(&(func_ctx->max_calls));
+        } else {
+            func_ctx->max_calls = 0;
+        }
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    entry = (ThreadPoolQueueStat*)func_ctx->user_fctx;
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[THREADPOOL_QUEUE_STAT_COL_NUM];
+        bool nulls[THREADPOOL_QUEUE_STAT_COL_NUM] = {false};
+        HeapTuple tuple = NULL;
+        uint64 served = 0;
+        int i;
+
+        entry += func_ctx->call_cntr;
+        for (i = 0; i < THREAD_QUEUE_TIME_BUCKETS; i++) {
+            served += entry->queueTime[i];
+        }
+
+        values[0] = CStringGetTextDatum(g_instance.attr.attr_common.PGXCNodeName);
+        values[1] = Int32GetDatum(entry->groupId);
+        values[2] = Int32GetDatum(entry->numaId);
+        values[3] = Int64GetDatum((int64)entry->stolenSessions);
+        values[4] = Int64GetDatum((int64)entry->lentSessions);
+        values[5] = Int64GetDatum((int64)served);
+        values[6] = Int64GetDatum(ThreadPoolQueueTimePercentile(entry->queueTime, served, 50));
+        values[7] = Int64GetDatum(ThreadPoolQueueTimePercentile(entry->queueTime, served, 99));
+
+        if (entry->numaId == -1) {
+            nulls[2] = true;
+        }
+        if (served == 0) {
+            nulls[6] = true;
+            nulls[7] = true;
+        }
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    }
+    SRF_RETURN_DONE(func_ctx);
+}
+
 Datum gs_globalplancache_status(PG_FUNCTION_ARGS)
 {
 #ifndef ENABLE_MULTIPLE_NODES
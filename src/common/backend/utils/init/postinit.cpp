@@ -82,6 +82,7 @@
 #include "instruments/instr_user.h"
 #include "instruments/percentile.h"
 #include "instruments/instr_workload.h"
+#include "instruments/instr_unique_sql.h"
 
 #ifdef PGXC
 #include "catalog/pgxc_node.h"
@@ -926,6 +927,9 @@ void ShutdownPostgres(int code, Datum arg)
      * them explicitly.
      */
     LockReleaseAll(USER_LOCKMETHOD, true);
+
+    /* unique sql counters of the session not added to the shared entries yet */
+    FlushUniqueSQLStat();
 }
 
 /*
@@ -37,6 +37,7 @@
 #include "access/twophase.h"
 #include "access/xact.h"
 #include "access/xlog.h"
+#include "access/xloginsert.h"
 #include "access/dfs/dfs_insert.h"
 #include "catalog/namespace.h"
 #include "catalog/pgxc_group.h"
@@ -117,6 +118,7 @@
 #include "storage/procarray.h"
 #include "storage/standby.h"
 #include "storage/remote_adapter.h"
+#include "storage/uring.h"
 #include "tcop/tcopprot.h"
 #include "threadpool/threadpool.h"
 #include "tsearch/ts_cache.h"
@@ -330,6 +332,8 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_constraint_optimization",
 #endif
     "enable_bloom_filter",
+    "enable_runtime_bloom_filter",
+    "enable_cstore_dict_filter",
 #ifdef ENABLE_MULTIPLE_NODES
     "cstore_insert_mode",
 #endif
@@ -945,6 +949,9 @@ static const struct config_enum_entry remote_read_options[] = {{"off", REMOTE_RE
     {"authentication", REMOTE_READ_AUTH, false},
     {NULL, 0, false}};
 
+static const struct config_enum_entry buffer_replacement_policy_options[] = {
+    {"clock", BUFFER_REPLACEMENT_CLOCK, false}, {"2q", BUFFER_REPLACEMENT_2Q, false}, {NULL, 0, false}};
+
 static const struct config_enum_entry resource_track_log_options[] = {
     {"summary", SUMMARY, false}, {"detail", DETAIL, false}, {NULL, 0, false}};
 
@@ -954,6 +961,11 @@ static const struct config_enum_entry opfusion_debug_level_options[] = {
 static const struct config_enum_entry unique_sql_track_option[] = {
     {"top", UNIQUE_SQL_TRACK_TOP, false}, {"all", UNIQUE_SQL_TRACK_ALL, true}, {NULL, 0, false}};
 
+static const struct config_enum_entry session_latency_class_options[] = {{"auto", SESSION_LATENCY_AUTO, false},
+    {"short", SESSION_LATENCY_SHORT, false},
+    {"long", SESSION_LATENCY_LONG, false},
+    {NULL, 0, false}};
+
 /*
  * Options for enum values stored in other modules
  */
@@ -1320,6 +1332,34 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_runtime_bloom_filter",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Enables hash joins to push bloom filters down to their outer scans outside stream plans."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_runtime_bloom_filter,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_cstore_dict_filter",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Enables column store scans to evaluate quals once per dictionary item."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_cstore_dict_filter,
+            true,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_codegen",
@@ -1657,6 +1697,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_parallel_hash",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Enables the planner's use of parallel hash plans."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_parallel_hash,
+            true,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_index_nestloop",
@@ -2565,6 +2619,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_pgstat_shared_memory",
+                PGC_POSTMASTER,
+                STATS_COLLECTOR,
+                gettext_noop("Keeps table statistics in shared memory instead of the statistics collector."),
+                NULL
+            },
+            &g_instance.attr.attr_common.enable_pgstat_shared_memory,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "track_sql_count",
@@ -3827,6 +3895,34 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_thread_pool_stealing",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("Enables idle thread pool workers to serve sessions waiting in other thread groups."),
+                NULL
+            },
+            &g_instance.attr.attr_common.enable_thread_pool_stealing,
+            true,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_thread_pool_latency_class",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("Enables thread pool workers to serve short requests before long ones."),
+                NULL
+            },
+            &g_instance.attr.attr_common.enable_thread_pool_latency_class,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_global_plancache",
@@ -4148,6 +4244,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_io_uring",
+                PGC_POSTMASTER,
+                RESOURCES_ASYNCHRONOUS,
+                gettext_noop("Use io_uring for prefetch, writeback and async direct IO batches."),
+                NULL
+            },
+            &g_instance.attr.attr_storage.enable_io_uring,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "td_compatible_truncation",
@@ -5335,6 +5445,22 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "cstore_compressed_cache_percent",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Sets the percentage of the CStore data cache that may hold CUs in compressed form only."),
+                gettext_noop("0 disables the compressed tier, cold CUs are then evicted instead of being kept compressed.")
+            },
+            &g_instance.attr.attr_storage.cstore_compressed_cache_percent,
+            0,
+            0,
+            90,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "max_loaded_cudesc",
@@ -6147,6 +6273,58 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "thread_pool_steal_remote_penalty",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("Sets the number of sessions that must wait in a thread group before "
+                             "workers of a thread group on another NUMA node serve them."),
+                NULL
+            },
+            &g_instance.attr.attr_common.thread_pool_steal_remote_penalty,
+            8,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "thread_pool_short_request_time",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("Sets the time in microseconds under which the last request of a session "
+                             "makes it a short one for the thread pool."),
+                NULL
+            },
+            &g_instance.attr.attr_common.thread_pool_short_request_time,
+            1000,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "thread_pool_latency_class_aging",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("Sets the time a long session waits for a thread pool worker "
+                             "before it is served ahead of short ones."),
+                NULL,
+                GUC_UNIT_MS
+            },
+            &g_instance.attr.attr_common.thread_pool_latency_class_aging,
+            50,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL
+        },
         /*
          * See also CheckRequiredParameterValues() if this parameter changes
          */
@@ -6491,6 +6669,23 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "wal_compression_level",
+                PGC_USERSET,
+                WAL_SETTINGS,
+                gettext_noop("Sets the compression level of full-page writes written in WAL file."),
+                gettext_noop("0 uses fast LZ4 compression, higher values use LZ4 HC, "
+                             "which is slower but writes less WAL.")
+            },
+            &u_sess->attr.attr_storage.wal_compression_level,
+            0,
+            0,
+            MAX_WAL_COMPRESSION_LEVEL,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "checkpoint_wait_timeout",
@@ -6889,6 +7084,22 @@ static void init_configure_names_int()
             assign_effective_io_concurrency,
             NULL
         },
+        {
+            {
+                "io_uring_queue_depth",
+                PGC_POSTMASTER,
+                RESOURCES_ASYNCHRONOUS,
+                gettext_noop("Sets the number of submission queue entries of each io_uring."),
+                NULL
+            },
+            &g_instance.attr.attr_storage.io_uring_queue_depth,
+            256,
+            URING_MIN_QUEUE_DEPTH,
+            URING_MAX_QUEUE_DEPTH,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "backend_flush_after",
@@ -7365,6 +7576,41 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "min_parallel_index_scan_size",
+                PGC_USERSET,
+                QUERY_TUNING_COST,
+                gettext_noop("Sets the minimum amount of index data for a parallel scan."),
+                gettext_noop("If the planner estimates that it will read a number of index "
+                    "pages too small to reach this limit, a parallel scan will not be considered."),
+                GUC_UNIT_BLOCKS,
+            },
+            &u_sess->attr.attr_sql.min_parallel_index_scan_size,
+            (512 * 1024) / BLCKSZ,
+            0,
+            INT_MAX / 3,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "vector_batch_size",
+                PGC_USERSET,
+                QUERY_TUNING,
+                gettext_noop("Sets the maximum number of rows in a vector engine batch."),
+                gettext_noop("Batches never grow beyond the compile-time capacity; hash join "
+                    "probes may use smaller batches sized to the CPU cache.")
+            },
+            &u_sess->attr.attr_sql.vector_batch_size,
+            BatchMaxSize,
+            VEC_MIN_BATCH_ROWS,
+            BatchMaxSize,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             /* Can't be set in postgresql.conf */
             {
@@ -7416,6 +7662,23 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "pgstat_shared_memory_tables",
+                PGC_POSTMASTER,
+                STATS_COLLECTOR,
+                gettext_noop("Sets the number of tables the shared memory table statistics are sized for."),
+                gettext_noop("Only used with enable_pgstat_shared_memory. The hash table does not grow, "
+                             "more tables make its buckets longer.")
+            },
+            &g_instance.attr.attr_common.pgstat_shared_memory_tables,
+            16384,
+            1024,
+            16777216,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "password_reuse_max",
@@ -9213,6 +9476,22 @@ static void init_configure_names_int()
             assign_instr_unique_sql_count,
             NULL
         },
+        {
+            {
+                "instr_unique_sql_batch_size",
+                PGC_USERSET,
+                INSTRUMENTS_OPTIONS,
+                gettext_noop("Sets how many statements a session counts before adding them to gs_instr_unique_sql."),
+                gettext_noop("1 adds each statement when it ends. Pending counts are also added when a statement ends a second after they were last added, and whenever the session goes idle.")
+            },
+            &u_sess->attr.attr_common.instr_unique_sql_batch_size,
+            32,
+            1,
+            UNIQUE_SQL_MAX_BATCH_SIZE,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "recovery_parse_workers",
@@ -9229,6 +9508,22 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "recovery_prefetch_window",
+                PGC_POSTMASTER,
+                RESOURCES_RECOVERY,
+                gettext_noop("Sets the number of data blocks parallel recovery may prefetch ahead of replay."),
+                gettext_noop("Zero disables prefetching of data blocks during parallel recovery.")
+            },
+            &g_instance.attr.attr_storage.recovery_prefetch_window,
+            256,
+            0,
+            MAX_RECOVERY_PREFETCH_WINDOW,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "recovery_redo_workers",
@@ -11265,6 +11560,21 @@ static void init_configure_names_string()
             logging_module_guc_assign,
             logging_module_guc_show
         },
+        {
+            {
+                "buffer_trace_directory",
+                PGC_SUSET,
+                DEVELOPER_OPTIONS,
+                gettext_noop("Sets the directory shared buffer accesses are traced to."),
+                gettext_noop("An empty string disables tracing."),
+                GUC_NOT_IN_SAMPLE
+            },
+            &u_sess->attr.attr_storage.buffer_trace_directory,
+            "",
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "inplace_upgrade_next_system_object_oids",
@@ -11947,6 +12257,21 @@ static void init_configure_names_enum()
             NULL,
             NULL
         },
+        {
+            {
+                "session_latency_class",
+                PGC_SUSET,
+                CLIENT_CONN_STATEMENT,
+                gettext_noop("Sets whether the thread pool serves the session as a short or a long one."),
+                gettext_noop("auto classifies the session by how long its last request kept a worker.")
+            },
+            &u_sess->attr.attr_common.session_latency_class,
+            SESSION_LATENCY_AUTO,
+            session_latency_class_options,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "opfusion_debug_mode",
@@ -11992,6 +12317,22 @@ static void init_configure_names_enum()
             NULL,
             NULL
         },
+        {
+            {
+                "buffer_replacement_policy",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Selects the replacement policy of the shared buffer pool."),
+                gettext_noop("clock evicts any unpinned buffer under the clock hand, "
+                             "2q only keeps buffers that were referenced again.")
+            },
+            &g_instance.attr.attr_storage.buffer_replacement_policy,
+            BUFFER_REPLACEMENT_CLOCK,
+            buffer_replacement_policy_options,
+            NULL,
+            NULL,
+            NULL
+        },
         /* End-of-list marker */
         {
             {
@@ -33,6 +33,7 @@
 #include "utils/lsyscache.h"
 #include "commands/tablespace.h"
 #include "catalog/pg_type.h"
+#include "utils/fmgroids.h"
 
 #include "pgxc/execRemote.h"
 #include "utils/datum.h"
@@ -49,6 +50,21 @@ typedef int (*LLVM_CMC_func)(const MultiColumns* a, const MultiColumns* b, Batch
 const int MINORDER = 6;
 const int TAPE_BUFFER_OVERHEAD = (BLCKSZ * 3);
 const int MERGE_BUFFER_SIZE = (BLCKSZ * 32);
+
+/*
+ * In-memory sorts of fewer rows than this stay on qsort, and radix buckets
+ * of fewer items than RADIX_SORT_INSERTION_ITEMS are finished by an
+ * insertion sort.
+ */
+const int RADIX_SORT_MIN_ROWS = 256;
+const int RADIX_SORT_INSERTION_ITEMS = 32;
+const int RADIX_SORT_BUCKETS = 256;
+
+typedef struct RadixSortItem {
+    uint64 key; /* normalized leading key */
+    int pos;    /* index into m_memValues before sorting */
+} RadixSortItem;
+
 extern void CopyDataRowToBatch(RemoteQueryState* node, VectorBatch* batch);
 
 template <bool abbreSortOptimize>
@@ -70,6 +86,10 @@ Datum CmpNumericFunc(PG_FUNCTION_ARGS);
 
 int CompareIntMutiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state);
 
+int CompareNormalizedMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state);
+
+static BatchSortNormKeyKind GetPlainNormKeyKind(ScanKey scanKey);
+
 Batchsortstate* batchsort_begin_heap(TupleDesc tupDesc, int nkeys, AttrNumber* attNums, Oid* sortOperators,
     Oid* sortCollations, const bool* nullsFirstFlags, int64 workMem, bool randomAccess, int64 maxMem, int planId,
     int dop)
@@ -176,12 +196,17 @@ Batchsortstate* batchsort_begin_heap(TupleDesc tupDesc, int nkeys, AttrNumber* a
 
     state->m_connDNBatch = NULL;
 
+    state->m_normKeyKind = GetPlainNormKeyKind(state->m_scanKeys);
+
     /*
      * If the first sort column doesn't satisfy optimized condition,
      * disable abbreviation here.
      */
     if (state->sortKeys[0].abbrev_converter == NULL) {
-        state->compareMultiColumn = CompareMultiColumn<false>;
+        if (state->m_normKeyKind != BS_NORMKEY_NONE)
+            state->compareMultiColumn = CompareNormalizedMultiColumn;
+        else
+            state->compareMultiColumn = CompareMultiColumn<false>;
         state->sort_putbatch = batchsort_putbatch<false>;
     } else {
         state->compareMultiColumn = CompareMultiColumn<true>;
@@ -328,8 +353,11 @@ Batchsortstate* batchsort_begin_merge(TupleDesc tupDesc, int nkeys, AttrNumber*
      * we don't care to regenerate them.  Disable abbreviation from this
      * point on. Reset compare and putbatch function.
      */
+    state->m_normKeyKind = GetPlainNormKeyKind(state->m_scanKeys);
     if (state->jitted_CompareMultiColumn)
         state->compareMultiColumn = ((LLVM_CMC_func)(state->jitted_CompareMultiColumn));
+    else if (state->m_normKeyKind != BS_NORMKEY_NONE)
+        state->compareMultiColumn = CompareNormalizedMultiColumn;
     else
         state->compareMultiColumn = CompareMultiColumn<false>;
     state->sort_putbatch = batchsort_putbatch<false>;
@@ -400,6 +428,8 @@ void batchsort_set_bound(Batchsortstate* state, int64 bound)
     /* restore the compare and putbatch function */
     if (state->jitted_CompareMultiColumn)
         state->compareMultiColumn = ((LLVM_CMC_func)(state->jitted_CompareMultiColumn));
+    else if (state->m_normKeyKind != BS_NORMKEY_NONE)
+        state->compareMultiColumn = CompareNormalizedMultiColumn;
     else
         state->compareMultiColumn = CompareMultiColumn<false>;
     state->sort_putbatch = batchsort_putbatch<false>;
@@ -789,6 +819,12 @@ bool Batchsortstate::ConsiderAbortCommon()
 void Batchsortstate::SortInMem()
 {
     if (m_storeColumns.m_memRowNum > 1) {
+        BatchSortNormKeyKind kind = GetInMemNormKeyKind();
+
+        if (kind != BS_NORMKEY_NONE && m_storeColumns.m_memRowNum >= RADIX_SORT_MIN_ROWS &&
+            RadixSortInMem(kind))
+            return;
+
         qsort_arg(m_storeColumns.m_memValues,
             m_storeColumns.m_memRowNum,
             sizeof(MultiColumns),
@@ -797,6 +833,248 @@ void Batchsortstate::SortInMem()
     }
 }
 
+/*
+ * Map the leading sort key of the rows in memory onto normalized keys, if it
+ * can be.  A leading key that is still abbreviated maps through its
+ * abbreviated value, which only text like and numeric types have.
+ */
+BatchSortNormKeyKind Batchsortstate::GetInMemNormKeyKind()
+{
+    if (sortKeys == NULL || sortKeys->abbrev_converter == NULL)
+        return m_normKeyKind;
+
+    switch (tupDesc->attrs[m_scanKeys->sk_attno - 1]->atttypid) {
+        case TEXTOID:
+        case BPCHAROID:
+        case VARCHAROID:
+        case NVARCHAR2OID:
+        case BYTEAOID:
+            return BS_NORMKEY_ABBREV_UNSIGNED;
+        case NUMERICOID:
+            return (SIZEOF_DATUM == 8) ? BS_NORMKEY_ABBREV_NUMERIC : BS_NORMKEY_NONE;
+        default:
+            return BS_NORMKEY_NONE;
+    }
+}
+
+/*
+ * Normalized key kind of a leading key sorted by its plain btree comparison
+ * function, BS_NORMKEY_NONE if the key is of another type.
+ */
+static BatchSortNormKeyKind GetPlainNormKeyKind(ScanKey scanKey)
+{
+    switch (scanKey->sk_func.fn_oid) {
+        case F_BTINT2CMP:
+            return BS_NORMKEY_INT16;
+        case F_BTINT4CMP:
+        case F_DATE_CMP:
+            return BS_NORMKEY_INT32;
+        case F_BTINT8CMP:
+        case F_TIMESTAMP_CMP:
+        case F_TIME_CMP:
+        case F_SMALLDATETIME_CMP:
+            return BS_NORMKEY_INT64;
+        case F_BTOIDCMP:
+            return BS_NORMKEY_UINT32;
+        default:
+            return BS_NORMKEY_NONE;
+    }
+}
+
+/*
+ * Normalized key of a not null leading key value: comparing two of them as
+ * unsigned integers orders them the way the sort key does, DESC included.
+ */
+static inline uint64 GetNormalizedKey(BatchSortNormKeyKind kind, Datum value, uint32 skFlags)
+{
+    const uint64 signBit = UINT64CONST(1) << 63;
+    uint64 key = 0;
+
+    switch (kind) {
+        case BS_NORMKEY_INT16:
+            key = (uint64)(int64)DatumGetInt16(value) ^ signBit;
+            break;
+        case BS_NORMKEY_INT32:
+            key = (uint64)(int64)DatumGetInt32(value) ^ signBit;
+            break;
+        case BS_NORMKEY_INT64:
+            key = (uint64)DatumGetInt64(value) ^ signBit;
+            break;
+        case BS_NORMKEY_UINT32:
+            key = (uint64)DatumGetObjectId(value);
+            break;
+        case BS_NORMKEY_ABBREV_UNSIGNED:
+            key = (uint64)value;
+            break;
+        case BS_NORMKEY_ABBREV_NUMERIC:
+            /* numeric abbreviations are negated relative to the value */
+            key = ~((uint64)DatumGetInt64(value) ^ signBit);
+            break;
+        default:
+            Assert(false);
+            break;
+    }
+
+    return (skFlags & SK_BT_DESC) ? ~key : key;
+}
+
+static inline bool RadixSortItemLess(const RadixSortItem* a, const RadixSortItem* b)
+{
+    return a->key < b->key;
+}
+
+/*
+ * MSD radix sort of items on their normalized keys, one byte per pass from
+ * byte byteIdx down.  Passes where all items share the byte are skipped,
+ * which keeps narrow value ranges of wide keys cheap.
+ */
+static void MsdRadixSort(RadixSortItem* items, RadixSortItem* scratch, int nitems, int byteIdx)
+{
+    int counts[RADIX_SORT_BUCKETS];
+    int offsets[RADIX_SORT_BUCKETS];
+
+    for (; byteIdx >= 0; byteIdx--) {
+        int shift = byteIdx * BITS_PER_BYTE;
+        int i;
+
+        if (nitems < RADIX_SORT_INSERTION_ITEMS) {
+            for (i = 1; i < nitems; i++) {
+                RadixSortItem item = items[i];
+                int j = i - 1;
+
+                while (j >= 0 && RadixSortItemLess(&item, &items[j])) {
+                    items[j + 1] = items[j];
+                    j--;
+                }
+                items[j + 1] = item;
+            }
+            return;
+        }
+
+        errno_t rc = memset_s(counts, sizeof(counts), 0, sizeof(counts));
+        securec_check(rc, "\0", "\0");
+        for (i = 0; i < nitems; i++)
+            counts[(items[i].key >> shift) & 0xFF]++;
+
+        /* all items share this byte, nothing to distribute */
+        if (counts[(items[0].key >> shift) & 0xFF] == nitems)
+            continue;
+
+        offsets[0] = 0;
+        for (i = 1; i < RADIX_SORT_BUCKETS; i++)
+            offsets[i] = offsets[i - 1] + counts[i - 1];
+        for (i = 0; i < nitems; i++)
+            scratch[offsets[(items[i].key >> shift) & 0xFF]++] = items[i];
+        rc = memcpy_s(items, nitems * sizeof(RadixSortItem), scratch, nitems * sizeof(RadixSortItem));
+        securec_check(rc, "\0", "\0");
+
+        if (byteIdx == 0)
+            return;
+
+        CHECK_FOR_INTERRUPTS();
+
+        int start = 0;
+        for (i = 0; i < RADIX_SORT_BUCKETS; i++) {
+            if (counts[i] > 1)
+                MsdRadixSort(items + start, scratch + start, counts[i], byteIdx - 1);
+            start += counts[i];
+        }
+        return;
+    }
+}
+
+/*
+ * Sort the rows in memory by a radix sort on the normalized leading key.
+ * NULLs of the leading key are set aside at the end NULLS FIRST/LAST asks
+ * for.  Rows whose normalized keys tie are then put in order by the
+ * comparator, unless the leading key is the only one and is exact.
+ *
+ * The work arrays are charged against the sort's memory budget.  Returns
+ * false without sorting if they do not fit, the caller then falls back to
+ * the comparison sort, which needs no extra memory.
+ */
+bool Batchsortstate::RadixSortInMem(BatchSortNormKeyKind kind)
+{
+    MultiColumns* values = m_storeColumns.m_memValues;
+    int rowNum = m_storeColumns.m_memRowNum;
+    int colIdx = m_scanKeys->sk_attno - 1;
+    uint32 skFlags = m_scanKeys->sk_flags;
+    bool abbreviated = (kind == BS_NORMKEY_ABBREV_UNSIGNED || kind == BS_NORMKEY_ABBREV_NUMERIC);
+    int valueIdx = abbreviated ? m_colNum : colIdx;
+    bool needTieBreak = abbreviated || m_nKeys > 1;
+    int nullNum = 0;
+    int itemNum = 0;
+    int row;
+    int64 workSpace = (int64)rowNum * (2 * sizeof(RadixSortItem) + sizeof(MultiColumns));
+
+    UseMem(workSpace);
+    if (LackMem()) {
+        FreeMem(workSpace);
+        return false;
+    }
+
+    for (row = 0; row < rowNum; row++) {
+        if (IS_NULL(values[row].m_nulls[colIdx]))
+            nullNum++;
+    }
+
+    int nullStart = (skFlags & SK_BT_NULLS_FIRST) ? 0 : rowNum - nullNum;
+    int notNullStart = (skFlags & SK_BT_NULLS_FIRST) ? nullNum : 0;
+    int nextNull = nullStart;
+
+    RadixSortItem* items = (RadixSortItem*)palloc_huge(CurrentMemoryContext, rowNum * sizeof(RadixSortItem));
+    RadixSortItem* scratch = (RadixSortItem*)palloc_huge(CurrentMemoryContext, rowNum * sizeof(RadixSortItem));
+    MultiColumns* sorted = (MultiColumns*)palloc_huge(CurrentMemoryContext, rowNum * sizeof(MultiColumns));
+
+    for (row = 0; row < rowNum; row++) {
+        if (IS_NULL(values[row].m_nulls[colIdx])) {
+            sorted[nextNull++] = values[row];
+        } else {
+            items[itemNum].key = GetNormalizedKey(kind, values[row].m_values[valueIdx], skFlags);
+            items[itemNum].pos = row;
+            itemNum++;
+        }
+    }
+
+    MsdRadixSort(items, scratch, itemNum, sizeof(uint64) - 1);
+
+    for (int i = 0; i < itemNum; i++)
+        sorted[notNullStart + i] = values[items[i].pos];
+
+    errno_t rc = memcpy_s(values, rowNum * sizeof(MultiColumns), sorted, rowNum * sizeof(MultiColumns));
+    securec_check(rc, "\0", "\0");
+
+    if (needTieBreak) {
+        if (nullNum > 1)
+            qsort_arg(values + nullStart,
+                nullNum,
+                sizeof(MultiColumns),
+                (qsort_arg_comparator)compareMultiColumn,
+                (void*)this);
+
+        for (int i = 0; i < itemNum;) {
+            int j = i + 1;
+
+            while (j < itemNum && items[j].key == items[i].key)
+                j++;
+            if (j - i > 1)
+                qsort_arg(values + notNullStart + i,
+                    j - i,
+                    sizeof(MultiColumns),
+                    (qsort_arg_comparator)compareMultiColumn,
+                    (void*)this);
+            i = j;
+        }
+    }
+
+    pfree(items);
+    pfree(scratch);
+    pfree(sorted);
+    FreeMem(workSpace);
+
+    return true;
+}
+
 void Batchsortstate::GetBatchInMemory(bool forward, VectorBatch* batch)
 {
     int i = 0;
@@ -1624,10 +1902,12 @@ void Batchsortstate::MakeBoundedHeap()
          * the upper level of sort node precislly. This case can also happen in
          * 'execute direct on' sql.
          */
-        if (sortKeys[0].abbrev_converter == NULL)
-            compareMultiColumn = CompareMultiColumn<false>;
-        else
+        if (sortKeys[0].abbrev_converter != NULL)
             compareMultiColumn = CompareMultiColumn<true>;
+        else if (m_normKeyKind != BS_NORMKEY_NONE)
+            compareMultiColumn = CompareNormalizedMultiColumn;
+        else
+            compareMultiColumn = CompareMultiColumn<false>;
     }
 
     m_storeColumns.m_memRowNum = 0; /* make the heap empty */
@@ -1816,14 +2096,12 @@ static inline int32 inlineApplySortFunction(
 }
 
 /*
- * When abbreSortOptimize is true , we use bttextcmp_abbrev or
- * numeric_cmp_abbrev to speed up compare operation, else execute the
- * old logic.
+ * Compare the sort keys from firstKey on, by their btree comparison
+ * functions.
  */
-template <bool abbreSortOptimize>
-int CompareMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state)
+static inline int CompareSortKeys(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state, int firstKey)
 {
-    ScanKey scanKey = state->m_scanKeys;
+    ScanKey scanKey = state->m_scanKeys + firstKey;
     int nkey;
     int32 compare = 0;
 
@@ -1831,27 +2109,9 @@ int CompareMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortst
     Datum datum1Tmp, datum2Tmp;
     bool isnull1 = false;
     bool isnull2 = false;
-
-    CHECK_FOR_INTERRUPTS();
-
     int colIdx;
 
-    // abbreSortOptimize is ture, run this code
-    if (abbreSortOptimize) {
-        /* Compare the leading sort key */
-        if (state->sortKeys->abbrev_converter) {
-            colIdx = scanKey->sk_attno - 1;
-            compare = ApplySortComparator(a->m_values[state->m_colNum],
-                IS_NULL(a->m_nulls[colIdx]),
-                b->m_values[state->m_colNum],
-                IS_NULL(b->m_nulls[colIdx]),
-                state->sortKeys);
-            if (compare != 0)
-                return compare;
-        }
-    }
-
-    for (nkey = 0; nkey < state->m_nKeys; ++nkey, ++scanKey) {
+    for (nkey = firstKey; nkey < state->m_nKeys; ++nkey, ++scanKey) {
         colIdx = scanKey->sk_attno - 1;
 
         Assert(colIdx >= 0);
@@ -1891,6 +2151,68 @@ int CompareMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortst
     return compare;
 }
 
+
+/*
+ * When abbreSortOptimize is true , we use bttextcmp_abbrev or
+ * numeric_cmp_abbrev to speed up compare operation, else execute the
+ * old logic.
+ */
+template <bool abbreSortOptimize>
+int CompareMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state)
+{
+    ScanKey scanKey = state->m_scanKeys;
+    int32 compare = 0;
+
+    CHECK_FOR_INTERRUPTS();
+
+    int colIdx;
+
+    // abbreSortOptimize is ture, run this code
+    if (abbreSortOptimize) {
+        /* Compare the leading sort key */
+        if (state->sortKeys->abbrev_converter) {
+            colIdx = scanKey->sk_attno - 1;
+            compare = ApplySortComparator(a->m_values[state->m_colNum],
+                IS_NULL(a->m_nulls[colIdx]),
+                b->m_values[state->m_colNum],
+                IS_NULL(b->m_nulls[colIdx]),
+                state->sortKeys);
+            if (compare != 0)
+                return compare;
+        }
+    }
+
+    return CompareSortKeys(a, b, state, 0);
+}
+
+/*
+ * Compare function for a leading key that has a plain normalized key: the
+ * leading key is compared inline on its normalized keys, the rest as in
+ * CompareMultiColumn.  This is what the run building, top N and merge heaps
+ * use when the comparator is not jitted.
+ */
+int CompareNormalizedMultiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state)
+{
+    ScanKey scanKey = state->m_scanKeys;
+    int colIdx = scanKey->sk_attno - 1;
+    bool isnull1 = IS_NULL(a->m_nulls[colIdx]);
+    bool isnull2 = IS_NULL(b->m_nulls[colIdx]);
+
+    CHECK_FOR_INTERRUPTS();
+
+    if (!isnull1 && !isnull2) {
+        uint64 key1 = GetNormalizedKey(state->m_normKeyKind, a->m_values[colIdx], scanKey->sk_flags);
+        uint64 key2 = GetNormalizedKey(state->m_normKeyKind, b->m_values[colIdx], scanKey->sk_flags);
+
+        if (key1 != key2)
+            return (key1 < key2) ? -1 : 1;
+    } else if (isnull1 != isnull2) {
+        return (isnull1 == ((scanKey->sk_flags & SK_BT_NULLS_FIRST) != 0)) ? -1 : 1;
+    }
+
+    return CompareSortKeys(a, b, state, 1);
+}
+
 void WriteMultiColumn(Batchsortstate* state, int tapeNum, MultiColumns* multiColumn)
 {
     int colNum = state->m_colNum;
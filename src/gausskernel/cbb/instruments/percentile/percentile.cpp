@@ -44,6 +44,7 @@
 #include "storage/ipc.h"
 #include "pgxc/poolutils.h"
 #include "instruments/percentile.h"
+#include "instruments/instr_histogram.h"
 #include "utils/postinit.h"
 
 extern void destroy_handles();
@@ -55,7 +56,9 @@ void SubPercentileMain(void);
 bool SetTimer(TimestampTz start, TimestampTz stop);
 bool ResetTimer(int interval);
 int64 calculate_percentile(SqlRTInfo* sql_rt_info, int counter, int percentile);
-void CalculatePercentile(SqlRTInfo* sqlRT, int counter);
+int GetPercentileValues(int* values);
+void CalculatePercentile(SqlRTInfo* sqlRT, int counter, const int* values, int num);
+void CalculateHistogramPercentile(const uint64* counts, uint64 total, const int* values, int num);
 void adjust(SqlRTInfo* sqlRT, int len, int index);
 void heapSort(SqlRTInfo* sqlRT, int size);
 void init_gspqsignal();
@@ -187,9 +190,6 @@ NON_EXEC_STATIC void PercentileMain()
     pgstat_bestart();
     pgstat_report_appname("PercentileJob");
     pgstat_report_activity(STATE_IDLE, NULL);
-    if (IS_SINGLE_NODE) {
-        pgstat_init_sql_rt_info_array(&g_instance.stat_cxt);
-    }
     while (!t_thrd.percentile_cxt.need_exit) {
         if (u_sess->sig_cxt.got_PoolReload) {
             processPoolerReload();
@@ -265,24 +265,43 @@ bool PercentileSpace::is_enable_percentile_thread(void)
     return false;
 }
 
+/*
+ * Single node merges the response time histograms of all backends, and takes
+ * the percentiles of what they counted since the last calculation.
+ */
 void PercentileSpace::calculatePercentileOfSingleNode(void)
 {
-    SqlRTInfo* sqlRT = NULL;
+    uint64* counts = NULL;
 
     if (!u_sess->attr.attr_common.enable_instr_rt_percentile)
         return;
     PG_TRY();
     {
-        int LocalCount = pgstat_fetch_sql_rt_info_counter();;
-        sqlRT = (SqlRTInfo*)palloc0(LocalCount * sizeof(SqlRTInfo));
-        pgstat_fetch_sql_rt_info_internal(sqlRT);
-        PercentileSpace::heapSort(sqlRT, LocalCount);
-        PercentileSpace::CalculatePercentile(sqlRT, LocalCount);
-        pfree_ext(sqlRT);
+        uint64* last = u_sess->percentile_cxt.LastRTHistogram;
+        uint64 total = 0;
+        int values[NUM_PERCENTILE_COUNT];
+        int num = PercentileSpace::GetPercentileValues(values);
+
+        if (last == NULL) {
+            last = (uint64*)MemoryContextAllocZero(u_sess->top_mem_cxt, LATENCY_HIST_BUCKETS * sizeof(uint64));
+            u_sess->percentile_cxt.LastRTHistogram = last;
+        }
+
+        counts = (uint64*)palloc0(LATENCY_HIST_BUCKETS * sizeof(uint64));
+        (void)pgstat_fetch_sql_rt_histogram(counts);
+        for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+            uint64 current = counts[i];
+
+            counts[i] = (current > last[i]) ? current - last[i] : 0;
+            last[i] = current;
+            total += counts[i];
+        }
+        PercentileSpace::CalculateHistogramPercentile(counts, total, values, num);
+        pfree_ext(counts);
     }
     PG_CATCH();
     {
-        pfree_ext(sqlRT);
+        pfree_ext(counts);
         FlushErrorState();
         elog(WARNING, "Percentile job failed");
     }
@@ -454,6 +473,8 @@ void processCalculatePercentile()
     int TotalCount = 0;
     int LocalCount;
     bool isTimeOut = false;
+    int values[NUM_PERCENTILE_COUNT];
+    int num = PercentileSpace::GetPercentileValues(values);
     /* get all data node index */
     cnlist = GetAllCoordNodes();
     PG_TRY();
@@ -493,7 +514,7 @@ void processCalculatePercentile()
 
             /* 5 calculate percentile */
             PercentileSpace::heapSort(sqlRT, TotalCount + LocalCount);
-            PercentileSpace::CalculatePercentile(sqlRT, TotalCount + LocalCount);
+            PercentileSpace::CalculatePercentile(sqlRT, TotalCount + LocalCount, values, num);
         }
         pfree(sqlRT);
     }
@@ -538,19 +559,16 @@ void PercentileSpace::heapSort(SqlRTInfo* sqlRT, int size)
     }
 }
 
-void PercentileSpace::CalculatePercentile(SqlRTInfo* sqlRT, int counter)
+/*
+ * GetPercentileValues - parse the guc parameter percentile_values into values,
+ * which has room for NUM_PERCENTILE_COUNT of them, returns how many there are
+ */
+int PercentileSpace::GetPercentileValues(int* values)
 {
     char* percentile = NULL;
     List* percentilelist = NIL;
     ListCell* l = NULL;
-    int i = 0;
-    if (counter == 0) {
-        /* there is no sql executed during last 10 seconds, so the percentile is 0 */
-        for (int j = 0; j < NUM_PERCENTILE_COUNT; j++) {
-            g_instance.stat_cxt.RTPERCENTILE[j] = 0;
-        }
-        return;
-    }
+    int num = 0;
 
     /* guc paramater percentile_values is reserved, only surport 80,95 now */
     percentile = pstrdup(u_sess->attr.attr_common.percentile_values);
@@ -559,25 +577,48 @@ void PercentileSpace::CalculatePercentile(SqlRTInfo* sqlRT, int counter)
         /* this should not happen if GUC checked check_percentile */
         pfree_ext(percentile);
         list_free_ext(percentilelist);
-        pfree_ext(sqlRT);
         ereport(ERROR, (errcode(ERRCODE_UNEXPECTED_NODE_STATE), errmsg("Invalid percentile syntax")));
     }
 
     if (list_length(percentilelist) > NUM_PERCENTILE_COUNT) {
         pfree_ext(percentile);
         list_free_ext(percentilelist);
-        pfree_ext(sqlRT);
         ereport(ERROR, (errcode(ERRCODE_UNEXPECTED_NODE_STATE), errmsg("Too many percentile values")));
     }
 
-    LWLockAcquire(PercentileLock, LW_EXCLUSIVE);
     foreach (l, percentilelist) {
-        int pv = pg_atoi((char*)lfirst(l), sizeof(int), 0);
-        g_instance.stat_cxt.RTPERCENTILE[i++] = PercentileSpace::calculate_percentile(sqlRT, counter, pv);
+        values[num++] = pg_atoi((char*)lfirst(l), sizeof(int), 0);
     }
-    LWLockRelease(PercentileLock);
     pfree_ext(percentile);
     list_free_ext(percentilelist);
+    return num;
+}
+
+void PercentileSpace::CalculatePercentile(SqlRTInfo* sqlRT, int counter, const int* values, int num)
+{
+    if (counter == 0) {
+        /* there is no sql executed during last 10 seconds, so the percentile is 0 */
+        for (int j = 0; j < NUM_PERCENTILE_COUNT; j++) {
+            g_instance.stat_cxt.RTPERCENTILE[j] = 0;
+        }
+        return;
+    }
+
+    LWLockAcquire(PercentileLock, LW_EXCLUSIVE);
+    for (int i = 0; i < num; i++) {
+        g_instance.stat_cxt.RTPERCENTILE[i] = PercentileSpace::calculate_percentile(sqlRT, counter, values[i]);
+    }
+    LWLockRelease(PercentileLock);
+}
+
+void PercentileSpace::CalculateHistogramPercentile(const uint64* counts, uint64 total, const int* values, int num)
+{
+    /* with no sql executed since the last calculation, the percentiles are 0 */
+    LWLockAcquire(PercentileLock, LW_EXCLUSIVE);
+    for (int i = 0; i < num; i++) {
+        g_instance.stat_cxt.RTPERCENTILE[i] = LatencyHistogramPercentile(counts, total, values[i]);
+    }
+    LWLockRelease(PercentileLock);
 }
 
 int64 PercentileSpace::calculate_percentile(SqlRTInfo* sqlRT, int counter, int percentile)
@@ -25,6 +25,7 @@
 #include "knl/knl_variable.h"
 #include "instruments/instr_unique_sql.h"
 #include "instruments/unique_query.h"
+#include "instruments/instr_histogram.h"
 #include "utils/atomic.h"
 #include "utils/lsyscache.h"
 #include "utils/hsearch.h"
@@ -124,7 +125,10 @@ typedef struct {
 typedef struct {
     UniqueSQLKey key; /* CN oid + user oid + unique sql id */
 
-    /* alloc extra UNIQUE_SQL_MAX_LEN space to store unique sql string */
+    /*
+     * alloc extra space after the entry for the elapse time histogram, see
+     * UniqueSQLElapseHist, and UNIQUE_SQL_MAX_LEN to store unique sql string
+     */
     char* unique_sql; /* unique sql text */
 
     pg_atomic_uint64 calls;          /* calling times */
@@ -137,6 +141,49 @@ typedef struct {
     bool is_local;                     /* local sql(run from current node) */
 } UniqueSQL;
 
+/* a session adds its pending counters to the shared entries at least this often */
+const int UNIQUE_SQL_FLUSH_INTERVAL_MS = 1000;
+
+/* most unique sqls a session keeps pending counters of */
+const int UNIQUE_SQL_MAX_PENDING = 64;
+
+/*
+ * Unique SQL counters of one session not added to the shared entry yet
+ *
+ * Statements of a unique sql the session has already added to the shared
+ * hash table are counted here without taking the partition lock, and
+ * FlushUniqueSQLStat adds them to the shared entry once a batch, so the
+ * lock and the atomic adds are paid once per instr_unique_sql_batch_size
+ * statements rather than once per statement.
+ */
+typedef struct {
+    UniqueSQLKey key;       /* same key as the shared entry */
+    TimestampTz reset_time; /* NodeStatResetTime when counting started */
+
+    int updates; /* statements counted */
+    uint64 calls;
+    int64 total_time;
+    int64 min_time;
+    int64 max_time;
+    int nelapse;    /* elapse times in elapse */
+    int elapse_max; /* room in elapse */
+    int64* elapse;  /* for the histogram, allocated when the entries have one */
+
+    uint64 returned_rows;
+    uint64 tuples_fetched;
+    uint64 tuples_returned;
+    uint64 tuples_inserted;
+    uint64 tuples_updated;
+    uint64 tuples_deleted;
+    uint64 blocks_fetched;
+    uint64 blocks_hit;
+
+    uint64 soft_parse;
+    uint64 hard_parse;
+
+    int64 timeInfo[TOTAL_TIME_INFO_TYPES];
+} UniqueSQLPendingStat;
+
 /* ---------Thread Local Variable---------- */
 /* save prev-hooks */
 static post_parse_analyze_hook_type g_prev_post_parse_analyze_hook = NULL;
@@ -174,12 +221,27 @@ static void UnlockUniqueSQLHashPartition(uint32 hashCode)
     LWLockRelease(partitionLock);
 }
 
+/*
+ * UniqueSQLElapseHist - the elapse time histogram of the entry, NULL when
+ * enable_instr_rt_percentile was off at startup and entries have none
+ */
+static LatencyHistogram* UniqueSQLElapseHist(UniqueSQL* entry)
+{
+    if (!g_instance.stat_cxt.unique_sql_elapse_hist) {
+        return NULL;
+    }
+
+    return (LatencyHistogram*)(entry + 1);
+}
+
 /*
  * resetUniqueSQLEntry - reset UniqueSQL entry except key
  */
 static void resetUniqueSQLEntry(UniqueSQL* entry)
 {
     if (entry != NULL) {
+        LatencyHistogram* elapse_hist = UniqueSQLElapseHist(entry);
+
         pg_atomic_write_u64(&(entry->calls), 0);
         entry->unique_sql = NULL;
 
@@ -187,6 +249,9 @@ static void resetUniqueSQLEntry(UniqueSQL* entry)
         gs_lock_test_and_set_64(&(entry->elapse_time.total_time), 0);
         gs_lock_test_and_set_64(&(entry->elapse_time.min_time), 0);
         gs_lock_test_and_set_64(&(entry->elapse_time.max_time), 0);
+        if (elapse_hist != NULL) {
+            LatencyHistogramReset(elapse_hist);
+        }
 
         // reset row activity stat
         pg_atomic_write_u64(&(entry->row_activity.returned_rows), 0);
@@ -239,12 +304,17 @@ void InitUniqueSQL()
 
     ctl.hcxt = g_instance.stat_cxt.UniqueSqlContext;
     ctl.keysize = sizeof(UniqueSQLKey);
+    ctl.entrysize = sizeof(UniqueSQL);
+
+    // the elapse time histogram takes about 2KB, only alloc it when percentiles are calculated
+    g_instance.stat_cxt.unique_sql_elapse_hist = u_sess->attr.attr_common.enable_instr_rt_percentile;
+    if (g_instance.stat_cxt.unique_sql_elapse_hist) {
+        ctl.entrysize += sizeof(LatencyHistogram);
+    }
 
     // alloc extra space for normalized query(only CN stores sql string)
     if (need_normalize_unique_string()) {
-        ctl.entrysize = sizeof(UniqueSQL) + UNIQUE_SQL_MAX_LEN;
-    } else {
-        ctl.entrysize = sizeof(UniqueSQL);
+        ctl.entrysize += UNIQUE_SQL_MAX_LEN;
     }
 
     ctl.hash = uniqueSQLHashCode;
@@ -321,11 +391,15 @@ static void UpdateUniqueSQLElapseTime(UniqueSQL* unique_sql, int64 elapse_start)
     }
 
     TimestampTz elapse_time = GetCurrentTimestamp() - elapse_start;
+    LatencyHistogram* elapse_hist = UniqueSQLElapseHist(unique_sql);
 
     /* update unique sql's total/max/min time */
     gs_atomic_add_64(&(unique_sql->elapse_time.total_time), elapse_time);
     updateMaxValueForAtomicType(elapse_time, &(unique_sql->elapse_time.max_time));
     updateMinValueForAtomicType(elapse_time, &(unique_sql->elapse_time.min_time));
+    if (elapse_hist != NULL) {
+        LatencyHistogramAdd(elapse_hist, elapse_time);
+    }
 }
 
 /*
@@ -420,6 +494,9 @@ static void set_unique_sql_string_in_entry(UniqueSQL* entry, Query* query, const
     // only CN stores normalized query string
     if (need_normalize_unique_string()) {
         entry->unique_sql = (char*)(entry + 1);
+        if (g_instance.stat_cxt.unique_sql_elapse_hist) {
+            entry->unique_sql += sizeof(LatencyHistogram);
+        }
         rc = memset_s(entry->unique_sql, UNIQUE_SQL_MAX_LEN, 0, UNIQUE_SQL_MAX_LEN);
         securec_check(rc, "\0", "\0");
     } else {
@@ -495,6 +572,291 @@ void UpdateSingleNodeByPassUniqueSQLStat(bool isTopLevel)
  *     - calls
  *     - response time(only input the start elapse time)
  */
+/*
+ * ApplyUniqueSQLPendingStat - add the pending counters of a session to the
+ * shared entry, with the partition lock held
+ */
+static void ApplyUniqueSQLPendingStat(UniqueSQL* entry, const UniqueSQLPendingStat* pending)
+{
+    LatencyHistogram* elapse_hist = UniqueSQLElapseHist(entry);
+
+    if (pending->calls > 0) {
+        pg_atomic_fetch_add_u64(&entry->calls, pending->calls);
+        gs_atomic_add_64(&(entry->elapse_time.total_time), pending->total_time);
+        updateMaxValueForAtomicType(pending->max_time, &(entry->elapse_time.max_time));
+        updateMinValueForAtomicType(pending->min_time, &(entry->elapse_time.min_time));
+        for (int i = 0; elapse_hist != NULL && i < pending->nelapse; i++) {
+            LatencyHistogramAdd(elapse_hist, pending->elapse[i]);
+        }
+    }
+
+    if (pending->returned_rows > 0) {
+        pg_atomic_fetch_add_u64(&entry->row_activity.returned_rows, pending->returned_rows);
+    }
+    if (pending->tuples_fetched > 0 || pending->tuples_returned > 0 || pending->tuples_inserted > 0 ||
+        pending->tuples_updated > 0 || pending->tuples_deleted > 0 || pending->blocks_fetched > 0 ||
+        pending->blocks_hit > 0) {
+        pg_atomic_fetch_add_u64(&entry->row_activity.tuples_fetched, pending->tuples_fetched);
+        pg_atomic_fetch_add_u64(&entry->row_activity.tuples_returned, pending->tuples_returned);
+        pg_atomic_fetch_add_u64(&entry->row_activity.tuples_inserted, pending->tuples_inserted);
+        pg_atomic_fetch_add_u64(&entry->row_activity.tuples_updated, pending->tuples_updated);
+        pg_atomic_fetch_add_u64(&entry->row_activity.tuples_deleted, pending->tuples_deleted);
+        pg_atomic_fetch_add_u64(&entry->cache_io.blocks_fetched, pending->blocks_fetched);
+        pg_atomic_fetch_add_u64(&entry->cache_io.blocks_hit, pending->blocks_hit);
+    }
+
+    if (pending->soft_parse > 0) {
+        pg_atomic_fetch_add_u64(&entry->parse.soft_parse, pending->soft_parse);
+    }
+    if (pending->hard_parse > 0) {
+        pg_atomic_fetch_add_u64(&entry->parse.hard_parse, pending->hard_parse);
+    }
+
+    for (int idx = 0; idx < TOTAL_TIME_INFO_TYPES; idx++) {
+        entry->timeInfo.TimeInfoArray[idx] += pending->timeInfo[idx];
+    }
+}
+
+static void ResetUniqueSQLPendingStat(UniqueSQLPendingStat* pending, TimestampTz reset_time)
+{
+    UniqueSQLKey key = pending->key;
+    int64* elapse = pending->elapse;
+    int elapse_max = pending->elapse_max;
+    errno_t rc = memset_s(pending, sizeof(UniqueSQLPendingStat), 0, sizeof(UniqueSQLPendingStat));
+    securec_check(rc, "\0", "\0");
+
+    pending->key = key;
+    pending->reset_time = reset_time;
+    pending->elapse = elapse;
+    pending->elapse_max = elapse_max;
+}
+
+static void RemoveUniqueSQLPendingStat(HTAB* pending_hash, UniqueSQLPendingStat* pending)
+{
+    pfree_ext(pending->elapse);
+    hash_search(pending_hash, &pending->key, HASH_REMOVE, NULL);
+}
+
+/*
+ * DestroyUniqueSQLPendingStats - flush the pending counters of the session
+ * and drop them
+ */
+static void DestroyUniqueSQLPendingStats()
+{
+    HTAB* pending_hash = u_sess->unique_sql_cxt.pending_stat_hash;
+    HASH_SEQ_STATUS hash_seq;
+    UniqueSQLPendingStat* pending = NULL;
+
+    FlushUniqueSQLStat();
+
+    hash_seq_init(&hash_seq, pending_hash);
+    while ((pending = (UniqueSQLPendingStat*)hash_seq_search(&hash_seq)) != NULL) {
+        pfree_ext(pending->elapse);
+    }
+    hash_destroy(pending_hash);
+    u_sess->unique_sql_cxt.pending_stat_hash = NULL;
+}
+
+/*
+ * FlushUniqueSQLStat - add the pending counters of the session to the
+ * shared unique sql entries
+ *
+ * An entry evicted from the shared hash table since it was counted is
+ * entered again, the way UpdateUniqueSQLStat enters a remote unique sql.  A
+ * local unique sql cannot be, it would have no sql text, so its counters are
+ * dropped, as are those of entries reset since they were counted; their
+ * pending entries are removed too, so the next statement of the unique sql
+ * goes to the shared hash table again.
+ */
+void FlushUniqueSQLStat()
+{
+    HTAB* pending_hash = u_sess->unique_sql_cxt.pending_stat_hash;
+    HASH_SEQ_STATUS hash_seq;
+    UniqueSQLPendingStat* pending = NULL;
+
+    if (pending_hash == NULL) {
+        return;
+    }
+
+    hash_seq_init(&hash_seq, pending_hash);
+    while ((pending = (UniqueSQLPendingStat*)hash_seq_search(&hash_seq)) != NULL) {
+        TimestampTz reset_time = g_instance.stat_cxt.NodeStatResetTime;
+        bool applied = false;
+
+        if (pending->updates == 0 && pending->reset_time == reset_time) {
+            continue;
+        }
+
+        if (pending->reset_time == reset_time && g_instance.stat_cxt.UniqueSQLHashtbl != NULL) {
+            uint32 hashCode = uniqueSQLHashCode(&pending->key, sizeof(UniqueSQLKey));
+            bool found = false;
+
+            LockUniqueSQLHashPartition(hashCode, LW_SHARED);
+            UniqueSQL* entry = (UniqueSQL*)hash_search(
+                g_instance.stat_cxt.UniqueSQLHashtbl, &pending->key, HASH_FIND, NULL);
+            if (entry == NULL && !is_local_unique_sql()) {
+                UnlockUniqueSQLHashPartition(hashCode);
+
+                LockUniqueSQLHashPartition(hashCode, LW_EXCLUSIVE);
+                entry = (UniqueSQL*)hash_search(
+                    g_instance.stat_cxt.UniqueSQLHashtbl, &pending->key, HASH_ENTER, &found);
+                if (entry != NULL && !found) {
+                    resetUniqueSQLEntry(entry);
+                    set_unique_sql_string_in_entry(entry, NULL, NULL);
+                }
+            }
+            if (entry != NULL) {
+                ApplyUniqueSQLPendingStat(entry, pending);
+                applied = true;
+            }
+            UnlockUniqueSQLHashPartition(hashCode);
+        }
+
+        if (applied) {
+            ResetUniqueSQLPendingStat(pending, reset_time);
+        } else {
+            RemoveUniqueSQLPendingStat(pending_hash, pending);
+        }
+    }
+
+    u_sess->unique_sql_cxt.pending_flush_time = GetCurrentTimestamp();
+}
+
+/*
+ * CheckUniqueSQLStatFlush - add the pending counters of the session to the
+ * shared unique sql entries if they were last added a flush interval ago
+ *
+ * Called whenever a statement ends; the session flushes them all when it
+ * goes idle, so that they are not held back for as long as it stays idle.
+ */
+void CheckUniqueSQLStatFlush()
+{
+    if (u_sess->unique_sql_cxt.pending_stat_hash != NULL &&
+        TimestampDifferenceExceeds(
+            u_sess->unique_sql_cxt.pending_flush_time, GetCurrentTimestamp(), UNIQUE_SQL_FLUSH_INTERVAL_MS)) {
+        FlushUniqueSQLStat();
+    }
+}
+
+/*
+ * AddUniqueSQLPendingStat - count the statement in the pending counters of
+ * the session, false if the unique sql has none and the shared entry is to
+ * be updated instead
+ */
+static bool AddUniqueSQLPendingStat(
+    const UniqueSQLKey* key, int64 elapse_start_time, PgStat_TableCounts* agg_table_stat, int64 timeInfo[])
+{
+    HTAB* pending_hash = u_sess->unique_sql_cxt.pending_stat_hash;
+    UniqueSQLPendingStat* pending = NULL;
+    TimestampTz now;
+
+    if (pending_hash == NULL) {
+        return false;
+    }
+
+    /* batching turned off in the middle of the session */
+    if (u_sess->attr.attr_common.instr_unique_sql_batch_size <= 1) {
+        DestroyUniqueSQLPendingStats();
+        return false;
+    }
+
+    pending = (UniqueSQLPendingStat*)hash_search(pending_hash, key, HASH_FIND, NULL);
+    if (pending == NULL) {
+        return false;
+    }
+    if (pending->reset_time != g_instance.stat_cxt.NodeStatResetTime) {
+        RemoveUniqueSQLPendingStat(pending_hash, pending);
+        return false;
+    }
+
+    now = GetCurrentTimestamp();
+    pending->updates++;
+    if ((IS_PGXC_COORDINATOR || IS_SINGLE_NODE) && elapse_start_time != 0) {
+        int64 elapse_time = now - elapse_start_time;
+
+        pending->calls++;
+        pending->total_time += elapse_time;
+        pending->max_time = Max(pending->max_time, elapse_time);
+        if (pending->min_time == 0 || pending->min_time > elapse_time) {
+            pending->min_time = elapse_time;
+        }
+        if (g_instance.stat_cxt.unique_sql_elapse_hist) {
+            if (pending->elapse == NULL) {
+                pending->elapse_max = u_sess->attr.attr_common.instr_unique_sql_batch_size;
+                pending->elapse = (int64*)MemoryContextAlloc(u_sess->top_mem_cxt, sizeof(int64) * pending->elapse_max);
+            }
+            pending->elapse[pending->nelapse++] = elapse_time;
+        }
+        pending->returned_rows += u_sess->unique_sql_cxt.unique_sql_returned_rows_counter;
+    } else if (IS_PGXC_DATANODE && agg_table_stat != NULL) {
+        pending->tuples_fetched += agg_table_stat->t_tuples_fetched;
+        pending->tuples_returned += agg_table_stat->t_tuples_returned;
+        pending->tuples_inserted += agg_table_stat->t_tuples_inserted;
+        pending->tuples_updated += agg_table_stat->t_tuples_updated;
+        pending->tuples_deleted += agg_table_stat->t_tuples_deleted;
+        pending->blocks_fetched += agg_table_stat->t_blocks_fetched;
+        pending->blocks_hit += agg_table_stat->t_blocks_hit;
+    }
+
+    pending->soft_parse += u_sess->unique_sql_cxt.unique_sql_soft_parse;
+    pending->hard_parse += u_sess->unique_sql_cxt.unique_sql_hard_parse;
+    UniqueSQLStatCountResetParseCounter();
+
+    if (timeInfo != NULL) {
+        for (int idx = 0; idx < TOTAL_TIME_INFO_TYPES; idx++) {
+            pending->timeInfo[idx] += timeInfo[idx];
+        }
+    }
+
+    if (pending->updates >= u_sess->attr.attr_common.instr_unique_sql_batch_size ||
+        (pending->elapse != NULL && pending->nelapse >= pending->elapse_max)) {
+        FlushUniqueSQLStat();
+    }
+
+    return true;
+}
+
+/*
+ * RegisterUniqueSQLPendingStat - start pending counters for a unique sql
+ * found in the shared hash table as of reset_time
+ */
+static void RegisterUniqueSQLPendingStat(const UniqueSQLKey* key, TimestampTz reset_time)
+{
+    UniqueSQLPendingStat* pending = NULL;
+    bool found = false;
+
+    if (u_sess->attr.attr_common.instr_unique_sql_batch_size <= 1) {
+        return;
+    }
+
+    if (u_sess->unique_sql_cxt.pending_stat_hash != NULL &&
+        hash_get_num_entries(u_sess->unique_sql_cxt.pending_stat_hash) >= UNIQUE_SQL_MAX_PENDING) {
+        DestroyUniqueSQLPendingStats();
+    }
+
+    if (u_sess->unique_sql_cxt.pending_stat_hash == NULL) {
+        HASHCTL ctl;
+        errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+        securec_check(rc, "\0", "\0");
+
+        ctl.keysize = sizeof(UniqueSQLKey);
+        ctl.entrysize = sizeof(UniqueSQLPendingStat);
+        ctl.hash = uniqueSQLHashCode;
+        ctl.match = uniqueSQLMatch;
+        ctl.hcxt = u_sess->top_mem_cxt;
+        u_sess->unique_sql_cxt.pending_stat_hash = hash_create("unique sql pending stat",
+            UNIQUE_SQL_MAX_PENDING,
+            &ctl,
+            HASH_ELEM | HASH_FUNCTION | HASH_COMPARE | HASH_CONTEXT);
+        u_sess->unique_sql_cxt.pending_flush_time = GetCurrentTimestamp();
+    }
+
+    pending = (UniqueSQLPendingStat*)hash_search(u_sess->unique_sql_cxt.pending_stat_hash, key, HASH_ENTER, &found);
+    if (!found) {
+        ResetUniqueSQLPendingStat(pending, reset_time);
+    }
+}
+
 void UpdateUniqueSQLStat(
     Query* query, const char* sql, int64 elapse_start_time, PgStat_TableCounts* agg_table_stat, int64 timeInfo[])
 {
@@ -524,7 +886,16 @@ void UpdateUniqueSQLStat(
                 key.user_id,
                 key.unique_sql_id)));
 
+    /* counters of any unique sql wait no longer than the flush interval */
+    CheckUniqueSQLStatFlush();
+
+    /* a unique sql counted by the session before needs no lookup in the shared hash table */
+    if (AddUniqueSQLPendingStat(&key, elapse_start_time, agg_table_stat, timeInfo)) {
+        return;
+    }
+
     uint32 hashCode = uniqueSQLHashCode(&key, sizeof(key));
+    TimestampTz reset_time = g_instance.stat_cxt.NodeStatResetTime;
 
     LockUniqueSQLHashPartition(hashCode, LW_SHARED);
     entry = (UniqueSQL*)hash_search(g_instance.stat_cxt.UniqueSQLHashtbl, &key, HASH_FIND, NULL);
@@ -591,6 +962,8 @@ void UpdateUniqueSQLStat(
     UpdateUniqueSQLTimeStat(entry, timeInfo);
 
     UnlockUniqueSQLHashPartition(hashCode);
+
+    RegisterUniqueSQLPendingStat(&key, reset_time);
 }
 
 /*
@@ -1103,6 +1476,9 @@ void* GetUniqueSQLStat(long* num)
     UniqueSQL* unique_sql_array = NULL;
     UniqueSQL* entry = NULL;
 
+    /* so the session sees its own statements */
+    FlushUniqueSQLStat();
+
     for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
         LWLockAcquire(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i), LW_SHARED);
     }
@@ -1191,11 +1567,11 @@ static void create_tuple_entry(TupleDesc tupdesc)
     }
 }
 
-static void set_tuple_cn_node_name(UniqueSQL* unique_sql, Datum* values, int* i)
+static void set_tuple_cn_node_name(const UniqueSQLKey* key, Datum* values, int* i)
 {
     // cn node name
     if (IS_PGXC_COORDINATOR || IS_SINGLE_NODE) {
-        char* node_name = get_pgxc_node_name_by_node_id(unique_sql->key.cn_id, false);
+        char* node_name = get_pgxc_node_name_by_node_id(key->cn_id, false);
         if (node_name != NULL) {
             values[(*i)++] = DirectFunctionCall1(namein, CStringGetDatum(node_name));
             pfree(node_name);
@@ -1211,13 +1587,13 @@ static void set_tuple_cn_node_name(UniqueSQL* unique_sql, Datum* values, int* i)
     }
 }
 
-static void set_tuple_user_name(UniqueSQL* unique_sql, Datum* values, int* i)
+static void set_tuple_user_name(const UniqueSQLKey* key, Datum* values, int* i)
 {
     char user_name[NAMEDATALEN] = {0};
 
     // user name
     if (IS_PGXC_COORDINATOR || IS_SINGLE_NODE) {
-        if (GetRoleName(unique_sql->key.user_id, user_name, sizeof(user_name)) != NULL) {
+        if (GetRoleName(key->user_id, user_name, sizeof(user_name)) != NULL) {
             values[(*i)++] = DirectFunctionCall1(namein, CStringGetDatum(user_name));
         } else {
             values[(*i)++] = DirectFunctionCall1(namein, CStringGetDatum("*REMOVED_USER*"));
@@ -1241,9 +1617,9 @@ static void set_tuple_value(UniqueSQL* unique_sql, Datum* values, bool* nulls, i
     int i = 0;
     int num = 0;
 
-    set_tuple_cn_node_name(unique_sql, values, &i);
+    set_tuple_cn_node_name(&unique_sql->key, values, &i);
     values[i++] = UInt32GetDatum(unique_sql->key.cn_id);
-    set_tuple_user_name(unique_sql, values, &i);
+    set_tuple_user_name(&unique_sql->key, values, &i);
 
     // basic info
     values[i++] = ObjectIdGetDatum(unique_sql->key.user_id);
@@ -1344,6 +1720,159 @@ Datum get_instr_unique_sql(PG_FUNCTION_ARGS)
     }
 }
 
+typedef struct {
+    UniqueSQLKey key;
+    uint64 calls;
+    int64 elapse_time; /* the percentile of the elapse time */
+} UniqueSQLRTPercentile;
+
+/*
+ * GetUniqueSQLRTPercentile - read the percentile of the elapse time of every
+ * unique sql run on this node from its histogram
+ */
+static UniqueSQLRTPercentile* GetUniqueSQLRTPercentile(int percentile, long* num)
+{
+    HASH_SEQ_STATUS hash_seq;
+    UniqueSQLRTPercentile* rt_array = NULL;
+    UniqueSQL* entry = NULL;
+    uint64 counts[LATENCY_HIST_BUCKETS];
+    long n = 0;
+    int i;
+
+    *num = 0;
+    if (!is_unique_sql_enabled() || g_instance.stat_cxt.UniqueSQLHashtbl == NULL) {
+        return NULL;
+    }
+
+    FlushUniqueSQLStat();
+
+    for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
+        LWLockAcquire(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i), LW_SHARED);
+    }
+
+    long max_num = hash_get_num_entries(g_instance.stat_cxt.UniqueSQLHashtbl);
+    if (max_num > 0) {
+        rt_array = (UniqueSQLRTPercentile*)palloc0_noexcept(max_num * sizeof(UniqueSQLRTPercentile));
+        if (rt_array == NULL) {
+            for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
+                LWLockRelease(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i));
+            }
+
+            ereport(ERROR, (errmsg("[UniqueSQL] palloc0 error when querying unique sql response time percentile!")));
+        }
+
+        hash_seq_init(&hash_seq, g_instance.stat_cxt.UniqueSQLHashtbl);
+        while ((entry = (UniqueSQL*)hash_seq_search(&hash_seq)) != NULL) {
+            /* only the node running the sql records its elapse time */
+            if (n >= max_num || pg_atomic_read_u64(&entry->calls) == 0) {
+                continue;
+            }
+
+            errno_t rc = memset_s(counts, sizeof(counts), 0, sizeof(counts));
+            securec_check(rc, "\0", "\0");
+            uint64 total = LatencyHistogramMerge(counts, UniqueSQLElapseHist(entry));
+
+            rt_array[n].key = entry->key;
+            rt_array[n].calls = total;
+            rt_array[n].elapse_time = LatencyHistogramPercentile(counts, total, percentile);
+            n++;
+        }
+    }
+
+    for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
+        LWLockRelease(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i));
+    }
+
+    *num = n;
+    return rt_array;
+}
+
+/*
+ * get_instr_unique_sql_rt_percentile - C function to get the given percentile
+ * of the elapse time of each unique sql
+ */
+Datum get_instr_unique_sql_rt_percentile(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    long num = 0;
+
+#define INSTRUMENTS_UNIQUE_SQL_RT_ATTRNUM 6
+
+    if (!superuser()) {
+        ereport(
+            ERROR, (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE), (errmsg("only system admin can query unique sql view"))));
+    }
+
+    if (SRF_IS_FIRSTCALL()) {
+        MemoryContext oldcontext = NULL;
+        TupleDesc tupdesc = NULL;
+        int percentile = PG_GETARG_INT32(0);
+        int i = 0;
+
+        if (percentile < 0 || percentile > 100) {
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                    errmsg("percentile must be between 0 and 100, got %d", percentile)));
+        }
+
+        if (!g_instance.stat_cxt.unique_sql_elapse_hist) {
+            ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("unique sql elapse time histograms are not collected"),
+                    errhint("Set enable_instr_rt_percentile to on and restart the server.")));
+        }
+
+        funcctx = SRF_FIRSTCALL_INIT();
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        tupdesc = CreateTemplateTupleDesc(INSTRUMENTS_UNIQUE_SQL_RT_ATTRNUM, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "node_name", NAMEOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "user_name", NAMEOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "user_id", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "unique_sql_id", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "n_calls", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "elapse_time", INT8OID, -1, 0);
+
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+        funcctx->user_fctx = GetUniqueSQLRTPercentile(percentile, &num);
+        funcctx->max_calls = num;
+        MemoryContextSwitchTo(oldcontext);
+
+        if (funcctx->max_calls == 0) {
+            if (funcctx->user_fctx) {
+                pfree_ext(funcctx->user_fctx);
+            }
+            SRF_RETURN_DONE(funcctx);
+        }
+    }
+
+    funcctx = SRF_PERCALL_SETUP();
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[INSTRUMENTS_UNIQUE_SQL_RT_ATTRNUM];
+        bool nulls[INSTRUMENTS_UNIQUE_SQL_RT_ATTRNUM] = {false};
+        HeapTuple tuple = NULL;
+        int i = 0;
+
+        UniqueSQLRTPercentile* rt = (UniqueSQLRTPercentile*)funcctx->user_fctx + funcctx->call_cntr;
+
+        set_tuple_cn_node_name(&rt->key, values, &i);
+        set_tuple_user_name(&rt->key, values, &i);
+        values[i++] = ObjectIdGetDatum(rt->key.user_id);
+        values[i++] = Int64GetDatum(rt->key.unique_sql_id);
+        values[i++] = Int64GetDatum(rt->calls);
+        values[i++] = Int64GetDatum(rt->elapse_time);
+        Assert(i == INSTRUMENTS_UNIQUE_SQL_RT_ATTRNUM);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        if (funcctx->user_fctx) {
+            pfree_ext(funcctx->user_fctx);
+        }
+        SRF_RETURN_DONE(funcctx);
+    }
+}
+
 /*
  * GenerateUniqueSQLInfo - generate unique sql info
  *
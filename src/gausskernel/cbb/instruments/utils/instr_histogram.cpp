@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ * instr_histogram.cpp
+ *        log-linear histograms of response times
+ *
+ * A histogram takes constant memory however many values go into it, adding
+ * to it is one increment, and histograms are merged by adding their buckets,
+ * so percentiles of any set of them can be read at any time without keeping
+ * or sorting samples.
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/cbb/instruments/utils/instr_histogram.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include "instruments/instr_histogram.h"
+#include "storage/proc.h"
+
+#define LATENCY_HIST_SUB_BUCKETS (1 << LATENCY_HIST_SUB_BITS)
+
+/* one histogram per backend thread, thread pool workers included */
+#define SQL_RT_HISTOGRAM_SLOTS                                                                               \
+    (g_instance.attr.attr_common.enable_thread_pool ? GLOBAL_RESERVE_SESSION_NUM : g_instance.shmem_cxt.MaxBackends)
+
+/*
+ * LatencyHistogramBucket - bucket of a value
+ *
+ * Values below 2 * LATENCY_HIST_SUB_BUCKETS are their own bucket, above that
+ * the bucket is given by the position of the leading bit and the
+ * LATENCY_HIST_SUB_BITS bits following it.
+ */
+int LatencyHistogramBucket(int64 value)
+{
+    uint64 v;
+    int msb;
+    int shift;
+
+    if (value <= 0) {
+        return 0;
+    }
+
+    v = (uint64)value;
+    if (v < (uint64)(2 * LATENCY_HIST_SUB_BUCKETS)) {
+        return (int)v;
+    }
+
+    msb = 63 - __builtin_clzll(v);
+    if (msb >= LATENCY_HIST_MAX_BITS) {
+        return LATENCY_HIST_BUCKETS - 1;
+    }
+
+    shift = msb - LATENCY_HIST_SUB_BITS;
+    return ((shift + 1) << LATENCY_HIST_SUB_BITS) + (int)((v >> shift) - LATENCY_HIST_SUB_BUCKETS);
+}
+
+/*
+ * LatencyHistogramBucketValue - the value a bucket stands for, the middle of
+ * the values going to it
+ */
+int64 LatencyHistogramBucketValue(int bucket)
+{
+    int shift;
+    uint64 lower;
+
+    Assert(bucket >= 0 && bucket < LATENCY_HIST_BUCKETS);
+
+    if (bucket < 2 * LATENCY_HIST_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    shift = (bucket >> LATENCY_HIST_SUB_BITS) - 1;
+    lower = (uint64)(LATENCY_HIST_SUB_BUCKETS + (bucket & (LATENCY_HIST_SUB_BUCKETS - 1))) << shift;
+    return (int64)(lower + ((uint64)1 << (shift - 1)));
+}
+
+void LatencyHistogramAdd(LatencyHistogram* hist, int64 value)
+{
+    pg_atomic_fetch_add_u64(&hist->counts[LatencyHistogramBucket(value)], 1);
+}
+
+/*
+ * LatencyHistogramAddLocal - add to a histogram no other backend adds to
+ *
+ * Readers may see the bucket before or after the increment, but never torn,
+ * so no locked instruction is needed.
+ */
+void LatencyHistogramAddLocal(LatencyHistogram* hist, int64 value)
+{
+    pg_atomic_uint64* count = &hist->counts[LatencyHistogramBucket(value)];
+
+    pg_atomic_write_u64(count, pg_atomic_read_u64(count) + 1);
+}
+
+void LatencyHistogramReset(LatencyHistogram* hist)
+{
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        pg_atomic_write_u64(&hist->counts[i], 0);
+    }
+}
+
+/*
+ * LatencyHistogramMerge - add the buckets of a histogram to counts
+ *
+ * Returns the number of values added.
+ */
+uint64 LatencyHistogramMerge(uint64* counts, const LatencyHistogram* hist)
+{
+    uint64 total = 0;
+
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        uint64 count = pg_atomic_read_u64((pg_atomic_uint64*)&hist->counts[i]);
+
+        counts[i] += count;
+        total += count;
+    }
+
+    return total;
+}
+
+/*
+ * LatencyHistogramPercentile - the percentile of the total values in counts
+ *
+ * The value of the bucket holding the value ranked percentile% of the way up,
+ * 0 if there are no values.
+ */
+int64 LatencyHistogramPercentile(const uint64* counts, uint64 total, int percentile)
+{
+    uint64 rank;
+    uint64 seen = 0;
+
+    if (total == 0) {
+        return 0;
+    }
+
+    percentile = Max(Min(percentile, 100), 0);
+    rank = Max((total * (uint64)percentile + 99) / 100, 1);
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return LatencyHistogramBucketValue(i);
+        }
+    }
+
+    return LatencyHistogramBucketValue(LATENCY_HIST_BUCKETS - 1);
+}
+
+/*
+ * InitSqlRTHistograms - one response time histogram per backend id
+ *
+ * Each backend thread only adds to the histogram of its own id, whatever
+ * session it serves, and the percentile thread merges them all.
+ */
+void InitSqlRTHistograms(void)
+{
+    g_instance.stat_cxt.sql_rt_histograms = (LatencyHistogram*)MemoryContextAllocZero(
+        g_instance.instance_context, mul_size(sizeof(LatencyHistogram), SQL_RT_HISTOGRAM_SLOTS));
+}
+
+void pgstat_update_sql_rt_histogram(int64 rt)
+{
+    LatencyHistogram* histograms = g_instance.stat_cxt.sql_rt_histograms;
+    int backendId = t_thrd.proc_cxt.MyBackendId;
+
+    if (histograms == NULL || backendId == InvalidBackendId || backendId > SQL_RT_HISTOGRAM_SLOTS) {
+        return;
+    }
+
+    LatencyHistogramAddLocal(&histograms[backendId - 1], rt);
+}
+
+/*
+ * pgstat_fetch_sql_rt_histogram - merge the histograms of all backends into
+ * counts, returns the number of values
+ */
+uint64 pgstat_fetch_sql_rt_histogram(uint64* counts)
+{
+    LatencyHistogram* histograms = g_instance.stat_cxt.sql_rt_histograms;
+    uint64 total = 0;
+
+    if (histograms == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < SQL_RT_HISTOGRAM_SLOTS; i++) {
+        total += LatencyHistogramMerge(counts, &histograms[i]);
+    }
+
+    return total;
+}
@@ -19,6 +19,7 @@
 
 #include <math.h>
 
+#include "access/cstore_sketch.h"
 #include "access/transam.h"
 #include "access/tupconvert.h"
 #include "access/tuptoaster.h"
@@ -271,6 +272,7 @@ static void do_analyze_compute_attr_stats(bool inh, Relation onerel, VacuumStmt*
     double numTotalRows, int64 numSampleRows, AnalyzeMode analyzemode);
 
 static void set_stats_dndistinct(VacAttrStats* stats, VacuumStmt* vacstmt, int tableidx);
+static void set_stats_sketch_distinct(Relation onerel, VacAttrStats* stats, double totalrows);
 static void update_pages_and_tuples_pgclass(Relation onerel, VacuumStmt* vacstmt, int attr_cnt,
     VacAttrStats** vacattrstats, bool hasindex, int nindexes, AnlIndexData* indexdata, Relation* Irel,
     BlockNumber relpages, double totalrows, double totaldeadrows, int64 numrows, bool inh);
@@ -6538,6 +6540,11 @@ static bool do_analyze_samplerows(Relation onerel, VacuumStmt* vacstmt, int attr
         (*stats->compute_stats)(stats, std_fetch_func, num_samplerows, num_total_rows, onerel);
         DEBUG_STOP_TIMER("Compute statistic for attr: %s", NameStr(stats->attrs[0]->attname));
 
+        if (!inh && !IS_PGXC_COORDINATOR && RelationIsColStore(onerel) && RelationGetCUSketch(onerel) &&
+            !RelationIsPartitioned(onerel) && !RELATION_OWN_BUCKET(onerel)) {
+            set_stats_sketch_distinct(onerel, stats, num_total_rows);
+        }
+
         /*
          * If the appropriate flavor of the n_distinct option is
          * specified, override with the corresponding value.
@@ -7123,6 +7130,43 @@ static bool analyze_index_sample_rows(MemoryContext speccontext, Relation rel, V
     return need_sample;
 }
 
+/*
+ * set_stats_sketch_distinct: raise the distinct count of a column of a column
+ * table created WITH (cu_sketch = on) to the one merged from the HyperLogLogs
+ * of its CUs.  The sample tends to underestimate high cardinality columns,
+ * while the sketches saw every value inserted; rows deleted since are still
+ * counted though, so the sample estimate is kept when it is the larger one.
+ *
+ * Parameters:
+ *	@in onerel: the relation analyzed, not partitioned
+ *	@in stats: statistic info of one attribute for analyze
+ *	@in totalrows: estimated total rows of the relation
+ */
+static void set_stats_sketch_distinct(Relation onerel, VacAttrStats* stats, double totalrows)
+{
+    double sample_distinct = stats->stadistinct;
+    double sketch_distinct = 0;
+    double nonnull_rows = totalrows * (1.0 - stats->stanullfrac);
+
+    if (!stats->stats_valid || nonnull_rows < 1.0 ||
+        !CUSketchEstimateDistinct(onerel, stats->attrs[0]->attnum, GetActiveSnapshot(), &sketch_distinct)) {
+        return;
+    }
+
+    if (sample_distinct < 0)
+        sample_distinct = -sample_distinct * totalrows;
+
+    sketch_distinct = floor(Min(sketch_distinct, nonnull_rows) + 0.5);
+    if (sketch_distinct <= sample_distinct)
+        return;
+
+    /* as in compute_scalar_stats, a count proportional to the rows is stored as their fraction */
+    if (sketch_distinct > 0.1 * totalrows)
+        stats->stadistinct = -(sketch_distinct / totalrows);
+    else
+        stats->stadistinct = sketch_distinct;
+}
+
 /*
  * set_stats_dndistinct: compute dndistinct value and set to statistic.
  *
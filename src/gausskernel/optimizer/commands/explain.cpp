@@ -1738,6 +1738,7 @@ static void ExplainNode(
     StringInfo tmpName;
     bool from_datanode = false;
     bool old_dn_flag = false;
+    const char* agg_split_mode = NULL;
 
     /* For plan_table column */
     char* pt_operation = NULL;
@@ -1775,10 +1776,18 @@ static void ExplainNode(
     /* Fetch plan node's plain text info */
     GetPlanNodePlainText(plan, &pname, &sname, &strategy, &operation, &pt_operation, &pt_options);
 
+    /* An Agg split around a Gather shows which half it is */
+    if (IsA(plan, Agg) && ((Agg*)plan)->is_partial)
+        agg_split_mode = "Partial";
+    else if (IsA(plan, Agg) && ((Agg*)plan)->is_final && plan->lefttree != NULL && IsA(plan->lefttree, Gather))
+        agg_split_mode = "Finalize";
+
     ExplainOpenGroup("Plan", relationship ? NULL : "Plan", true, es);
 
     if (es->format == EXPLAIN_FORMAT_TEXT) {
         if (is_pretty) {
+            if (agg_split_mode != NULL)
+                appendStringInfo(tmpName, "%s ", agg_split_mode);
             appendStringInfoString(tmpName, pname);
         } else {
             if (es->wlm_statistics_plan_max_digit) {
@@ -1797,6 +1806,9 @@ static void ExplainNode(
                 if (plan->parallel_aware) {
                     appendStringInfoString(es->str, "Parallel ");
                 }
+                if (agg_split_mode != NULL) {
+                    appendStringInfo(es->str, "%s ", agg_split_mode);
+                }
                 appendStringInfoString(es->str, pname);
 
                 es->indent++;
@@ -1815,6 +1827,9 @@ static void ExplainNode(
         if (plan->parallel_aware) {
             ExplainPropertyText("Parallel Aware", "true", es);
         }
+        if (agg_split_mode != NULL) {
+            ExplainPropertyText("Partial Mode", agg_split_mode, es);
+        }
     }
 
     switch (nodeTag(plan)) {
@@ -2387,6 +2402,12 @@ static void ExplainNode(
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
+            if (plan->var_list != NIL) {
+                show_bloomfilter<false>(plan, planstate, ancestors, es);
+                show_instrumentation_count("Rows Removed by Bloom Filter", 3, planstate, es);
+                if (IsA(plan, CStoreScan))
+                    show_instrumentation_count("CUs Skipped by Bloom Filter", 4, planstate, es);
+            }
             show_llvm_info(planstate, es);
             break;
         case T_Gather: {
@@ -2531,6 +2552,8 @@ static void ExplainNode(
             show_upper_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 2, planstate, es);
+            if (plan->var_list != NIL)
+                show_bloomfilter<true>(plan, planstate, ancestors, es);
             show_skew_optimization(planstate, es);
         } break;
         case T_VecHashJoin: {
@@ -6944,6 +6967,10 @@ static void show_instrumentation_count(const char* qlabel, int which, const Plan
                         nfiltered += instr->nfiltered1;
                     else if (which == 2)
                         nfiltered += instr->nfiltered2;
+                    else if (which == 3)
+                        nfiltered += instr->bloomFilterRows;
+                    else if (which == 4)
+                        nfiltered += instr->bloomFilterBlocks;
                 }
             }
         }
@@ -6952,6 +6979,10 @@ static void show_instrumentation_count(const char* qlabel, int which, const Plan
             nfiltered = planstate->instrument->nfiltered1;
         else if (which == 2)
             nfiltered = planstate->instrument->nfiltered2;
+        else if (which == 3)
+            nfiltered = planstate->instrument->bloomFilterRows;
+        else if (which == 4)
+            nfiltered = planstate->instrument->bloomFilterBlocks;
     }
 
     if (t_thrd.explain_cxt.explain_perf_mode == EXPLAIN_NORMAL &&
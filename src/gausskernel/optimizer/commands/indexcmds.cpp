@@ -702,12 +702,16 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
-    if (stmt->unique && !accessMethodForm->amcanunique)
+
+    /* MOT implements hash indexes itself, as unique indexes on one or more columns */
+    bool isMOTHashIndex = (accessMethodId == HASH_AM_OID && rel->rd_rel->relkind == RELKIND_FOREIGN_TABLE &&
+                           isMOTFromTblOid(relationId));
+    if (stmt->unique && !accessMethodForm->amcanunique && !isMOTHashIndex)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
-    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol && !isMOTHashIndex)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
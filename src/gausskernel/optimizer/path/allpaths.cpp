@@ -65,6 +65,7 @@ static void set_correlated_rel_pathlist(PlannerInfo* root, RelOptInfo* rel);
 static void set_rel_pathlist(PlannerInfo* root, RelOptInfo* rel, Index rti, RangeTblEntry* rte);
 static void set_plain_rel_size(PlannerInfo* root, RelOptInfo* rel, RangeTblEntry* rte);
 static void create_parallel_paths(PlannerInfo* root, RelOptInfo* rel);
+static void create_parallel_cstore_paths(PlannerInfo* root, RelOptInfo* rel);
 static void set_tablesample_rel_size(PlannerInfo* root, RelOptInfo* rel, RangeTblEntry* rte);
 static void set_plain_rel_pathlist(PlannerInfo* root, RelOptInfo* rel, RangeTblEntry* rte);
 static void set_rel_consider_parallel(PlannerInfo *root, RelOptInfo *rel, RangeTblEntry *rte);
@@ -740,14 +741,39 @@ static void set_plain_rel_size(PlannerInfo* root, RelOptInfo* rel, RangeTblEntry
 }
 
 /*
- * create_parallel_paths
- *	  Build parallel access paths for a plain relation
+ * parallel_degree_for_pages
+ *	  Limit the degree of parallelism logarithmically based on the number of
+ *	  pages to be scanned.  This probably needs to be a good deal more
+ *	  sophisticated, but we need something here for now.
  */
-static void create_parallel_paths(PlannerInfo* root, RelOptInfo* rel)
+static int parallel_degree_for_pages(double pages, int parallel_threshold, int max_parallel_degree)
 {
-    int parallel_threshold = u_sess->attr.attr_sql.min_parallel_table_scan_size;
     int parallel_degree = 1;
+
+    while (pages > parallel_threshold * 3 && parallel_degree < max_parallel_degree) {
+        parallel_degree++;
+        parallel_threshold *= 3;
+        if (parallel_threshold >= PG_INT32_MAX / 3)
+            break;
+    }
+
+    return parallel_degree;
+}
+
+/*
+ * compute_parallel_degree
+ *	  Compute the degree of parallelism for a scan of rel that reads
+ *	  heap_pages heap pages and index_pages index pages.  Pass -1 for either
+ *	  count if that kind of page isn't read.  Returns 0 if the scan is too
+ *	  small to be worth parallelizing.
+ */
+int compute_parallel_degree(RelOptInfo* rel, double heap_pages, double index_pages)
+{
     int max_parallel_degree = u_sess->attr.attr_sql.max_parallel_workers_per_gather;
+    int table_threshold = u_sess->attr.attr_sql.min_parallel_table_scan_size;
+    int index_threshold = u_sess->attr.attr_sql.min_parallel_index_scan_size;
+    int parallel_degree = 0;
+
     /*
      * If this relation is too small to be worth a parallel scan, just return
      * without doing anything ... unless it's an inheritance child.  In that case,
@@ -755,35 +781,75 @@ static void create_parallel_paths(PlannerInfo* root, RelOptInfo* rel)
      * just for this relation, but when combined with all of its inheritance siblings
      * it may well pay off.
      */
-    if (rel->pages < parallel_threshold && rel->reloptkind == RELOPT_BASEREL) {
+    if (rel->reloptkind == RELOPT_BASEREL &&
+        ((heap_pages >= 0 && heap_pages < table_threshold) || (index_pages >= 0 && index_pages < index_threshold))) {
+        return 0;
+    }
+
+    if (heap_pages >= 0) {
+        parallel_degree = parallel_degree_for_pages(heap_pages, table_threshold, max_parallel_degree);
+    }
+
+    /* If both kinds of page are read, the smaller degree wins */
+    if (index_pages >= 0) {
+        int index_parallel_degree = parallel_degree_for_pages(index_pages, index_threshold, max_parallel_degree);
+        parallel_degree =
+            (parallel_degree > 0) ? Min(parallel_degree, index_parallel_degree) : index_parallel_degree;
+    }
+
+    return parallel_degree;
+}
+
+/*
+ * create_partial_bitmap_paths
+ *	  Build a partial bitmap heap path for the given bitmapqual, if the heap
+ *	  pages it will visit are enough to be worth dividing among workers.
+ */
+void create_partial_bitmap_paths(PlannerInfo* root, RelOptInfo* rel, Path* bitmapqual)
+{
+    Cost indexTotalCost;
+    Selectivity indexSelectivity;
+    int parallel_degree;
+
+    cost_bitmap_tree_node(bitmapqual, &indexTotalCost, &indexSelectivity);
+    parallel_degree = compute_parallel_degree(rel, ceil(indexSelectivity * rel->pages), -1);
+    if (parallel_degree <= 0) {
         return;
     }
 
-    /*
-     * Limit the degree of parallelism logarithmically based on the size of the
-     * relation.  This probably needs to be a good deal more sophisticated, but we
-     * need something here for now.
-     */
-    while (rel->pages > parallel_threshold * 3 && parallel_degree < max_parallel_degree) {
-        parallel_degree++;
-        parallel_threshold *= 3;
-        if (parallel_threshold >= PG_INT32_MAX / 3)
-            break;
+    add_partial_path(rel, (Path*)create_bitmap_heap_path(root, rel, bitmapqual, NULL, 1.0, parallel_degree));
+}
+
+/*
+ * create_parallel_paths
+ *	  Build parallel access paths for a plain relation
+ */
+static void create_parallel_paths(PlannerInfo* root, RelOptInfo* rel)
+{
+    int parallel_degree = compute_parallel_degree(rel, rel->pages, -1);
+
+    if (parallel_degree <= 0) {
+        return;
     }
 
     /* Add an unordered partial path based on a parallel sequential scan. */
     add_partial_path(rel, create_seqscan_path(root, rel, NULL, 1, parallel_degree));
+}
 
-    /*
-     * If this is a baserel, consider gathering any partial paths we may have
-     * just created.  If we gathered an inheritance child, we could end up
-     * with a very large number of gather nodes, each trying to grab its own
-     * pool of workers, so don't do this in that case.  Instead, we'll
-     * consider gathering partial paths for the appendrel.
-     */
-    if (rel->reloptkind == RELOPT_BASEREL) {
-        generate_gather_paths(root, rel);
+/*
+ * create_parallel_cstore_paths
+ *	  Build a parallel access path for a column store relation
+ */
+static void create_parallel_cstore_paths(PlannerInfo* root, RelOptInfo* rel)
+{
+    int parallel_degree = compute_parallel_degree(rel, rel->pages, -1);
+
+    if (parallel_degree <= 0) {
+        return;
     }
+
+    /* Add an unordered partial path whose workers claim CUs from a shared cursor. */
+    add_partial_path(rel, create_cstorescan_path(root, rel, 1, parallel_degree));
 }
 
 
@@ -927,6 +993,16 @@ static void set_plain_rel_pathlist(PlannerInfo* root, RelOptInfo* rel, RangeTblE
                         add_path(root, rel, create_cstorescan_path(root, rel));
                         if (can_parallel)
                             add_path(root, rel, create_cstorescan_path(root, rel, u_sess->opt_cxt.query_dop));
+
+                        /*
+                         * Consider parallel column store scan.  Quals pulled up for the
+                         * vector engine would not be applied to a partial path, and ADIO
+                         * prefetches past the CU ranges shared out to the workers.
+                         */
+                        if (rel->consider_parallel && rel->orientation == REL_COL_ORIENTED &&
+                            !has_vecengine_unsupport_expr && !g_instance.attr.attr_storage.enable_adio_function) {
+                            create_parallel_cstore_paths(root, rel);
+                        }
                 }
                 break;
             }
@@ -963,6 +1039,18 @@ static void set_plain_rel_pathlist(PlannerInfo* root, RelOptInfo* rel, RangeTblE
             if (rel->orientation == REL_ROW_ORIENTED)
                 create_tidscan_paths(root, rel);
         }
+
+        /*
+         * If this is a baserel, consider gathering any partial paths we may
+         * have created, from a parallel sequential scan or a parallel index
+         * scan.  If we gathered an inheritance child, we could end up with a
+         * very large number of gather nodes, each trying to grab its own pool
+         * of workers, so don't do this in that case.  Instead, we'll consider
+         * gathering partial paths for the appendrel.
+         */
+        if (rel->reloptkind == RELOPT_BASEREL) {
+            generate_gather_paths(root, rel);
+        }
 #ifdef PGXC
     } else {
         Oid relId = rte->relid;
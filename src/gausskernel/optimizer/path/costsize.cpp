@@ -843,6 +843,14 @@ void cost_cstorescan(Path* path, PlannerInfo* root, RelOptInfo* baserel)
         u_sess->attr.attr_sql.cpu_tuple_cost / COL_TUPLE_COST_MULTIPLIER + baserel->baserestrictcost.per_tuple;
     run_cost += cpu_per_tuple * RELOPTINFO_LOCAL_FIELD(root, baserel, tuples) / dop;
 
+    /* The CUs of a partial path are shared out like the pages of a parallel seqscan. */
+    if (path->parallel_degree > 0) {
+        double parallel_divisor = get_parallel_divisor(path);
+
+        run_cost = run_cost / parallel_divisor;
+        path->rows = clamp_row_est(path->rows / parallel_divisor);
+    }
+
     path->startup_cost = startup_cost;
     path->total_cost = startup_cost + run_cost;
     path->stream_cost = 0;
@@ -1001,6 +1009,8 @@ void cost_gather(GatherPath *path, RelOptInfo *rel, ParamPathInfo *param_info)
  *		except for the fields to be set by this routine
  * 'loop_count' is the number of repetitions of the indexscan to factor into
  *		estimates of caching behavior
+ * 'partial_path' is true if the path is to be scanned in parallel by the
+ *		workers of a Gather; the degree of parallelism is chosen here
  *
  * In addition to rows, startup_cost and total_cost, cost_index() sets the
  * path's indextotalcost and indexselectivity fields.  These values will be
@@ -1011,7 +1021,7 @@ void cost_gather(GatherPath *path, RelOptInfo *rel, ParamPathInfo *param_info)
  * number of returned tuples, but they won't reduce the number of tuples
  * we have to fetch from the table, so they don't reduce the scan cost.
  */
-void cost_index(IndexPath* path, PlannerInfo* root, double loop_count)
+void cost_index(IndexPath* path, PlannerInfo* root, double loop_count, bool partial_path)
 {
     IndexOptInfo* index = path->indexinfo;
     RelOptInfo* baserel = index->rel;
@@ -1027,8 +1037,11 @@ void cost_index(IndexPath* path, PlannerInfo* root, double loop_count)
     Cost min_IO_cost, max_IO_cost;
     QualCost qpqual_cost;
     Cost cpu_per_tuple = 0.0;
+    Cost cpu_run_cost = 0.0;
     double tuples_fetched;
     double pages_fetched;
+    double rand_heap_pages;
+    double index_pages;
     bool ispartitionedindex = path->indexinfo->rel->isPartitionedTable;
 
     /* Should only be applied to base relations */
@@ -1153,6 +1166,7 @@ void cost_index(IndexPath* path, PlannerInfo* root, double loop_count)
             pages_fetched = ceil(pages_fetched * (1.0 - baserel->allvisfrac));
 
         min_IO_cost = (pages_fetched * spc_random_page_cost) / loop_count;
+        rand_heap_pages = -1;
     } else {
         /*
          * Normal case: apply the Mackert and Lohman formula, and then
@@ -1164,6 +1178,8 @@ void cost_index(IndexPath* path, PlannerInfo* root, double loop_count)
         if (indexonly)
             pages_fetched = ceil(pages_fetched * (1.0 - baserel->allvisfrac));
 
+        rand_heap_pages = pages_fetched;
+
         /* max_IO_cost is for the perfectly uncorrelated case (csquared=0) */
         max_IO_cost = pages_fetched * spc_random_page_cost;
 
@@ -1217,7 +1233,36 @@ void cost_index(IndexPath* path, PlannerInfo* root, double loop_count)
     else
         cpu_per_tuple = u_sess->attr.attr_sql.cpu_tuple_cost + qpqual_cost.per_tuple;
 
-    run_cost += cpu_per_tuple * tuples_fetched;
+    cpu_run_cost += cpu_per_tuple * tuples_fetched;
+
+    /*
+     * For a partial path, the heap and index pages are divided among the
+     * participants, so use them to choose the degree of parallelism.  The
+     * index-only case reads no heap pages worth counting.  A path too small
+     * to be worth parallelizing is marked with parallel_degree 0 and left to
+     * the caller to discard.
+     */
+    if (partial_path) {
+        if (loop_count > 1 || indexonly)
+            rand_heap_pages = -1;
+        index_pages = ceil(indexSelectivity * (double)index->pages);
+        path->path.parallel_degree = compute_parallel_degree(baserel, rand_heap_pages, index_pages);
+        if (path->path.parallel_degree <= 0) {
+            path->path.parallel_degree = 0;
+            return;
+        }
+        path->path.parallel_aware = true;
+
+        /*
+         * Only the CPU cost is divided; the disk cost is left alone because
+         * the pages are read randomly and the leader waits for all of them.
+         */
+        double parallel_divisor = get_parallel_divisor(&path->path);
+        path->path.rows = clamp_row_est(path->path.rows / parallel_divisor);
+        cpu_run_cost /= parallel_divisor;
+    }
+
+    run_cost += cpu_run_cost;
 
     path->path.startup_cost = startup_cost;
     path->path.total_cost = startup_cost + run_cost;
@@ -1514,6 +1559,18 @@ void cost_bitmap_heap_scan(
     startup_cost += qpqual_cost.startup;
     cpu_per_tuple = u_sess->attr.attr_sql.cpu_tuple_cost + qpqual_cost.per_tuple;
 
+    /*
+     * In a parallel bitmap heap scan one participant builds the bitmap and
+     * then the heap pages and their tuples are divided among everyone.
+     */
+    if (path->parallel_degree > 0) {
+        double parallel_divisor = get_parallel_divisor(path);
+
+        run_cost = run_cost / parallel_divisor;
+        tuples_fetched = tuples_fetched / parallel_divisor;
+        path->rows = clamp_row_est(path->rows / parallel_divisor);
+    }
+
     run_cost += cpu_per_tuple * tuples_fetched;
 
     path->startup_cost = startup_cost;
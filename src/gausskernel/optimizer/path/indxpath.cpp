@@ -281,6 +281,11 @@ void create_index_paths(PlannerInfo* root, RelOptInfo* rel)
         bitmapqual = choose_bitmap_and(root, rel, bitindexpaths);
         bpath = create_bitmap_heap_path(root, rel, bitmapqual, NULL, 1.0);
         add_path(root, rel, (Path*)bpath);
+
+        /* Consider a parallel bitmap heap scan as well */
+        if (rel->consider_parallel && rel->orientation == REL_ROW_ORIENTED && bitmapqual->parallel_safe) {
+            create_partial_bitmap_paths(root, rel, bitmapqual);
+        }
     }
 
     /*
@@ -742,6 +747,7 @@ static List* build_index_paths(PlannerInfo* root, RelOptInfo* rel, IndexOptInfo*
     List* useful_pathkeys = NIL;
     bool found_clause = false;
     bool found_lower_saop_clause = false;
+    bool found_saop_clause = false;
     bool pathkeys_possibly_useful = false;
     bool index_is_ordered = false;
     bool index_only_scan = false;
@@ -806,6 +812,7 @@ static List* build_index_paths(PlannerInfo* root, RelOptInfo* rel, IndexOptInfo*
                 if (saop_control == SAOP_PER_AM && !index->amsearcharray)
                     continue;
                 found_clause = true;
+                found_saop_clause = true;
                 if (indexcol > 0)
                     found_lower_saop_clause = true;
             } else {
@@ -898,6 +905,37 @@ static List* build_index_paths(PlannerInfo* root, RelOptInfo* rel, IndexOptInfo*
             outer_relids,
             loop_count);
         result = lappend(result, ipath);
+
+        /*
+         * If appropriate, consider a parallel index scan.  Only forward btree
+         * scans without array keys can be divided among workers, and a
+         * parameterized scan is rescanned by each worker on its own anyway.
+         * Gather doesn't preserve the order of its input, so the partial path
+         * is unordered.
+         */
+        if (rel->consider_parallel && outer_relids == NULL && scantype != ST_BITMAPSCAN &&
+            index->relam == BTREE_AM_OID && index->amhasgettuple && !found_saop_clause &&
+            !relHasbkt && !index->isGlobal && !rel->isPartitionedTable) {
+            ipath = create_index_path(root,
+                index,
+                index_clauses,
+                clause_columns,
+                NIL,
+                NIL,
+                NIL,
+                ForwardScanDirection,
+                index_only_scan,
+                outer_relids,
+                loop_count,
+                true);
+
+            /* If the planner found the scan too small to divide, forget it */
+            if (ipath->path.parallel_degree > 0) {
+                add_partial_path(rel, (Path*)ipath);
+            } else {
+                pfree_ext(ipath);
+            }
+        }
     }
 
     /*
@@ -870,11 +870,15 @@ static void try_hashjoin_path(PlannerInfo* root, RelOptInfo* joinrel, JoinType j
  * try_partial_hashjoin_path
  *	  Consider a partial hashjoin join path; if it appears useful, push it into
  *	  the joinrel's partial_pathlist via add_partial_path().
+ *
+ * If parallel_hash is true, inner_path is partial as well and the participants
+ * build one shared hash table from it instead of a private copy each.
  */
 static void try_partial_hashjoin_path(PlannerInfo* root, RelOptInfo* joinrel, Path* outer_path, Path* inner_path,
-    List* hashclauses, JoinType jointype, JoinPathExtraData* extra)
+    List* hashclauses, JoinType jointype, JoinPathExtraData* extra, bool parallel_hash)
 {
     JoinCostWorkspace workspace;
+    HashPath* hash_path = NULL;
 
     /*
      * If the inner path is parameterized, the parameterization must be fully
@@ -901,18 +905,19 @@ static void try_partial_hashjoin_path(PlannerInfo* root, RelOptInfo* joinrel, Pa
     }
 
     /* Might be good enough to be worth trying, so let's try it. */
-    add_partial_path(joinrel,
-        (Path*)create_hashjoin_path(root,
-            joinrel,
-            jointype,
-            &workspace,
-            extra->sjinfo,
-            &extra->semifactors,
-            outer_path,
-            inner_path,
-            extra->restrictlist,
-            NULL,
-            hashclauses));
+    hash_path = create_hashjoin_path(root,
+        joinrel,
+        jointype,
+        &workspace,
+        extra->sjinfo,
+        &extra->semifactors,
+        outer_path,
+        inner_path,
+        extra->restrictlist,
+        NULL,
+        hashclauses);
+    hash_path->jpath.path.parallel_aware = parallel_hash;
+    add_partial_path(joinrel, (Path*)hash_path);
 }
 
 /*
@@ -1834,8 +1839,36 @@ static void hash_inner_and_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptI
                     }
 
                     if (cheapest_safe_inner != NULL) {
-                        try_partial_hashjoin_path(
-                            root, joinrel, cheapest_partial_outer, cheapest_safe_inner, hashclauses, jointype, extra);
+                        try_partial_hashjoin_path(root,
+                            joinrel,
+                            cheapest_partial_outer,
+                            cheapest_safe_inner,
+                            hashclauses,
+                            jointype,
+                            extra,
+                            false);
+                    }
+
+                    /*
+                     * If the inner side can be scanned in parallel too, consider a
+                     * parallel-aware hash join whose participants share a single
+                     * hash table.  The executor doesn't track inner-tuple matches
+                     * in a shared table, so only join types that never emit
+                     * unmatched inner tuples are allowed.
+                     */
+                    if (u_sess->attr.attr_sql.enable_parallel_hash && innerrel->partial_pathlist != NIL &&
+                        (jointype == JOIN_INNER || jointype == JOIN_LEFT || jointype == JOIN_SEMI ||
+                            jointype == JOIN_ANTI)) {
+                        Path* cheapest_partial_inner = (Path*)linitial(innerrel->partial_pathlist);
+
+                        try_partial_hashjoin_path(root,
+                            joinrel,
+                            cheapest_partial_outer,
+                            cheapest_partial_inner,
+                            hashclauses,
+                            jointype,
+                            extra,
+                            true);
                     }
                 }
             }
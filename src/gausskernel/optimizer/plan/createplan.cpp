@@ -131,7 +131,6 @@ static Plan* setPartitionParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel);
 static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel);
 Plan* create_globalpartInterator_plan(PlannerInfo* root, PartIteratorPath* pIterpath);
 
-static Gather *make_gather(List *qptlist, List *qpqual, int nworkers, bool single_copy, Plan *subplan);
 static IndexScan* make_indexscan(List* qptlist, List* qpqual, Index scanrelid, Oid indexid, List* indexqual,
     List* indexqualorig, List* indexorderby, List* indexorderbyorig, ScanDirection indexscandir);
 static IndexOnlyScan* make_indexonlyscan(List* qptlist, List* qpqual, Index scanrelid, Oid indexid, List* indexqual,
@@ -4332,6 +4331,30 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
 
             break;
         }
+        case T_SeqScan:
+        case T_CStoreScan: {
+            /*
+             * Heap and column store scans only test integer columns against
+             * the filter, see ExecRuntimeFilterMayMatch.
+             */
+            Var* var = (Var*)expr;
+            if (!u_sess->attr.attr_sql.enable_runtime_bloom_filter ||
+                (var->vartype != INT2OID && var->vartype != INT4OID && var->vartype != INT8OID)) {
+                return;
+            }
+
+            if (find_var_from_targetlist(expr, plan->targetlist)) {
+                if (context->add_index) {
+                    context->bloomfilter_index++;
+                    context->add_index = false;
+                }
+
+                plan->var_list = lappend(plan->var_list, copyObject(expr));
+                plan->filterIndexList = lappend_int(plan->filterIndexList, context->bloomfilter_index);
+            }
+
+            break;
+        }
         case T_NestLoop:
         case T_MergeJoin:
         case T_HashJoin: {
@@ -4692,9 +4715,17 @@ static HashJoin* create_hashjoin_plan(PlannerInfo* root, HashPath* best_path, Pl
     join_plan->join.plan.dop = best_path->jpath.path.dop;
     hash_plan->plan.dop = best_path->jpath.path.dop;
 
+    /* A parallel-aware join fills a hash table shared by all participants */
+    hash_plan->plan.parallel_aware = best_path->jpath.path.parallel_aware;
+
     join_plan->isSonicHash = u_sess->attr.attr_sql.enable_sonic_hashjoin && isSonicHashJoinEnable(join_plan);
 
-    if (IS_STREAM_PLAN && u_sess->attr.attr_sql.enable_bloom_filter) {
+    /*
+     * A null-equal join matches null keys, which a bloom filter never
+     * includes, so such a join publishes no filter.
+     */
+    if ((IS_STREAM_PLAN || u_sess->attr.attr_sql.enable_runtime_bloom_filter) &&
+        u_sess->attr.attr_sql.enable_bloom_filter && join_plan->join.nulleqqual == NIL) {
         left_relids = best_path->jpath.outerjoinpath->parent->relids;
         set_bloomfilter(root, left_relids, join_plan);
     }
@@ -7568,7 +7599,7 @@ Unique* make_unique(Plan* lefttree, List* distinctList)
     return node;
 }
 
-static Gather *make_gather(List *qptlist, List *qpqual, int nworkers, bool single_copy, Plan *subplan)
+Gather* make_gather(List* qptlist, List* qpqual, int nworkers, bool single_copy, Plan* subplan)
 {
     Gather *node = makeNode(Gather);
     Plan *plan = &node->plan;
@@ -209,6 +209,8 @@ static Plan* generate_hashagg_plan(PlannerInfo* root, Plan* plan, List* final_li
 static Plan* get_count_distinct_partial_plan(PlannerInfo* root, Plan* result_plan, List** final_tlist,
     Node* distinct_node, AggClauseCosts agg_costs, const double* numGroups, WindowLists* wflists,
     AttrNumber* groupColIdx, bool* needs_stream, Size hash_entry_size, RelOptInfo* rel_info);
+static Plan* generate_parallel_agg_plan(
+    PlannerInfo* root, Plan* plan, const AggClauseCosts* agg_costs, Size hash_entry_size);
 static Node* get_multiple_from_expr(
     PlannerInfo* root, Node* expr, double rows, double* skew_multiple, double* bias_multiple);
 static void free_est_varlist(List* varlist);
@@ -3058,6 +3060,7 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
                             NIL,
                             false,
                             hash_entry_size);
+                        result_plan = generate_parallel_agg_plan(root, result_plan, &agg_costs, hash_entry_size);
 
                         next_is_second_level_group = true;
                     }
@@ -3326,6 +3329,7 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
                         NIL,
                         0,
                         true);
+                    result_plan = generate_parallel_agg_plan(root, result_plan, &agg_costs, 0);
                 }
                 next_is_second_level_group = true;
 
@@ -8468,6 +8472,7 @@ static Plan* fallback_plan(Plan* result_plan)
         case T_Agg:
         case T_RowToVec:
         case T_VecRemoteQuery:
+        case T_Gather:
             result_plan->lefttree = fallback_plan(result_plan->lefttree);
             break;
 
@@ -8570,6 +8575,13 @@ Plan* vectorize_plan(Plan* result_plan, bool ignore_remotequery)
         case T_ValuesScan: {
             result_plan = (Plan*)make_rowtovec(result_plan);
         } break;
+        /*
+         * Vector nodes are not parallel aware, so the workers below a Gather run
+         * a row plan, each turning the batches of its column store scan into rows.
+         */
+        case T_Gather:
+            result_plan->lefttree = fallback_plan(result_plan->lefttree);
+            break;
         /*
          * For those node that support vectorize, build vector node if child is
          * vector or enable_force_vector_engine.
@@ -10668,6 +10680,186 @@ static Plan* get_count_distinct_partial_plan(PlannerInfo* root, Plan* result_pla
     return result_plan;
 }
 
+/*
+ * parallel_agg_is_splittable: check whether every aggregate of an Agg can be
+ * computed as a partial agg in the parallel workers and combined above the
+ * Gather by the aggregate's collection function.
+ */
+static bool parallel_agg_is_splittable(List* aggrefs)
+{
+    ListCell* lc = NULL;
+
+    if (has_parallel_hazard((Node*)aggrefs, false))
+        return false;
+
+    foreach (lc, aggrefs) {
+        Aggref* aggref = (Aggref*)lfirst(lc);
+
+        if (!IsA(aggref, Aggref))
+            continue;
+        if (!aggref->agghas_collectfn || aggref->aggdistinct != NIL || aggref->aggorder != NIL ||
+            aggref->aggdirectargs != NIL || aggref->aggkind != AGGKIND_NORMAL || aggref->agglevelsup != 0)
+            return false;
+        /* transition values cross the Gather as tuples, so they need a real type */
+        if (aggref->aggtrantype == INTERNALOID || IsPolymorphicType(aggref->aggtrantype))
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * generate_parallel_agg_plan: split an Agg over a Gather into two steps
+ *
+ * The partial agg runs in each worker below the Gather and emits the grouping
+ * columns and the transition values of its aggregates; the finalize agg above
+ * the Gather merges them with the collection functions and applies the final
+ * functions, so only one row per group and worker crosses the Gather:
+ *
+ *     Finalize Aggregate
+ *       ->  Gather
+ *             ->  Partial Aggregate
+ *                   ->  Parallel Seq Scan
+ *
+ * The finalize Aggrefs are one aggstage above the partial ones, which is how
+ * setrefs tells them apart.  The original plan is returned if the aggregates
+ * can't be split or the split plan is not cheaper.
+ */
+static Plan* generate_parallel_agg_plan(
+    PlannerInfo* root, Plan* plan, const AggClauseCosts* agg_costs, Size hash_entry_size)
+{
+    Agg* agg = (Agg*)plan;
+    Gather* gather = NULL;
+    Plan* subplan = NULL;
+    Agg* partial_agg = NULL;
+    Gather* new_gather = NULL;
+    Agg* final_agg = NULL;
+    List* final_tlist = NIL;
+    List* final_qual = NIL;
+    List* partial_tlist = NIL;
+    List* aggrefs = NIL;
+    List* exprs = NIL;
+    AttrNumber* final_grpColIdx = NULL;
+    ListCell* lc = NULL;
+    int i;
+
+    if (!IsA(plan, Agg) || plan->lefttree == NULL || !IsA(plan->lefttree, Gather))
+        return plan;
+    if (IS_STREAM_PLAN || root->glob->vectorized || root->parse->groupingSets != NIL)
+        return plan;
+    if (agg->aggstrategy == AGG_SORTED || agg_costs->numOrderedAggs > 0 || agg_costs->exprAggs != NIL)
+        return plan;
+
+    gather = (Gather*)plan->lefttree;
+    if (gather->single_copy || gather->plan.qual != NIL)
+        return plan;
+
+    final_tlist = (List*)copyObject(plan->targetlist);
+    final_qual = (List*)copyObject(plan->qual);
+    exprs = pull_var_clause((Node*)list_concat(list_copy(final_tlist), list_copy(final_qual)),
+        PVC_INCLUDE_AGGREGATES,
+        PVC_RECURSE_PLACEHOLDERS);
+
+    foreach (lc, exprs) {
+        if (IsA(lfirst(lc), Aggref))
+            aggrefs = lappend(aggrefs, lfirst(lc));
+    }
+    if (aggrefs == NIL || !parallel_agg_is_splittable(aggrefs))
+        return plan;
+
+    /* Grouping columns go first, so the finalize agg groups on 1..numCols */
+    if (agg->numCols > 0)
+        final_grpColIdx = (AttrNumber*)palloc(sizeof(AttrNumber) * agg->numCols);
+    for (i = 0; i < agg->numCols; i++) {
+        TargetEntry* tle = get_tle_by_resno(gather->plan.targetlist, agg->grpColIdx[i]);
+        TargetEntry* newtle = flatCopyTargetEntry(tle);
+
+        newtle->resno = list_length(partial_tlist) + 1;
+        newtle->resjunk = false;
+        partial_tlist = lappend(partial_tlist, newtle);
+        final_grpColIdx[i] = newtle->resno;
+    }
+
+    /* Then plain Vars the finalize agg still needs, and the transition values */
+    foreach (lc, exprs) {
+        Node* node = (Node*)lfirst(lc);
+
+        if (IsA(node, Aggref)) {
+            Aggref* aggref = (Aggref*)node;
+            Aggref* partial_aggref = (Aggref*)copyObject(aggref);
+
+            partial_aggref->aggtype = aggref->aggtrantype;
+            aggref->aggstage = partial_aggref->aggstage + 1;
+            if (tlist_member((Node*)partial_aggref, partial_tlist) == NULL)
+                partial_tlist = lappend(partial_tlist,
+                    makeTargetEntry((Expr*)partial_aggref, list_length(partial_tlist) + 1, NULL, false));
+        } else if (tlist_member(node, partial_tlist) == NULL) {
+            partial_tlist = lappend(partial_tlist,
+                makeTargetEntry((Expr*)copyObject(node), list_length(partial_tlist) + 1, NULL, false));
+        }
+    }
+    list_free_ext(exprs);
+
+    /* The partial agg reads the Gather's input with the Gather's projection */
+    subplan = gather->plan.lefttree;
+    if (!equal(subplan->targetlist, gather->plan.targetlist) && !is_projection_capable_plan(subplan))
+        subplan = (Plan*)make_result(root, (List*)copyObject(gather->plan.targetlist), NULL, subplan);
+
+    partial_agg = make_agg(root,
+        partial_tlist,
+        NIL,
+        agg->aggstrategy,
+        agg_costs,
+        agg->numCols,
+        agg->grpColIdx,
+        agg->grpOperators,
+        agg->numGroups,
+        subplan,
+        NULL,
+        false,
+        false,
+        NIL,
+        hash_entry_size,
+        true);
+    partial_agg->is_partial = true;
+
+    new_gather = make_gather((List*)copyObject(partial_tlist), NIL, gather->num_workers, false, (Plan*)partial_agg);
+#ifdef STREAMPLAN
+    inherit_plan_locator_info((Plan*)new_gather, (Plan*)gather);
+#endif
+    copy_plan_costsize((Plan*)new_gather, (Plan*)partial_agg);
+    set_plan_rows((Plan*)new_gather, PLAN_LOCAL_ROWS((Plan*)partial_agg) * (gather->num_workers + 1));
+    new_gather->plan.startup_cost += u_sess->attr.attr_sql.parallel_setup_cost;
+    new_gather->plan.total_cost += u_sess->attr.attr_sql.parallel_setup_cost +
+                                   u_sess->attr.attr_sql.parallel_tuple_cost * PLAN_LOCAL_ROWS(&new_gather->plan);
+
+    final_agg = make_agg(root,
+        final_tlist,
+        final_qual,
+        agg->aggstrategy,
+        agg_costs,
+        agg->numCols,
+        final_grpColIdx,
+        agg->grpOperators,
+        agg->numGroups,
+        (Plan*)new_gather,
+        NULL,
+        false,
+        true,
+        NIL,
+        hash_entry_size,
+        true);
+    final_agg->is_final = true;
+
+    if (final_agg->plan.total_cost >= plan->total_cost)
+        return plan;
+
+    if (subplan == gather->plan.lefttree && !equal(subplan->targetlist, gather->plan.targetlist))
+        subplan->targetlist = (List*)copyObject(gather->plan.targetlist);
+
+    return (Plan*)final_agg;
+}
+
 double get_bias_from_varlist(PlannerInfo* root, List* varlist, double rows, bool isCoalesceExpr)
 {
     double bias = 1.0;
@@ -313,6 +313,7 @@ static Plan* set_plan_refs(PlannerInfo* root, Plan* plan, int rtoffset)
             if (splan->plan.distributed_keys != NIL) {
                 splan->plan.distributed_keys = fix_scan_list(root, splan->plan.distributed_keys, rtoffset);
             }
+            splan->plan.var_list = fix_scan_list(root, splan->plan.var_list, rtoffset);
             if (splan->tablesample) {
                 splan->tablesample = (TableSampleClause*)fix_scan_expr(root, (Node*)splan->tablesample, rtoffset);
             }
@@ -1825,6 +1826,10 @@ static Var* search_indexed_tlist_for_non_var(Node* node, indexed_tlist* itlist,
 #endif
         tle = tlist_member(node, itlist->tlist);
 
+    /* An aggregate split around a Gather differs from its other half in aggstage */
+    if (tle == NULL && IsA(node, Aggref))
+        tle = tlist_member_split_aggref((Aggref*)node, itlist->tlist, &nested_agg);
+
     if (tle != NULL) {
         /* Found a matching subplan output expression */
         Var* newvar = NULL;
@@ -1694,15 +1694,21 @@ Path* build_seqScanPath_by_indexScanPath(PlannerInfo* root, Path* index_path)
 /*
  * create_cstorescan_path with dop parm for parallelism
  * Creates a path corresponding to a column store scan, returning the
- * pathnode.
+ * pathnode.  A positive parallel_degree makes it a partial path whose CUs are
+ * shared out among the workers of a Gather.
  */
-Path* create_cstorescan_path(PlannerInfo* root, RelOptInfo* rel, int dop)
+Path* create_cstorescan_path(PlannerInfo* root, RelOptInfo* rel, int dop, int parallel_degree)
 {
     Path* pathnode = makeNode(Path);
 
     pathnode->parent = rel;
     pathnode->pathkeys = NIL; /* seqscan has unordered result */
     pathnode->dop = dop;
+    pathnode->parallel_aware = parallel_degree > 0 ? true : false;
+    pathnode->parallel_safe = rel->consider_parallel;
+    pathnode->parallel_degree = parallel_degree;
+    /* We need to set locator_type for parallel query, cause we may send this value to bg worker */
+    pathnode->locator_type = rel->locator_type;
 
 #ifdef STREAMPLAN
     if (IS_STREAM_PLAN) {
@@ -1969,12 +1975,14 @@ bool is_pwj_path(Path* pwjpath)
  * 'required_outer' is the set of outer relids for a parameterized path.
  * 'loop_count' is the number of repetitions of the indexscan to factor into
  *		estimates of caching behavior.
+ * 'partial_path' is true if a parallel index scan path is wanted; cost_index
+ *		leaves parallel_degree 0 if it isn't worth it.
  *
  * Returns the new path node.
  */
 IndexPath* create_index_path(PlannerInfo* root, IndexOptInfo* index, List* indexclauses, List* indexclausecols,
     List* indexorderbys, List* indexorderbycols, List* pathkeys, ScanDirection indexscandir, bool indexonly,
-    Relids required_outer, double loop_count)
+    Relids required_outer, double loop_count, bool partial_path)
 {
     IndexPath* pathnode = makeNode(IndexPath);
     RelOptInfo* rel = index->rel;
@@ -1985,6 +1993,7 @@ IndexPath* create_index_path(PlannerInfo* root, IndexOptInfo* index, List* index
     pathnode->path.parent = rel;
     pathnode->path.param_info = get_baserel_parampathinfo(root, rel, required_outer);
     pathnode->path.pathkeys = pathkeys;
+    pathnode->path.parallel_safe = rel->consider_parallel;
 
     /* Convert clauses to indexquals the executor can handle */
     expand_indexqual_conditions(index, indexclauses, indexclausecols, &indexquals, &indexqualcols);
@@ -2009,7 +2018,7 @@ IndexPath* create_index_path(PlannerInfo* root, IndexOptInfo* index, List* index
     }
 #endif
 
-    cost_index(pathnode, root, loop_count);
+    cost_index(pathnode, root, loop_count, partial_path);
 
     return pathnode;
 }
@@ -2023,11 +2032,14 @@ IndexPath* create_index_path(PlannerInfo* root, IndexOptInfo* index, List* index
  * 'loop_count' is the number of repetitions of the indexscan to factor into
  *		estimates of caching behavior.
  *
+ * 'parallel_degree' is the number of workers sharing the scan if this is a
+ *		partial path, else 0.
+ *
  * loop_count should match the value used when creating the component
  * IndexPaths.
  */
-BitmapHeapPath* create_bitmap_heap_path(
-    PlannerInfo* root, RelOptInfo* rel, Path* bitmapqual, Relids required_outer, double loop_count)
+BitmapHeapPath* create_bitmap_heap_path(PlannerInfo* root, RelOptInfo* rel, Path* bitmapqual,
+    Relids required_outer, double loop_count, int parallel_degree)
 {
     BitmapHeapPath* pathnode = makeNode(BitmapHeapPath);
 
@@ -2035,6 +2047,9 @@ BitmapHeapPath* create_bitmap_heap_path(
     pathnode->path.parent = rel;
     pathnode->path.param_info = get_baserel_parampathinfo(root, rel, required_outer);
     pathnode->path.pathkeys = NIL; /* always unordered */
+    pathnode->path.parallel_aware = parallel_degree > 0 ? true : false;
+    pathnode->path.parallel_safe = rel->consider_parallel && bitmapqual->parallel_safe;
+    pathnode->path.parallel_degree = parallel_degree;
 
     pathnode->bitmapqual = bitmapqual;
 
@@ -2067,6 +2082,7 @@ BitmapAndPath* create_bitmap_and_path(PlannerInfo* root, RelOptInfo* rel, List*
     pathnode->path.parent = rel;
     pathnode->path.param_info = NULL; /* not used in bitmap trees */
     pathnode->path.pathkeys = NIL;    /* always unordered */
+    pathnode->path.parallel_safe = rel->consider_parallel;
 
     pathnode->bitmapquals = bitmapquals;
 
@@ -2100,6 +2116,7 @@ BitmapOrPath* create_bitmap_or_path(PlannerInfo* root, RelOptInfo* rel, List* bi
     pathnode->path.parent = rel;
     pathnode->path.param_info = NULL; /* not used in bitmap trees */
     pathnode->path.pathkeys = NIL;    /* always unordered */
+    pathnode->path.parallel_safe = rel->consider_parallel;
 
     pathnode->bitmapquals = bitmapquals;
 
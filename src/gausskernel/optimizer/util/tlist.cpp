@@ -70,6 +70,51 @@ TargetEntry* tlist_member_ignore_relabel(Node* node, List* targetlist)
     return NULL;
 }
 
+/*
+ * tlist_member_split_aggref
+ *	  Find the targetlist entry matching an Aggref of an aggregate that was
+ *	  split into a partial and a finalize step around a Gather.
+ *
+ *	  The finalize Aggref is one aggstage above the partial one, whose aggtype
+ *	  is the transition type; *nested_agg is set in that case.  Nodes above the
+ *	  finalize agg still carry the original Aggref, one aggstage below it.
+ */
+TargetEntry* tlist_member_split_aggref(Aggref* aggref, List* targetlist, bool* nested_agg)
+{
+    ListCell* temp = NULL;
+
+    foreach (temp, targetlist) {
+        TargetEntry* tlentry = (TargetEntry*)lfirst(temp);
+        Aggref* tlaggref = (Aggref*)tlentry->expr;
+        int saved_stage;
+        Oid saved_type;
+        bool matched = false;
+        bool nested = false;
+
+        if (!IsA(tlaggref, Aggref))
+            continue;
+
+        if (aggref->aggstage == tlaggref->aggstage + 1 && tlaggref->aggtype == aggref->aggtrantype)
+            nested = true;
+        else if (aggref->aggstage + 1 != tlaggref->aggstage || tlaggref->aggtype != aggref->aggtype)
+            continue;
+
+        saved_stage = tlaggref->aggstage;
+        saved_type = tlaggref->aggtype;
+        tlaggref->aggstage = aggref->aggstage;
+        tlaggref->aggtype = aggref->aggtype;
+        matched = equal(aggref, tlaggref);
+        tlaggref->aggstage = saved_stage;
+        tlaggref->aggtype = saved_type;
+
+        if (matched) {
+            *nested_agg = nested;
+            return tlentry;
+        }
+    }
+    return NULL;
+}
+
 #ifdef STREAMPLAN
 static bool equal_node_except_aggref(const void* a, const void* b, bool* judge_nest)
 {
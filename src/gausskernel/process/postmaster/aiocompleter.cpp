@@ -48,6 +48,7 @@
 #include "storage/fd.h"
 #include "storage/ipc.h"
 #include "storage/pmsignal.h"
+#include "storage/uring.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
 #include <pthread.h>
@@ -87,9 +88,6 @@ const int AioCompltrThreads = 4;
 int AioCompltrSets = 1;
 const int AioCompltrShutdownTimeout = 1;
 
-/* Completer callback to handle the AIO event */
-typedef int (*AioCallback_t)(void*, long);
-
 /*
  * Completer Thread definitions
  */
@@ -179,6 +177,12 @@ AioCompltrThread_t compltrArray[MAX_AIOCOMPLTR_THREADS];
  */
 static bool volatile AioCompltrReady = false;
 
+/*
+ * AioCompltrInline is set by the postmaster in AioResourceInitialize() when
+ * io_uring is enabled and the kernel lets us set up a ring.
+ */
+static bool volatile AioCompltrInline = false;
+
 /* Associate a template with a thread index */
 #define AIOCOMPLTR_TEMPLATE(threadIdx) (&compltrDescArray[(threadIdx) % NUM_AIOCOMPLTR_TYPES])
 
@@ -195,7 +199,21 @@ static bool volatile AioCompltrReady = false;
  */
 bool AioCompltrIsReady(void)
 {
-    return AioCompltrReady;
+    return AioCompltrReady || AioCompltrIsInline();
+}
+
+/*
+ * @Description: Check whether AIO requests are completed by the submitting
+ *  thread itself instead of the completer threads.  This is the case when
+ *  io_uring is enabled and could be set up at startup: the dispatch list is
+ *  submitted and reaped in place and the completer callbacks run right after,
+ *  see FileAsyncSubmitInline().
+ * @Return: true if no completer thread is needed
+ * @See also:
+ */
+bool AioCompltrIsInline(void)
+{
+    return AioCompltrInline;
 }
 
 /*
@@ -651,4 +669,11 @@ void AioResourceInitialize(void)
         ALLOCSET_DEFAULT_INITSIZE,
         ALLOCSET_DEFAULT_MAXSIZE,
         SHARED_CONTEXT);
+
+    if (g_instance.attr.attr_storage.enable_io_uring) {
+        AioCompltrInline = UringProbe();
+        if (!AioCompltrInline) {
+            ereport(LOG, (errmsg("io_uring is not available, AIO requests go to the completer threads")));
+        }
+    }
 }
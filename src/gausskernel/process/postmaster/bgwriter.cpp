@@ -40,6 +40,9 @@
 #include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
 
 #include "access/xlog_internal.h"
 #include "access/double_write.h"
@@ -48,6 +51,7 @@
 #include "pgstat.h"
 #include "postmaster/bgwriter.h"
 #include "storage/bufmgr.h"
+#include "storage/buf_internals.h"
 #include "storage/ipc.h"
 #include "storage/lwlock.h"
 #include "storage/proc.h"
@@ -55,6 +59,7 @@
 #include "storage/smgr.h"
 #include "storage/spin.h"
 #include "storage/standby.h"
+#include "storage/uring.h"
 #include "utils/guc.h"
 #include "utils/builtins.h"
 #include "utils/memutils.h"
@@ -311,6 +316,9 @@ void BackgroundWriterMain(void)
          */
         can_hibernate = BgBufferSync(&wb_context);
 
+        /* The page writes it left in our io_uring must not wait for us to wake up */
+        UringWaitBatches();
+
         /*
          * Send off activity statistics to the stats collector
          */
@@ -633,6 +641,50 @@ void incre_ckpt_bgwriter_flush_page_batch(WritebackContext wb_context, int threa
     smgrcloseall();
 }
 
+/**
+ * @Description: Give bgwriter thread_id the part of the buffer pool it scans. When the
+ *    buffer pool is split into NUMA partitions and there is at least one thread per
+ *    partition, the threads are spread over the partitions and each one only scans
+ *    buffers of its own partition. Otherwise the buffers are split evenly.
+ * @in: thread_id, bgwriter thread id
+ * @in: thread_num, number of bgwriter threads
+ */
+static void bgwriter_assign_buffer_range(int thread_id, int thread_num)
+{
+    BgWriterProc *bgwriter = &g_instance.bgwriter_cxt.bgwriter_procs[thread_id];
+    int partitions = StrategyNumPartitions();
+    int start;
+    int num;
+
+    if (partitions > 1 && thread_num >= partitions) {
+        /* threads [first, next_first) serve this partition */
+        int partition = thread_id * partitions / thread_num;
+        int first = (partition * thread_num + partitions - 1) / partitions;
+        int next_first = ((partition + 1) * thread_num + partitions - 1) / partitions;
+        int part_start;
+        int part_num;
+        int avg_num;
+
+        StrategyPartitionRange(partition, &part_start, &part_num);
+        avg_num = part_num / (next_first - first);
+        start = part_start + avg_num * (thread_id - first);
+        num = (thread_id == next_first - 1) ? (part_start + part_num - start) : avg_num;
+        bgwriter->numa_node = partition;
+    } else {
+        int avg_num = g_instance.attr.attr_storage.NBuffers / thread_num;
+        start = avg_num * thread_id;
+        num = avg_num;
+        if (thread_id == thread_num - 1) {
+            num += g_instance.attr.attr_storage.NBuffers % thread_num;
+        }
+        bgwriter->numa_node = -1;
+    }
+
+    bgwriter->buf_id_start = start;
+    bgwriter->cand_list_size = num;
+    bgwriter->cand_buf_list = &g_instance.bgwriter_cxt.candidate_buffers[start];
+}
+
 void candidate_buf_init(void)
 {
     bool found_candidate_buf = false;
@@ -659,17 +711,8 @@ void candidate_buf_init(void)
         securec_check(rc, "", "");
         if (g_instance.bgwriter_cxt.bgwriter_procs != NULL) {
             int thread_num = g_instance.attr.attr_storage.bgwriter_thread_num;
-            int avg_num = g_instance.attr.attr_storage.NBuffers / thread_num;
             for (int i = 0; i < thread_num; i++) {
-                int start = avg_num * i;
-                int end = start + avg_num;
-                if (i == thread_num - 1) {
-                    end += g_instance.attr.attr_storage.NBuffers % thread_num;
-                }
-                g_instance.bgwriter_cxt.bgwriter_procs[i].buf_id_start = start;
-                g_instance.bgwriter_cxt.bgwriter_procs[i].cand_list_size = end - start;
-                g_instance.bgwriter_cxt.bgwriter_procs[i].cand_buf_list =
-                    &g_instance.bgwriter_cxt.candidate_buffers[start];
+                bgwriter_assign_buffer_range(i, thread_num);
                 g_instance.bgwriter_cxt.bgwriter_procs[i].head = 0;
                 g_instance.bgwriter_cxt.bgwriter_procs[i].tail = 0;
             }
@@ -687,16 +730,8 @@ void incre_ckpt_bgwriter_cxt_init()
     g_instance.bgwriter_cxt.bgwriter_procs = (BgWriterProc *)palloc0(sizeof(BgWriterProc) * thread_num);
 
     uint32 dirty_list_size = DW_DIRTY_PAGE_MAX_FOR_NOHBK * MAX_DIRTY_PAGE_BATCH;
-    int avg_num = g_instance.attr.attr_storage.NBuffers / thread_num;
     for (int i = 0; i < thread_num; i++) {
-        int start = avg_num * i;
-        int end = start + avg_num;
-        if (i == thread_num - 1) {
-            end += g_instance.attr.attr_storage.NBuffers % thread_num;
-        }
-        g_instance.bgwriter_cxt.bgwriter_procs[i].buf_id_start = start;
-        g_instance.bgwriter_cxt.bgwriter_procs[i].cand_list_size = end - start;
-        g_instance.bgwriter_cxt.bgwriter_procs[i].cand_buf_list = &g_instance.bgwriter_cxt.candidate_buffers[start];
+        bgwriter_assign_buffer_range(i, thread_num);
 
         /* bgwriter thread dw cxt init */
         char *unaligned_buf = (char*)palloc0((DW_BUF_MAX_FOR_NOHBK + 1) * BLCKSZ);
@@ -748,6 +783,17 @@ void incre_ckpt_background_writer_main(void)
     errno_t err_rc = snprintf_s(name, MAX_THREAD_NAME_LEN, MAX_THREAD_NAME_LEN - 1, "%s%d", "bgwriter", thread_id);
     securec_check_ss(err_rc, "", "");
 
+#ifdef __USE_NUMA
+    /* Run next to the buffers we scan and flush */
+    if (bgwriter->numa_node >= 0) {
+        if (numa_run_on_node(bgwriter->numa_node) == -1) {
+            ereport(WARNING, (errmodule(MOD_INCRE_BG),
+                errmsg("bgwriter %d could not run on NUMA node %d, errno:%d", thread_id, bgwriter->numa_node, errno)));
+        }
+        numa_set_localalloc();
+    }
+#endif
+
     /*
      * Create a resource owner to keep track of our resources (currently only buffer pins).
      */
@@ -57,6 +57,7 @@
 #include "postmaster/pagewriter.h"
 #include "replication/catchup.h"
 #include "storage/backendid.h"
+#include "storage/buf_internals.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
 #include "storage/latch.h"
@@ -85,6 +86,7 @@
 #include "access/multi_redo_api.h"
 #include "instruments/instr_unique_sql.h"
 #include "instruments/instr_event.h"
+#include "instruments/instr_histogram.h"
 
 #ifdef ENABLE_UT
 #define static
@@ -344,6 +346,20 @@ static void pgstat_sighup_handler(SIGNAL_ARGS);
 static PgStat_StatDBEntry* pgstat_get_db_entry(Oid databaseid, bool create);
 static PgStat_StatTabEntry* pgstat_get_tab_entry(
     PgStat_StatDBEntry* dbentry, Oid tableoid, bool create, uint32 statFlag);
+static PgStat_StatTabEntry* pgstat_lock_tab_entry(
+    PgStat_StatDBEntry* dbentry, Oid tableoid, uint32 statFlag, LWLock** lock);
+static void pgstat_release_tab_entry(LWLock* lock);
+static PgStat_StatTabEntry* pgstat_shm_lock_tab_entry(
+    Oid databaseid, Oid tableoid, uint32 statFlag, bool create, LWLockMode lockmode, LWLock** lock);
+static void pgstat_sum_tab_counts(PgStat_TableCounts* sum, const PgStat_TableCounts* counts);
+static void pgstat_shm_add_tabstat(Oid databaseid, const PgStat_TableStatus* entry);
+static void pgstat_shm_remove_tab_entry(Oid databaseid, Oid tableoid, uint32 statFlag, bool adjustParent);
+static void pgstat_shm_remove_db_tab_entries(Oid databaseid);
+static PgStat_ShmTabEntry* pgstat_shm_copy_tab_entries(long* nentries);
+static void pgstat_shm_write_tab_entries(
+    FILE* fpout, Oid databaseid, const PgStat_ShmTabEntry* entries, long nentries);
+static void pgstat_shm_load_tab_entry(Oid databaseid, const PgStat_StatTabEntry* tabbuf);
+static PgStat_StatTabEntry* pgstat_shm_fetch_tab_entry(PgStat_StatTabKey* tabkey);
 static void pgstat_write_statsfile(bool permanent);
 static HTAB* pgstat_read_statsfile(Oid onlydb, bool permanent);
 static void backend_read_statsfile(void);
@@ -789,6 +805,9 @@ void pgstat_report_stat(bool force)
     bool force_to_destory = false;
     errno_t rc = EOK;
 
+    /* NUMA buffer counts are kept per thread until now */
+    StrategyFlushCounts();
+
     /* Don't expend a clock check if nothing to do */
     if ((u_sess->stat_cxt.pgStatTabList == NULL || u_sess->stat_cxt.pgStatTabList->tsa_used == 0) &&
         !u_sess->stat_cxt.have_function_stats && !force)
@@ -816,6 +835,13 @@ void pgstat_report_stat(bool force)
     shared_msg.m_databaseid = InvalidOid;
     regular_msg.m_nentries = 0;
     shared_msg.m_nentries = 0;
+    if (ENABLE_PGSTAT_SHARED_MEMORY) {
+        /* the tables go to shared memory, the collector only gets their sum for the database */
+        rc = memset_s(&regular_msg.m_entry[0], sizeof(PgStat_TableEntry), 0, sizeof(PgStat_TableEntry));
+        securec_check(rc, "\0", "\0");
+        rc = memset_s(&shared_msg.m_entry[0], sizeof(PgStat_TableEntry), 0, sizeof(PgStat_TableEntry));
+        securec_check(rc, "\0", "\0");
+    }
 
     DEBUG_MOD_START_TIMER(MOD_AUTOVAC);
 
@@ -841,6 +867,12 @@ void pgstat_report_stat(bool force)
              * OK, insert data into the appropriate message, and send if full.
              */
             this_msg = entry->t_shared ? &shared_msg : &regular_msg;
+            if (ENABLE_PGSTAT_SHARED_MEMORY) {
+                pgstat_shm_add_tabstat(this_msg->m_databaseid, entry);
+                pgstat_sum_tab_counts(&this_msg->m_entry[0].t_counts, &entry->t_counts);
+                this_msg->m_nentries = 1;
+                continue;
+            }
             this_ent = &this_msg->m_entry[this_msg->m_nentries];
             this_ent->t_id = entry->t_id;
             this_ent->t_statFlag = entry->t_statFlag;
@@ -2395,6 +2427,9 @@ PgStat_StatTabEntry* pgstat_fetch_stat_tabentry(PgStat_StatTabKey* tabkey)
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
 
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        return pgstat_shm_fetch_tab_entry(tabkey);
+
     /*
      * If not done for this transaction, read the statistics collector stats
      * file into some hash tables.
@@ -5362,6 +5397,423 @@ static PgStat_StatTabEntry* pgstat_get_tab_entry(
     return result;
 }
 
+/*
+ * pgstat_get_tab_entry() for the collector's handling of a message about one
+ * table.  With enable_pgstat_shared_memory the entry is the shared one, and
+ * the partition lock left in *lock is released by pgstat_release_tab_entry().
+ */
+static PgStat_StatTabEntry* pgstat_lock_tab_entry(
+    PgStat_StatDBEntry* dbentry, Oid tableoid, uint32 statFlag, LWLock** lock)
+{
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        return pgstat_shm_lock_tab_entry(dbentry->databaseid, tableoid, statFlag, true, LW_EXCLUSIVE, lock);
+
+    *lock = NULL;
+    return pgstat_get_tab_entry(dbentry, tableoid, true, statFlag);
+}
+
+static void pgstat_release_tab_entry(LWLock* lock)
+{
+    if (lock != NULL)
+        LWLockRelease(lock);
+}
+
+/* ----------
+ * Shared memory table statistics
+ *
+ * With enable_pgstat_shared_memory the table entries live in one hash in
+ * shared memory, partitioned under NUM_PGSTAT_TAB_PARTITIONS locks, instead
+ * of in the per-database hashes of the collector.  Backends add their counts
+ * to it directly rather than sending them over the stats socket, the
+ * collector applies vacuum, analyze, truncate and the like to the same
+ * entries, and readers copy the entries they look at into a snapshot kept
+ * until the end of the transaction.  The collector still writes the entries
+ * into the stats files, for autovacuum and for the next start.
+ * ----------
+ */
+void InitPgStatShmTab(void)
+{
+    HASHCTL ctl;
+    errno_t rc;
+
+    g_instance.stat_cxt.PgStatTabContext = AllocSetContextCreate(g_instance.instance_context,
+        "PgStatTabContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        SHARED_CONTEXT);
+
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "\0", "\0");
+
+    ctl.hcxt = g_instance.stat_cxt.PgStatTabContext;
+    ctl.keysize = sizeof(PgStat_ShmTabKey);
+    ctl.entrysize = sizeof(PgStat_ShmTabEntry);
+    ctl.hash = tag_hash;
+    ctl.num_partitions = NUM_PGSTAT_TAB_PARTITIONS;
+
+    /* A partitioned hash table never expands, so size it for all the tables up front */
+    g_instance.stat_cxt.PgStatTabHTAB = hash_create("shared table statistics hash table",
+        g_instance.attr.attr_common.pgstat_shared_memory_tables,
+        &ctl,
+        HASH_ELEM | HASH_SHRCTX | HASH_FUNCTION | HASH_PARTITION);
+}
+
+static inline LWLock* pgstat_shm_tab_partition_lock(uint32 hashcode)
+{
+    return GetMainLWLockByIndex(FirstPgStatTabLock + (hashcode % NUM_PGSTAT_TAB_PARTITIONS));
+}
+
+static void pgstat_shm_lock_all_partitions(LWLockMode lockmode)
+{
+    for (int i = 0; i < NUM_PGSTAT_TAB_PARTITIONS; i++)
+        (void)LWLockAcquire(GetMainLWLockByIndex(FirstPgStatTabLock + i), lockmode);
+}
+
+static void pgstat_shm_unlock_all_partitions(void)
+{
+    for (int i = 0; i < NUM_PGSTAT_TAB_PARTITIONS; i++)
+        LWLockRelease(GetMainLWLockByIndex(FirstPgStatTabLock + i));
+}
+
+/*
+ * Look up the shared entry of a table, creating it if create is true, and
+ * return it with its partition lock held in lockmode, left in *lock.  NULL,
+ * with no lock held, if there is no entry and create is false.
+ */
+static PgStat_StatTabEntry* pgstat_shm_lock_tab_entry(
+    Oid databaseid, Oid tableoid, uint32 statFlag, bool create, LWLockMode lockmode, LWLock** lock)
+{
+    HTAB* htab = g_instance.stat_cxt.PgStatTabHTAB;
+    PgStat_ShmTabKey key;
+    PgStat_ShmTabEntry* entry = NULL;
+    uint32 hashcode;
+    bool found = false;
+
+    Assert(!create || lockmode == LW_EXCLUSIVE);
+
+    key.databaseid = databaseid;
+    key.tablekey.tableid = tableoid;
+    key.tablekey.statFlag = statFlag;
+    hashcode = get_hash_value(htab, &key);
+
+    *lock = pgstat_shm_tab_partition_lock(hashcode);
+    (void)LWLockAcquire(*lock, lockmode);
+
+    entry = (PgStat_ShmTabEntry*)hash_search_with_hash_value(
+        htab, &key, hashcode, create ? HASH_ENTER : HASH_FIND, &found);
+    if (entry == NULL) {
+        LWLockRelease(*lock);
+        *lock = NULL;
+        return NULL;
+    }
+
+    /* If not found, initialize the new one, as pgstat_get_tab_entry() does. */
+    if (!found) {
+        errno_t rc = memset_s(&entry->tabentry, sizeof(PgStat_StatTabEntry), 0, sizeof(PgStat_StatTabEntry));
+        securec_check(rc, "\0", "\0");
+        entry->tabentry.tablekey = key.tablekey;
+    }
+
+    return &entry->tabentry;
+}
+
+static void pgstat_sum_tab_counts(PgStat_TableCounts* sum, const PgStat_TableCounts* counts)
+{
+    sum->t_numscans += counts->t_numscans;
+    sum->t_tuples_returned += counts->t_tuples_returned;
+    sum->t_tuples_fetched += counts->t_tuples_fetched;
+    sum->t_tuples_inserted += counts->t_tuples_inserted;
+    sum->t_tuples_updated += counts->t_tuples_updated;
+    sum->t_tuples_deleted += counts->t_tuples_deleted;
+    sum->t_tuples_hot_updated += counts->t_tuples_hot_updated;
+    sum->t_delta_live_tuples += counts->t_delta_live_tuples;
+    sum->t_delta_dead_tuples += counts->t_delta_dead_tuples;
+    sum->t_changed_tuples += counts->t_changed_tuples;
+    sum->t_blocks_fetched += counts->t_blocks_fetched;
+    sum->t_blocks_hit += counts->t_blocks_hit;
+    sum->t_cu_mem_hit += counts->t_cu_mem_hit;
+    sum->t_cu_hdd_sync += counts->t_cu_hdd_sync;
+    sum->t_cu_hdd_asyn += counts->t_cu_hdd_asyn;
+}
+
+static void pgstat_add_tab_counts(PgStat_StatTabEntry* tabentry, const PgStat_TableCounts* counts)
+{
+    tabentry->numscans += counts->t_numscans;
+    tabentry->tuples_returned += counts->t_tuples_returned;
+    tabentry->tuples_fetched += counts->t_tuples_fetched;
+    tabentry->tuples_inserted += counts->t_tuples_inserted;
+    tabentry->tuples_updated += counts->t_tuples_updated;
+    tabentry->tuples_deleted += counts->t_tuples_deleted;
+    tabentry->tuples_hot_updated += counts->t_tuples_hot_updated;
+    tabentry->n_live_tuples += counts->t_delta_live_tuples;
+    tabentry->n_dead_tuples += counts->t_delta_dead_tuples;
+    tabentry->changes_since_analyze += counts->t_changed_tuples;
+    tabentry->blocks_fetched += counts->t_blocks_fetched;
+    tabentry->blocks_hit += counts->t_blocks_hit;
+    tabentry->cu_mem_hit += counts->t_cu_mem_hit;
+    tabentry->cu_hdd_sync += counts->t_cu_hdd_sync;
+    tabentry->cu_hdd_asyn += counts->t_cu_hdd_asyn;
+}
+
+/*
+ * Add what a backend counted for one table to its shared entry, and to the
+ * entry of its partitioned table if it is a partition; what
+ * pgstat_recv_tabstat() does for the entries of a tabstat message.
+ */
+static void pgstat_shm_add_tabstat(Oid databaseid, const PgStat_TableStatus* entry)
+{
+    PgStat_StatTabEntry* tabentry = NULL;
+    LWLock* lock = NULL;
+
+    tabentry = pgstat_shm_lock_tab_entry(databaseid, entry->t_id, entry->t_statFlag, true, LW_EXCLUSIVE, &lock);
+    pgstat_add_tab_counts(tabentry, &entry->t_counts);
+    /* Clamp n_live_tuples and n_dead_tuples in case of negative deltas */
+    tabentry->n_live_tuples = Max(tabentry->n_live_tuples, 0);
+    tabentry->n_dead_tuples = Max(tabentry->n_dead_tuples, 0);
+    LWLockRelease(lock);
+
+    /* partitioned table alse should record UDI info */
+    if (pg_stat_relation(entry->t_statFlag))
+        return;
+
+    tabentry = pgstat_shm_lock_tab_entry(databaseid, entry->t_statFlag, InvalidOid, true, LW_EXCLUSIVE, &lock);
+    pgstat_add_tab_counts(tabentry, &entry->t_counts);
+    LWLockRelease(lock);
+}
+
+/*
+ * Remove the shared entry of a table.  With adjustParent, the tuples of a
+ * partition go out of its partitioned table the way pgstat_recv_tabpurge()
+ * does it.
+ */
+static void pgstat_shm_remove_tab_entry(Oid databaseid, Oid tableoid, uint32 statFlag, bool adjustParent)
+{
+    PgStat_ShmTabKey key;
+    PgStat_StatTabEntry* tabentry = NULL;
+    PgStat_StatTabEntry removed;
+    LWLock* lock = NULL;
+
+    tabentry = pgstat_shm_lock_tab_entry(databaseid, tableoid, statFlag, false, LW_EXCLUSIVE, &lock);
+    if (tabentry == NULL)
+        return;
+
+    removed = *tabentry;
+    key.databaseid = databaseid;
+    key.tablekey = removed.tablekey;
+    (void)hash_search(g_instance.stat_cxt.PgStatTabHTAB, (void*)&key, HASH_REMOVE, NULL);
+    LWLockRelease(lock);
+
+    if (!adjustParent || pg_stat_relation(statFlag))
+        return;
+
+    tabentry = pgstat_shm_lock_tab_entry(databaseid, statFlag, InvalidOid, false, LW_EXCLUSIVE, &lock);
+    if (tabentry != NULL) {
+        tabentry->n_dead_tuples = Max(0, tabentry->n_dead_tuples - removed.n_dead_tuples);
+        tabentry->n_live_tuples = Max(0, tabentry->n_live_tuples - removed.n_live_tuples);
+        tabentry->changes_since_analyze += removed.changes_since_analyze;
+        LWLockRelease(lock);
+    }
+}
+
+/*
+ * Remove the shared entries of all the tables of a database.
+ */
+static void pgstat_shm_remove_db_tab_entries(Oid databaseid)
+{
+    HASH_SEQ_STATUS hstat;
+    PgStat_ShmTabEntry* entry = NULL;
+
+    pgstat_shm_lock_all_partitions(LW_EXCLUSIVE);
+    hash_seq_init(&hstat, g_instance.stat_cxt.PgStatTabHTAB);
+    while ((entry = (PgStat_ShmTabEntry*)hash_seq_search(&hstat)) != NULL) {
+        if (entry->key.databaseid == databaseid)
+            (void)hash_search(g_instance.stat_cxt.PgStatTabHTAB, (void*)&entry->key, HASH_REMOVE, NULL);
+    }
+    pgstat_shm_unlock_all_partitions();
+}
+
+static int pgstat_shm_tab_entry_cmp(const void* a, const void* b)
+{
+    Oid dba = ((const PgStat_ShmTabEntry*)a)->key.databaseid;
+    Oid dbb = ((const PgStat_ShmTabEntry*)b)->key.databaseid;
+
+    return (dba < dbb) ? -1 : ((dba > dbb) ? 1 : 0);
+}
+
+/*
+ * Copy the shared table entries for pgstat_write_statsfile(), sorted by
+ * database.  One pass over the hash table does for all the databases, and
+ * the partition locks are not held while the file is written.
+ */
+static PgStat_ShmTabEntry* pgstat_shm_copy_tab_entries(long* nentries)
+{
+    HASH_SEQ_STATUS hstat;
+    PgStat_ShmTabEntry* entry = NULL;
+    PgStat_ShmTabEntry* entries = NULL;
+    long count = 0;
+    long n;
+
+    pgstat_shm_lock_all_partitions(LW_SHARED);
+    n = hash_get_num_entries(g_instance.stat_cxt.PgStatTabHTAB);
+    if (n > 0) {
+        entries = (PgStat_ShmTabEntry*)palloc_huge(CurrentMemoryContext, n * sizeof(PgStat_ShmTabEntry));
+        hash_seq_init(&hstat, g_instance.stat_cxt.PgStatTabHTAB);
+        while ((entry = (PgStat_ShmTabEntry*)hash_seq_search(&hstat)) != NULL)
+            entries[count++] = *entry;
+    }
+    pgstat_shm_unlock_all_partitions();
+
+    if (count > 1)
+        qsort(entries, count, sizeof(PgStat_ShmTabEntry), pgstat_shm_tab_entry_cmp);
+
+    *nentries = count;
+    return entries;
+}
+
+/*
+ * Write the 'T' records of the tables of a database for
+ * pgstat_write_statsfile(), from the entries pgstat_shm_copy_tab_entries()
+ * returned.
+ */
+static void pgstat_shm_write_tab_entries(
+    FILE* fpout, Oid databaseid, const PgStat_ShmTabEntry* entries, long nentries)
+{
+    long lo = 0;
+    long hi = nentries;
+    int rc;
+
+    /* find the first entry of the database */
+    while (lo < hi) {
+        long mid = lo + (hi - lo) / 2;
+
+        if (entries[mid].key.databaseid < databaseid)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    for (; lo < nentries && entries[lo].key.databaseid == databaseid; lo++) {
+        fputc('T', fpout);
+        rc = fwrite(&entries[lo].tabentry, sizeof(PgStat_StatTabEntry), 1, fpout);
+        (void)rc; /* we'll check for error with ferror */
+    }
+}
+
+/*
+ * Add the counters of a table entry read from the stats file to the shared
+ * entry of the table, which only holds what backends counted since.  The
+ * later of the two vacuum and analyze timestamps wins, and the autovacuum
+ * timeout status of the file is kept unless a newer one was recorded.
+ */
+static void pgstat_shm_merge_tab_entry(PgStat_StatTabEntry* tabentry, const PgStat_StatTabEntry* tabbuf)
+{
+    tabentry->numscans += tabbuf->numscans;
+    tabentry->tuples_returned += tabbuf->tuples_returned;
+    tabentry->tuples_fetched += tabbuf->tuples_fetched;
+    tabentry->tuples_inserted += tabbuf->tuples_inserted;
+    tabentry->tuples_updated += tabbuf->tuples_updated;
+    tabentry->tuples_deleted += tabbuf->tuples_deleted;
+    tabentry->tuples_hot_updated += tabbuf->tuples_hot_updated;
+    tabentry->n_live_tuples += tabbuf->n_live_tuples;
+    tabentry->n_dead_tuples += tabbuf->n_dead_tuples;
+    tabentry->changes_since_analyze += tabbuf->changes_since_analyze;
+    tabentry->blocks_fetched += tabbuf->blocks_fetched;
+    tabentry->blocks_hit += tabbuf->blocks_hit;
+    tabentry->cu_mem_hit += tabbuf->cu_mem_hit;
+    tabentry->cu_hdd_sync += tabbuf->cu_hdd_sync;
+    tabentry->cu_hdd_asyn += tabbuf->cu_hdd_asyn;
+
+    tabentry->vacuum_timestamp = Max(tabentry->vacuum_timestamp, tabbuf->vacuum_timestamp);
+    tabentry->vacuum_count += tabbuf->vacuum_count;
+    tabentry->autovac_vacuum_timestamp = Max(tabentry->autovac_vacuum_timestamp, tabbuf->autovac_vacuum_timestamp);
+    tabentry->autovac_vacuum_count += tabbuf->autovac_vacuum_count;
+    tabentry->analyze_timestamp = Max(tabentry->analyze_timestamp, tabbuf->analyze_timestamp);
+    tabentry->analyze_count += tabbuf->analyze_count;
+    tabentry->autovac_analyze_timestamp = Max(tabentry->autovac_analyze_timestamp, tabbuf->autovac_analyze_timestamp);
+    tabentry->autovac_analyze_count += tabbuf->autovac_analyze_count;
+    tabentry->data_changed_timestamp = Max(tabentry->data_changed_timestamp, tabbuf->data_changed_timestamp);
+    if (tabentry->autovac_status == 0)
+        tabentry->autovac_status = tabbuf->autovac_status;
+}
+
+/*
+ * Put a table entry of the permanent stats file into shared memory when the
+ * collector starts.  Backends may have kept counting while the collector was
+ * away, into an entry of their own; the file's counters are added to it.
+ */
+static void pgstat_shm_load_tab_entry(Oid databaseid, const PgStat_StatTabEntry* tabbuf)
+{
+    HTAB* htab = g_instance.stat_cxt.PgStatTabHTAB;
+    PgStat_ShmTabKey key;
+    PgStat_ShmTabEntry* entry = NULL;
+    uint32 hashcode;
+    LWLock* lock = NULL;
+    bool found = false;
+
+    key.databaseid = databaseid;
+    key.tablekey = tabbuf->tablekey;
+    hashcode = get_hash_value(htab, &key);
+
+    lock = pgstat_shm_tab_partition_lock(hashcode);
+    (void)LWLockAcquire(lock, LW_EXCLUSIVE);
+    entry = (PgStat_ShmTabEntry*)hash_search_with_hash_value(htab, &key, hashcode, HASH_ENTER, &found);
+    if (!found)
+        entry->tabentry = *tabbuf;
+    else
+        pgstat_shm_merge_tab_entry(&entry->tabentry, tabbuf);
+    LWLockRelease(lock);
+}
+
+/*
+ * pgstat_fetch_stat_tabentry() with enable_pgstat_shared_memory: the entry of
+ * the table in our database, or else of the shared table, as it was the first
+ * time this transaction looked at it.
+ */
+static PgStat_StatTabEntry* pgstat_shm_fetch_tab_entry(PgStat_StatTabKey* tabkey)
+{
+    PgStat_StatTabEntry* tabentry = NULL;
+    PgStat_StatTabEntry tabbuf;
+    LWLock* lock = NULL;
+
+    if (u_sess->stat_cxt.pgStatTabSnapshot == NULL) {
+        HASHCTL hash_ctl;
+        errno_t rc;
+
+        pgstat_setup_memcxt();
+
+        rc = memset_s(&hash_ctl, sizeof(hash_ctl), 0, sizeof(hash_ctl));
+        securec_check(rc, "\0", "\0");
+        hash_ctl.keysize = sizeof(PgStat_StatTabKey);
+        hash_ctl.entrysize = sizeof(PgStat_StatTabEntry);
+        hash_ctl.hash = tag_hash;
+        hash_ctl.hcxt = u_sess->stat_cxt.pgStatLocalContext;
+        u_sess->stat_cxt.pgStatTabSnapshot = hash_create("Table statistics snapshot",
+            PGSTAT_TAB_HASH_SIZE,
+            &hash_ctl,
+            HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+    }
+
+    tabentry = (PgStat_StatTabEntry*)hash_search(u_sess->stat_cxt.pgStatTabSnapshot, (void*)tabkey, HASH_FIND, NULL);
+    if (tabentry != NULL)
+        return tabentry;
+
+    tabentry = pgstat_shm_lock_tab_entry(
+        u_sess->proc_cxt.MyDatabaseId, tabkey->tableid, tabkey->statFlag, false, LW_SHARED, &lock);
+    /* If we didn't find it, maybe it's a shared table. */
+    if (tabentry == NULL)
+        tabentry = pgstat_shm_lock_tab_entry(InvalidOid, tabkey->tableid, tabkey->statFlag, false, LW_SHARED, &lock);
+    if (tabentry == NULL)
+        return NULL;
+
+    tabbuf = *tabentry;
+    LWLockRelease(lock);
+
+    tabentry = (PgStat_StatTabEntry*)hash_search(u_sess->stat_cxt.pgStatTabSnapshot, (void*)tabkey, HASH_ENTER, NULL);
+    *tabentry = tabbuf;
+    return tabentry;
+}
+
 /* ----------
  * pgstat_write_statsfile() -
  *
@@ -5381,6 +5833,8 @@ static void pgstat_write_statsfile(bool permanent)
     PgStat_StatTabEntry* tabentry = NULL;
     PgStat_StatFuncEntry* funcentry = NULL;
     FILE* fpout = NULL;
+    PgStat_ShmTabEntry* shmTabEntries = NULL;
+    long shmTabEntryNum = 0;
     int32 format_id;
     const char* tmpfile = permanent ? PGSTAT_STAT_PERMANENT_TMPFILE : u_sess->stat_cxt.pgstat_stat_tmpname;
     const char* statfile = permanent ? PGSTAT_STAT_PERMANENT_FILENAME : u_sess->stat_cxt.pgstat_stat_filename;
@@ -5414,6 +5868,9 @@ static void pgstat_write_statsfile(bool permanent)
     rc = fwrite(u_sess->stat_cxt.globalStats, sizeof(PgStat_GlobalStats), 1, fpout);
     (void)rc; /* we'll check for error with ferror */
 
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        shmTabEntries = pgstat_shm_copy_tab_entries(&shmTabEntryNum);
+
     /*
      * Walk through the database table.
      */
@@ -5431,11 +5888,15 @@ static void pgstat_write_statsfile(bool permanent)
         /*
          * Walk through the database's access stats per table.
          */
-        hash_seq_init(&tstat, dbentry->tables);
-        while ((tabentry = (PgStat_StatTabEntry*)hash_seq_search(&tstat)) != NULL) {
-            fputc('T', fpout);
-            rc = fwrite(tabentry, sizeof(PgStat_StatTabEntry), 1, fpout);
-            (void)rc; /* we'll check for error with ferror */
+        if (ENABLE_PGSTAT_SHARED_MEMORY) {
+            pgstat_shm_write_tab_entries(fpout, dbentry->databaseid, shmTabEntries, shmTabEntryNum);
+        } else {
+            hash_seq_init(&tstat, dbentry->tables);
+            while ((tabentry = (PgStat_StatTabEntry*)hash_seq_search(&tstat)) != NULL) {
+                fputc('T', fpout);
+                rc = fwrite(tabentry, sizeof(PgStat_StatTabEntry), 1, fpout);
+                (void)rc; /* we'll check for error with ferror */
+            }
         }
 
         /*
@@ -5454,6 +5915,9 @@ static void pgstat_write_statsfile(bool permanent)
         fputc('d', fpout);
     }
 
+    if (shmTabEntries != NULL)
+        pfree(shmTabEntries);
+
     /*
      * No more output to be done. Close the temp file and replace the old
      * pgstat.stat with it.  The ferror() check replaces testing for error
@@ -5688,6 +6152,12 @@ static HTAB* pgstat_read_statsfile(Oid onlydb, bool permanent)
                 if (tabhash == NULL)
                     break;
 
+                /* The collector keeps the tables in shared memory. */
+                if (u_sess->stat_cxt.pgStatRunningInCollector && ENABLE_PGSTAT_SHARED_MEMORY) {
+                    pgstat_shm_load_tab_entry(dbentry->databaseid, &tabbuf);
+                    break;
+                }
+
                 tabentry = (PgStat_StatTabEntry*)hash_search(tabhash, (void*)&(tabbuf.tablekey), HASH_ENTER, &found);
 
                 if (found) {
@@ -6097,6 +6567,7 @@ void pgstat_clear_snapshot(void)
     /* Reset variables */
     u_sess->stat_cxt.pgStatLocalContext = NULL;
     u_sess->stat_cxt.pgStatDBHash = NULL;
+    u_sess->stat_cxt.pgStatTabSnapshot = NULL;
     u_sess->stat_cxt.localBackendStatusTable = NULL;
     u_sess->stat_cxt.localNumBackends = 0;
     u_sess->stat_cxt.analyzeCheckHash = NULL;
@@ -6144,6 +6615,24 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg)
         PgStat_TableEntry* tabmsg = &(msg->m_entry[i]);
         PgStat_StatTabKey tabkey;
 
+        /*
+         * Add per-table stats to the per-database entry.
+         */
+        dbentry->n_tuples_returned += tabmsg->t_counts.t_tuples_returned;
+        dbentry->n_tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
+        dbentry->n_tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
+        dbentry->n_tuples_updated += tabmsg->t_counts.t_tuples_updated;
+        dbentry->n_tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
+        dbentry->n_blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
+        dbentry->n_blocks_hit += tabmsg->t_counts.t_blocks_hit;
+        dbentry->n_cu_mem_hit += tabmsg->t_counts.t_cu_mem_hit;
+        dbentry->n_cu_hdd_sync += tabmsg->t_counts.t_cu_hdd_sync;
+        dbentry->n_cu_hdd_asyn += tabmsg->t_counts.t_cu_hdd_asyn;
+
+        /* The backends keep the table entries themselves in shared memory. */
+        if (ENABLE_PGSTAT_SHARED_MEMORY)
+            continue;
+
         tabkey.statFlag = tabmsg->t_statFlag;
         tabkey.tableid = tabmsg->t_id;
 
@@ -6206,20 +6695,6 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg)
         /* Likewise for n_dead_tuples */
         tabentry->n_dead_tuples = Max(tabentry->n_dead_tuples, 0);
 
-        /*
-         * Add per-table stats to the per-database entry, too.
-         */
-        dbentry->n_tuples_returned += tabmsg->t_counts.t_tuples_returned;
-        dbentry->n_tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
-        dbentry->n_tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
-        dbentry->n_tuples_updated += tabmsg->t_counts.t_tuples_updated;
-        dbentry->n_tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
-        dbentry->n_blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
-        dbentry->n_blocks_hit += tabmsg->t_counts.t_blocks_hit;
-        dbentry->n_cu_mem_hit += tabmsg->t_counts.t_cu_mem_hit;
-        dbentry->n_cu_hdd_sync += tabmsg->t_counts.t_cu_hdd_sync;
-        dbentry->n_cu_hdd_asyn += tabmsg->t_counts.t_cu_hdd_asyn;
-
         /* partitioned table alse should record UDI info */
         if (pg_stat_relation(tabkey.statFlag))
             continue;
@@ -6298,6 +6773,13 @@ static void pgstat_recv_tabpurge(PgStat_MsgTabpurge* msg)
     PgStat_StatTabEntry* parententry = NULL;
     int i;
 
+    if (ENABLE_PGSTAT_SHARED_MEMORY) {
+        for (i = 0; i < msg->m_nentries; i++)
+            pgstat_shm_remove_tab_entry(
+                msg->m_databaseid, msg->m_entry[i].m_tableid, msg->m_entry[i].m_statFlag, true);
+        return;
+    }
+
     dbentry = pgstat_get_db_entry(msg->m_databaseid, false);
     /*
      * No need to purge if we don't even know the database.
@@ -6339,6 +6821,9 @@ static void pgstat_recv_dropdb(PgStat_MsgDropdb* msg)
 {
     PgStat_StatDBEntry* dbentry = NULL;
 
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        pgstat_shm_remove_db_tab_entries(msg->m_databaseid);
+
     /*
      * Lookup the database in the hashtable.
      */
@@ -6371,6 +6856,9 @@ static void pgstat_recv_resetcounter(PgStat_MsgResetcounter* msg)
     PgStat_StatDBEntry* dbentry = NULL;
     errno_t rc = EOK;
 
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        pgstat_shm_remove_db_tab_entries(msg->m_databaseid);
+
     /*
      * Lookup the database in the hashtable.  Nothing to do if not there.
      */
@@ -6480,7 +6968,10 @@ static void pgstat_recv_resetsinglecounter(PgStat_MsgResetsinglecounter* msg)
         tabkey.statFlag = msg->p_objectid;
         tabkey.tableid = msg->m_objectid;
 
-        (void)hash_search(dbentry->tables, (void*)&(tabkey), HASH_REMOVE, NULL);
+        if (ENABLE_PGSTAT_SHARED_MEMORY)
+            pgstat_shm_remove_tab_entry(msg->m_databaseid, tabkey.tableid, tabkey.statFlag, false);
+        else
+            (void)hash_search(dbentry->tables, (void*)&(tabkey), HASH_REMOVE, NULL);
     } else if (msg->m_resettype == RESET_FUNCTION) {
         (void)hash_search(dbentry->functions, (void*)&(msg->m_objectid), HASH_REMOVE, NULL);
     }
@@ -6514,12 +7005,13 @@ static void pgstat_recv_vacuum(PgStat_MsgVacuum* msg)
 {
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
+    LWLock* tablock = NULL;
 
     /*
      * Store the data in the table's hashtable entry.
      */
     dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-    tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true, msg->m_statFlag);
+    tabentry = pgstat_lock_tab_entry(dbentry, msg->m_tableoid, msg->m_statFlag, &tablock);
 
     /* Resetting dead_tuples ... use negtive number to verify Cstore */
     if (msg->m_tuples < 0)
@@ -6536,6 +7028,7 @@ static void pgstat_recv_vacuum(PgStat_MsgVacuum* msg)
         tabentry->vacuum_timestamp = msg->m_vacuumtime;
         tabentry->vacuum_count++;
     }
+    pgstat_release_tab_entry(tablock);
 }
 
 /* ----------
@@ -6548,15 +7041,17 @@ static void pgstat_recv_data_changed(PgStat_MsgDataChanged* msg)
 {
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
+    LWLock* tablock = NULL;
 
     /*
      * Store the data in the table's hashtable entry.
      */
     dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-    tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true, msg->m_statFlag);
+    tabentry = pgstat_lock_tab_entry(dbentry, msg->m_tableoid, msg->m_statFlag, &tablock);
 
     /* store start time of insert/delete/update operation */
     tabentry->data_changed_timestamp = msg->m_changed_time;
+    pgstat_release_tab_entry(tablock);
 }
 
 /* ----------
@@ -6569,16 +7064,18 @@ static void pgstat_recv_autovac_stat(PgStat_MsgAutovacStat* msg)
 {
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
+    LWLock* tablock = NULL;
 
     /*
      * Store the data in the table's hashtable entry.
      */
     dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-    tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true, msg->m_statFlag);
+    tabentry = pgstat_lock_tab_entry(dbentry, msg->m_tableoid, msg->m_statFlag, &tablock);
     if (tabentry && AV_TIMEOUT == msg->m_autovacStat) {
         increase_continued_timeout(tabentry->autovac_status);
         increase_toatl_timeout(tabentry->autovac_status);
     }
+    pgstat_release_tab_entry(tablock);
 }
 
 /* ----------
@@ -6592,26 +7089,35 @@ static void pgstat_recv_truncate(PgStat_MsgTruncate* msg)
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
     PgStat_StatTabEntry* parent_entry = NULL;
+    PgStat_Counter dead_tuples;
+    PgStat_Counter live_tuples;
+    PgStat_Counter changes_since_analyze;
+    LWLock* tablock = NULL;
 
     /*
      * Store the data in the table's hashtable entry.
      */
     dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-    tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true, msg->m_statFlag);
+    tabentry = pgstat_lock_tab_entry(dbentry, msg->m_tableoid, msg->m_statFlag, &tablock);
+    dead_tuples = tabentry->n_dead_tuples;
+    live_tuples = tabentry->n_live_tuples;
+    changes_since_analyze = tabentry->changes_since_analyze;
+
+    /* After truncate reset dead_tuple and live_tuple */
+    tabentry->n_dead_tuples = 0;
+    tabentry->n_live_tuples = 0;
+    pgstat_release_tab_entry(tablock);
 
     /* modify parent table's stat info(dead_tuple, live_tuple, changes_since_analyze) if it is a patition */
     if (msg->m_statFlag) {
-        parent_entry = pgstat_get_tab_entry(dbentry, msg->m_statFlag, true, InvalidOid);
+        parent_entry = pgstat_lock_tab_entry(dbentry, msg->m_statFlag, InvalidOid, &tablock);
         if (NULL != parent_entry) {
-            parent_entry->n_dead_tuples = Max(0, parent_entry->n_dead_tuples - tabentry->n_dead_tuples);
-            parent_entry->n_live_tuples = Max(0, parent_entry->n_live_tuples - tabentry->n_live_tuples);
-            parent_entry->changes_since_analyze += tabentry->changes_since_analyze;
+            parent_entry->n_dead_tuples = Max(0, parent_entry->n_dead_tuples - dead_tuples);
+            parent_entry->n_live_tuples = Max(0, parent_entry->n_live_tuples - live_tuples);
+            parent_entry->changes_since_analyze += changes_since_analyze;
         }
+        pgstat_release_tab_entry(tablock);
     }
-
-    /* After truncate reset dead_tuple and live_tuple */
-    tabentry->n_dead_tuples = 0;
-    tabentry->n_live_tuples = 0;
 }
 
 /* ----------
@@ -6624,12 +7130,13 @@ static void pgstat_recv_analyze(PgStat_MsgAnalyze* msg)
 {
     PgStat_StatDBEntry* dbentry = NULL;
     PgStat_StatTabEntry* tabentry = NULL;
+    LWLock* tablock = NULL;
 
     /*
      * Store the data in the table's hashtable entry.
      */
     dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-    tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true, msg->m_statFlag);
+    tabentry = pgstat_lock_tab_entry(dbentry, msg->m_tableoid, msg->m_statFlag, &tablock);
 
     tabentry->n_live_tuples = msg->m_live_tuples;
     tabentry->n_dead_tuples = msg->m_dead_tuples;
@@ -6650,6 +7157,7 @@ static void pgstat_recv_analyze(PgStat_MsgAnalyze* msg)
         tabentry->analyze_timestamp = msg->m_analyzetime;
         tabentry->analyze_count++;
     }
+    pgstat_release_tab_entry(tablock);
 }
 
 /* ----------
@@ -6798,32 +7306,18 @@ void pgstat_init_sql_rt_info_array(knl_g_stat_context* stat_cxt)
     }
 }
 
+/*
+ * Single node adds the response time to the histogram of this backend, the
+ * percentile thread merges the histograms of all backends.  Nothing is
+ * sampled or dropped, and no lock is taken.
+ */
 void pgstat_update_responstime_singlenode(uint64 UniqueSQLId, int64 start_time, int64 rt)
 {
-    uint32 sqlRTIndex;
-
     if (!u_sess->attr.attr_common.enable_instr_rt_percentile ||
         strncmp(u_sess->attr.attr_common.application_name, "gs_clean", strlen("gs_clean") == 0))
         return;
 
-    /* if the percentile thread is memory copying or memory is null, not record */
-    if (g_instance.stat_cxt.force_process != false ||
-        g_instance.stat_cxt.sql_rt_info_array == NULL) {
-        return;
-    }
-
-    LWLockAcquire(PercentileLock, LW_SHARED);
-    /* if the current is full , not record this time, set force process to true to active percentile thread */
-    sqlRTIndex = pg_atomic_fetch_add_u32(&g_instance.stat_cxt.sql_rt_info_array->sqlRTIndex, 1);
-    if (sqlRTIndex >= MAX_SQL_RT_INFO_COUNT) {
-         g_instance.stat_cxt.force_process = true;
-         LWLockRelease(PercentileLock);
-         return;
-    }
-    g_instance.stat_cxt.sql_rt_info_array->sqlRT[sqlRTIndex].UniqueSQLId = UniqueSQLId;
-    g_instance.stat_cxt.sql_rt_info_array->sqlRT[sqlRTIndex].start_time = start_time;
-    g_instance.stat_cxt.sql_rt_info_array->sqlRT[sqlRTIndex].rt = rt;
-    LWLockRelease(PercentileLock);
+    pgstat_update_sql_rt_histogram(rt);
 }
 
 static void pgstat_recv_sql_responstime(PgStat_SqlRT* msg)
@@ -6908,41 +7402,6 @@ static void prepare_calculate(SqlRTInfoArray* sql_rt_info, int* counter)
     qsort(u_sess->percentile_cxt.LocalsqlRT, sql_rt_info_count, sizeof(SqlRTInfo), sqlRTComparator);
 }
 
-static void prepare_calculate_single(SqlRTInfoArray* sql_rt_info, int* counter)
-{
-    int sql_rt_info_count = 0;
-
-    sql_rt_info_count = g_instance.stat_cxt.sql_rt_info_array->sqlRTIndex;
-
-    if (sql_rt_info_count > MAX_SQL_RT_INFO_COUNT) {
-        sql_rt_info_count = MAX_SQL_RT_INFO_COUNT;
-    }
-
-    if (sql_rt_info_count == 0) {
-        *counter = sql_rt_info_count;
-        return;
-    }
-
-    if (u_sess->percentile_cxt.LocalsqlRT != NULL)
-        pfree(u_sess->percentile_cxt.LocalsqlRT);
-
-    u_sess->percentile_cxt.LocalsqlRT =
-        (SqlRTInfo*)MemoryContextAllocZero(u_sess->top_mem_cxt, sql_rt_info_count * sizeof(SqlRTInfo));
-
-    LWLockAcquire(PercentileLock, LW_EXCLUSIVE);
-    errno_t ss_rc = memcpy_s(u_sess->percentile_cxt.LocalsqlRT,
-        sql_rt_info_count * sizeof(SqlRTInfo),
-        sql_rt_info->sqlRT,
-        sql_rt_info_count * sizeof(SqlRTInfo));
-    securec_check(ss_rc, "\0", "\0");
-    g_instance.stat_cxt.sql_rt_info_array->sqlRTIndex = 0;
-    g_instance.stat_cxt.force_process = false;
-    LWLockRelease(PercentileLock);
-    
-    *counter = sql_rt_info_count;
-    qsort(u_sess->percentile_cxt.LocalsqlRT, sql_rt_info_count, sizeof(SqlRTInfo), sqlRTComparator);
-}
-
 /* ----------
  * pgstat_recv_memReserved() -
  *
@@ -9403,11 +9862,7 @@ bool CalcSQLRowStatCounter(PgStat_TableCounts* last_total_counter, PgStat_TableC
 int pgstat_fetch_sql_rt_info_counter(void)
 {
     if (g_instance.stat_cxt.sql_rt_info_array != NULL) {
-        if (IS_SINGLE_NODE) {
-            prepare_calculate_single(g_instance.stat_cxt.sql_rt_info_array, &u_sess->percentile_cxt.LocalCounter);
-        } else {
-            prepare_calculate(g_instance.stat_cxt.sql_rt_info_array, &u_sess->percentile_cxt.LocalCounter);
-        }
+        prepare_calculate(g_instance.stat_cxt.sql_rt_info_array, &u_sess->percentile_cxt.LocalCounter);
     }
     return u_sess->percentile_cxt.LocalCounter;
 }
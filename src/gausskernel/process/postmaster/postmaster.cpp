@@ -88,6 +88,7 @@
 #include "catalog/pg_control.h"
 #include "instruments/instr_unique_sql.h"
 #include "instruments/instr_user.h"
+#include "instruments/instr_histogram.h"
 #include "instruments/percentile.h"
 #include "opfusion/opfusion_util.h"
 
@@ -2165,8 +2166,14 @@ int PostmasterMain(int argc, char* argv[])
         SHARED_CONTEXT);
     /* init unique sql */
     InitUniqueSQL();
+    /* init response time histograms of the percentile thread */
+    if (IS_SINGLE_NODE)
+        InitSqlRTHistograms();
     /* init instr user */
     InitInstrUser();
+    /* init shared memory table statistics */
+    if (ENABLE_PGSTAT_SHARED_MEMORY)
+        InitPgStatShmTab();
     /* init Opfusion function id */
     InitOpfusionFunctionId();
 
@@ -2847,7 +2854,7 @@ static int ServerLoop(void)
          */
         ADIO_RUN()
         {
-            if (!g_instance.pid_cxt.AioCompleterStarted && !dummyStandbyMode) {
+            if (!g_instance.pid_cxt.AioCompleterStarted && !dummyStandbyMode && !AioCompltrIsInline()) {
                 int aioStartErr = 0;
                 if ((aioStartErr = AioCompltrStart()) == 0) {
                     g_instance.pid_cxt.AioCompleterStarted = 1;
@@ -7737,6 +7737,8 @@ int PostgresMain(int argc, char* argv[], const char* dbname, const char* usernam
                     UpdateUniqueSQLStatOnRemote();
                 UniqueSQLStatCountResetReturnedRows();
                 UniqueSQLStatCountResetParseCounter();
+                /* nothing else would add the pending counts while the session is idle */
+                FlushUniqueSQLStat();
             }
 
             if (IsStmtRetryEnabled()) {
@@ -185,6 +185,8 @@ static void knl_g_parallel_redo_init(knl_g_parallel_redo_context* predo_cxt)
     predo_cxt->redoPf.recovery_done_ptr = 0;
     predo_cxt->redoPf.speed_according_seg = 0;
     predo_cxt->redoPf.local_max_lsn = 0;
+    errno_t rc = memset_s(&predo_cxt->redoPf.prefetch, sizeof(RedoPrefetchStats), 0, sizeof(RedoPrefetchStats));
+    securec_check(rc, "\0", "\0");
     knl_g_set_is_local_redo_finish(false);
     predo_cxt->redoType = DEFAULT_REDO;
     SpinLockInit(&(predo_cxt->destroy_lock));
@@ -263,6 +265,7 @@ static void knl_g_stat_init(knl_g_stat_context* stat_cxt)
     stat_cxt->got_SIGHUP = false;
 
     stat_cxt->UniqueSQLHashtbl = NULL;
+    stat_cxt->unique_sql_elapse_hist = false;
     stat_cxt->InstrUserHTAB = NULL;
     stat_cxt->calculate_on_other_cn = false;
     stat_cxt->force_process = false;
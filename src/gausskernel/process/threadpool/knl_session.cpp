@@ -672,6 +672,7 @@ static void knl_u_stat_init(knl_u_stat_context* stat_cxt)
     stat_cxt->pgstat_stat_tmpname = NULL;
     stat_cxt->pgStatDBHash = NULL;
     stat_cxt->pgStatTabList = NULL;
+    stat_cxt->pgStatTabSnapshot = NULL;
 
     stat_cxt->BgWriterStats = (PgStat_MsgBgWriter*)palloc0(sizeof(PgStat_MsgBgWriter));
     stat_cxt->globalStats = (PgStat_GlobalStats*)palloc0(sizeof(PgStat_GlobalStats));
@@ -813,6 +814,8 @@ static void knl_u_unique_sql_init(knl_u_unique_sql_context* unique_sql_cxt)
     unique_sql_cxt->curr_single_unique_sql = NULL;
     unique_sql_cxt->is_multi_unique_sql = false;
     unique_sql_cxt->is_top_unique_sql = false;
+    unique_sql_cxt->pending_stat_hash = NULL;
+    unique_sql_cxt->pending_flush_time = 0;
 }
 
 static void knl_u_percentile_init(knl_u_percentile_context* percentile_cxt)
@@ -820,6 +823,7 @@ static void knl_u_percentile_init(knl_u_percentile_context* percentile_cxt)
     Assert(percentile_cxt != NULL);
     percentile_cxt->LocalsqlRT = NULL;
     percentile_cxt->LocalCounter = 0;
+    percentile_cxt->LastRTHistogram = NULL;
 }
 
 static void knl_u_user_login_init(knl_u_user_login_context* user_login_cxt)
@@ -1030,6 +1034,10 @@ void knl_session_init(knl_session_context* sess_cxt)
 {
     sess_cxt->status = KNL_SESS_UNINIT;
     DLInitElem(&sess_cxt->elem, sess_cxt);
+    sess_cxt->thread_pool_group = NULL;
+    sess_cxt->ready_time = 0;
+    sess_cxt->attach_time = 0;
+    sess_cxt->latency_class = SESSION_LATENCY_LONG;
 
     sess_cxt->top_transaction_mem_cxt = NULL;
     sess_cxt->self_mem_cxt = NULL;
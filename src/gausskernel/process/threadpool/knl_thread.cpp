@@ -497,6 +497,7 @@ static void knl_t_xlog_init(knl_t_xlog_context* xlog_cxt)
     xlog_cxt->LogwrtResult = (XLogwrtResult*)palloc0(sizeof(XLogwrtResult));
     xlog_cxt->needImmediateCkp = false;
     xlog_cxt->redoItemIdx = 0;
+    xlog_cxt->redo_prefetcher = NULL;
 #ifndef ENABLE_MULTIPLE_NODES
     xlog_cxt->committing_csn_list = NIL;
 #endif
@@ -1154,6 +1155,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->smoothed_alloc = 0;
     storage_cxt->smoothed_density = 10.0;
     storage_cxt->StrategyControl = NULL;
+    storage_cxt->buffer_trace = NULL;
+    storage_cxt->buffer_partition_counts = NULL;
     storage_cxt->CacheBlockInProgressIO = CACHE_BLOCK_INVALID_IDX;
     storage_cxt->CacheBlockInProgressUncompress = CACHE_BLOCK_INVALID_IDX;
     storage_cxt->MetaBlockInProgressIO = CACHE_BLOCK_INVALID_IDX;
@@ -1238,6 +1241,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
 
     storage_cxt->max_safe_fds = 32;
     storage_cxt->max_userdatafiles = 8192 - 1000;
+    storage_cxt->uring_cxt = NULL;
+    storage_cxt->uring_unavailable = false;
 }
 
 static void knl_t_port_init(knl_t_port_context* port_cxt)
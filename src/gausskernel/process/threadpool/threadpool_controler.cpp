@@ -102,7 +102,8 @@ void ThreadPoolControler::Init(bool enableNumaDistribute)
     int max_thread_num = 0;
     int numa_id = 0;
 
-    m_groups = (ThreadPoolGroup**)palloc(sizeof(ThreadPoolGroup*) * m_groupNum);
+    /* zeroed, as work stealing looks at the groups while they are set up */
+    m_groups = (ThreadPoolGroup**)palloc0(sizeof(ThreadPoolGroup*) * m_groupNum);
     m_sessCtrl = New(CurrentMemoryContext) ThreadPoolSessControl(CurrentMemoryContext);
 
     for (int i = 0; i < m_groupNum; i++) {
@@ -579,6 +580,93 @@ ThreadPoolStat* ThreadPoolControler::GetThreadPoolStat(uint32* num)
     return result;
 }
 
+ThreadPoolQueueStat* ThreadPoolControler::GetThreadPoolQueueStat(uint32* num)
+{
+    ThreadPoolQueueStat* result = (ThreadPoolQueueStat*)palloc(m_groupNum * sizeof(ThreadPoolQueueStat));
+    int i;
+
+    for (i = 0; i < m_groupNum; i++) {
+        m_groups[i]->GetThreadPoolGroupQueueStat(&result[i]);
+    }
+
+    *num = m_groupNum;
+    return result;
+}
+
+/*
+ * The idx-th group work stealing between home and the other groups looks at:
+ * groups on the NUMA node of home come first, the rest after them, and each
+ * round starts after home so that the load spreads over the groups.  NULL if
+ * the group at that place is in the other round or not set up yet.
+ */
+ThreadPoolGroup* ThreadPoolControler::GetStealGroup(ThreadPoolGroup* home, int idx)
+{
+    bool localRound = (idx < m_groupNum - 1);
+    ThreadPoolGroup* group = m_groups[(home->GetGroupId() + 1 + idx % (m_groupNum - 1)) % m_groupNum];
+
+    if (group == NULL || group->GetListener() == NULL) {
+        return NULL;
+    }
+    if ((group->GetNumaId() == home->GetNumaId()) != localRound) {
+        return NULL;
+    }
+    return group;
+}
+
+/*
+ * A worker of thief found nothing to do in its own group: take the session
+ * that waits longest in one of the other groups, if work stealing allows it.
+ */
+knl_session_context* ThreadPoolControler::StealSession(ThreadPoolGroup* thief)
+{
+    int penalty = g_instance.attr.attr_common.thread_pool_steal_remote_penalty;
+
+    if (!g_instance.attr.attr_common.enable_thread_pool_stealing || m_groupNum <= 1) {
+        return NULL;
+    }
+
+    for (int i = 0; i < 2 * (m_groupNum - 1); i++) {
+        ThreadPoolGroup* home = GetStealGroup(thief, i);
+        if (home == NULL || !thief->CanStealFrom(home, penalty)) {
+            continue;
+        }
+
+        knl_session_context* session = home->GetListener()->GetReadySession();
+        if (session != NULL) {
+            thief->RecordStolenSession(home);
+            return session;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * A session of home found no free worker there: hand it to a free worker of
+ * another group, if work stealing allows it.
+ */
+bool ThreadPoolControler::LendSession(ThreadPoolGroup* home, knl_session_context* session)
+{
+    int penalty = g_instance.attr.attr_common.thread_pool_steal_remote_penalty;
+
+    if (!g_instance.attr.attr_common.enable_thread_pool_stealing || m_groupNum <= 1) {
+        return false;
+    }
+
+    for (int i = 0; i < 2 * (m_groupNum - 1); i++) {
+        ThreadPoolGroup* thief = GetStealGroup(home, i);
+        if (thief == NULL || !thief->CanStealFrom(home, penalty)) {
+            continue;
+        }
+
+        if (thief->GetListener()->WakeUpFreeWorker(session)) {
+            thief->RecordStolenSession(home);
+            home->RecordQueueTime(0);
+            return true;
+        }
+    }
+    return false;
+}
+
 void ThreadPoolControler::CloseAllSessions()
 {
     m_sessCtrl->MarkAllSessionClose();
@@ -68,6 +68,8 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum,
       m_sessionCount(0),
       m_waitServeSessionCount(0),
       m_processTaskCount(0),
+      m_stolenSessionCount(0),
+      m_lentSessionCount(0),
       m_groupId(groupId),
       m_numaId(numaId),
       m_groupCpuNum(cpuNum),
@@ -83,6 +85,8 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum,
         SHARED_CONTEXT);
     pthread_mutex_init(&m_mutex, NULL);
     CPU_ZERO(&m_nodeCpuSet);
+    errno_t rc = memset_s((void*)m_queueTimeHist, sizeof(m_queueTimeHist), 0, sizeof(m_queueTimeHist));
+    securec_check(rc, "\0", "\0");
 }
 
 ThreadPoolGroup::~ThreadPoolGroup()
@@ -195,6 +199,58 @@ void ThreadPoolGroup::GetThreadPoolGroupStat(ThreadPoolStat* stat)
     securec_check_ss(rc, "\0", "\0");
 }
 
+void ThreadPoolGroup::GetThreadPoolGroupQueueStat(ThreadPoolQueueStat* stat)
+{
+    stat->groupId = m_groupId;
+    stat->numaId = m_numaId;
+    stat->stolenSessions = m_stolenSessionCount;
+    stat->lentSessions = m_lentSessionCount;
+    for (int i = 0; i < THREAD_QUEUE_TIME_BUCKETS; i++) {
+        stat->queueTime[i] = m_queueTimeHist[i];
+    }
+}
+
+/*
+ * Count the queueing delay of a session of this group that a worker takes up
+ * now.  readyTime is when the session was queued, 0 if it found a free worker
+ * at once.
+ */
+void ThreadPoolGroup::RecordQueueTime(TimestampTz readyTime)
+{
+    int bucket = 0;
+
+    if (readyTime != 0) {
+        int64 waitTime = Max(GetCurrentTimestamp() - readyTime, 0);
+
+        bucket = 1;
+        while (bucket < THREAD_QUEUE_TIME_BUCKETS - 1 && waitTime >= ((int64)1 << bucket)) {
+            bucket++;
+        }
+    }
+    (void)pg_atomic_fetch_add_u64(&m_queueTimeHist[bucket], 1);
+}
+
+/*
+ * Whether workers of this group may serve the waiting sessions of home.  A
+ * group with sessions of its own waiting keeps its workers, and a group on
+ * another NUMA node only helps once penalty sessions wait in home.
+ */
+bool ThreadPoolGroup::CanStealFrom(ThreadPoolGroup* home, int penalty)
+{
+    if (home == this || m_waitServeSessionCount > 0) {
+        return false;
+    }
+
+    return (home->m_numaId == m_numaId || home->m_waitServeSessionCount >= penalty);
+}
+
+void ThreadPoolGroup::RecordStolenSession(ThreadPoolGroup* home)
+{
+    (void)pg_atomic_fetch_add_u64(&m_stolenSessionCount, 1);
+    (void)pg_atomic_fetch_add_u64(&home->m_lentSessionCount, 1);
+    (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_processTaskCount, 1);
+}
+
 void ThreadPoolGroup::AddWorkerIfNecessary()
 {
     AutoMutexLock alock(&m_mutex);
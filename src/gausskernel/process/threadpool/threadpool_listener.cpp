@@ -103,6 +103,7 @@ ThreadPoolListener::ThreadPoolListener(ThreadPoolGroup* group)
     m_reaperAllSession = false;
     m_freeWorkerList = New(CurrentMemoryContext) DllistWithLock();
     m_readySessionList = New(CurrentMemoryContext) DllistWithLock();
+    m_shortReadySessionList = New(CurrentMemoryContext) DllistWithLock();
     m_idleSessionList = New(CurrentMemoryContext) DllistWithLock();
 }
 
@@ -113,6 +114,7 @@ ThreadPoolListener::~ThreadPoolListener()
     m_epollEvents = NULL;
     m_freeWorkerList = NULL;
     m_readySessionList = NULL;
+    m_shortReadySessionList = NULL;
     m_idleSessionList = NULL;
 }
 
@@ -167,21 +169,82 @@ void ThreadPoolListener::AddEpoll(knl_session_context* session)
 
 bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
 {
-    Dlelem* sc = m_readySessionList->RemoveHead();
-    if (sc != NULL) {
-        worker->SetSession((knl_session_context*)sc->dle_val);
-        pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
+    knl_session_context* session = GetReadySession();
+    if (session != NULL) {
+        worker->SetSession(session);
         pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
         return true;
-    } else {
-        m_freeWorkerList->AddTail(&worker->m_elem);
-        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_idleWorkerNum, 1);
-        return false;
     }
+
+    /* Serve a session waiting in another group rather than going idle. */
+    session = g_threadPoolControler->StealSession(m_group);
+    if (session != NULL) {
+        worker->SetSession(session);
+        return true;
+    }
+
+    m_freeWorkerList->AddTail(&worker->m_elem);
+    pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_idleWorkerNum, 1);
+    return false;
+}
+
+/* Whether the session at the head of a ready list was queued before *arg. */
+static bool ReadySessionAged(Dlelem* e, void* arg)
+{
+    return ((knl_session_context*)DLE_VAL(e))->ready_time <= *(TimestampTz*)arg;
+}
+
+/*
+ * Take the next session for a worker of this group: the one that has waited
+ * longest, or with enable_thread_pool_latency_class the short session that
+ * has waited longest, unless a long session has waited past the aging time.
+ */
+knl_session_context* ThreadPoolListener::GetReadySession()
+{
+    Dlelem* sc = NULL;
+
+    if (g_instance.attr.attr_common.enable_thread_pool_latency_class) {
+        if (!m_readySessionList->IsEmpty()) {
+            TimestampTz agedTime = TimestampTzPlusMilliseconds(GetCurrentTimestamp(),
+                -g_instance.attr.attr_common.thread_pool_latency_class_aging);
+            sc = m_readySessionList->RemoveHeadIf(ReadySessionAged, &agedTime);
+        }
+        if (sc == NULL) {
+            sc = m_shortReadySessionList->RemoveHead();
+        }
+    }
+    if (sc == NULL) {
+        sc = m_readySessionList->RemoveHead();
+    }
+    if (sc == NULL) {
+        return NULL;
+    }
+
+    knl_session_context* session = (knl_session_context*)DLE_VAL(sc);
+    pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
+    m_group->RecordQueueTime(session->ready_time);
+    session->ready_time = 0;
+    return session;
+}
+
+/*
+ * Hand the session to a free worker of this group, if there is one.
+ */
+bool ThreadPoolListener::WakeUpFreeWorker(knl_session_context* session)
+{
+    Dlelem* sc = m_freeWorkerList->RemoveHead();
+    while (sc != NULL) {
+        if (((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToWork(session)) {
+            return true;
+        }
+        sc = m_freeWorkerList->RemoveHead();
+    }
+    return false;
 }
 
 void ThreadPoolListener::AddNewSession(knl_session_context* session)
 {
+    session->thread_pool_group = m_group;
     AddEpoll(session);
     (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_sessionCount, 1);
 }
@@ -286,18 +349,18 @@ knl_session_context* ThreadPoolListener::GetSessionBaseOnEvent(struct epoll_even
 void ThreadPoolListener::DispatchSession(knl_session_context* session)
 {
     m_idleSessionList->Remove(&session->elem);
-    while (true) {
-        Dlelem* sc = m_freeWorkerList->RemoveHead();
-        if (sc != NULL) {
-            if (((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToWork(session)) {
-                pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
-                break;
-            }
+    if (WakeUpFreeWorker(session)) {
+        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
+        m_group->RecordQueueTime(0);
+    } else if (!g_threadPoolControler->LendSession(m_group, session)) {
+        session->ready_time = GetCurrentTimestamp();
+        if (g_instance.attr.attr_common.enable_thread_pool_latency_class &&
+            session->latency_class == SESSION_LATENCY_SHORT) {
+            m_shortReadySessionList->AddTail(&session->elem);
         } else {
             m_readySessionList->AddTail(&session->elem);
-            pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
-            break;
         }
+        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
     }
 }
 
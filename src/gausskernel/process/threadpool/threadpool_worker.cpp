@@ -53,6 +53,7 @@
 #include "storage/pmsignal.h"
 #include "storage/sinvaladt.h"
 #include "storage/smgr.h"
+#include "storage/uring.h"
 #include "tcop/dest.h"
 #include "tcop/tcopprot.h"
 #include "utils/guc.h"
@@ -395,6 +396,9 @@ void ThreadPoolWorker::CleanThread()
      */
     FreeAllAllocatedDescs();
 
+    /* Queued io_uring hints may use fds of this session, which can move to another thread */
+    UringSubmitPending();
+
     /* we should abandon this session. */
     if (t_thrd.int_cxt.ClientConnectionLost || t_thrd.threadpool_cxt.reaper_dead_session) {
         t_thrd.int_cxt.ClientConnectionLost = false;
@@ -448,8 +452,22 @@ void ThreadPoolWorker::DetachSessionFromThread()
     pgstat_deinitialize_session();
     m_currentSession->attachPid = (ThreadId)-1;
 
-    /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    /* Decide the queue the next request of the session waits in. */
+    if (g_instance.attr.attr_common.enable_thread_pool_latency_class) {
+        int latencyClass = m_currentSession->attr.attr_common.session_latency_class;
+        if (latencyClass == SESSION_LATENCY_AUTO) {
+            int64 serveTime = GetCurrentTimestamp() - m_currentSession->attach_time;
+            latencyClass = (serveTime < g_instance.attr.attr_common.thread_pool_short_request_time) ?
+                SESSION_LATENCY_SHORT : SESSION_LATENCY_LONG;
+        }
+        m_currentSession->latency_class = (SessionLatencyClass)latencyClass;
+    }
+
+    /*
+     * should restore the data before return to listener. The session may have
+     * been served for another group, hand it back to the group it belongs to.
+     */
+    m_currentSession->thread_pool_group->GetListener()->AddEpoll(m_currentSession);
     m_currentSession = NULL;
     u_sess = NULL;
 }
@@ -467,6 +485,9 @@ bool ThreadPoolWorker::AttachSessionToThread()
 
     u_sess = m_currentSession;
     t_thrd.postgres_cxt.whereToSendOutput = DestRemote;
+    if (g_instance.attr.attr_common.enable_thread_pool_latency_class) {
+        u_sess->attach_time = GetCurrentTimestamp();
+    }
     SelfMemoryContext = u_sess->self_mem_cxt;
     /*
      * Since thread pool worker may start earlier than startup finishing recovery,
@@ -561,7 +582,7 @@ void ThreadPoolWorker::CleanUpSession(bool threadexit)
         }
 
         /* Close Session. */
-        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        m_currentSession->thread_pool_group->GetListener()->DelSessionFromEpoll(m_currentSession);
 
         /*
          * Record this state in case we reenter this function because
@@ -25,6 +25,10 @@
 
 #include "executor/execParallel.h"
 #include "executor/executor.h"
+#include "executor/nodeBitmapHeapscan.h"
+#include "executor/nodeHashjoin.h"
+#include "executor/nodeIndexonlyscan.h"
+#include "executor/nodeIndexscan.h"
 #include "executor/nodeSeqscan.h"
 #include "executor/tqueue.h"
 #include "nodes/nodeFuncs.h"
@@ -34,6 +38,7 @@
 #include "tcop/tcopprot.h"
 #include "utils/memutils.h"
 #include "utils/snapmgr.h"
+#include "vecexecutor/vecnodecstorescan.h"
 
 #define PARALLEL_TUPLE_QUEUE_SIZE 65536
 
@@ -67,6 +72,7 @@ typedef struct ExecParallelInitializeDSMContext {
 static char *ExecSerializePlan(Plan *plan, EState *estate);
 static bool ExecParallelEstimate(PlanState *node, ExecParallelEstimateContext *e);
 static bool ExecParallelInitializeDSM(PlanState *node, ExecParallelInitializeDSMContext *d);
+static bool ExecParallelReInitializeDSM(PlanState *planstate, ParallelContext *pcxt);
 static shm_mq_handle **ExecParallelSetupTupleQueues(ParallelContext *pcxt, bool reinitialize);
 static bool ExecParallelRetrieveInstrumentation(PlanState *planstate, SharedExecutorInstrumentation *instrumentation);
 
@@ -149,6 +155,12 @@ static bool ExecParallelEstimate(PlanState *planstate, ExecParallelEstimateConte
             case T_SeqScanState:
                 ExecSeqScanEstimate((SeqScanState *)planstate, e->pcxt);
                 break;
+            case T_IndexScanState:
+                ExecIndexScanEstimate((IndexScanState *)planstate, e->pcxt);
+                break;
+            case T_IndexOnlyScanState:
+                ExecIndexOnlyScanEstimate((IndexOnlyScanState *)planstate, e->pcxt);
+                break;
             default:
                 break;
         }
@@ -190,6 +202,28 @@ static bool ExecParallelInitializeDSM(PlanState *planstate, ExecParallelInitiali
                 ExecSeqScanInitializeDSM((SeqScanState *)planstate, d->pcxt, cxt->pwCtx->queryInfo.pscan_num);
                 cxt->pwCtx->queryInfo.pscan_num++;
                 break;
+            case T_HashJoinState:
+                ExecHashJoinInitializeDSM((HashJoinState *)planstate, d->pcxt, cxt->pwCtx->queryInfo.phj_num);
+                cxt->pwCtx->queryInfo.phj_num++;
+                break;
+            case T_IndexScanState:
+                ExecIndexScanInitializeDSM((IndexScanState *)planstate, d->pcxt, cxt->pwCtx->queryInfo.piscan_num);
+                cxt->pwCtx->queryInfo.piscan_num++;
+                break;
+            case T_IndexOnlyScanState:
+                ExecIndexOnlyScanInitializeDSM((IndexOnlyScanState *)planstate, d->pcxt,
+                    cxt->pwCtx->queryInfo.piscan_num);
+                cxt->pwCtx->queryInfo.piscan_num++;
+                break;
+            case T_BitmapHeapScanState:
+                ExecBitmapHeapInitializeDSM((BitmapHeapScanState *)planstate, d->pcxt, cxt->pwCtx->queryInfo.pbms_num);
+                cxt->pwCtx->queryInfo.pbms_num++;
+                break;
+            case T_CStoreScanState:
+                ExecCStoreScanInitializeDSM((CStoreScanState *)planstate, d->pcxt,
+                    cxt->pwCtx->queryInfo.pcstore_num);
+                cxt->pwCtx->queryInfo.pcstore_num++;
+                break;
             default:
                 break;
         }
@@ -263,6 +297,40 @@ void ExecParallelReinitialize(ParallelExecutorInfo *pei)
     pei->tqueue = ExecParallelSetupTupleQueues(pei->pcxt, true);
     pei->reader = NULL;
     pei->finished = false;
+
+    /* Let parallel-aware nodes reset their shared state for the new scan. */
+    (void)ExecParallelReInitializeDSM(pei->planstate, pei->pcxt);
+}
+
+/*
+ * Traverse plan tree to reinitialize per-node dynamic shared memory state.
+ * The workers are gone at this point, so no locking is needed.
+ */
+static bool ExecParallelReInitializeDSM(PlanState *planstate, ParallelContext *pcxt)
+{
+    if (planstate == NULL)
+        return false;
+
+    if (planstate->plan->parallel_aware) {
+        switch (nodeTag(planstate)) {
+            case T_IndexScanState:
+                ExecIndexScanReInitializeDSM((IndexScanState *)planstate, pcxt);
+                break;
+            case T_IndexOnlyScanState:
+                ExecIndexOnlyScanReInitializeDSM((IndexOnlyScanState *)planstate, pcxt);
+                break;
+            case T_BitmapHeapScanState:
+                ExecBitmapHeapReInitializeDSM((BitmapHeapScanState *)planstate, pcxt);
+                break;
+            case T_CStoreScanState:
+                ExecCStoreScanReInitializeDSM((CStoreScanState *)planstate, pcxt);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return planstate_tree_walker(planstate, (bool (*)())ExecParallelReInitializeDSM, pcxt);
 }
 
 /*
@@ -356,6 +424,12 @@ ParallelExecutorInfo *ExecInitParallelPlan(PlanState *planstate, EState *estate,
     }
 
     queryInfo.pscan = (ParallelHeapScanDesc *)palloc0(sizeof(ParallelHeapScanDesc) * e.nnodes);
+    queryInfo.phjstate = (struct ParallelHashJoinState **)palloc0(sizeof(struct ParallelHashJoinState *) * e.nnodes);
+    queryInfo.piscan = (ParallelIndexScanDesc *)palloc0(sizeof(ParallelIndexScanDesc) * e.nnodes);
+    queryInfo.pbmstate =
+        (struct ParallelBitmapHeapState **)palloc0(sizeof(struct ParallelBitmapHeapState *) * e.nnodes);
+    queryInfo.pcstore =
+        (struct ParallelCStoreScanDescData **)palloc0(sizeof(struct ParallelCStoreScanDescData *) * e.nnodes);
 
     /*
      * Give parallel-aware nodes a chance to initialize their shared data.
@@ -591,6 +665,21 @@ static bool ExecParallelInitializeWorker(PlanState *planstate, void *context)
             case T_SeqScanState:
                 ExecSeqScanInitializeWorker((SeqScanState *)planstate, context);
                 break;
+            case T_HashJoinState:
+                ExecHashJoinInitializeWorker((HashJoinState *)planstate, context);
+                break;
+            case T_IndexScanState:
+                ExecIndexScanInitializeWorker((IndexScanState *)planstate, context);
+                break;
+            case T_IndexOnlyScanState:
+                ExecIndexOnlyScanInitializeWorker((IndexOnlyScanState *)planstate, context);
+                break;
+            case T_BitmapHeapScanState:
+                ExecBitmapHeapInitializeWorker((BitmapHeapScanState *)planstate, context);
+                break;
+            case T_CStoreScanState:
+                ExecCStoreScanInitializeWorker((CStoreScanState *)planstate, context);
+                break;
             default:
                 break;
         }
@@ -22,6 +22,7 @@
 
 #include "executor/executor.h"
 #include "miscadmin.h"
+#include "catalog/pg_type.h"
 #include "utils/memutils.h"
 
 /*
@@ -379,3 +380,122 @@ void ExecScanReScan(ScanState* node)
         e_state->es_epqScanDone[scan_rel_id - 1] = false;
     }
 }
+
+/*
+ * RuntimeFilterDatumGetInt64
+ *		Widen an integer datum of the given type to int64.
+ */
+static inline int64 RuntimeFilterDatumGetInt64(Datum value, Oid type_id)
+{
+    switch (type_id) {
+        case INT2OID:
+            return (int64)DatumGetInt16(value);
+        case INT4OID:
+            return (int64)DatumGetInt32(value);
+        default:
+            return DatumGetInt64(value);
+    }
+}
+
+static inline bool RuntimeFilterIsIntType(Oid type_id)
+{
+    return type_id == INT2OID || type_id == INT4OID || type_id == INT8OID;
+}
+
+/*
+ * ExecGetRuntimeFilter
+ *		Return the bloom filter published for the i'th entry of a scan's
+ *		var_list, or NULL if the hash join has not built it (yet).
+ *
+ * The filter array is read on every call: the row hash join fetches its
+ * first outer tuple before it builds the hash table, so a filter can show
+ * up after the scan has started.  Only integer filters are returned; the
+ * heap and column store scans test nothing else.
+ */
+filter::BloomFilter* ExecGetRuntimeFilter(PlanState* node, int i)
+{
+    BloomFilterControl* control = &node->state->es_bloom_filter;
+    int idx = list_nth_int(node->plan->filterIndexList, i);
+
+    if (control->bfarray == NULL || idx < 0 || idx >= control->array_size) {
+        return NULL;
+    }
+
+    filter::BloomFilter* bf = control->bfarray[idx];
+    if (bf == NULL || !RuntimeFilterIsIntType(bf->getDataType())) {
+        return NULL;
+    }
+
+    return bf;
+}
+
+/*
+ * ExecRuntimeFilterMayMatch
+ *		Test a non-null integer value against a runtime filter, first against
+ *		the min/max of the build side and then against the bloom filter bits.
+ */
+bool ExecRuntimeFilterMayMatch(filter::BloomFilter* bf, Datum value, Oid type_id)
+{
+    int64 val = RuntimeFilterDatumGetInt64(value, type_id);
+
+    if (bf->hasMinMax()) {
+        Oid bf_type = bf->getDataType();
+
+        if (val < RuntimeFilterDatumGetInt64(bf->getMin(), bf_type) ||
+            val > RuntimeFilterDatumGetInt64(bf->getMax(), bf_type)) {
+            return false;
+        }
+    }
+
+    return bf->includeLong(val);
+}
+
+/*
+ * ExecRuntimeFilterRange
+ *		Get the build side min/max of a runtime filter as int64.  Returns
+ *		false if the filter has no min/max.
+ */
+bool ExecRuntimeFilterRange(filter::BloomFilter* bf, int64* min_val, int64* max_val)
+{
+    if (!bf->hasMinMax()) {
+        return false;
+    }
+
+    *min_val = RuntimeFilterDatumGetInt64(bf->getMin(), bf->getDataType());
+    *max_val = RuntimeFilterDatumGetInt64(bf->getMax(), bf->getDataType());
+    return true;
+}
+
+/*
+ * ExecRuntimeFilterPassTuple
+ *		Check a scanned heap tuple against the runtime filters of its scan.
+ *
+ * Null keys are passed through; the join drops them anyway.  Returns false
+ * if any filter rejects the tuple, counting it in the instrumentation.
+ */
+bool ExecRuntimeFilterPassTuple(ScanState* node, TupleTableSlot* slot)
+{
+    ListCell* lc = NULL;
+    int i = 0;
+
+    foreach (lc, node->ps.plan->var_list) {
+        Var* var = (Var*)lfirst(lc);
+        filter::BloomFilter* bf = ExecGetRuntimeFilter(&node->ps, i++);
+        bool isnull = false;
+        Datum value;
+
+        if (bf == NULL) {
+            continue;
+        }
+
+        value = slot_getattr(slot, var->varattno, &isnull);
+        if (!isnull && !ExecRuntimeFilterMayMatch(bf, value, var->vartype)) {
+            if (node->ps.instrument != NULL) {
+                node->ps.instrument->bloomFilterRows++;
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
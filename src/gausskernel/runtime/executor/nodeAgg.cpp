@@ -2282,6 +2282,15 @@ AggState* ExecInitAgg(Agg* node, EState* estate, int eflags)
                 }
             }
         }
+
+        /*
+         * A partial agg below a Gather hands its transition values up to the
+         * finalize agg, which collects them and applies the final function.
+         */
+        if (node->is_partial && need_adjust_agg_inner_func_type(aggref)) {
+            peraggstate->finalfn_oid = finalfn_oid = InvalidOid;
+            peraggstate->collectfn_oid = collectfn_oid = InvalidOid;
+        }
 #endif /* PGXC */
         /* Check that aggregate owner has permission to call component fns */
         {
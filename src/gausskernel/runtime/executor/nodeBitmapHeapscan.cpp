@@ -32,6 +32,9 @@
  *		ExecInitBitmapHeapScan		creates and initializes state info.
  *		ExecReScanBitmapHeapScan	prepares to rescan the plan.
  *		ExecEndBitmapHeapScan		releases all storage.
+ *		ExecBitmapHeapInitializeDSM	initialize DSM for parallel bitmap heap scan
+ *		ExecBitmapHeapReInitializeDSM	reinitialize DSM for fresh scan
+ *		ExecBitmapHeapInitializeWorker	attach to DSM info in parallel worker
  */
 #include "postgres.h"
 #include "knl/knl_variable.h"
@@ -44,6 +47,7 @@
 #include "pgstat.h"
 #include "storage/bufmgr.h"
 #include "storage/predicate.h"
+#include "storage/shm_condvar.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
@@ -59,6 +63,7 @@ static void ExecInitPartitionForBitmapHeapScan(BitmapHeapScanState* scanstate, E
 static void ExecInitNextPartitionForBitmapHeapScan(BitmapHeapScanState* node);
 static void BitmapHeapPrefetchNext(
     BitmapHeapScanState* node, HeapScanDesc scan, const TIDBitmap* tbm, TBMIterator** prefetch_iterator);
+static void BitmapHeapInitializeShared(BitmapHeapScanState* node);
 
 /* This struct is used for partition switch while prefetch pages */
 typedef struct PrefetchNode {
@@ -76,6 +81,11 @@ void BitmapHeapFree(BitmapHeapScanState* node)
         tbm_end_iterate(node->prefetch_iterator);
         node->prefetch_iterator = NULL;
     }
+    /* the shared bitmap itself is released along with its shared context */
+    if (node->shared_tbmiterator != NULL) {
+        tbm_end_shared_iterate(node->shared_tbmiterator);
+        node->shared_tbmiterator = NULL;
+    }
     if (node->tbm != NULL) {
         tbm_free(node->tbm);
         node->tbm = NULL;
@@ -146,8 +156,16 @@ static TupleTableSlot* BitmapHeapTblNext(BitmapHeapScanState* node)
      * GUC-controlled maximum, target_prefetch_pages.  This is to avoid doing
      * a lot of prefetching in a scan that stops after a few tuples because of
      * a LIMIT.
+     *
+     * In a parallel scan the bitmap is built once, by whichever participant
+     * gets here first, and the pages are handed out through a shared
+     * iterator.  We don't prefetch in that case.
      */
-    if (tbm == NULL) {
+    if (node->pstate != NULL) {
+        if (node->shared_tbmiterator == NULL) {
+            BitmapHeapInitializeShared(node);
+        }
+    } else if (tbm == NULL) {
         tbm = (TIDBitmap*)MultiExecProcNode(outerPlanState(node));
 
         if (tbm == NULL || !IsA(tbm, TIDBitmap)) {
@@ -178,7 +196,11 @@ static TupleTableSlot* BitmapHeapTblNext(BitmapHeapScanState* node)
          * Get next page of results if needed
          */
         if (tbmres == NULL) {
-            node->tbmres = tbmres = tbm_iterate(tbmiterator);
+            if (node->shared_tbmiterator != NULL) {
+                node->tbmres = tbmres = tbm_shared_iterate(node->shared_tbmiterator);
+            } else {
+                node->tbmres = tbmres = tbm_iterate(tbmiterator);
+            }
             if (tbmres == NULL) {
                 /* no more entries in the bitmap */
                 break;
@@ -343,6 +365,53 @@ static TupleTableSlot* BitmapHeapTblNext(BitmapHeapScanState* node)
     return ExecClearTuple(slot);
 }
 
+/*
+ * BitmapHeapInitializeShared - set up the shared bitmap of a parallel scan
+ *
+ * The first participant to get here runs the bitmap index scans and copies
+ * the resulting pages into the shared context; the others wait for it.  Then
+ * every participant attaches its own iterator.
+ */
+static void BitmapHeapInitializeShared(BitmapHeapScanState* node)
+{
+    ParallelBitmapHeapState* pstate = node->pstate;
+    bool build = false;
+
+    ShmCondVarLock(&pstate->cv);
+    if (pstate->state == PBM_INITIAL) {
+        pstate->state = PBM_INPROGRESS;
+        build = true;
+    } else {
+        while (pstate->state == PBM_INPROGRESS) {
+            ShmCondVarWait(&pstate->cv);
+        }
+    }
+    ShmCondVarUnlock(&pstate->cv);
+
+    if (build) {
+        TIDBitmap* tbm = (TIDBitmap*)MultiExecProcNode(outerPlanState(node));
+
+        if (tbm == NULL || !IsA(tbm, TIDBitmap)) {
+            ereport(ERROR,
+                (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("unrecognized result from subplan for BitmapHeapScan.")));
+        }
+
+        /* the pages are copied out, so our private bitmap can go right away */
+        pstate->tbmiterator = tbm_prepare_shared_iterate(tbm, pstate->bitmapCxt);
+        tbm_free(tbm);
+
+        ShmCondVarLock(&pstate->cv);
+        pstate->state = PBM_FINISHED;
+        ShmCondVarBroadcast(&pstate->cv);
+        ShmCondVarUnlock(&pstate->cv);
+    }
+
+    node->shared_tbmiterator = tbm_attach_shared_iterate(pstate->tbmiterator);
+    node->tbmres = NULL;
+}
+
 /*
  * bitgetpage - subroutine for BitmapHeapNext()
  *
@@ -621,6 +690,8 @@ BitmapHeapScanState* ExecInitBitmapHeapScan(BitmapHeapScan* node, EState* estate
     scanstate->prefetch_iterator = NULL;
     scanstate->prefetch_pages = 0;
     scanstate->prefetch_target = 0;
+    scanstate->shared_tbmiterator = NULL;
+    scanstate->pstate = NULL;
     scanstate->ss.isPartTbl = node->scan.isPartTbl;
     scanstate->ss.currentSlot = 0;
     scanstate->ss.partScanDirection = node->scan.partScanDirection;
@@ -918,3 +989,71 @@ void BitmapHeapPrefetchNext(
     }
     ADIO_END();
 }
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapInitializeDSM
+ *
+ *		Set up the shared state of a parallel bitmap heap scan.  The
+ *		bitmap is built lazily, by the first participant to need it.
+ * ----------------------------------------------------------------
+ */
+void ExecBitmapHeapInitializeDSM(BitmapHeapScanState* node, ParallelContext* pcxt, int nodeid)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)pcxt->seg;
+
+    /* Here we can't use palloc, cause we have switch to old memctx in ExecInitParallelPlan */
+    ParallelBitmapHeapState* pstate =
+        (ParallelBitmapHeapState*)MemoryContextAllocZero(cxt->memCtx, sizeof(ParallelBitmapHeapState));
+    pstate->plan_node_id = node->ss.ps.plan->plan_node_id;
+    pstate->bitmapCxt = AllocSetContextCreate(cxt->memCtx,
+        "ParallelBitmapHeapScan",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        SHARED_CONTEXT,
+        Max((Size)u_sess->attr.attr_memory.work_mem * 1024L * 2, (Size)SHARED_MEMORY_CONTEXT_MAX_SIZE));
+    ShmCondVarInit(&pstate->cv);
+    pstate->state = PBM_INITIAL;
+    pstate->tbmiterator = NULL;
+
+    cxt->pwCtx->queryInfo.pbmstate[nodeid] = pstate;
+    node->pstate = pstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapReInitializeDSM
+ *
+ *		Reset shared state before beginning a fresh scan.  Called by the
+ *		leader while no worker is running.
+ * ----------------------------------------------------------------
+ */
+void ExecBitmapHeapReInitializeDSM(BitmapHeapScanState* node, ParallelContext* pcxt)
+{
+    ParallelBitmapHeapState* pstate = node->pstate;
+
+    MemoryContextReset(pstate->bitmapCxt);
+    pstate->tbmiterator = NULL;
+    pstate->state = PBM_INITIAL;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapInitializeWorker
+ *
+ *		Copy relevant information from TOC into planstate.
+ * ----------------------------------------------------------------
+ */
+void ExecBitmapHeapInitializeWorker(BitmapHeapScanState* node, void* context)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)context;
+
+    for (int i = 0; i < cxt->pwCtx->queryInfo.pbms_num; i++) {
+        if (node->ss.ps.plan->plan_node_id == cxt->pwCtx->queryInfo.pbmstate[i]->plan_node_id) {
+            node->pstate = cxt->pwCtx->queryInfo.pbmstate[i];
+            break;
+        }
+    }
+
+    if (node->pstate == NULL) {
+        ereport(ERROR, (errmsg("could not find plan info, plan node id:%d", node->ss.ps.plan->plan_node_id)));
+    }
+}
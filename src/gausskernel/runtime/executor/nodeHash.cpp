@@ -24,6 +24,7 @@
 #include <math.h>
 #include <limits.h>
 #include "access/hash.h"
+#include "access/parallel.h"
 #include "catalog/pg_partition_fn.h"
 #include "catalog/pg_statistic.h"
 #include "commands/tablespace.h"
@@ -55,6 +56,8 @@ static void ExecHashRemoveNextSkewBucket(HashJoinTable hashtable);
 static void ExecHashIncreaseBuckets(HashJoinTable hashtable);
 
 static void* dense_alloc(HashJoinTable hashtable, Size size);
+static void ExecHashTableInitHashFunctions(HashJoinTable hashtable, List* hashOperators);
+static void ExecParallelHashTableInsertTuple(HashJoinTable hashtable, MinimalTuple tuple, uint32 hashvalue);
 /* ----------------------------------------------------------------
  *		ExecHash
  *
@@ -119,6 +122,13 @@ Node* MultiExecHash(HashState* node)
         if (ExecHashGetHashValue(hashtable, econtext, hashkeys, false, hashtable->keepNulls, &hashvalue)) {
             int bucketNumber;
 
+            if (hashtable->parallel_state != NULL) {
+                /* Parallel-aware hash join: insert into the shared table */
+                ExecParallelHashTableInsert(hashtable, slot, hashvalue);
+                hashtable->totalTuples += 1;
+                continue;
+            }
+
             bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
             if (bucketNumber != INVALID_SKEW_BUCKET_NO) {
                 /* It's a skew tuple, so put it into that hash table */
@@ -258,11 +268,8 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     int nbatch;
     int num_skew_mcvs;
     int log2_nbuckets;
-    int nkeys;
-    int i;
     int64 local_work_mem = SET_NODEMEM(node->plan.operatorMemKB[0], node->plan.dop);
     int64 max_mem = (node->plan.operatorMaxMem > 0) ? SET_NODEMEM(node->plan.operatorMaxMem, node->plan.dop) : 0;
-    ListCell* ho = NULL;
     MemoryContext oldcxt;
 
     /*
@@ -337,30 +344,10 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     hashtable->maxMem = max_mem * 1024L;
     hashtable->spreadNum = 0;
 
-    /*
-     * Get info about the hash functions to be used for each hash key. Also
-     * remember whether the join operators are strict.
-     */
-    nkeys = list_length(hashOperators);
-    hashtable->outer_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
-    hashtable->inner_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
-    hashtable->hashStrict = (bool*)palloc(nkeys * sizeof(bool));
-    i = 0;
-    foreach (ho, hashOperators) {
-        Oid hashop = lfirst_oid(ho);
-        Oid left_hashfn;
-        Oid right_hashfn;
+    hashtable->parallel_state = NULL;
+    hashtable->participant = 0;
 
-        if (!get_op_hash_functions(hashop, &left_hashfn, &right_hashfn))
-            ereport(ERROR,
-                (errcode(ERRCODE_UNDEFINED_FUNCTION),
-                    errmodule(MOD_EXECUTOR),
-                    errmsg("could not find hash function for hash operator %u", hashop)));
-        fmgr_info(left_hashfn, &hashtable->outer_hashfunctions[i]);
-        fmgr_info(right_hashfn, &hashtable->inner_hashfunctions[i]);
-        hashtable->hashStrict[i] = op_strict(hashop);
-        i++;
-    }
+    ExecHashTableInitHashFunctions(hashtable, hashOperators);
 
     /*
      * Create temporary memory contexts in which to keep the hashtable working
@@ -416,6 +403,233 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     return hashtable;
 }
 
+/*
+ * Get info about the hash functions to be used for each hash key. Also
+ * remember whether the join operators are strict.
+ */
+static void ExecHashTableInitHashFunctions(HashJoinTable hashtable, List* hashOperators)
+{
+    int nkeys = list_length(hashOperators);
+    int i = 0;
+    ListCell* ho = NULL;
+
+    hashtable->outer_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
+    hashtable->inner_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
+    hashtable->hashStrict = (bool*)palloc(nkeys * sizeof(bool));
+    foreach (ho, hashOperators) {
+        Oid hashop = lfirst_oid(ho);
+        Oid left_hashfn;
+        Oid right_hashfn;
+
+        if (!get_op_hash_functions(hashop, &left_hashfn, &right_hashfn))
+            ereport(ERROR,
+                (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("could not find hash function for hash operator %u", hashop)));
+        fmgr_info(left_hashfn, &hashtable->outer_hashfunctions[i]);
+        fmgr_info(right_hashfn, &hashtable->inner_hashfunctions[i]);
+        hashtable->hashStrict[i] = op_strict(hashop);
+        i++;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashTableCreate
+ *
+ *		create this participant's view of a shared hash table for a
+ *		parallel-aware hashjoin.  The buckets and the tuples of the current
+ *		batch belong to the ParallelHashJoinState; only the control block,
+ *		the hash functions and the batch file arrays are private.
+ * ----------------------------------------------------------------
+ */
+HashJoinTable ExecParallelHashTableCreate(Hash* node, List* hashOperators, bool keepNulls, ParallelHashJoinState* pstate)
+{
+    HashJoinTable hashtable;
+    int64 local_work_mem = SET_NODEMEM(node->plan.operatorMemKB[0], node->plan.dop);
+    MemoryContext oldcxt;
+
+    hashtable = (HashJoinTable)palloc0(sizeof(HashJoinTableData));
+    hashtable->nbuckets = pstate->nbuckets;
+    hashtable->log2_nbuckets = pstate->log2_nbuckets;
+    hashtable->buckets = pstate->buckets;
+    hashtable->keepNulls = keepNulls;
+    hashtable->skewEnabled = false;
+    hashtable->nbatch = pstate->nbatch;
+    hashtable->curbatch = 0;
+    hashtable->nbatch_original = pstate->nbatch;
+    hashtable->nbatch_outstart = pstate->nbatch;
+    /* the shared nbatch only grows through ExecParallelHashIncreaseNumBatches */
+    hashtable->growEnabled = false;
+    hashtable->totalTuples = 0;
+    hashtable->spaceAllowed = local_work_mem * 1024L;
+    hashtable->chunks = NULL;
+    hashtable->parallel_state = pstate;
+    hashtable->participant = IsParallelWorker() ? t_thrd.bgworker_cxt.ParallelWorkerNumber + 1 : 0;
+    hashtable->outerFileParticipant = -1;
+    Assert(hashtable->participant < pstate->nparticipants);
+
+    ExecHashTableInitHashFunctions(hashtable, hashOperators);
+
+    /* Private storage lives in hashCxt, the tuples in the shared batchCxt */
+    hashtable->hashCxt = AllocSetContextCreate(CurrentMemoryContext,
+        "HashTableContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        STANDARD_CONTEXT,
+        local_work_mem * 1024L);
+    hashtable->batchCxt = pstate->batchCxt;
+
+    if (pstate->nbatch > 1) {
+        oldcxt = MemoryContextSwitchTo(hashtable->hashCxt);
+        hashtable->innerBatchFile = (BufFile**)palloc0(pstate->nbatch * sizeof(BufFile*));
+        hashtable->outerBatchFile = (BufFile**)palloc0(pstate->nbatch * sizeof(BufFile*));
+        MemoryContextSwitchTo(oldcxt);
+    }
+
+    return hashtable;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashTableReset
+ *
+ *		empty the shared hash table before loading the next batch.  Only
+ *		one participant may call this, while all the others are waiting
+ *		at the build barrier.
+ * ----------------------------------------------------------------
+ */
+void ExecParallelHashTableReset(ParallelHashJoinState* pstate)
+{
+    MemoryContextReset(pstate->batchCxt);
+
+    errno_t rc = memset_s(pstate->buckets,
+        pstate->nbuckets * sizeof(HashJoinTuple), 0, pstate->nbuckets * sizeof(HashJoinTuple));
+    securec_check(rc, "\0", "\0");
+
+    pg_atomic_write_u32(&pstate->nextInnerFile, 0);
+    pg_atomic_write_u32(&pstate->nextOuterFile, 0);
+    pg_atomic_write_u64(&pstate->spaceUsed, 0);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashIncreaseNumBatches
+ *
+ *		double the number of batches of a parallel-aware hash table whose
+ *		current batch did not fit into spaceAllowed, and empty the buckets
+ *		so that ExecParallelHashRepartition can refill them.  Only the
+ *		elected participant may call this, while all the others are
+ *		waiting at the build barrier.
+ * ----------------------------------------------------------------
+ */
+void ExecParallelHashIncreaseNumBatches(ParallelHashJoinState* pstate)
+{
+    int nbatch = pstate->nbatch * 2;
+    Size countBytes = (Size)nbatch * pstate->nparticipants * sizeof(int);
+    Size oldBytes = countBytes / 2;
+    errno_t rc;
+
+    pg_atomic_write_u32(&pstate->growBatches, 0);
+    pg_atomic_write_u64(&pstate->ntuplesMoved, 0);
+    pg_atomic_write_u64(&pstate->spaceUsed, 0);
+
+    rc = memset_s(pstate->buckets,
+        pstate->nbuckets * sizeof(HashJoinTuple), 0, pstate->nbuckets * sizeof(HashJoinTuple));
+    securec_check(rc, "\0", "\0");
+
+    /* safety check to avoid overflow, the file counts live in hashCxt as well */
+    if (!pstate->growEnabled || (uint32)pstate->nbatch > INT_MAX / 2 ||
+        countBytes > SHARED_MEMORY_CONTEXT_MAX_SIZE / 4) {
+        pstate->growEnabled = false;
+        return;
+    }
+
+    pstate->innerFileCount = (int*)repalloc(pstate->innerFileCount, countBytes);
+    pstate->outerFileCount = (int*)repalloc(pstate->outerFileCount, countBytes);
+    rc = memset_s((char*)pstate->innerFileCount + oldBytes, countBytes - oldBytes, 0, countBytes - oldBytes);
+    securec_check(rc, "\0", "\0");
+    rc = memset_s((char*)pstate->outerFileCount + oldBytes, countBytes - oldBytes, 0, countBytes - oldBytes);
+    securec_check(rc, "\0", "\0");
+
+    pstate->nbatch = nbatch;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashRepartition
+ *
+ *		take over the number of batches chosen by the elected participant,
+ *		and put each tuple of this participant's chunks of the current
+ *		batch back into the emptied hash table or out to the file of its new
+ *		batch.  The chunks are freed as we go.
+ *
+ *		Returns the number of tuples moved to a later batch.
+ * ----------------------------------------------------------------
+ */
+uint64 ExecParallelHashRepartition(HashJoinTable hashtable)
+{
+    ParallelHashJoinState* pstate = hashtable->parallel_state;
+    int oldnbatch = hashtable->nbatch;
+    int nbatch = pstate->nbatch;
+    HashMemoryChunk oldchunks = hashtable->chunks;
+    uint64 nmoved = 0;
+    errno_t rc;
+
+    if (nbatch > oldnbatch) {
+        MemoryContext oldcxt = MemoryContextSwitchTo(hashtable->hashCxt);
+
+        if (hashtable->innerBatchFile == NULL) {
+            hashtable->innerBatchFile = (BufFile**)palloc0(nbatch * sizeof(BufFile*));
+            hashtable->outerBatchFile = (BufFile**)palloc0(nbatch * sizeof(BufFile*));
+        } else {
+            /* enlarge arrays and zero out added entries */
+            hashtable->innerBatchFile = (BufFile**)repalloc(hashtable->innerBatchFile, nbatch * sizeof(BufFile*));
+            hashtable->outerBatchFile = (BufFile**)repalloc(hashtable->outerBatchFile, nbatch * sizeof(BufFile*));
+            rc = memset_s(hashtable->innerBatchFile + oldnbatch,
+                (nbatch - oldnbatch) * sizeof(BufFile*),
+                0,
+                (nbatch - oldnbatch) * sizeof(BufFile*));
+            securec_check(rc, "\0", "\0");
+            rc = memset_s(hashtable->outerBatchFile + oldnbatch,
+                (nbatch - oldnbatch) * sizeof(BufFile*),
+                0,
+                (nbatch - oldnbatch) * sizeof(BufFile*));
+            securec_check(rc, "\0", "\0");
+        }
+
+        MemoryContextSwitchTo(oldcxt);
+        hashtable->nbatch = nbatch;
+    }
+
+    hashtable->chunks = NULL;
+    hashtable->spaceUsed = 0;
+
+    while (oldchunks != NULL) {
+        HashMemoryChunk nextchunk = oldchunks->next;
+        size_t idx = 0;
+
+        while (idx < oldchunks->used) {
+            HashJoinTuple hashTuple = (HashJoinTuple)(oldchunks->data + idx);
+            MinimalTuple tuple = HJTUPLE_MINTUPLE(hashTuple);
+            int bucketno;
+            int batchno;
+
+            ExecHashGetBucketAndBatch(hashtable, hashTuple->hashvalue, &bucketno, &batchno);
+            if (batchno != hashtable->curbatch)
+                nmoved++;
+            ExecParallelHashTableInsertTuple(hashtable, tuple, hashTuple->hashvalue);
+
+            idx += MAXALIGN(HJTUPLE_OVERHEAD + tuple->t_len);
+
+            /* allow this loop to be cancellable */
+            CHECK_FOR_INTERRUPTS();
+        }
+
+        pfree_ext(oldchunks);
+        oldchunks = nextchunk;
+    }
+
+    return nmoved;
+}
+
 /*
  * Compute max tuples which fit into a given mem
  *
@@ -752,13 +966,19 @@ void ExecHashTableDestroy(HashJoinTable hashtable)
         if (hashtable->outerBatchFile[i])
             BufFileClose(hashtable->outerBatchFile[i]);
     }
+    if (hashtable->overflowFile != NULL)
+        BufFileClose(hashtable->overflowFile);
 
     /* Free the unused buffers */
     pfree_ext(hashtable->outer_hashfunctions);
     pfree_ext(hashtable->inner_hashfunctions);
     pfree_ext(hashtable->hashStrict);
 
-    /* Release working memory (batchCxt is a child, so it goes away too) */
+    /*
+     * Release working memory (batchCxt is a child, so it goes away too).  A
+     * parallel-aware hash table's batchCxt and buckets are shared and are
+     * released together with the parallel context instead.
+     */
     MemoryContextDelete(hashtable->hashCxt);
 
     /* And drop the control block */
@@ -1040,6 +1260,113 @@ void ExecHashTableInsert(
     }
 }
 
+/*
+ * ExecParallelHashTupleFits
+ *		check that a tuple of the current batch still fits into the shared
+ *		budget of the batch.
+ *
+ * Space is claimed a chunk at a time, in the same way dense_alloc allocates
+ * it.  The first participant to run out of room asks for more batches, and
+ * from then on nobody claims any more until the batch has been split.
+ */
+static bool ExecParallelHashTupleFits(HashJoinTable hashtable, Size size)
+{
+    ParallelHashJoinState* pstate = hashtable->parallel_state;
+    Size chunkSize;
+
+    size = MAXALIGN(size);
+    if (size <= HASH_CHUNK_THRESHOLD && hashtable->chunks != NULL &&
+        hashtable->chunks->maxlen - hashtable->chunks->used >= size)
+        return true;
+
+    chunkSize = offsetof(HashMemoryChunkData, data) + (size > HASH_CHUNK_THRESHOLD ? size : HASH_CHUNK_SIZE);
+
+    /* Splitting does not help any more, we have to gut it out */
+    if (!pstate->growEnabled) {
+        (void)pg_atomic_fetch_add_u64(&pstate->spaceUsed, chunkSize);
+        return true;
+    }
+
+    if (pg_atomic_read_u32(&pstate->growBatches) != 0)
+        return false;
+
+    if (pg_atomic_add_fetch_u64(&pstate->spaceUsed, chunkSize) > pstate->spaceAllowed) {
+        (void)pg_atomic_fetch_sub_u64(&pstate->spaceUsed, chunkSize);
+        pg_atomic_write_u32(&pstate->growBatches, 1);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * ExecParallelHashTableInsertTuple
+ *		insert a tuple into the shared hash table of a parallel-aware
+ *		hashjoin, or into this participant's batch file of a later batch.
+ *
+ * Several participants insert concurrently, so tuples are pushed onto the
+ * bucket lists with compare-and-swap.  The tuple memory comes from chunks
+ * of the shared batch context that are private to this participant.  A
+ * tuple of the current batch that does not fit goes to the overflow file,
+ * until the batch has been split by ExecParallelHashRepartition.
+ */
+static void ExecParallelHashTableInsertTuple(HashJoinTable hashtable, MinimalTuple tuple, uint32 hashvalue)
+{
+    int bucketno;
+    int batchno;
+    errno_t errorno = EOK;
+
+    ExecHashGetBucketAndBatch(hashtable, hashvalue, &bucketno, &batchno);
+
+    if (batchno == hashtable->curbatch) {
+        HashJoinTuple hashTuple;
+        int hashTupleSize = HJTUPLE_OVERHEAD + tuple->t_len;
+        volatile uintptr_t* bucket = (volatile uintptr_t*)&hashtable->buckets[bucketno];
+        uintptr_t head;
+
+        if (!ExecParallelHashTupleFits(hashtable, hashTupleSize)) {
+            ExecHashJoinSaveTuple(tuple, hashvalue, &hashtable->overflowFile);
+
+            *hashtable->spill_size += sizeof(uint32) + tuple->t_len;
+            pgstat_increase_session_spill_size(sizeof(uint32) + tuple->t_len);
+            return;
+        }
+
+        hashTuple = (HashJoinTuple)dense_alloc(hashtable, hashTupleSize);
+        hashTuple->hashvalue = hashvalue;
+        errorno = memcpy_s(HJTUPLE_MINTUPLE(hashTuple), tuple->t_len, tuple, tuple->t_len);
+        securec_check(errorno, "\0", "\0");
+        HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(hashTuple));
+
+        /* Push it onto the front of the bucket's list */
+        head = pg_atomic_read_uintptr(bucket);
+        do {
+            hashTuple->next = (HashJoinTuple)head;
+        } while (!pg_atomic_compare_exchange_uintptr(bucket, &head, (uintptr_t)hashTuple));
+
+        hashtable->spaceUsed += hashTupleSize;
+        if (hashtable->spaceUsed > hashtable->spacePeak) {
+            hashtable->spacePeak = hashtable->spaceUsed;
+        }
+    } else {
+        Assert(batchno > hashtable->curbatch);
+        ExecParallelHashJoinSaveTuple(hashtable, tuple, hashvalue, batchno, true);
+
+        *hashtable->spill_size += sizeof(uint32) + tuple->t_len;
+        pgstat_increase_session_spill_size(sizeof(uint32) + tuple->t_len);
+    }
+}
+
+/*
+ * ExecParallelHashTableInsert
+ *		insert the tuple of a slot into a parallel-aware hash table, see
+ *		ExecParallelHashTableInsertTuple.
+ */
+void ExecParallelHashTableInsert(HashJoinTable hashtable, TupleTableSlot* slot, uint32 hashvalue)
+{
+    ExecParallelHashTableInsertTuple(hashtable, ExecFetchSlotMinimalTuple(slot), hashvalue);
+}
+
 /*
  * ExecHashGetHashValue
  *		Compute the hash value for a tuple
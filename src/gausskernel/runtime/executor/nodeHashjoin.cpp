@@ -16,6 +16,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/parallel.h"
 #include "executor/executor.h"
 #include "executor/execStream.h"
 #include "executor/hashjoin.h"
@@ -23,7 +24,10 @@
 #include "executor/nodeHashjoin.h"
 #include "miscadmin.h"
 #include "utils/anls_opt.h"
+#include "utils/dynahash.h"
+#include "utils/guc.h"
 #include "utils/memutils.h"
+#include "utils/selfuncs.h"
 
 /*
  * States of the ExecHashJoin state machine
@@ -44,6 +48,14 @@ static TupleTableSlot* ExecHashJoinOuterGetTuple(PlanState* outerNode, HashJoinS
 static TupleTableSlot* ExecHashJoinGetSavedTuple(
     HashJoinState* hjstate, BufFile* file, uint32* hashvalue, TupleTableSlot* tupleSlot);
 static bool ExecHashJoinNewBatch(HashJoinState* hjstate);
+static bool ExecParallelHashJoinBuild(HashJoinState* hjstate);
+static TupleTableSlot* ExecParallelHashJoinOuterGetTuple(HashJoinState* hjstate, uint32* hashvalue);
+static bool ExecParallelHashJoinNewBatch(HashJoinState* hjstate);
+static void ExecParallelHashJoinDetach(HashJoinState* hjstate);
+static void ExecParallelHashJoinResetShared(ParallelHashJoinState* pstate);
+static void ExecParallelHashJoinGrowBatches(HashJoinState* hjstate);
+static void ExecHashJoinPushDownFilter(HashJoinState* hjstate);
+static void ExecHashJoinClearFilter(HashJoinState* hjstate);
 
 /* ----------------------------------------------------------------
  *		ExecHashJoin
@@ -113,6 +125,24 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                  * First time through: build hash table for inner relation.
                  */
                 Assert(hashtable == NULL);
+
+                /* Filters of a previous hash table must not reach the outer scans. */
+                ExecHashJoinClearFilter(node);
+
+                /*
+                 * A parallel-aware join builds one shared hash table together
+                 * with the other participants, or attaches to the one they
+                 * have already built.
+                 */
+                if (node->hj_ParallelState != NULL) {
+                    if (!ExecParallelHashJoinBuild(node))
+                        return NULL;
+                    hashtable = node->hj_HashTable;
+                    node->hj_OuterNotEmpty = false;
+                    node->hj_JoinState = HJ_NEED_NEW_OUTER;
+                    continue;
+                }
+
                 /*
                  * If the outer relation is completely empty, and it's not
                  * right/full join, we can quit without building the hash
@@ -211,6 +241,9 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                     return NULL;
                 }
 
+                /* Let the scans on the outer side skip rows without a match. */
+                ExecHashJoinPushDownFilter(node);
+
                 /*
                  * need to remember whether nbatch has increased since we
                  * began scanning the outer relation
@@ -267,7 +300,10 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                      */
                     Assert(batchno > hashtable->curbatch);
                     MinimalTuple tuple = ExecFetchSlotMinimalTuple(outerTupleSlot);
-                    ExecHashJoinSaveTuple(tuple, hashvalue, &hashtable->outerBatchFile[batchno]);
+                    if (hashtable->parallel_state != NULL)
+                        ExecParallelHashJoinSaveTuple(hashtable, tuple, hashvalue, batchno, false);
+                    else
+                        ExecHashJoinSaveTuple(tuple, hashvalue, &hashtable->outerBatchFile[batchno]);
                     *hashtable->spill_size += sizeof(uint32) + tuple->t_len;
                     pgstat_increase_session_spill_size(sizeof(uint32) + tuple->t_len);
 
@@ -332,7 +368,12 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                         if (jointype == JOIN_RIGHT_ANTI || jointype == JOIN_RIGHT_ANTI_FULL)
                             continue;
                     } else {
-                        HeapTupleHeaderSetMatch(HJTUPLE_MINTUPLE(node->hj_CurTuple));
+                        /*
+                         * Match flags are only read by right/full joins, which are
+                         * never parallel-aware, so leave the shared tuples alone.
+                         */
+                        if (node->hj_ParallelState == NULL)
+                            HeapTupleHeaderSetMatch(HJTUPLE_MINTUPLE(node->hj_CurTuple));
 
                         /* Anti join: we never return a matched tuple */
                         if (jointype == JOIN_ANTI || jointype == JOIN_LEFT_ANTI_FULL) {
@@ -432,7 +473,8 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                 /*
                  * Try to advance to next batch.  Done if there are no more.
                  */
-                if (!ExecHashJoinNewBatch(node)) {
+                if (!(node->hj_ParallelState != NULL ? ExecParallelHashJoinNewBatch(node)
+                                                     : ExecHashJoinNewBatch(node))) {
                     ExecEarlyFree(outerPlanState(node));
                     EARLY_FREE_LOG(elog(LOG,
                         "Early Free: HashJoin Probe is done"
@@ -608,6 +650,18 @@ HashJoinState* ExecInitHashJoin(HashJoin* node, EState* estate, int eflags)
     hjstate->hj_JoinState = HJ_BUILD_HASHTABLE;
     hjstate->hj_MatchedOuter = false;
     hjstate->hj_OuterNotEmpty = false;
+    hjstate->hj_ParallelState = NULL;
+    hjstate->hj_ParallelAttached = false;
+
+    /* runtime bloom filters for the outer side, see ExecHashJoinPushDownFilter */
+    hjstate->hj_BloomFilterCxt = NULL;
+    if (node->join.plan.var_list != NIL) {
+        hjstate->hj_BloomFilterCxt = AllocSetContextCreate(CurrentMemoryContext,
+            "HashJoinBloomFilter",
+            ALLOCSET_DEFAULT_MINSIZE,
+            ALLOCSET_DEFAULT_INITSIZE,
+            ALLOCSET_DEFAULT_MAXSIZE);
+    }
 
     return hjstate;
 }
@@ -620,6 +674,9 @@ HashJoinState* ExecInitHashJoin(HashJoin* node, EState* estate, int eflags)
  */
 void ExecEndHashJoin(HashJoinState* node)
 {
+    /* Stop participating in a parallel-aware join, if we still are */
+    ExecParallelHashJoinDetach(node);
+
     /*
      * Free hash table
      */
@@ -628,6 +685,8 @@ void ExecEndHashJoin(HashJoinState* node)
         node->hj_HashTable = NULL;
     }
 
+    ExecHashJoinClearFilter(node);
+
     /*
      * Free the exprcontext
      */
@@ -702,7 +761,12 @@ static TupleTableSlot* ExecHashJoinOuterGetTuple(PlanState* outerNode, HashJoinS
             slot = ExecProcNode(outerNode);
         }
     } else if (curbatch < hashtable->nbatch) {
-        BufFile* file = hashtable->outerBatchFile[curbatch];
+        BufFile* file = NULL;
+
+        if (hashtable->parallel_state != NULL)
+            return ExecParallelHashJoinOuterGetTuple(hjstate, hashvalue);
+
+        file = hashtable->outerBatchFile[curbatch];
 
         /*
          * In outer-join cases, we could get here even though the batch file
@@ -975,7 +1039,24 @@ void ExecReScanHashJoin(HashJoinState* node)
      * inner subnode, then we can just re-use the existing hash table without
      * rebuilding it.
      */
-    if (node->hj_HashTable != NULL) {
+    if (node->hj_ParallelState != NULL) {
+        /*
+         * A parallel-aware join is only rescanned by the leader of a Gather
+         * whose workers have all finished, so the shared hash table can be
+         * reset here and built again by the next set of workers.
+         */
+        ExecParallelHashJoinDetach(node);
+        if (node->hj_HashTable != NULL) {
+            ExecHashTableDestroy(node->hj_HashTable);
+            node->hj_HashTable = NULL;
+            ((HashState*)innerPlanState(node))->hashtable = NULL;
+        }
+        ExecParallelHashJoinResetShared(node->hj_ParallelState);
+        node->hj_JoinState = HJ_BUILD_HASHTABLE;
+
+        if (node->js.ps.righttree->chgParam == NULL)
+            ExecReScan(node->js.ps.righttree);
+    } else if (node->hj_HashTable != NULL) {
         if (!node->js.ps.plan->ispwj && node->hj_HashTable->nbatch == 1 && node->js.ps.righttree->chgParam == NULL &&
             !node->hj_rebuildHashtable && node->js.jointype != JOIN_RIGHT_SEMI &&
             node->js.jointype != JOIN_RIGHT_ANTI) {
@@ -1059,6 +1140,9 @@ void ExecEarlyFreeHashJoin(HashJoinState* node)
     if (plan_state->earlyFreed)
         return;
 
+    /* Stop participating in a parallel-aware join, if we still are */
+    ExecParallelHashJoinDetach(node);
+
     /*
      * Free hash table
      */
@@ -1130,3 +1214,633 @@ void ExecReSetHashJoin(HashJoinState* node)
     if (node->js.ps.lefttree->chgParam == NULL)
         ExecReSetRecursivePlanTree(node->js.ps.lefttree);
 }
+
+/* ----------------------------------------------------------------
+ *		ExecHashJoinInitializeDSM
+ *
+ *		Set up the shared state of a parallel-aware hash join.  The hash
+ *		table is sized once here for the whole inner relation and the
+ *		combined work_mem of all participants, see executor/hashjoin.h.
+ * ----------------------------------------------------------------
+ */
+void ExecHashJoinInitializeDSM(HashJoinState* node, ParallelContext* pcxt, int nodeid)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)pcxt->seg;
+    Hash* hash = (Hash*)innerPlan(node->js.ps.plan);
+    Plan* innerNode = outerPlan(hash);
+    int nparticipants = pcxt->nworkers + 1;
+    int64 local_work_mem = SET_NODEMEM(hash->plan.operatorMemKB[0], hash->plan.dop);
+    int64 total_work_mem = Min(local_work_mem * nparticipants, (int64)MAX_KILOBYTES);
+    int nbuckets;
+    int nbatch;
+    int num_skew_mcvs;
+    Size bucket_bytes;
+    Size batch_bytes;
+    ParallelHashJoinState* pstate = NULL;
+
+    /* Partial plans estimate rows per participant */
+    ExecChooseHashTableSize(PLAN_LOCAL_ROWS(innerNode) * nparticipants,
+        innerNode->plan_width,
+        false,
+        &nbuckets,
+        &nbatch,
+        &num_skew_mcvs,
+        (int4)total_work_mem);
+
+    /* Here we can't use palloc, cause we have switch to old memctx in ExecInitParallelPlan */
+    pstate = (ParallelHashJoinState*)MemoryContextAllocZero(cxt->memCtx, sizeof(ParallelHashJoinState));
+    pstate->plan_node_id = node->js.ps.plan->plan_node_id;
+    pstate->nparticipants = nparticipants;
+    pstate->nbuckets = nbuckets;
+    pstate->log2_nbuckets = my_log2(nbuckets);
+    pstate->nbatch = nbatch;
+    pstate->growEnabled = true;
+    Assert(nbuckets == (1 << pstate->log2_nbuckets));
+
+    BarrierInit(&pstate->build_barrier, 0);
+    pg_atomic_init_u64(&pstate->totalTuples, 0);
+    pg_atomic_init_u32(&pstate->nextInnerFile, 0);
+    pg_atomic_init_u32(&pstate->nextOuterFile, 0);
+    pg_atomic_init_u64(&pstate->spaceUsed, 0);
+    pg_atomic_init_u32(&pstate->growBatches, 0);
+    pg_atomic_init_u64(&pstate->ntuplesMoved, 0);
+
+    /*
+     * The shared contexts need an explicit limit, the default one of shared
+     * contexts is far too small for a hash table.  A batch is split once its
+     * tuples outgrow spaceAllowed, the limit of batchCxt only leaves room for
+     * the chunks the participants are still filling and for a batch that
+     * cannot be split any further.  The file counts grow with nbatch, see
+     * ExecParallelHashIncreaseNumBatches.
+     */
+    bucket_bytes = (Size)nbuckets * sizeof(HashJoinTuple);
+    batch_bytes = Max((Size)total_work_mem * 1024L * 2, (Size)SHARED_MEMORY_CONTEXT_MAX_SIZE);
+    pstate->spaceAllowed = (Size)total_work_mem * 1024L;
+    pstate->hashCxt = AllocSetContextCreate(cxt->memCtx,
+        "ParallelHashTableContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        SHARED_CONTEXT,
+        bucket_bytes + SHARED_MEMORY_CONTEXT_MAX_SIZE);
+    pstate->batchCxt = AllocSetContextCreate(pstate->hashCxt,
+        "ParallelHashBatchContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        SHARED_CONTEXT,
+        batch_bytes);
+
+    pstate->buckets = (HashJoinTuple*)MemoryContextAllocZero(pstate->hashCxt, bucket_bytes);
+    pstate->innerFileCount = (int*)MemoryContextAllocZero(pstate->hashCxt, nbatch * nparticipants * sizeof(int));
+    pstate->outerFileCount = (int*)MemoryContextAllocZero(pstate->hashCxt, nbatch * nparticipants * sizeof(int));
+
+    /*
+     * The batch files go away when the leader detaches from the parallel
+     * context.  Even a single batch may have to be split later on.
+     */
+    SharedFileSetInit(&pstate->fileset, pcxt->seg);
+
+    cxt->pwCtx->queryInfo.phjstate[nodeid] = pstate;
+    node->hj_ParallelState = pstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashJoinInitializeWorker
+ *
+ *		Find the shared state of a parallel-aware hash join.
+ * ----------------------------------------------------------------
+ */
+void ExecHashJoinInitializeWorker(HashJoinState* node, void* context)
+{
+    ParallelHashJoinState* pstate = NULL;
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)context;
+
+    for (int i = 0; i < cxt->pwCtx->queryInfo.phj_num; i++) {
+        if (node->js.ps.plan->plan_node_id == cxt->pwCtx->queryInfo.phjstate[i]->plan_node_id) {
+            pstate = cxt->pwCtx->queryInfo.phjstate[i];
+            break;
+        }
+    }
+
+    if (pstate == NULL) {
+        ereport(ERROR, (errmsg("could not find plan info, plan node id:%d", node->js.ps.plan->plan_node_id)));
+    }
+
+    node->hj_ParallelState = pstate;
+}
+
+/*
+ * ExecParallelHashJoinResetShared
+ *		forget everything about the previous scan, so that the next set of
+ *		workers starts building from scratch.  Only the leader calls this,
+ *		when no worker is running.
+ */
+static void ExecParallelHashJoinResetShared(ParallelHashJoinState* pstate)
+{
+    Size count_bytes = pstate->nbatch * pstate->nparticipants * sizeof(int);
+    errno_t rc;
+
+    /* Keep the number of batches the previous scan ended up with */
+    BarrierInit(&pstate->build_barrier, 0);
+    pg_atomic_write_u64(&pstate->totalTuples, 0);
+    pg_atomic_write_u32(&pstate->growBatches, 0);
+    pstate->growEnabled = true;
+    ExecParallelHashTableReset(pstate);
+
+    rc = memset_s(pstate->innerFileCount, count_bytes, 0, count_bytes);
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(pstate->outerFileCount, count_bytes, 0, count_bytes);
+    securec_check(rc, "\0", "\0");
+
+    SharedFileSetDeleteAll(&pstate->fileset);
+}
+
+/*
+ * ExecParallelHashJoinFileName
+ *		name of the seq'th shared batch file written by a participant
+ */
+static void ExecParallelHashJoinFileName(char* name, Size len, bool inner, int batchno, int participant, int seq)
+{
+    int rc = snprintf_s(name, len, len - 1, "%c%d.p%d.%d", inner ? 'i' : 'o', batchno, participant, seq);
+    securec_check_ss(rc, "", "");
+}
+
+/*
+ * ExecParallelHashJoinSaveTuple
+ *		save a tuple to this participant's shared batch file, creating a
+ *		new file and advertising it to the others if none is open.
+ */
+void ExecParallelHashJoinSaveTuple(
+    HashJoinTable hashtable, MinimalTuple tuple, uint32 hashvalue, int batchno, bool inner)
+{
+    ParallelHashJoinState* pstate = hashtable->parallel_state;
+    BufFile** fileptr = inner ? &hashtable->innerBatchFile[batchno] : &hashtable->outerBatchFile[batchno];
+
+    if (*fileptr == NULL) {
+        char name[MAXPGPATH];
+        int* count = inner ? pstate->innerFileCount : pstate->outerFileCount;
+        int index = PHJ_FILE_INDEX(pstate, batchno, hashtable->participant);
+
+        ExecParallelHashJoinFileName(name, MAXPGPATH, inner, batchno, hashtable->participant, count[index]);
+        *fileptr = BufFileCreateShared(&pstate->fileset, name);
+        count[index]++;
+    }
+
+    ExecHashJoinSaveTuple(tuple, hashvalue, fileptr);
+}
+
+/*
+ * ExecParallelHashJoinCloseFiles
+ *		close the batch files this participant has written, which makes
+ *		them readable by everybody else.
+ */
+static void ExecParallelHashJoinCloseFiles(HashJoinTable hashtable, BufFile** files)
+{
+    for (int i = 1; i < hashtable->nbatch; i++) {
+        if (files[i] != NULL) {
+            BufFileClose(files[i]);
+            files[i] = NULL;
+        }
+    }
+}
+
+/*
+ * ExecParallelHashJoinDetach
+ *		stop taking part in the shared hash join
+ */
+static void ExecParallelHashJoinDetach(HashJoinState* hjstate)
+{
+    if (hjstate->hj_ParallelAttached) {
+        (void)BarrierDetach(&hjstate->hj_ParallelState->build_barrier);
+        hjstate->hj_ParallelAttached = false;
+    }
+}
+
+/*
+ * ExecParallelHashJoinBuild
+ *		attach to the shared hash table and help to build it, if it is not
+ *		built yet.
+ *
+ * Returns false if this participant has nothing to do, either because it
+ * arrived after the first batch was finished or because the inner relation
+ * is empty.
+ */
+static bool ExecParallelHashJoinBuild(HashJoinState* hjstate)
+{
+    ParallelHashJoinState* pstate = hjstate->hj_ParallelState;
+    HashState* hashNode = (HashState*)innerPlanState(hjstate);
+    HashJoinTable hashtable;
+    MemoryContext oldcxt;
+    int phase;
+
+    oldcxt = MemoryContextSwitchTo(hashNode->ps.nodeContext);
+    hashtable = ExecParallelHashTableCreate(
+        (Hash*)hashNode->ps.plan, hjstate->hj_HashOperators, HJ_FILL_INNER(hjstate) || hjstate->js.nulleqqual != NIL,
+        pstate);
+    MemoryContextSwitchTo(oldcxt);
+    hashtable->spill_size = &hashNode->spill_size;
+    hjstate->hj_HashTable = hashtable;
+    hashNode->hashtable = hashtable;
+
+    phase = BarrierAttach(&pstate->build_barrier);
+    hjstate->hj_ParallelAttached = true;
+
+    if (phase == PHJ_PHASE_BUILD) {
+        WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
+        hashNode->ps.hbktScanSlot.currSlot = hjstate->js.ps.hbktScanSlot.currSlot;
+        (void)MultiExecProcNode((PlanState*)hashNode);
+
+        if (hashtable->nbatch > 1)
+            ExecParallelHashJoinCloseFiles(hashtable, hashtable->innerBatchFile);
+        (void)pg_atomic_fetch_add_u64(&pstate->totalTuples, (uint64)hashtable->totalTuples);
+
+        /* wait until the whole inner relation has been hashed */
+        (void)BarrierArriveAndWait(&pstate->build_barrier);
+        ExecParallelHashJoinGrowBatches(hjstate);
+        (void)pgstat_report_waitstatus(oldStatus);
+
+        /* Early free right tree after hash table built */
+        ExecEarlyFree((PlanState*)hashNode);
+    } else if (phase == PHJ_PHASE_PROBE_FIRST) {
+        /*
+         * The build is over, but the table may still have to be split.  We
+         * have no tuples of our own, so that costs us only the waiting.
+         */
+        ExecParallelHashJoinGrowBatches(hjstate);
+    } else {
+        /* Too late, the others are already past the first batch */
+        ExecParallelHashJoinDetach(hjstate);
+        return false;
+    }
+
+    /*
+     * If the inner relation is completely empty, and we're not doing a left
+     * outer join, we can quit without scanning the outer relation.
+     */
+    if (pg_atomic_read_u64(&pstate->totalTuples) == 0 && !HJ_FILL_OUTER(hjstate)) {
+        ExecParallelHashJoinDetach(hjstate);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * ExecParallelHashJoinOuterGetTuple
+ *		get the next outer tuple of the current batch (never the first one)
+ *		from the outer batch files written by all participants.
+ *
+ * Each file is claimed and read by exactly one participant, and deleted as
+ * soon as it has been read.
+ */
+static TupleTableSlot* ExecParallelHashJoinOuterGetTuple(HashJoinState* hjstate, uint32* hashvalue)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    ParallelHashJoinState* pstate = hashtable->parallel_state;
+    int curbatch = hashtable->curbatch;
+    char name[MAXPGPATH];
+
+    for (;;) {
+        BufFile* file = hashtable->outerBatchFile[curbatch];
+        TupleTableSlot* slot = NULL;
+
+        if (file == NULL) {
+            int participant = hashtable->outerFileParticipant;
+            int seq = hashtable->outerFileSeq + 1;
+
+            /* The next file of the same participant, or else claim the next participant */
+            while (participant < 0 || seq >= pstate->outerFileCount[PHJ_FILE_INDEX(pstate, curbatch, participant)]) {
+                participant = (int)pg_atomic_fetch_add_u32(&pstate->nextOuterFile, 1);
+                if (participant >= pstate->nparticipants)
+                    return NULL; /* End of this batch */
+                seq = 0;
+            }
+
+            ExecParallelHashJoinFileName(name, MAXPGPATH, false, curbatch, participant, seq);
+            hashtable->outerBatchFile[curbatch] = BufFileOpenShared(&pstate->fileset, name);
+            hashtable->outerFileParticipant = participant;
+            hashtable->outerFileSeq = seq;
+            continue;
+        }
+
+        slot = ExecHashJoinGetSavedTuple(hjstate, file, hashvalue, hjstate->hj_OuterTupleSlot);
+        if (!TupIsNull(slot))
+            return slot;
+
+        BufFileClose(file);
+        hashtable->outerBatchFile[curbatch] = NULL;
+        ExecParallelHashJoinFileName(
+            name, MAXPGPATH, false, curbatch, hashtable->outerFileParticipant, hashtable->outerFileSeq);
+        BufFileDeleteShared(&pstate->fileset, name);
+    }
+}
+
+/*
+ * ExecParallelHashJoinLoadBatch
+ *		load the current batch into the shared hash table from the inner
+ *		batch files written by all participants.
+ *
+ * Tuples written before the last doubling of nbatch may belong to a later
+ * batch by now, they are written out to this participant's files again.
+ */
+static void ExecParallelHashJoinLoadBatch(HashJoinState* hjstate)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    ParallelHashJoinState* pstate = hashtable->parallel_state;
+    int curbatch = hashtable->curbatch;
+    char name[MAXPGPATH];
+    TupleTableSlot* slot = NULL;
+    uint32 hashvalue;
+
+    for (;;) {
+        int participant = (int)pg_atomic_fetch_add_u32(&pstate->nextInnerFile, 1);
+        int nfiles;
+
+        if (participant >= pstate->nparticipants)
+            break;
+
+        nfiles = pstate->innerFileCount[PHJ_FILE_INDEX(pstate, curbatch, participant)];
+        for (int seq = 0; seq < nfiles; seq++) {
+            BufFile* file = NULL;
+
+            ExecParallelHashJoinFileName(name, MAXPGPATH, true, curbatch, participant, seq);
+            file = BufFileOpenShared(&pstate->fileset, name);
+            while ((slot = ExecHashJoinGetSavedTuple(hjstate, file, &hashvalue, hjstate->hj_HashTupleSlot)))
+                ExecParallelHashTableInsert(hashtable, slot, hashvalue);
+            BufFileClose(file);
+            BufFileDeleteShared(&pstate->fileset, name);
+        }
+    }
+
+    ExecParallelHashJoinCloseFiles(hashtable, hashtable->innerBatchFile);
+}
+
+/*
+ * ExecParallelHashJoinNextBatch
+ *		find the first batch starting at batchno that has to be processed.
+ *
+ * Every participant sees the same batch files once the previous batch is
+ * finished, so they all skip the same batches without coordinating.
+ */
+static int ExecParallelHashJoinNextBatch(HashJoinState* hjstate, int batchno)
+{
+    ParallelHashJoinState* pstate = hjstate->hj_ParallelState;
+
+    for (; batchno < pstate->nbatch; batchno++) {
+        bool hasInner = false;
+        bool hasOuter = false;
+
+        for (int i = 0; i < pstate->nparticipants; i++) {
+            hasInner = hasInner || pstate->innerFileCount[PHJ_FILE_INDEX(pstate, batchno, i)] > 0;
+            hasOuter = hasOuter || pstate->outerFileCount[PHJ_FILE_INDEX(pstate, batchno, i)] > 0;
+        }
+
+        /* In a left outer join, we have to process outer batches even if the inner batch is empty */
+        if (hasOuter && (hasInner || HJ_FILL_OUTER(hjstate)))
+            break;
+    }
+
+    return batchno;
+}
+
+/*
+ * ExecParallelHashJoinNewBatch
+ *		switch to the next batch of a parallel-aware hash join.
+ *
+ * Returns true if successful, false if there is nothing left for this
+ * participant to do.
+ */
+static bool ExecParallelHashJoinNewBatch(HashJoinState* hjstate)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    ParallelHashJoinState* pstate = hjstate->hj_ParallelState;
+    Barrier* barrier = &pstate->build_barrier;
+    int curbatch = hashtable->curbatch;
+    bool elected = false;
+
+    if (hashtable->nbatch == 1) {
+        ExecParallelHashJoinDetach(hjstate);
+        return false;
+    }
+
+    /* Outer tuples of later batches may be written while probing any batch */
+    ExecParallelHashJoinCloseFiles(hashtable, hashtable->outerBatchFile);
+
+    if (curbatch == 0) {
+        if (!IsParallelWorker()) {
+            /*
+             * The leader must not wait for the workers, they may be blocked
+             * on a full tuple queue that only the leader drains.  It carries
+             * on with the remaining batches only if it is alone.
+             */
+            if (!BarrierArriveAndDetachExceptLast(barrier)) {
+                hjstate->hj_ParallelAttached = false;
+                return false;
+            }
+            elected = true;
+        } else {
+            elected = BarrierArriveAndWait(barrier);
+        }
+    } else {
+        elected = BarrierArriveAndWait(barrier);
+    }
+
+    /* Everybody has finished the previous batch, so all batch files are complete */
+    curbatch = ExecParallelHashJoinNextBatch(hjstate, curbatch + 1);
+    if (curbatch >= hashtable->nbatch) {
+        ExecParallelHashJoinDetach(hjstate);
+        return false;
+    }
+
+    /* One participant empties the table while the others wait */
+    if (elected)
+        ExecParallelHashTableReset(pstate);
+    (void)BarrierArriveAndWait(barrier);
+
+    /* Forget the chunks, the memory was freed by the reset above */
+    hashtable->curbatch = curbatch;
+    hashtable->chunks = NULL;
+    hashtable->spaceUsed = 0;
+    hashtable->outerFileParticipant = -1;
+
+    ExecParallelHashJoinLoadBatch(hjstate);
+
+    /* wait until the whole batch is loaded before probing it */
+    (void)BarrierArriveAndWait(barrier);
+    ExecParallelHashJoinGrowBatches(hjstate);
+
+    return true;
+}
+
+/*
+ * ExecParallelHashJoinRepartition
+ *		split this participant's share of the current batch after nbatch
+ *		has been doubled: its chunks, and then the tuples that it had to
+ *		keep aside in its overflow file.
+ */
+static void ExecParallelHashJoinRepartition(HashJoinState* hjstate)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    ParallelHashJoinState* pstate = hjstate->hj_ParallelState;
+    BufFile* overflow = hashtable->overflowFile;
+    TupleTableSlot* slot = NULL;
+    uint32 hashvalue;
+    uint64 nmoved;
+
+    /* Tuples that still do not fit go to a new overflow file */
+    hashtable->overflowFile = NULL;
+    nmoved = ExecParallelHashRepartition(hashtable);
+
+    if (overflow != NULL) {
+        if (BufFileSeek(overflow, 0, 0L, SEEK_SET))
+            ereport(ERROR,
+                (errcode_for_file_access(), errmsg("could not rewind hash-join overflow temporary file: %m")));
+
+        while ((slot = ExecHashJoinGetSavedTuple(hjstate, overflow, &hashvalue, hjstate->hj_HashTupleSlot))) {
+            int bucketno;
+            int batchno;
+
+            ExecHashGetBucketAndBatch(hashtable, hashvalue, &bucketno, &batchno);
+            if (batchno != hashtable->curbatch)
+                nmoved++;
+            ExecParallelHashTableInsert(hashtable, slot, hashvalue);
+        }
+        BufFileClose(overflow);
+    }
+
+    ExecParallelHashJoinCloseFiles(hashtable, hashtable->innerBatchFile);
+    (void)pg_atomic_fetch_add_u64(&pstate->ntuplesMoved, nmoved);
+}
+
+/*
+ * ExecParallelHashJoinGrowBatches
+ *		split the current batch until it fits into spaceAllowed.
+ *
+ * Called by every attached participant right after the barrier that ends
+ * the loading of a batch, when nobody is inserting and growBatches can be
+ * read safely.  Each doubling takes three phases: everybody has seen the
+ * request before the elected participant doubles nbatch, everybody then
+ * repartitions its own tuples, and the batch is checked again.
+ */
+static void ExecParallelHashJoinGrowBatches(HashJoinState* hjstate)
+{
+    ParallelHashJoinState* pstate = hjstate->hj_ParallelState;
+    Barrier* barrier = &pstate->build_barrier;
+
+    while (pg_atomic_read_u32(&pstate->growBatches) != 0) {
+        if (BarrierArriveAndWait(barrier))
+            ExecParallelHashIncreaseNumBatches(pstate);
+        (void)BarrierArriveAndWait(barrier);
+
+        ExecParallelHashJoinRepartition(hjstate);
+
+        /*
+         * If the split moved none of the tuples out, we have enough tuples of
+         * identical hash values to overflow spaceAllowed, and splitting again
+         * will not help.  Load the rest of the batch regardless.
+         */
+        if (BarrierArriveAndWait(barrier) && pg_atomic_read_u64(&pstate->ntuplesMoved) == 0)
+            pstate->growEnabled = false;
+    }
+}
+
+/*
+ * ExecHashJoinPushDownFilter
+ *
+ *		Build a bloom filter over each inner join key listed in the join's
+ *		var_list (see set_bloomfilter) and publish it in the executor state,
+ *		where the scans on the outer side look it up by filter index.
+ *
+ * Only a single-batch, non-parallel hash table is used, since all its tuples
+ * are in memory, and only integer keys, the ones the heap and column store
+ * scans can test.
+ */
+static void ExecHashJoinPushDownFilter(HashJoinState* hjstate)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    Plan* plan = hjstate->js.ps.plan;
+    filter::BloomFilter** bfarray = hjstate->js.ps.state->es_bloom_filter.bfarray;
+    TupleTableSlot* slot = hjstate->hj_HashTupleSlot;
+    MemoryContext oldcxt;
+    ListCell* lc = NULL;
+    int i = 0;
+
+    if (hjstate->hj_BloomFilterCxt == NULL || bfarray == NULL || !u_sess->attr.attr_sql.enable_bloom_filter ||
+        hjstate->hj_ParallelState != NULL || hashtable->nbatch != 1 ||
+        hashtable->totalTuples > DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
+        return;
+    }
+
+    oldcxt = MemoryContextSwitchTo(hjstate->hj_BloomFilterCxt);
+
+    foreach (lc, plan->var_list) {
+        Var* var = (Var*)lfirst(lc);
+        int idx = list_nth_int(plan->filterIndexList, i++);
+        filter::BloomFilter* bf = NULL;
+        HashJoinTuple tuple = NULL;
+        bool isnull = false;
+        Datum value;
+
+        if (var->vartype != INT2OID && var->vartype != INT4OID && var->vartype != INT8OID) {
+            continue;
+        }
+
+        bf = filter::createBloomFilter(var->vartype,
+            var->vartypmod,
+            var->varcollid,
+            HASHJOIN_BLOOM_FILTER,
+            DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5,
+            true);
+
+        for (int bucketno = 0; bucketno < hashtable->nbuckets; bucketno++) {
+            for (tuple = hashtable->buckets[bucketno]; tuple != NULL; tuple = tuple->next) {
+                (void)ExecStoreMinimalTuple(HJTUPLE_MINTUPLE(tuple), slot, false);
+                value = slot_getattr(slot, var->varattno, &isnull);
+                if (!isnull) {
+                    bf->addDatum(value);
+                }
+            }
+        }
+
+        for (int j = 0; j < hashtable->nSkewBuckets; j++) {
+            HashSkewBucket* skew_bucket = hashtable->skewBucket[hashtable->skewBucketNums[j]];
+
+            for (tuple = skew_bucket->tuples; tuple != NULL; tuple = tuple->next) {
+                (void)ExecStoreMinimalTuple(HJTUPLE_MINTUPLE(tuple), slot, false);
+                value = slot_getattr(slot, var->varattno, &isnull);
+                if (!isnull) {
+                    bf->addDatum(value);
+                }
+            }
+        }
+
+        bfarray[idx] = bf;
+    }
+
+    (void)ExecClearTuple(slot);
+    (void)MemoryContextSwitchTo(oldcxt);
+}
+
+/*
+ * ExecHashJoinClearFilter
+ *
+ *		Withdraw the bloom filters published by this join and free them.
+ */
+static void ExecHashJoinClearFilter(HashJoinState* hjstate)
+{
+    filter::BloomFilter** bfarray = hjstate->js.ps.state->es_bloom_filter.bfarray;
+    ListCell* lc = NULL;
+
+    if (hjstate->hj_BloomFilterCxt == NULL) {
+        return;
+    }
+
+    if (bfarray != NULL) {
+        foreach (lc, hjstate->js.ps.plan->filterIndexList) {
+            bfarray[lfirst_int(lc)] = NULL;
+        }
+    }
+
+    MemoryContextReset(hjstate->hj_BloomFilterCxt);
+}
@@ -21,6 +21,12 @@
  *		ExecEndIndexOnlyScan		releases all storage.
  *		ExecIndexOnlyMarkPos		marks scan position.
  *		ExecIndexOnlyRestrPos		restores scan position.
+ *		ExecIndexOnlyScanEstimate	estimates DSM space needed for
+ *						parallel index-only scan
+ *		ExecIndexOnlyScanInitializeDSM	initialize DSM for parallel
+ *						index-only scan
+ *		ExecIndexOnlyScanReInitializeDSM	reinitialize DSM for fresh scan
+ *		ExecIndexOnlyScanInitializeWorker attach to DSM info in parallel worker
  */
 #include "postgres.h"
 #include "knl/knl_variable.h"
@@ -786,3 +792,55 @@ void ExecInitPartitionForIndexOnlyScan(IndexOnlyScanState* indexstate, EState* e
         }
     }
 }
+
+/* ----------------------------------------------------------------
+ *						Parallel Index-only Scan Support
+ * ----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ *		ExecIndexOnlyScanEstimate
+ *
+ *		estimates the space required to serialize index-only scan node.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexOnlyScanEstimate(IndexOnlyScanState* node, ParallelContext* pcxt)
+{
+    node->ioss_PscanLen = index_parallelscan_estimate(node->ioss_RelationDesc);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexOnlyScanInitializeDSM
+ *
+ *		Set up a parallel index-only scan descriptor.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexOnlyScanInitializeDSM(IndexOnlyScanState* node, ParallelContext* pcxt, int nodeid)
+{
+    ParallelIndexScanDesc piscan =
+        ExecIndexInitParallelScan(&node->ss, node->ioss_RelationDesc, node->ioss_PscanLen, pcxt, nodeid);
+    ExecIndexAttachParallelScan(node->ioss_ScanDesc, piscan);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexOnlyScanReInitializeDSM
+ *
+ *		Reset shared state before beginning a fresh scan.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexOnlyScanReInitializeDSM(IndexOnlyScanState* node, ParallelContext* pcxt)
+{
+    index_parallelrescan(GetIndexScanDesc(node->ioss_ScanDesc));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexOnlyScanInitializeWorker
+ *
+ *		Copy relevant information from TOC into planstate.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexOnlyScanInitializeWorker(IndexOnlyScanState* node, void* context)
+{
+    ParallelIndexScanDesc piscan = ExecIndexFindParallelScan(&node->ss, context);
+    ExecIndexAttachParallelScan(node->ioss_ScanDesc, piscan);
+}
@@ -21,6 +21,10 @@
  *		ExecEndIndexScan		releases all storage.
  *		ExecIndexMarkPos		marks scan position.
  *		ExecIndexRestrPos		restores scan position.
+ *		ExecIndexScanEstimate	estimates DSM space needed for parallel index scan
+ *		ExecIndexScanInitializeDSM initialize DSM for parallel indexscan
+ *		ExecIndexScanReInitializeDSM reinitialize DSM for fresh scan
+ *		ExecIndexScanInitializeWorker attach to DSM info in parallel worker
  */
 #include "postgres.h"
 #include "knl/knl_variable.h"
@@ -1337,3 +1341,116 @@ void ExecInitPartitionForIndexScan(IndexScanState* index_state, EState* estate)
         }
     }
 }
+
+/* ----------------------------------------------------------------
+ *						Parallel Scan Support
+ * ----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ *		ExecIndexInitParallelScan
+ *
+ *		Set up the shared state of a parallel index scan in the parallel
+ *		context's memory, and register it under nodeid.  Shared with
+ *		nodeIndexonlyscan.cpp.
+ * ----------------------------------------------------------------
+ */
+ParallelIndexScanDesc ExecIndexInitParallelScan(
+    ScanState* node, Relation index, Size pscan_len, ParallelContext* pcxt, int nodeid)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)pcxt->seg;
+
+    /* Here we can't use palloc, cause we have switch to old memctx in ExecInitParallelPlan */
+    ParallelIndexScanDesc piscan = (ParallelIndexScanDesc)MemoryContextAllocZero(cxt->memCtx, pscan_len);
+    index_parallelscan_initialize(node->ss_currentRelation, index, piscan);
+    piscan->plan_node_id = node->ps.plan->plan_node_id;
+    cxt->pwCtx->queryInfo.piscan[nodeid] = piscan;
+
+    return piscan;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexFindParallelScan
+ *
+ *		Look up the shared state the leader set up for this node.
+ * ----------------------------------------------------------------
+ */
+ParallelIndexScanDesc ExecIndexFindParallelScan(ScanState* node, void* context)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)context;
+
+    for (int i = 0; i < cxt->pwCtx->queryInfo.piscan_num; i++) {
+        if (node->ps.plan->plan_node_id == cxt->pwCtx->queryInfo.piscan[i]->plan_node_id) {
+            return cxt->pwCtx->queryInfo.piscan[i];
+        }
+    }
+
+    ereport(ERROR, (errmsg("could not find plan info, plan node id:%d", node->ps.plan->plan_node_id)));
+    return NULL; /* keep compiler quiet */
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexAttachParallelScan
+ *
+ *		Make the index scan descriptor take part in a parallel scan.
+ *		Hash bucket and partitioned relations never get a parallel-aware
+ *		index path, so only plain index scan descriptors are expected.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexAttachParallelScan(AbsIdxScanDesc scandesc, ParallelIndexScanDesc piscan)
+{
+    if (scandesc == NULL || scandesc->type != T_ScanDesc_Index) {
+        ereport(ERROR,
+            (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("parallel index scan is not supported on this relation")));
+    }
+
+    index_parallelscan_attach((IndexScanDesc)scandesc, piscan);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexScanEstimate
+ *
+ *		estimates the space required to serialize indexscan node.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexScanEstimate(IndexScanState* node, ParallelContext* pcxt)
+{
+    node->iss_PscanLen = index_parallelscan_estimate(node->iss_RelationDesc);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexScanInitializeDSM
+ *
+ *		Set up a parallel index scan descriptor.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexScanInitializeDSM(IndexScanState* node, ParallelContext* pcxt, int nodeid)
+{
+    ParallelIndexScanDesc piscan =
+        ExecIndexInitParallelScan(&node->ss, node->iss_RelationDesc, node->iss_PscanLen, pcxt, nodeid);
+    ExecIndexAttachParallelScan(node->iss_ScanDesc, piscan);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexScanReInitializeDSM
+ *
+ *		Reset shared state before beginning a fresh scan.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexScanReInitializeDSM(IndexScanState* node, ParallelContext* pcxt)
+{
+    index_parallelrescan(GetIndexScanDesc(node->iss_ScanDesc));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIndexScanInitializeWorker
+ *
+ *		Copy relevant information from TOC into planstate.
+ * ----------------------------------------------------------------
+ */
+void ExecIndexScanInitializeWorker(IndexScanState* node, void* context)
+{
+    ParallelIndexScanDesc piscan = ExecIndexFindParallelScan(&node->ss, context);
+    ExecIndexAttachParallelScan(node->iss_ScanDesc, piscan);
+}
@@ -218,26 +218,33 @@ static TupleTableSlot* SeqNext(SeqScanState* node)
 
     GetHeapScanDesc(scanDesc)->rs_ss_accessor = node->ss_scanaccessor;
 
-    /*
-     * get the next tuple from the table for seqscan.
-     */
-    tuple = abs_tbl_getnext(scanDesc, direction);
+    for (;;) {
+        /*
+         * get the next tuple from the table for seqscan.
+         */
+        tuple = abs_tbl_getnext(scanDesc, direction);
 
-    ADIO_RUN()
-    {
-        Start_Prefetch(GetHeapScanDesc(scanDesc), node->ss_scanaccessor, direction);
-    }
-    ADIO_END();
+        ADIO_RUN()
+        {
+            Start_Prefetch(GetHeapScanDesc(scanDesc), node->ss_scanaccessor, direction);
+        }
+        ADIO_END();
 
-    /*
-     * save the tuple and the buffer returned to us by the access methods in
-     * our scan tuple slot and return the slot.  Note: we pass 'false' because
-     * tuples returned by heap_getnext() are pointers onto disk pages and were
-     * not created with palloc() and so should not be pfree_ext()'d.  Note also
-     * that ExecStoreTuple will increment the refcount of the buffer; the
-     * refcount will not be dropped until the tuple table slot is cleared.
-     */
-    return ExecMakeTupleSlot(tuple, GetHeapScanDesc(scanDesc), slot);
+        /*
+         * save the tuple and the buffer returned to us by the access methods in
+         * our scan tuple slot and return the slot.  Note: we pass 'false' because
+         * tuples returned by heap_getnext() are pointers onto disk pages and were
+         * not created with palloc() and so should not be pfree_ext()'d.  Note also
+         * that ExecStoreTuple will increment the refcount of the buffer; the
+         * refcount will not be dropped until the tuple table slot is cleared.
+         */
+        slot = ExecMakeTupleSlot(tuple, GetHeapScanDesc(scanDesc), slot);
+
+        /* skip tuples the runtime filters of a parent hash join reject */
+        if (node->ps.plan->var_list == NIL || TupIsNull(slot) || ExecRuntimeFilterPassTuple(node, slot)) {
+            return slot;
+        }
+    }
 }
 
 /*
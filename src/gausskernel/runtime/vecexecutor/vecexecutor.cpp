@@ -162,6 +162,10 @@ VectorBatch* VectorEngine(PlanState* node)
     result = VectorEngineRunner[GetRunnerIdx(nodeTag(node))](node);
     t_thrd.pgxc_cxt.GlobalNetInstr = NULL;
 
+    /* Only a parent that asked for it gets a batch in selection-vector mode */
+    if (!BatchIsNull(result) && result->m_checkSel && !node->vec_accept_sel)
+        result->Compact();
+
     if (node->instrument) {
         switch (nodeTag(node)) {
             case T_VecModifyTableState:
@@ -189,7 +193,7 @@ VectorBatch* VectorEngine(PlanState* node)
                 node->instrument->firsttuple = INSTR_TIME_GET_DOUBLE(first_tuple);
                 break;
             default:
-                InstrStopNode(node->instrument, BatchIsNull(result) ? 0.0 : result->m_rows);
+                InstrStopNode(node->instrument, BatchIsNull(result) ? 0.0 : result->SelectedRows());
                 break;
         }
         node->instrument->memoryinfo.operatorMemory = node->plan->operatorMemKB[0];
@@ -203,6 +207,53 @@ VectorBatch* VectorEngine(PlanState* node)
     return result;
 }
 
+/*
+ * ExecSetVecBatchRows
+ *	Lower the number of rows the node puts into one output batch.  Nodes
+ *	that only hand their child's batches through (partition iterator) pass
+ *	the limit on to the child that fills them.
+ */
+void ExecSetVecBatchRows(PlanState* node, int rows)
+{
+    if (node == NULL || !node->vectorized)
+        return;
+
+    rows = Max(Min(rows, BatchMaxSize), VEC_MIN_BATCH_ROWS);
+    if (node->vec_batch_rows == 0 || rows < node->vec_batch_rows)
+        node->vec_batch_rows = rows;
+
+    if (IsA(node, VecPartIteratorState))
+        ExecSetVecBatchRows(outerPlanState(node), rows);
+}
+
+/*
+ * ExecVecProbeBatchRows
+ *	Rows per probe batch of a hash join such that the probe batch, the
+ *	per-row probe state and the inner cells it touches stay in the L2 cache.
+ *	Half of the cache is left to the hash table buckets being looked up.
+ */
+int ExecVecProbeBatchRows(int outerCols, int innerCols)
+{
+    static long l2_size = 0;
+    long row_width;
+    long rows;
+
+    if (l2_size == 0) {
+        long size = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        l2_size = (size > 0) ? size : 256 * 1024L;
+    }
+
+    /* probe batch columns, result columns of the inner side, and the probe state of a row */
+    row_width = (long)outerCols * (sizeof(ScalarValue) + sizeof(uint8)) +
+                (long)innerCols * (sizeof(ScalarValue) + sizeof(uint8)) + 4 * sizeof(void*);
+    rows = (l2_size / 2) / row_width;
+
+    return (int)Max(Min(rows, (long)u_sess->attr.attr_sql.vector_batch_size), (long)VEC_MIN_BATCH_ROWS);
+}
+
 /*
  * ExecVecMarkPos
  * Marks the current scan position.
@@ -47,6 +47,7 @@
 #include "utils/xml.h"
 #include "utils/date.h"
 #include "vecexecutor/vecfunc.h"
+#include "vecexecutor/vecsimd.h"
 #include "catalog/pg_proc.h"
 #include "utils/syscache.h"
 #include "access/hash.h"
@@ -3238,14 +3239,7 @@ ScalarVector* ExecVecQual(List* qual, ExprContext* econtext, bool resultForNull,
         pVal = qual_result->m_vals;
         pFlag = qual_result->m_flag;
         // use pSel to control if a record should go into next qual.
-        for (i = 0; i < rows; i++) {
-            if (NOT_NULL(pFlag[i]))
-                pSel[i] = pSel[i] && pVal[i];
-            else
-                pSel[i] = pSel[i] && resultForNull;
-
-            res = res || pSel[i];
-        }
+        res = VEC_SIMD()->qual_to_selection(pVal, pFlag, pSel, rows, resultForNull);
 
         if (!res)
             return NULL;
@@ -3508,6 +3502,25 @@ static inline void SetAlignRowsForProject(ExprContext* econtext, VectorBatch* ba
     }
 }
 
+/*
+ * @Description: find the selection vector of the source batches of a projection
+ * @IN  econtext: the expression context for expression evaluation
+ * @Return: the selection vector of the first source batch in selection-vector
+ *          mode, NULL if all of them are dense
+ */
+static inline const bool* GetSelectionForProject(ExprContext* econtext)
+{
+    VectorBatch* batches[] = {
+        econtext->ecxt_scanbatch, econtext->ecxt_outerbatch, econtext->ecxt_innerbatch, econtext->ecxt_aggbatch};
+
+    for (uint32 i = 0; i < lengthof(batches); i++) {
+        if (batches[i] != NULL && batches[i]->m_checkSel)
+            return batches[i]->m_sel;
+    }
+
+    return NULL;
+}
+
 /*
  * ExecVecProject
  *
@@ -3522,6 +3535,7 @@ VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet, ExprDoneCon
     VectorBatch* pProjBatch = NULL;
     VectorBatch* srcBatch = NULL;
     ExprContext* econtext = NULL;
+    const bool* srcSel = NULL;
     int numSimpleVars;
 
     Assert(projInfo != NULL);
@@ -3543,6 +3557,13 @@ VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet, ExprDoneCon
         pProjBatch->ResetSelection(true);
     }
 
+    /*
+     * Projecting a batch in selection-vector mode keeps the result in that
+     * mode, and generic expressions are only evaluated for selected rows.
+     */
+    srcSel = GetSelectionForProject(econtext);
+    pProjBatch->m_checkSel = false;
+
     // align rows
     econtext->align_rows = 0;
     SetAlignRowsForProject(econtext, econtext->ecxt_outerbatch);
@@ -3550,6 +3571,11 @@ VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet, ExprDoneCon
     SetAlignRowsForProject(econtext, econtext->ecxt_aggbatch);
     SetAlignRowsForProject(econtext, econtext->ecxt_scanbatch);
     Assert(econtext->align_rows != 0);
+    if (srcSel != NULL) {
+        errno_t rc = memcpy_s(pProjBatch->m_sel, BatchMaxSize * sizeof(bool), srcSel, econtext->align_rows * sizeof(bool));
+        securec_check(rc, "\0", "\0");
+    }
+
     // Assign simple Vars to result by direct extraction of fields from source
     // slots ... a mite ugly, but fast ...
     //
@@ -3597,7 +3623,14 @@ VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet, ExprDoneCon
     // If there are any generic expressions, evaluate them.
     //
     if (projInfo->pi_targetlist) {
-        if (projInfo->jitted_vectarget) {
+        if (srcSel != NULL) {
+            bool savedUseSelection = econtext->m_fUseSelection;
+
+            Assert(!econtext->have_vec_set_fun);
+            econtext->m_fUseSelection = true;
+            ExecVecTargetList(projInfo->pi_targetlist, econtext, pProjBatch);
+            econtext->m_fUseSelection = savedUseSelection;
+        } else if (projInfo->jitted_vectarget) {
             projInfo->jitted_vectarget(econtext, pProjBatch);
         } else {
             if (econtext->have_vec_set_fun) {
@@ -3626,6 +3659,8 @@ VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet, ExprDoneCon
     if (srcBatch != NULL)
         pProjBatch->m_rows = Min(pProjBatch->m_rows, srcBatch->m_rows);
 
+    pProjBatch->m_checkSel = (srcSel != NULL);
+
     // Successfully formed a result batch
     //
     if (econtext->have_vec_set_fun) {
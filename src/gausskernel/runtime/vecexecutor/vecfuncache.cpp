@@ -26,6 +26,7 @@
 
 #include "catalog/pg_proc.h"
 #include "vecexecutor/vecfunc.h"
+#include "vecexecutor/vecsimd.h"
 #include "utils/date.h"
 #include "utils/builtins.h"
 #include "utils/int8.h"
@@ -770,32 +771,32 @@ static VecFuncCacheEntry vec_func_table[] = {{1724,
         }},
     {293,
         {
-            vfloat4_sop<float8eq>,
+            vfloat8_sop<SOP_EQ>,
 
         }},
     {294,
         {
-            vfloat4_sop<float8ne>,
+            vfloat8_sop<SOP_NEQ>,
 
         }},
     {298,
         {
-            vfloat4_sop<float8ge>,
+            vfloat8_sop<SOP_GE>,
 
         }},
     {297,
         {
-            vfloat4_sop<float8gt>,
+            vfloat8_sop<SOP_GT>,
 
         }},
     {296,
         {
-            vfloat4_sop<float8le>,
+            vfloat8_sop<SOP_LE>,
 
         }},
     {295,
         {
-            vfloat4_sop<float8lt>,
+            vfloat8_sop<SOP_LT>,
 
         }},
     {204,
@@ -1255,6 +1256,7 @@ void InitGlobalVecFuncMap()
     }
 
     InitVecsubarray();
+    (void)vec_simd_choose();
 }
 
 /*
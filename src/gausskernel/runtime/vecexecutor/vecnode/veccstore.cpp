@@ -45,8 +45,16 @@
 #include "executor/nodeSeqscan.h"
 #include "storage/cstore_compress.h"
 #include "access/cstore_am.h"
+#include "access/cstore_sketch.h"
 #include "optimizer/clauses.h"
+#include "optimizer/planmain.h"
 #include "nodes/params.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/bytea.h"
+#include "utils/date.h"
+#include "utils/int8.h"
+#include "utils/timestamp.h"
 #include "utils/lsyscache.h"
 #include "utils/datum.h"
 #include "utils/rel.h"
@@ -75,6 +83,8 @@ extern bool CodeGenPassThreshold(double rows, int dn_num, int dop);
 static CStoreStrategyNumber get_cstore_scan_strategy_num(Oid opno);
 static Datum get_param_extern_const_value(Oid left_type, Expr* expr, PlanState* ps, uint16* flag);
 static void exec_init_next_part4cstore_scan(CStoreScanState* node);
+static void exec_cstore_init_dict_filters(CStoreScanState* node);
+static void exec_cstore_init_sketch_keys(CStoreScanState* node);
 static void exec_cstore_build_scan_keys(CStoreScanState* scan_stat, List* quals, CStoreScanKey* scan_keys, int* num_scan_keys,
     CStoreScanRunTimeKeyInfo** runtime_key_info, int* runtime_keys_num);
 static void exec_cstore_scan_eval_runtime_keys(
@@ -184,6 +194,81 @@ void OptimizeProjectionAndFilter(CStoreScanState* node)
     node->m_fSimpleMap = simple_map;
 }
 
+/*
+ * Drop the rows of a scan batch that the runtime bloom filters of a parent
+ * hash join reject, see ExecGetRuntimeFilter.  Null keys are kept.  The
+ * batch is left in selection-vector mode if keep_sel, else it is packed.
+ * Returns the number of rows removed.
+ */
+static int ApplyRuntimeFilter(CStoreScanState* node, VectorBatch* batch, bool keep_sel)
+{
+    bool* sel = batch->m_sel;
+    int nrows = batch->m_rows;
+    int removed = 0;
+    ListCell* lc = NULL;
+    int i = 0;
+
+    foreach (lc, node->ps.plan->var_list) {
+        Var* var = (Var*)lfirst(lc);
+        filter::BloomFilter* bf = ExecGetRuntimeFilter(&node->ps, i++);
+
+        if (bf == NULL) {
+            continue;
+        }
+
+        if (!batch->m_checkSel) {
+            errno_t rc = memset_s(sel, BatchMaxSize * sizeof(bool), true, nrows * sizeof(bool));
+            securec_check(rc, "\0", "\0");
+            batch->m_checkSel = true;
+        }
+
+        ScalarVector* vec = &batch->m_arr[var->varattno - 1];
+        for (int j = 0; j < nrows; j++) {
+            if (sel[j] && NOT_NULL(vec->m_flag[j]) && !ExecRuntimeFilterMayMatch(bf, vec->m_vals[j], var->vartype)) {
+                sel[j] = false;
+                removed++;
+            }
+        }
+    }
+
+    if (batch->m_checkSel && !keep_sel) {
+        batch->Pack(sel);
+        batch->m_checkSel = false;
+    }
+
+    return removed;
+}
+
+/*
+ * Evaluate the qual of a batch whose dictionary filters CStore has applied
+ * while filling it: start from the rows they select and run the rest of the
+ * qual on those only.  Returns NULL if no row passes.
+ */
+static ScalarVector* ApplyDictFilterQual(CStoreScanState* node, const bool* dict_sel, ExprContext* econtext)
+{
+    VectorBatch* batch = econtext->ecxt_scanbatch;
+    bool matched = false;
+
+    for (int i = 0; i < batch->m_rows; i++) {
+        batch->m_sel[i] = dict_sel[i];
+        matched = matched || dict_sel[i];
+    }
+
+    if (!matched) {
+        return NULL;
+    }
+    if (node->m_dictResidualQual == NIL) {
+        return econtext->qual_results;
+    }
+
+    /* ExecVecQual leaves selection mode on when no row passes */
+    bool saved_use_selection = econtext->m_fUseSelection;
+    ScalarVector* result = ExecVecQual(node->m_dictResidualQual, econtext, false, false);
+    econtext->m_fUseSelection = saved_use_selection;
+
+    return result;
+}
+
 VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan_batch, ExprDoneCond* done)
 {
     List* qual = NIL;
@@ -193,6 +278,7 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
     bool simple_map = false;
     int late_read_ctid = 0;
     uint64 input_rows = p_scan_batch->m_rows;
+    uint64 bloom_filter_rows = 0;
 
     VECCSTORE_SCAN_TRACE_START(node, CSTORE_PROJECT);
 
@@ -207,6 +293,7 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
         }
     }
 
+    p_scan_batch->m_checkSel = false;
     if (p_scan_batch->m_rows != 0) {
         ResetExprContext(econtext);
         initEcontextBatch(p_scan_batch, NULL, NULL, NULL);
@@ -214,8 +301,14 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
         //
         if (qual != NULL) {
             ScalarVector* p_vector = NULL;
+            const bool* dict_sel = NULL;
+
+            if (node->m_hasDictFilter && !node->ss_deltaScan)
+                dict_sel = node->m_CStore->GetDictFilterSel();
 
-            if (node->jitted_vecqual)
+            if (dict_sel != NULL)
+                p_vector = ApplyDictFilterQual(node, dict_sel, econtext);
+            else if (node->jitted_vecqual)
                 p_vector = node->jitted_vecqual(econtext);
             else
                 p_vector = ExecVecQual(qual, econtext, false);
@@ -228,11 +321,18 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             }
 
             /*
+             * Leave the batch in selection-vector mode if the parent takes it
+             * that way and nothing below needs the rows packed: late read
+             * columns are fetched by the ctids of the packed rows, and
+             * set-returning projections walk the selection themselves.
              * Call optimized PackT function when codegen is turned on.
              */
-            if (econtext->ecxt_scanbatch->m_sel) {
+            late_read_ctid = node->m_CStore->GetLateReadCtid();
+            if (node->ps.vec_accept_sel && (node->ss_deltaScan || late_read_ctid == -1) &&
+                !proj->pi_exprContext->have_vec_set_fun) {
+                p_scan_batch->m_checkSel = true;
+            } else if (econtext->ecxt_scanbatch->m_sel) {
                 if (u_sess->attr.attr_sql.enable_codegen) {
-                    late_read_ctid = node->m_CStore->GetLateReadCtid();
                     if (node->ss_deltaScan || late_read_ctid == -1) {
                         p_scan_batch->OptimizePack(econtext->ecxt_scanbatch->m_sel, proj->pi_PackTCopyVars);
                     } else {
@@ -255,6 +355,13 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             node->ss_deltaScan = false;
         }
 
+        // Drop the rows the runtime bloom filters of a parent hash join reject
+        //
+        if (node->ps.plan->var_list != NIL && p_scan_batch->m_rows != 0) {
+            bloom_filter_rows = ApplyRuntimeFilter(node, p_scan_batch,
+                node->ps.vec_accept_sel && !proj->pi_exprContext->have_vec_set_fun);
+        }
+
         // Project the final result
         //
         if (!simple_map) {
@@ -265,6 +372,12 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             // for non simpleMap case, we don't need to do anything.
             //
             p_out_batch->m_rows = p_scan_batch->m_rows;
+            p_out_batch->m_checkSel = p_scan_batch->m_checkSel;
+            if (p_out_batch->m_checkSel) {
+                errno_t rc = memcpy_s(p_out_batch->m_sel, BatchMaxSize * sizeof(bool), p_scan_batch->m_sel,
+                    p_scan_batch->m_rows * sizeof(bool));
+                securec_check(rc, "\0", "\0");
+            }
             for (int i = 0; i < p_out_batch->m_cols; i++) {
                 AttrNumber att = proj->pi_varNumbers[i];
                 errno_t rc;
@@ -288,7 +401,10 @@ done:
     VECCSTORE_SCAN_TRACE_END(node, CSTORE_PROJECT);
 
     // collect information of removed rows
-    InstrCountFiltered1(node, input_rows - p_out_batch->m_rows);
+    InstrCountFiltered1(node, input_rows - p_out_batch->SelectedRows() - bloom_filter_rows);
+    if (bloom_filter_rows != 0 && node->ps.instrument) {
+        node->ps.instrument->bloomFilterRows += bloom_filter_rows;
+    }
 
     // Check fullness of return batch and refill it does not contain enough?
     return p_out_batch;
@@ -336,6 +452,7 @@ VectorBatch* ExecCStoreScan(CStoreScanState* node)
 
     // update cstore scan timing flag
     node->m_CStore->SetTiming(node);
+    node->m_CStore->SetBatchRows(VecBatchRows(&node->ps));
 
     ExprDoneCond done = ExprSingleResult;
     /*
@@ -358,6 +475,7 @@ restart:
     //
     p_scan_batch->Reset(true);
     p_out_batch->Reset(true);
+    p_out_batch->m_checkSel = false;
     node->ps.ps_ProjInfo->pi_exprContext->current_row = 0;
 
     if (!node->isSampleScan) {
@@ -799,6 +917,14 @@ CStoreScanState* ExecInitCStoreScan(
     scan_stat->m_CStore->InitScan(scan_stat, GetActiveSnapshot());
     OptimizeProjectionAndFilter(scan_stat);
 
+    /* the jitted qual can't start from a selection */
+    if (!idx_flag && jitted_vecqual == NULL) {
+        exec_cstore_init_dict_filters(scan_stat);
+    }
+    if (!idx_flag) {
+        exec_cstore_init_sketch_keys(scan_stat);
+    }
+
     /*
      * initialize delta relation
      */
@@ -880,6 +1006,323 @@ void ExecEndCStoreScan(CStoreScanState* node, bool idx_flag)
     EndScanDeltaRelation(node);
 }
 
+/*
+ * Build the dictionary filter clause of a qual clause "column op const" or
+ * "column op ANY (const array)", see CStoreDictClause.  Returns false if the
+ * clause doesn't have that form.
+ */
+static bool exec_cstore_build_dict_clause(
+    CStoreScanState* node, Expr* clause, AttrNumber* attno, CStoreDictClause* dict_clause)
+{
+    TupleDesc tupdesc = RelationGetDescr(node->ss_currentRelation);
+    Index scanrelid = ((Scan*)node->ps.plan)->scanrelid;
+    List* args = NIL;
+    Oid opfuncid = InvalidOid;
+    Oid collation = InvalidOid;
+    bool is_array = false;
+
+    if (IsA(clause, OpExpr)) {
+        OpExpr* op = (OpExpr*)clause;
+
+        if (op->opresulttype != BOOLOID || op->opretset) {
+            return false;
+        }
+        set_opfuncid(op);
+        opfuncid = op->opfuncid;
+        collation = op->inputcollid;
+        args = op->args;
+    } else if (IsA(clause, ScalarArrayOpExpr)) {
+        ScalarArrayOpExpr* saop = (ScalarArrayOpExpr*)clause;
+
+        if (!saop->useOr) {
+            return false;
+        }
+        set_sa_opfuncid(saop);
+        opfuncid = saop->opfuncid;
+        collation = saop->inputcollid;
+        args = saop->args;
+        is_array = true;
+    } else {
+        return false;
+    }
+
+    if (list_length(args) != 2) {
+        return false;
+    }
+
+    Node* left = (Node*)linitial(args);
+    Node* right = (Node*)lsecond(args);
+    while (IsA(left, RelabelType)) {
+        left = (Node*)((RelabelType*)left)->arg;
+    }
+    while (IsA(right, RelabelType)) {
+        right = (Node*)((RelabelType*)right)->arg;
+    }
+
+    Var* var = NULL;
+    Const* con = NULL;
+    if (IsA(left, Var) && IsA(right, Const)) {
+        var = (Var*)left;
+        con = (Const*)right;
+        dict_clause->varOnLeft = true;
+    } else if (!is_array && IsA(left, Const) && IsA(right, Var)) {
+        var = (Var*)right;
+        con = (Const*)left;
+        dict_clause->varOnLeft = false;
+    } else {
+        return false;
+    }
+
+    /* only varlena columns have dictionary encoded CUs */
+    if (var->varno != scanrelid || var->varlevelsup != 0 || var->varattno <= 0 || var->varattno > tupdesc->natts ||
+        tupdesc->attrs[var->varattno - 1]->attlen != -1 || con->constisnull) {
+        return false;
+    }
+
+    /* evaluated once per dictionary item, so it must not depend on the row */
+    if (func_volatile(opfuncid) != PROVOLATILE_IMMUTABLE || !func_strict(opfuncid)) {
+        return false;
+    }
+
+    if (is_array) {
+        ArrayType* arr = DatumGetArrayTypeP(con->constvalue);
+        int16 elmlen;
+        bool elmbyval = false;
+        char elmalign;
+        Datum* elems = NULL;
+        bool* nulls = NULL;
+        int nelems = 0;
+
+        get_typlenbyvalalign(ARR_ELEMTYPE(arr), &elmlen, &elmbyval, &elmalign);
+        deconstruct_array(arr, ARR_ELEMTYPE(arr), elmlen, elmbyval, elmalign, &elems, &nulls, &nelems);
+
+        /* a NULL element never makes the clause true */
+        dict_clause->consts = (Datum*)palloc(sizeof(Datum) * Max(nelems, 1));
+        dict_clause->nconsts = 0;
+        for (int i = 0; i < nelems; i++) {
+            if (!nulls[i]) {
+                dict_clause->consts[dict_clause->nconsts++] = elems[i];
+            }
+        }
+    } else {
+        dict_clause->consts = (Datum*)palloc(sizeof(Datum));
+        dict_clause->consts[0] = con->constvalue;
+        dict_clause->nconsts = 1;
+    }
+
+    fmgr_info(opfuncid, &dict_clause->opFunc);
+    dict_clause->collation = collation;
+    *attno = var->varattno;
+    return true;
+}
+
+/*
+ * Hand the qual clauses comparing varlena columns with constants to CStore,
+ * which evaluates them once per dictionary item of the CUs it reads, and keep
+ * the other clauses in m_dictResidualQual.  The whole qual still runs on the
+ * batches CStore could not filter, e.g. of CUs that are not dictionary
+ * encoded, and on the delta table.
+ */
+static void exec_cstore_init_dict_filters(CStoreScanState* node)
+{
+    List* plan_qual = node->ps.plan->qual;
+    List* filters = NIL;
+    List* residual = NIL;
+    ListCell* plan_lc = NULL;
+    ListCell* state_lc = NULL;
+
+    /* the redistribution quals differ from the plan qual */
+    if (!u_sess->attr.attr_sql.enable_cstore_dict_filter || plan_qual == NIL || node->isSampleScan ||
+        u_sess->attr.attr_sql.enable_cluster_resize || list_length(plan_qual) != list_length(node->ps.qual)) {
+        return;
+    }
+
+    forboth(plan_lc, plan_qual, state_lc, node->ps.qual) {
+        CStoreDictClause dict_clause;
+        AttrNumber attno = InvalidAttrNumber;
+        CStoreDictFilter* filter = NULL;
+        ListCell* lc = NULL;
+
+        if (!exec_cstore_build_dict_clause(node, (Expr*)lfirst(plan_lc), &attno, &dict_clause)) {
+            residual = lappend(residual, lfirst(state_lc));
+            continue;
+        }
+
+        foreach (lc, filters) {
+            if (((CStoreDictFilter*)lfirst(lc))->attno == attno) {
+                filter = (CStoreDictFilter*)lfirst(lc);
+                break;
+            }
+        }
+        if (filter == NULL) {
+            filter = (CStoreDictFilter*)palloc0(sizeof(CStoreDictFilter));
+            filter->attno = attno;
+            filter->clauses = (CStoreDictClause*)palloc(sizeof(CStoreDictClause) * list_length(plan_qual));
+            filters = lappend(filters, filter);
+        }
+        filter->clauses[filter->nclauses++] = dict_clause;
+    }
+
+    if (filters != NIL && node->m_CStore->SetDictFilters(filters)) {
+        node->m_hasDictFilter = true;
+        node->m_dictResidualQual = residual;
+    } else {
+        list_free_ext(residual);
+    }
+}
+
+/*
+ * Whether the operator function is one of the equalities of the types the CU
+ * sketches hash by value, see CUSketchHashValue().
+ */
+static bool exec_cstore_is_sketch_eq_func(Oid opfuncid)
+{
+    FmgrInfo finfo;
+
+    fmgr_info(opfuncid, &finfo);
+    return finfo.fn_addr == int2eq || finfo.fn_addr == int4eq || finfo.fn_addr == int8eq ||
+           finfo.fn_addr == int24eq || finfo.fn_addr == int42eq || finfo.fn_addr == int28eq ||
+           finfo.fn_addr == int82eq || finfo.fn_addr == int48eq || finfo.fn_addr == int84eq ||
+           finfo.fn_addr == date_eq || finfo.fn_addr == time_eq || finfo.fn_addr == timestamp_eq ||
+           finfo.fn_addr == texteq || finfo.fn_addr == byteaeq;
+}
+
+/*
+ * Build the sketch key of a qual clause "column = const" or
+ * "column = ANY (const array)", or return NULL if the clause is not one.
+ */
+static CStoreSketchKey* exec_cstore_build_sketch_key(CStoreScanState* node, Expr* clause)
+{
+    TupleDesc tupdesc = RelationGetDescr(node->ss_currentRelation);
+    Index scanrelid = ((Scan*)node->ps.plan)->scanrelid;
+    List* args = NIL;
+    Oid opfuncid = InvalidOid;
+    bool is_array = false;
+
+    if (IsA(clause, OpExpr)) {
+        OpExpr* op = (OpExpr*)clause;
+
+        set_opfuncid(op);
+        opfuncid = op->opfuncid;
+        args = op->args;
+    } else if (IsA(clause, ScalarArrayOpExpr) && ((ScalarArrayOpExpr*)clause)->useOr) {
+        ScalarArrayOpExpr* saop = (ScalarArrayOpExpr*)clause;
+
+        set_sa_opfuncid(saop);
+        opfuncid = saop->opfuncid;
+        args = saop->args;
+        is_array = true;
+    } else {
+        return NULL;
+    }
+
+    if (list_length(args) != 2) {
+        return NULL;
+    }
+
+    Node* left = (Node*)linitial(args);
+    Node* right = (Node*)lsecond(args);
+    while (IsA(left, RelabelType)) {
+        left = (Node*)((RelabelType*)left)->arg;
+    }
+    while (IsA(right, RelabelType)) {
+        right = (Node*)((RelabelType*)right)->arg;
+    }
+
+    Var* var = NULL;
+    Const* con = NULL;
+    if (IsA(left, Var) && IsA(right, Const)) {
+        var = (Var*)left;
+        con = (Const*)right;
+    } else if (!is_array && IsA(left, Const) && IsA(right, Var)) {
+        var = (Var*)right;
+        con = (Const*)left;
+    } else {
+        return NULL;
+    }
+
+    if (var->varno != scanrelid || var->varlevelsup != 0 || var->varattno <= 0 || var->varattno > tupdesc->natts ||
+        !CUSketchTypeSupported(tupdesc->attrs[var->varattno - 1]->atttypid) || con->constisnull ||
+        !exec_cstore_is_sketch_eq_func(opfuncid)) {
+        return NULL;
+    }
+
+    CStoreSketchKey* key = (CStoreSketchKey*)palloc0(sizeof(CStoreSketchKey));
+    key->attno = var->varattno;
+
+    if (is_array) {
+        ArrayType* arr = DatumGetArrayTypeP(con->constvalue);
+        Oid elmtype = ARR_ELEMTYPE(arr);
+        int16 elmlen;
+        bool elmbyval = false;
+        char elmalign;
+        Datum* elems = NULL;
+        bool* nulls = NULL;
+        int nelems = 0;
+
+        if (!CUSketchTypeSupported(elmtype)) {
+            pfree(key);
+            return NULL;
+        }
+
+        get_typlenbyvalalign(elmtype, &elmlen, &elmbyval, &elmalign);
+        deconstruct_array(arr, elmtype, elmlen, elmbyval, elmalign, &elems, &nulls, &nelems);
+
+        key->hashes = (uint32*)palloc(sizeof(uint32) * Max(nelems, 1));
+        for (int i = 0; i < nelems; i++) {
+            if (!nulls[i]) {
+                key->hashes[key->nhashes++] = CUSketchHashValue(elmtype, elems[i]);
+            }
+        }
+    } else {
+        if (!CUSketchTypeSupported(con->consttype)) {
+            pfree(key);
+            return NULL;
+        }
+
+        key->hashes = (uint32*)palloc(sizeof(uint32));
+        key->hashes[0] = CUSketchHashValue(con->consttype, con->constvalue);
+        key->nhashes = 1;
+    }
+
+    /* an array of NULLs only matches no row, which the qual finds cheaply */
+    if (key->nhashes == 0) {
+        pfree(key->hashes);
+        pfree(key);
+        return NULL;
+    }
+
+    return key;
+}
+
+/*
+ * Hand the equality qual clauses on columns of the types CU sketches are
+ * built for to CStore, which prunes the CUs whose bloom filters hold none of
+ * the constants compared with.  The whole qual still runs on the CUs read.
+ */
+static void exec_cstore_init_sketch_keys(CStoreScanState* node)
+{
+    List* keys = NIL;
+    ListCell* lc = NULL;
+
+    /* the redistribution quals differ from the plan qual */
+    if (node->ps.plan->qual == NIL || u_sess->attr.attr_sql.enable_cluster_resize) {
+        return;
+    }
+
+    foreach (lc, node->ps.plan->qual) {
+        CStoreSketchKey* key = exec_cstore_build_sketch_key(node, (Expr*)lfirst(lc));
+
+        if (key != NULL) {
+            keys = lappend(keys, key);
+        }
+    }
+
+    if (keys != NIL && !node->m_CStore->SetSketchKeys(keys)) {
+        list_free_deep(keys);
+    }
+}
+
 /* Build the cstore scan keys from the qual. */
 static void exec_cstore_build_scan_keys(CStoreScanState* scan_stat, List* quals, CStoreScanKey* scan_keys, int* num_scan_keys,
     CStoreScanRunTimeKeyInfo** runtime_key_info, int* runtime_keys_num)
@@ -1170,6 +1613,65 @@ void ExecReScanCStoreScan(CStoreScanState* node)
 
     ExecReCStoreSeqScan(node);
     ReScanDeltaRelation(node);
+    node->m_deltaScanOwner = false;
+}
+
+/*
+ * @Description: set up the shared CU cursor of a parallel-aware scan.
+ *     The CU range is the one the leader computed in ExecInitCStoreScan.
+ * @Param[IN] node: leader's scan state
+ * @Param[IN] pcxt: parallel context
+ * @Param[IN] nodeid: slot in the parallel query info
+ */
+void ExecCStoreScanInitializeDSM(CStoreScanState* node, ParallelContext* pcxt, int nodeid)
+{
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)pcxt->seg;
+
+    /* Here we can't use palloc, cause we have switch to old memctx in ExecInitParallelPlan */
+    ParallelCStoreScanDesc pscan =
+        (ParallelCStoreScanDesc)MemoryContextAllocZero(cxt->memCtx, sizeof(ParallelCStoreScanDescData));
+    pscan->plan_node_id = node->ps.plan->plan_node_id;
+    node->m_CStore->InitParallelScanDesc(pscan, pcxt->nworkers + 1);
+    cxt->pwCtx->queryInfo.pcstore[nodeid] = pscan;
+
+    node->m_parallelScan = pscan;
+    node->m_CStore->SetParallelScan(pscan);
+}
+
+/*
+ * @Description: rewind the shared CU cursor for a rescan.  The workers are
+ *     gone at this point, and the leader resets its own state in
+ *     ExecReScanCStoreScan.
+ */
+void ExecCStoreScanReInitializeDSM(CStoreScanState* node, ParallelContext* pcxt)
+{
+    ParallelCStoreScanDesc pscan = node->m_parallelScan;
+
+    pg_atomic_write_u32(&pscan->nextCUID, pscan->startCUID);
+    pg_atomic_write_u32(&pscan->deltaClaimed, 0);
+}
+
+/*
+ * @Description: attach a worker's scan to the shared CU cursor.
+ */
+void ExecCStoreScanInitializeWorker(CStoreScanState* node, void* context)
+{
+    ParallelCStoreScanDesc pscan = NULL;
+    knl_u_parallel_context* cxt = (knl_u_parallel_context*)context;
+
+    for (int i = 0; i < cxt->pwCtx->queryInfo.pcstore_num; i++) {
+        if (node->ps.plan->plan_node_id == cxt->pwCtx->queryInfo.pcstore[i]->plan_node_id) {
+            pscan = cxt->pwCtx->queryInfo.pcstore[i];
+            break;
+        }
+    }
+
+    if (pscan == NULL) {
+        ereport(ERROR, (errmsg("could not find plan info, plan node id:%d", node->ps.plan->plan_node_id)));
+    }
+
+    node->m_parallelScan = pscan;
+    node->m_CStore->SetParallelScan(pscan);
 }
 
 static void exec_init_next_part4cstore_scan(CStoreScanState* node)
@@ -132,6 +132,13 @@ HashAggRunner::HashAggRunner(VecAggState* runtime) : BaseAggRunner(runtime, true
 
     BindingFp();
 
+    /*
+     * buildAggTbl leaves the filtered rows of a selection vector out of the
+     * hash table, the codegened hashing and aggregation do not know about it.
+     */
+    outerPlanState(runtime)->vec_accept_sel =
+        (runtime->jitted_hashing == NULL && runtime->jitted_sglhashing == NULL && runtime->jitted_batchagg == NULL);
+
     if (m_runtime->ss.ps.instrument) {
         m_runtime->ss.ps.instrument->sorthashinfo.hashtable_expand_times = 0;
     }
@@ -729,6 +736,8 @@ void HashAggRunner::buildAggTbl(VectorBatch* batch)
                     "[VecHashAgg(%d)]: AggHashing with %d segments!", m_runtime->ss.ps.plan->plan_node_id, m_segnum)));
         ((vechashing_func)(m_runtime->jitted_hashing))(this, batch);
     } else {
+        const bool* sel = SelectionVector(batch);
+
         rows = batch->m_rows;
         hashBatch(batch, m_keyIdx, m_hashVal, m_outerHashFuncs);
         for (i = 0; i < rows; i++) {
@@ -736,6 +745,12 @@ void HashAggRunner::buildAggTbl(VectorBatch* batch)
         }
 
         for (i = 0; i < rows; i++) {
+            /* a filtered row has no cell, the agg functions skip it */
+            if (sel != NULL && !sel[i]) {
+                m_Loc[i] = NULL;
+                continue;
+            }
+
             if (m_segnum == 1) {
                 cell = m_hashData[0].tbl_data[m_cacheLoc[i]];
             } else {
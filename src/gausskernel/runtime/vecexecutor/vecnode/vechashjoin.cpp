@@ -111,6 +111,10 @@ VecHashJoinState* ExecInitVecHashJoin(VecHashJoin* node, EState* estate, int efl
     outerPlanState(hash_state) = ExecInitNode(outer_node, estate, eflags);
     innerPlanState(hash_state) = ExecInitNode(inner_node, estate, eflags);
 
+    /* Probe with batches whose working set fits in the L2 cache */
+    ExecSetVecBatchRows(outerPlanState(hash_state),
+        ExecVecProbeBatchRows(list_length(outer_node->targetlist), list_length(inner_node->targetlist)));
+
     /*
      * tuple table initialization
      */
@@ -582,6 +586,14 @@ HashJoinTbl::HashJoinTbl(VecHashJoinState* runtime_context)
     if (m_complicateJoinKey == false)
         ReplaceEqfunc();
 
+    /*
+     * SaveToMemory packs the selected rows of the inner batches while it
+     * copies them into hash cells, so the inner side may hand up batches in
+     * selection-vector mode.  Complicated join keys are evaluated on whole
+     * batches, which must be dense.
+     */
+    innerPlanState(m_runtime)->vec_accept_sel = !m_complicateJoinKey;
+
     m_tupleCount = m_colWidth = 0;
     m_sysBusy = false;
     if (((Plan*)node)->operatorMaxMem > 0)
@@ -1076,7 +1088,9 @@ void HashJoinTbl::SaveToMemory(VectorBatch* batch)
     hashCell* cell_arr = NULL;
     int i;
 
-    int rows = batch->m_rows;
+    const bool* sel = SelectionVector(batch);
+    int nrows = batch->m_rows;
+    int rows = batch->SelectedRows();
     int cols = batch->m_cols;
 
     m_rows += rows;
@@ -1132,13 +1146,17 @@ void HashJoinTbl::SaveToMemory(VectorBatch* batch)
         ScalarVector* p_vector = &batch->m_arr[j];
         cell = cell_arr;
         if (simple || m_colDesc[j].encoded == false) {
-            for (i = 0; i < rows; i++) {
+            for (i = 0; i < nrows; i++) {
+                if (sel != NULL && !sel[i])
+                    continue;
                 (cell)->m_val[j].val = p_vector->m_vals[i];
                 (cell)->m_val[j].flag = p_vector->m_flag[i];
                 (cell) = (hashCell*)((char*)cell + m_cellSize);
             }
         } else {
-            for (i = 0; i < rows; i++) {
+            for (i = 0; i < nrows; i++) {
+                if (sel != NULL && !sel[i])
+                    continue;
                 if (likely(p_vector->IsNull(i) == false)) {
                     (cell)->m_val[j].val = addVariable(m_hashContext, p_vector->m_vals[i]);
                     m_colWidth += VARSIZE_ANY(p_vector->m_vals[i]);
@@ -1150,6 +1168,7 @@ void HashJoinTbl::SaveToMemory(VectorBatch* batch)
     }
 
     if (complicate_join_key) {
+        Assert(sel == NULL);
         cell = cell_arr;
         for (i = 0; i < rows; i++) {
             (cell)->m_val[m_cols].val = m_cacheLoc[i];  // last value remember hash value.
@@ -1198,6 +1217,7 @@ void HashJoinTbl::SaveToDisk(VectorBatch* batch)
 {
     int i;
     int row = batch->m_rows;
+    const bool* sel = SelectionVector(batch);
     int* key_idx = build_side ? m_keyIdx : m_outKeyIdx;
     hashFileSource* file_source = build_side ? m_buildFileSource : m_probeFileSource;
 
@@ -1221,6 +1241,8 @@ void HashJoinTbl::SaveToDisk(VectorBatch* batch)
         }
     } else {
         for (i = 0; i < row; i++) {
+            if (sel != NULL && !sel[i])
+                continue;
             file_source->writeBatch(batch, i, DatumGetUInt32(m_cacheLoc[i]));
         }
     }
@@ -26,6 +26,7 @@
 #include "knl/knl_variable.h"
 
 #include "executor/executor.h"
+#include "vecexecutor/vecexecutor.h"
 #include "vecexecutor/vecnoderowtovector.h"
 #include "utils/memutils.h"
 #include "catalog/pg_type.h"
@@ -166,7 +167,8 @@ VectorBatch* ExecRowToVec(RowToVecState* state)
          * Vectorize one tuple and switch to ecxt_per_tuple_memory of
          * exprcontext.
          */
-        if (VectorizeOneTuple(batch, outer_slot, econtext->ecxt_per_tuple_memory)) {
+        if (VectorizeOneTuple(batch, outer_slot, econtext->ecxt_per_tuple_memory) ||
+            batch->m_rows >= VecBatchRows(&state->ps)) {
             /* It is full now, now return current batch */
             break;
         }
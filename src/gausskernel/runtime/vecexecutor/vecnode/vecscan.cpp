@@ -137,6 +137,7 @@ VectorBatch* ExecVecScan(ScanState* node, ExecVecScanAccessMtd accessMtd, /* fun
          * when the qual is nil ... saves only a few cycles, but they add up
          * ...
          */
+        batch->m_checkSel = false;
         econtext->ecxt_scanbatch = batch;
         if (qual == NULL || ExecVecQual(qual, econtext, false)) {
             /*
@@ -145,9 +146,15 @@ VectorBatch* ExecVecScan(ScanState* node, ExecVecScanAccessMtd accessMtd, /* fun
             result_batch = batch;
 
             /*
-             * The pack operator must be done defore the projection.
+             * If the parent takes batches in selection-vector mode, hand the
+             * qual result up instead of packing every column here; the
+             * projection then only evaluates the selected rows.  Otherwise
+             * the pack operator must be done defore the projection.
              */
-            if (econtext->ecxt_scanbatch->m_sel) {
+            if (qual != NULL && node->ps.vec_accept_sel && !econtext->have_vec_set_fun &&
+                !IsA(node->ps.plan, VecForeignScan)) {
+                batch->m_checkSel = true;
+            } else if (econtext->ecxt_scanbatch->m_sel) {
                 econtext->ecxt_scanbatch->Pack(econtext->ecxt_scanbatch->m_sel);
             }
 
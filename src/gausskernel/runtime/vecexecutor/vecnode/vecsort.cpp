@@ -309,6 +309,9 @@ VecSortState* ExecInitVecSort(Sort* node, EState* estate, int eflags)
 
     outerPlanState(sort_stat) = ExecInitNode(outerPlan(node), estate, eflags);
 
+    /* batchsort_putbatch skips the rows filtered out by a selection vector */
+    outerPlanState(sort_stat)->vec_accept_sel = true;
+
     /*
      * initialize tuple type.  no need to initialize projection info because
      * this node doesn't do projections.
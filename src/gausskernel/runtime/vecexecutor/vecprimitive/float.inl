@@ -28,6 +28,7 @@
 
 #include "vecexecutor/vechashtable.h"
 #include "utils/array.h"
+#include "vecexecutor/vecsimd.h"
 
 template <PGFunction floatFun>
 ScalarVector*
@@ -80,6 +81,31 @@ vfloat4_sop(PG_FUNCTION_ARGS)
     return PG_GETARG_VECTOR(3);
 }
 
+/*
+ * float8 comparisons run through the SIMD kernels, which keep the NaN
+ * ordering of float8_cmp_internal.
+ */
+template <SimpleOp sop>
+ScalarVector*
+vfloat8_sop(PG_FUNCTION_ARGS)
+{
+	ScalarValue*	parg1 = PG_GETARG_VECVAL(0);
+	ScalarValue*	parg2 = PG_GETARG_VECVAL(1);
+	int32       	nvalues = PG_GETARG_INT32(2);
+	ScalarValue*	presult = PG_GETARG_VECVAL(3);
+	uint8*  pflag = (uint8*)(PG_GETARG_VECTOR(3)->m_flag);
+	bool*        	pselection = PG_GETARG_SELECTION(4);
+	uint8*			pflags1 = (PG_GETARG_VECTOR(0)->m_flag);
+	uint8*			pflags2 = (PG_GETARG_VECTOR(1)->m_flag);
+
+	VEC_SIMD()->cmp[VEC_SIMD_FLOAT8_FLOAT8][sop](parg1, parg2, pflags1, pflags2, pselection, presult, pflag, nvalues);
+
+	PG_GETARG_VECTOR(3)->m_rows = nvalues;
+    PG_GETARG_VECTOR(3)->m_desc.typeId = BOOLOID;
+
+    return PG_GETARG_VECTOR(3);
+}
+
 /*
 * @Description: For each level of avg/stddev_samp, a final operation is needed
 * @in isTransition -  is the first stage of avg/stddev_samp. If so, input is int8 type, or array type.
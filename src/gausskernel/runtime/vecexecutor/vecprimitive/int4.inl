@@ -32,6 +32,7 @@
 #include "utils/array.h"
 #include "utils/biginteger.h"
 #include "vectorsonic/vsonichashagg.h"
+#include "vecexecutor/vecsimd.h"
 
 #define SAMESIGN(a,b)	(((a) < 0) == ((b) < 0))
 
@@ -53,38 +54,9 @@ vint_sop(PG_FUNCTION_ARGS)
 	bool*		pselection = PG_GETARG_SELECTION(4);
 	uint8*		pflags1 = (uint8*)(PG_GETARG_VECTOR(0)->m_flag);
 	uint8*		pflags2 = (uint8*)(PG_GETARG_VECTOR(1)->m_flag);
-	int          i;
-
 
-    if(likely(pselection == NULL))
-    {
-    	for (i = 0; i < nvalues; i++)
-		{
-			if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
-			{
-				presult[i] = eval_simple_op<sop, Datatype>((Datatype)parg1[i], (Datatype)parg2[i]);
-				SET_NOTNULL(pflag[i]);
-			}
-			else
-				SET_NULL(pflag[i]);
-		}
-    }
-	else
-	{
-		for (i = 0; i < nvalues; i++)
-		{
-			if(pselection[i])
-			{
-				if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
-				{
-					presult[i] = eval_simple_op<sop, Datatype>((Datatype)parg1[i], (Datatype)parg2[i]);
-					SET_NOTNULL(pflag[i]);
-				}
-			else
-				SET_NULL(pflag[i]);
-			}
-		}
-	}
+	VEC_SIMD()->cmp[vec_simd_int_arg_kind<Datatype, Datatype>()][sop](parg1, parg2, pflags1, pflags2,
+																	   pselection, presult, pflag, nvalues);
 
     PG_GETARG_VECTOR(3)->m_rows = nvalues;
     PG_GETARG_VECTOR(3)->m_desc.typeId = BOOLOID;
@@ -32,6 +32,7 @@
 #include "vecexecutor/vechashagg.h"
 #include "vectorsonic/vsonichashagg.h"
 #include "vectorsonic/vsonicarray.h"
+#include "vecexecutor/vecsimd.h"
 
 #define SAMESIGN(a,b)	(((a) < 0) == ((b) < 0))
 
@@ -47,38 +48,9 @@ vint8_sop(PG_FUNCTION_ARGS)
 	bool*		   pselection = PG_GETARG_SELECTION(4);
 	uint8*		pflags1 = (uint8*)(PG_GETARG_VECTOR(0)->m_flag);
 	uint8*		pflags2 = (uint8*)(PG_GETARG_VECTOR(1)->m_flag);
-	int          i;
 
-
-    if(likely(pselection == NULL))
-    {
-    	for (i = 0; i < nvalues; i++)
-		{
-			if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
-			{
-				presult[i] = eval_simple_op<sop, int64>((Datatype1)parg1[i], (Datatype2)parg2[i]);
-				SET_NOTNULL(pflag[i]);
-			}
-			else
-				SET_NULL(pflag[i]);
-		}
-    }
-	else
-	{
-		for (i = 0; i < nvalues; i++)
-		{
-			if(pselection[i])
-			{
-				if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
-				{
-					presult[i] = eval_simple_op<sop, int64>((Datatype1)parg1[i], (Datatype2)parg2[i]);
-					SET_NOTNULL(pflag[i]);
-				}
-				else
-					SET_NULL(pflag[i]);
-			}
-		}
-	}
+	VEC_SIMD()->cmp[vec_simd_int_arg_kind<Datatype1, Datatype2>()][sop](parg1, parg2, pflags1, pflags2,
+																		 pselection, presult, pflag, nvalues);
 
     PG_GETARG_VECTOR(3)->m_rows = nvalues;
     PG_GETARG_VECTOR(3)->m_desc.typeId = BOOLOID;
@@ -540,7 +512,10 @@ vint8mi(PG_FUNCTION_ARGS)
 	Datatype2	arg2;
     int64 		result;
 
-    if(likely(pselection == NULL))
+    /* int8 op int8 goes through the SIMD kernels */
+    if (sizeof(Datatype1) == sizeof(int64) && sizeof(Datatype2) == sizeof(int64))
+        mask = VEC_SIMD()->int8_sub(parg1, parg2, pflags1, pflags2, pselection, presult, pflagsRes, nvalues);
+    else if(likely(pselection == NULL))
    	{
    		for (i = 0; i < nvalues; i++)
    		{
@@ -610,7 +585,10 @@ vint8pl(PG_FUNCTION_ARGS)
 	Datatype2	arg2;
     int64 		result;
 
-	if(likely(pselection == NULL))
+	/* int8 op int8 goes through the SIMD kernels */
+	if (sizeof(Datatype1) == sizeof(int64) && sizeof(Datatype2) == sizeof(int64))
+		mask = VEC_SIMD()->int8_add(parg1, parg2, pflags1, pflags2, pselection, presult, pflagsRes, nvalues);
+	else if(likely(pselection == NULL))
 	{
 		for (i = 0; i < nvalues; i++)
 		{
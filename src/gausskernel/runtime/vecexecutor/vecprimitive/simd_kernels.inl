@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * simd_kernels.inl
+ *	  block drivers of the SIMD vector primitives.
+ *
+ * This file is included by vecsimd.cpp once per instruction set, inside the
+ * namespace and target region of that instruction set, which must already
+ * define the block primitives:
+ *
+ *	  CmpBlock<sop, kind>(a, b, res)	compare VEC_SIMD_BLOCK rows, false if
+ *										the block has to be redone row by row
+ *	  ArithBlock<is_add>(a, b, res)		int8 add/sub, true on overflow
+ *	  NonZeroMask(v)					bitmask of the nonzero rows
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/runtime/vecexecutor/vecprimitive/simd_kernels.inl
+ *
+ * -------------------------------------------------------------------------
+ */
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static void
+CmpKernel(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1, const uint8* pflags2,
+		  const bool* pselection, ScalarValue* presult, uint8* pflag, int nvalues)
+{
+	int i = 0;
+
+	for (; i + VEC_SIMD_BLOCK <= nvalues; i += VEC_SIMD_BLOCK)
+	{
+		if (vec_simd_block_dense(pflags1 + i, pflags2 + i, pselection, i) &&
+			CmpBlock<sop, kind>(parg1 + i, parg2 + i, presult + i))
+		{
+			vec_simd_block_set_notnull(pflag + i);
+			continue;
+		}
+
+		vec_simd_cmp_rows<sop, kind>(parg1, parg2, pflags1, pflags2, pselection, presult, pflag,
+									 i, i + VEC_SIMD_BLOCK);
+	}
+
+	vec_simd_cmp_rows<sop, kind>(parg1, parg2, pflags1, pflags2, pselection, presult, pflag, i, nvalues);
+}
+
+template <bool is_add>
+static bool
+ArithKernel(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1, const uint8* pflags2,
+			const bool* pselection, ScalarValue* presult, uint8* pflag, int nvalues)
+{
+	bool overflow = false;
+	int i = 0;
+
+	for (; i + VEC_SIMD_BLOCK <= nvalues; i += VEC_SIMD_BLOCK)
+	{
+		if (vec_simd_block_dense(pflags1 + i, pflags2 + i, pselection, i))
+		{
+			overflow |= ArithBlock<is_add>(parg1 + i, parg2 + i, presult + i);
+			vec_simd_block_set_notnull(pflag + i);
+			continue;
+		}
+
+		overflow |= vec_simd_arith_rows<is_add>(parg1, parg2, pflags1, pflags2, pselection, presult, pflag,
+												i, i + VEC_SIMD_BLOCK);
+	}
+
+	overflow |= vec_simd_arith_rows<is_add>(parg1, parg2, pflags1, pflags2, pselection, presult, pflag,
+											i, nvalues);
+	return overflow;
+}
+
+static bool
+QualKernel(const ScalarValue* pval, const uint8* pflag, bool* psel, int nrows, bool resultForNull)
+{
+	uint64	any = 0;
+	int		i = 0;
+
+	for (; i + VEC_SIMD_BLOCK <= nrows; i += VEC_SIMD_BLOCK)
+	{
+		uint64	selword = vec_simd_load_word(psel + i);
+		uint32	nullbits;
+		uint32	qualbits;
+
+		if (selword == 0)
+			continue;
+
+		nullbits = vec_simd_word_to_bits(vec_simd_load_word(pflag + i) & VEC_SIMD_NULL_WORD);
+		qualbits = (NonZeroMask(pval + i) & ~nullbits) | (resultForNull ? nullbits : 0);
+		selword &= vec_simd_bits_to_word(qualbits);
+		vec_simd_store_word(psel + i, selword);
+		any |= selword;
+	}
+
+	return vec_simd_qual_rows(pval, pflag, psel, i, nrows, resultForNull) || any != 0;
+}
+
+static void
+InitKernels(VecSimdKernels* kernels)
+{
+#define SET_CMP_KERNELS(kind)										\
+	do {															\
+		kernels->cmp[kind][SOP_EQ] = CmpKernel<SOP_EQ, kind>;		\
+		kernels->cmp[kind][SOP_NEQ] = CmpKernel<SOP_NEQ, kind>;		\
+		kernels->cmp[kind][SOP_LE] = CmpKernel<SOP_LE, kind>;		\
+		kernels->cmp[kind][SOP_LT] = CmpKernel<SOP_LT, kind>;		\
+		kernels->cmp[kind][SOP_GE] = CmpKernel<SOP_GE, kind>;		\
+		kernels->cmp[kind][SOP_GT] = CmpKernel<SOP_GT, kind>;		\
+	} while (0)
+
+	SET_CMP_KERNELS(VEC_SIMD_INT64_INT64);
+	SET_CMP_KERNELS(VEC_SIMD_INT32_INT32);
+	SET_CMP_KERNELS(VEC_SIMD_INT32_INT64);
+	SET_CMP_KERNELS(VEC_SIMD_INT64_INT32);
+	SET_CMP_KERNELS(VEC_SIMD_FLOAT8_FLOAT8);
+#undef SET_CMP_KERNELS
+
+	kernels->int8_add = ArithKernel<true>;
+	kernels->int8_sub = ArithKernel<false>;
+	kernels->qual_to_selection = QualKernel;
+}
@@ -0,0 +1,623 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * vecsimd.cpp
+ *        SIMD kernels for the vector engine primitives, chosen at runtime.
+ *
+ * Every ScalarValue is 64 bits wide whatever the column type, so one block of
+ * eight rows fills a single AVX-512 register, two AVX2 registers or four
+ * SSE registers.  int4 values are sign-extended from the low half of their
+ * ScalarValue before they are compared.  float8 blocks holding a NaN are
+ * left to the row-at-a-time code, which orders NaN above all other values
+ * like float8_cmp_internal does.
+ *
+ * Each instruction set is compiled with a GCC target pragma, so the file
+ * needs no special compiler flags and the binary still runs on CPUs without
+ * AVX.  The block drivers shared by all of them are in simd_kernels.inl.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/runtime/vecexecutor/vecsimd.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <math.h>
+
+#include "storage/barrier.h"
+#include "vecexecutor/vecsimd.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define VEC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/* V_NULL_MASK in every byte of a word of null flags */
+#define VEC_SIMD_NULL_WORD (UINT64CONST(0x0101010101010101) * V_NULL_MASK)
+/* true in every byte of a word of selection bools */
+#define VEC_SIMD_TRUE_WORD UINT64CONST(0x0101010101010101)
+
+const VecSimdKernels* volatile vec_simd_kernels = NULL;
+
+static inline uint64 vec_simd_load_word(const void* p)
+{
+    return *(const uint64*)p;
+}
+
+static inline void vec_simd_store_word(void* p, uint64 word)
+{
+    *(uint64*)p = word;
+}
+
+/* Gather the low bit of each byte of a word into an 8-bit mask */
+static inline uint32 vec_simd_word_to_bits(uint64 word)
+{
+    return (uint32)((word * UINT64CONST(0x0102040810204080)) >> 56);
+}
+
+/* Spread an 8-bit mask into a word holding 0 or 1 in each byte */
+static inline uint64 vec_simd_bits_to_word(uint32 bits)
+{
+    const uint64 low7 = UINT64CONST(0x7f7f7f7f7f7f7f7f);
+    uint64 word = ((uint64)bits * UINT64CONST(0x0101010101010101)) & UINT64CONST(0x8040201008040201);
+
+    return ((word | ((word & low7) + low7)) >> 7) & UINT64CONST(0x0101010101010101);
+}
+
+/*
+ * A block can be done with SIMD instructions when all of its rows are
+ * selected and neither argument is null in any of them.
+ */
+static inline bool vec_simd_block_dense(const uint8* pflags1, const uint8* pflags2, const bool* pselection, int start)
+{
+    if (((vec_simd_load_word(pflags1) | vec_simd_load_word(pflags2)) & VEC_SIMD_NULL_WORD) != 0)
+        return false;
+    return pselection == NULL || vec_simd_load_word(pselection + start) == VEC_SIMD_TRUE_WORD;
+}
+
+static inline void vec_simd_block_set_notnull(uint8* pflag)
+{
+    vec_simd_store_word(pflag, vec_simd_load_word(pflag) & ~VEC_SIMD_NULL_WORD);
+}
+
+static inline float8 vec_simd_float8(ScalarValue value)
+{
+    union {
+        ScalarValue value;
+        float8 f;
+    } u;
+
+    u.value = value;
+    return u.f;
+}
+
+/* same ordering as float8_cmp_internal: NaN equals NaN and sorts last */
+static inline int vec_simd_float8_cmp(float8 a, float8 b)
+{
+    if (isnan(a))
+        return isnan(b) ? 0 : 1;
+    if (isnan(b))
+        return -1;
+    return (a > b) ? 1 : ((a < b) ? -1 : 0);
+}
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static inline bool vec_simd_eval_row(ScalarValue arg1, ScalarValue arg2)
+{
+    switch (kind) {
+        case VEC_SIMD_INT32_INT32:
+            return eval_simple_op<sop, int64>((int32)arg1, (int32)arg2);
+        case VEC_SIMD_INT32_INT64:
+            return eval_simple_op<sop, int64>((int32)arg1, (int64)arg2);
+        case VEC_SIMD_INT64_INT32:
+            return eval_simple_op<sop, int64>((int64)arg1, (int32)arg2);
+        case VEC_SIMD_FLOAT8_FLOAT8:
+            return eval_simple_op<sop, int>(vec_simd_float8_cmp(vec_simd_float8(arg1), vec_simd_float8(arg2)), 0);
+        default:
+            return eval_simple_op<sop, int64>((int64)arg1, (int64)arg2);
+    }
+}
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static void vec_simd_cmp_rows(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1,
+    const uint8* pflags2, const bool* pselection, ScalarValue* presult, uint8* pflag, int start, int end)
+{
+    for (int i = start; i < end; i++) {
+        if (pselection != NULL && !pselection[i])
+            continue;
+
+        if (BOTH_NOT_NULL(pflags1[i], pflags2[i])) {
+            presult[i] = vec_simd_eval_row<sop, kind>(parg1[i], parg2[i]);
+            SET_NOTNULL(pflag[i]);
+        } else
+            SET_NULL(pflag[i]);
+    }
+}
+
+template <bool is_add>
+static inline uint64 vec_simd_arith_row(int64 arg1, int64 arg2, ScalarValue* result)
+{
+    int64 res = is_add ? (int64)((uint64)arg1 + (uint64)arg2) : (int64)((uint64)arg1 - (uint64)arg2);
+
+    *result = (ScalarValue)res;
+    /* sign bit set on overflow, same test as SAMESIGN in vint8pl and vint8mi */
+    return is_add ? (uint64)((arg1 ^ res) & (arg2 ^ res)) : (uint64)((arg1 ^ arg2) & (arg1 ^ res));
+}
+
+template <bool is_add>
+static bool vec_simd_arith_rows(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1,
+    const uint8* pflags2, const bool* pselection, ScalarValue* presult, uint8* pflag, int start, int end)
+{
+    uint64 overflow = 0;
+
+    for (int i = start; i < end; i++) {
+        if (pselection != NULL && !pselection[i])
+            continue;
+
+        if (BOTH_NOT_NULL(pflags1[i], pflags2[i])) {
+            overflow |= vec_simd_arith_row<is_add>((int64)parg1[i], (int64)parg2[i], &presult[i]);
+            SET_NOTNULL(pflag[i]);
+        } else
+            SET_NULL(pflag[i]);
+    }
+
+    return (int64)overflow < 0;
+}
+
+static bool vec_simd_qual_rows(
+    const ScalarValue* pval, const uint8* pflag, bool* psel, int start, int end, bool resultForNull)
+{
+    bool res = false;
+
+    for (int i = start; i < end; i++) {
+        if (NOT_NULL(pflag[i]))
+            psel[i] = psel[i] && pval[i];
+        else
+            psel[i] = psel[i] && resultForNull;
+
+        res = res || psel[i];
+    }
+
+    return res;
+}
+
+/*
+ * Scalar level: no SIMD instructions, but dense blocks still skip the
+ * per-row null and selection tests.
+ */
+namespace vec_simd_scalar {
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static inline bool CmpBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    for (int i = 0; i < VEC_SIMD_BLOCK; i++)
+        res[i] = vec_simd_eval_row<sop, kind>(arg1[i], arg2[i]);
+    return true;
+}
+
+template <bool is_add>
+static inline bool ArithBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    uint64 overflow = 0;
+
+    for (int i = 0; i < VEC_SIMD_BLOCK; i++)
+        overflow |= vec_simd_arith_row<is_add>((int64)arg1[i], (int64)arg2[i], &res[i]);
+    return (int64)overflow < 0;
+}
+
+static inline uint32 NonZeroMask(const ScalarValue* val)
+{
+    uint32 bits = 0;
+
+    for (int i = 0; i < VEC_SIMD_BLOCK; i++)
+        bits |= (uint32)(val[i] != 0) << i;
+    return bits;
+}
+
+#include "vecprimitive/simd_kernels.inl"
+
+}  // namespace vec_simd_scalar
+
+#ifdef VEC_SIMD_X86
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+
+namespace vec_simd_sse42 {
+
+template <VecSimdArgKind kind, bool first>
+static inline __m128i LoadArg(const ScalarValue* p)
+{
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    bool is_int32 = first ? (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT32_INT64)
+                          : (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT64_INT32);
+
+    if (is_int32)
+        v = _mm_cvtepi32_epi64(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 0, 2, 0)));
+    return v;
+}
+
+/* compare two lanes, returning the lanes that satisfy sop as all-ones */
+template <SimpleOp sop>
+static inline __m128i CmpInt(__m128i a, __m128i b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm_cmpeq_epi64(a, b);
+        case SOP_NEQ:
+            return _mm_xor_si128(_mm_cmpeq_epi64(a, b), _mm_set1_epi64x(-1));
+        case SOP_LT:
+            return _mm_cmpgt_epi64(b, a);
+        case SOP_LE:
+            return _mm_xor_si128(_mm_cmpgt_epi64(a, b), _mm_set1_epi64x(-1));
+        case SOP_GT:
+            return _mm_cmpgt_epi64(a, b);
+        default:
+            return _mm_xor_si128(_mm_cmpgt_epi64(b, a), _mm_set1_epi64x(-1));
+    }
+}
+
+template <SimpleOp sop>
+static inline __m128i CmpFloat(__m128d a, __m128d b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm_castpd_si128(_mm_cmpeq_pd(a, b));
+        case SOP_NEQ:
+            return _mm_castpd_si128(_mm_cmpneq_pd(a, b));
+        case SOP_LT:
+            return _mm_castpd_si128(_mm_cmplt_pd(a, b));
+        case SOP_LE:
+            return _mm_castpd_si128(_mm_cmple_pd(a, b));
+        case SOP_GT:
+            return _mm_castpd_si128(_mm_cmpgt_pd(a, b));
+        default:
+            return _mm_castpd_si128(_mm_cmpge_pd(a, b));
+    }
+}
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static inline bool CmpBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __m128i mask[VEC_SIMD_BLOCK / 2];
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 2; i++) {
+        if (kind == VEC_SIMD_FLOAT8_FLOAT8) {
+            __m128d a = _mm_loadu_pd((const double*)(arg1 + 2 * i));
+            __m128d b = _mm_loadu_pd((const double*)(arg2 + 2 * i));
+
+            if (_mm_movemask_pd(_mm_cmpunord_pd(a, b)) != 0)
+                return false;
+            mask[i] = CmpFloat<sop>(a, b);
+        } else {
+            mask[i] = CmpInt<sop>(LoadArg<kind, true>(arg1 + 2 * i), LoadArg<kind, false>(arg2 + 2 * i));
+        }
+    }
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 2; i++)
+        _mm_storeu_si128((__m128i*)(res + 2 * i), _mm_srli_epi64(mask[i], 63));
+    return true;
+}
+
+template <bool is_add>
+static inline bool ArithBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __m128i overflow = _mm_setzero_si128();
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 2; i++) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(arg1 + 2 * i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(arg2 + 2 * i));
+        __m128i r = is_add ? _mm_add_epi64(a, b) : _mm_sub_epi64(a, b);
+
+        if (is_add)
+            overflow = _mm_or_si128(overflow, _mm_and_si128(_mm_xor_si128(a, r), _mm_xor_si128(b, r)));
+        else
+            overflow = _mm_or_si128(overflow, _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, r)));
+        _mm_storeu_si128((__m128i*)(res + 2 * i), r);
+    }
+
+    return _mm_movemask_pd(_mm_castsi128_pd(overflow)) != 0;
+}
+
+static inline uint32 NonZeroMask(const ScalarValue* val)
+{
+    uint32 zero = 0;
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 2; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(val + 2 * i));
+
+        zero |= (uint32)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(v, _mm_setzero_si128()))) << (2 * i);
+    }
+    return ~zero & 0xff;
+}
+
+#include "vecprimitive/simd_kernels.inl"
+
+}  // namespace vec_simd_sse42
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace vec_simd_avx2 {
+
+template <VecSimdArgKind kind, bool first>
+static inline __m256i LoadArg(const ScalarValue* p)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    bool is_int32 = first ? (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT32_INT64)
+                          : (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT64_INT32);
+
+    if (is_int32) {
+        __m256i low = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        v = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(low));
+    }
+    return v;
+}
+
+template <SimpleOp sop>
+static inline __m256i CmpInt(__m256i a, __m256i b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm256_cmpeq_epi64(a, b);
+        case SOP_NEQ:
+            return _mm256_xor_si256(_mm256_cmpeq_epi64(a, b), _mm256_set1_epi64x(-1));
+        case SOP_LT:
+            return _mm256_cmpgt_epi64(b, a);
+        case SOP_LE:
+            return _mm256_xor_si256(_mm256_cmpgt_epi64(a, b), _mm256_set1_epi64x(-1));
+        case SOP_GT:
+            return _mm256_cmpgt_epi64(a, b);
+        default:
+            return _mm256_xor_si256(_mm256_cmpgt_epi64(b, a), _mm256_set1_epi64x(-1));
+    }
+}
+
+template <SimpleOp sop>
+static inline __m256i CmpFloat(__m256d a, __m256d b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+        case SOP_NEQ:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_NEQ_OQ));
+        case SOP_LT:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+        case SOP_LE:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LE_OQ));
+        case SOP_GT:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GT_OQ));
+        default:
+            return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GE_OQ));
+    }
+}
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static inline bool CmpBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __m256i mask[VEC_SIMD_BLOCK / 4];
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 4; i++) {
+        if (kind == VEC_SIMD_FLOAT8_FLOAT8) {
+            __m256d a = _mm256_loadu_pd((const double*)(arg1 + 4 * i));
+            __m256d b = _mm256_loadu_pd((const double*)(arg2 + 4 * i));
+
+            if (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_UNORD_Q)) != 0)
+                return false;
+            mask[i] = CmpFloat<sop>(a, b);
+        } else {
+            mask[i] = CmpInt<sop>(LoadArg<kind, true>(arg1 + 4 * i), LoadArg<kind, false>(arg2 + 4 * i));
+        }
+    }
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 4; i++)
+        _mm256_storeu_si256((__m256i*)(res + 4 * i), _mm256_srli_epi64(mask[i], 63));
+    return true;
+}
+
+template <bool is_add>
+static inline bool ArithBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __m256i overflow = _mm256_setzero_si256();
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 4; i++) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(arg1 + 4 * i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(arg2 + 4 * i));
+        __m256i r = is_add ? _mm256_add_epi64(a, b) : _mm256_sub_epi64(a, b);
+
+        if (is_add)
+            overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(a, r), _mm256_xor_si256(b, r)));
+        else
+            overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, r)));
+        _mm256_storeu_si256((__m256i*)(res + 4 * i), r);
+    }
+
+    return _mm256_movemask_pd(_mm256_castsi256_pd(overflow)) != 0;
+}
+
+static inline uint32 NonZeroMask(const ScalarValue* val)
+{
+    uint32 zero = 0;
+
+    for (int i = 0; i < VEC_SIMD_BLOCK / 4; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(val + 4 * i));
+
+        zero |= (uint32)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, _mm256_setzero_si256())))
+                << (4 * i);
+    }
+    return ~zero & 0xff;
+}
+
+#include "vecprimitive/simd_kernels.inl"
+
+}  // namespace vec_simd_avx2
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace vec_simd_avx512 {
+
+template <VecSimdArgKind kind, bool first>
+static inline __m512i LoadArg(const ScalarValue* p)
+{
+    __m512i v = _mm512_loadu_si512((const void*)p);
+    bool is_int32 = first ? (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT32_INT64)
+                          : (kind == VEC_SIMD_INT32_INT32 || kind == VEC_SIMD_INT64_INT32);
+
+    if (is_int32)
+        v = _mm512_cvtepi32_epi64(_mm512_cvtepi64_epi32(v));
+    return v;
+}
+
+template <SimpleOp sop>
+static inline __mmask8 CmpInt(__m512i a, __m512i b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_EQ);
+        case SOP_NEQ:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NE);
+        case SOP_LT:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LT);
+        case SOP_LE:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LE);
+        case SOP_GT:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NLE);
+        default:
+            return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NLT);
+    }
+}
+
+template <SimpleOp sop>
+static inline __mmask8 CmpFloat(__m512d a, __m512d b)
+{
+    switch (sop) {
+        case SOP_EQ:
+            return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+        case SOP_NEQ:
+            return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_OQ);
+        case SOP_LT:
+            return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+        case SOP_LE:
+            return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+        case SOP_GT:
+            return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+        default:
+            return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+    }
+}
+
+template <SimpleOp sop, VecSimdArgKind kind>
+static inline bool CmpBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __mmask8 mask;
+
+    if (kind == VEC_SIMD_FLOAT8_FLOAT8) {
+        __m512d a = _mm512_loadu_pd((const void*)arg1);
+        __m512d b = _mm512_loadu_pd((const void*)arg2);
+
+        if (_mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q) != 0)
+            return false;
+        mask = CmpFloat<sop>(a, b);
+    } else {
+        mask = CmpInt<sop>(LoadArg<kind, true>(arg1), LoadArg<kind, false>(arg2));
+    }
+
+    _mm512_storeu_si512((void*)res, _mm512_maskz_mov_epi64(mask, _mm512_set1_epi64(1)));
+    return true;
+}
+
+template <bool is_add>
+static inline bool ArithBlock(const ScalarValue* arg1, const ScalarValue* arg2, ScalarValue* res)
+{
+    __m512i a = _mm512_loadu_si512((const void*)arg1);
+    __m512i b = _mm512_loadu_si512((const void*)arg2);
+    __m512i r = is_add ? _mm512_add_epi64(a, b) : _mm512_sub_epi64(a, b);
+    __m512i overflow = is_add ? _mm512_and_si512(_mm512_xor_si512(a, r), _mm512_xor_si512(b, r))
+                              : _mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, r));
+
+    _mm512_storeu_si512((void*)res, r);
+    return _mm512_cmp_epi64_mask(overflow, _mm512_setzero_si512(), _MM_CMPINT_LT) != 0;
+}
+
+static inline uint32 NonZeroMask(const ScalarValue* val)
+{
+    __m512i v = _mm512_loadu_si512((const void*)val);
+
+    return (uint32)_mm512_test_epi64_mask(v, v);
+}
+
+#include "vecprimitive/simd_kernels.inl"
+
+}  // namespace vec_simd_avx512
+
+#pragma GCC pop_options
+
+#endif /* VEC_SIMD_X86 */
+
+static VecSimdKernels vec_simd_kernel_table;
+
+static VecSimdLevel vec_simd_detect(void)
+{
+#ifdef VEC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return VEC_SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return VEC_SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return VEC_SIMD_SSE42;
+#endif
+    return VEC_SIMD_SCALAR;
+}
+
+/*
+ * Pick the kernels for this CPU.  Called while the instance starts up, before
+ * any worker thread exists; later callers just get the published table.
+ */
+const VecSimdKernels* vec_simd_choose(void)
+{
+    VecSimdKernels* kernels = &vec_simd_kernel_table;
+
+    if (vec_simd_kernels != NULL)
+        return vec_simd_kernels;
+
+    kernels->level = vec_simd_detect();
+    switch (kernels->level) {
+#ifdef VEC_SIMD_X86
+        case VEC_SIMD_AVX512:
+            vec_simd_avx512::InitKernels(kernels);
+            break;
+        case VEC_SIMD_AVX2:
+            vec_simd_avx2::InitKernels(kernels);
+            break;
+        case VEC_SIMD_SSE42:
+            vec_simd_sse42::InitKernels(kernels);
+            break;
+#endif
+        default:
+            vec_simd_scalar::InitKernels(kernels);
+            break;
+    }
+
+    pg_memory_barrier();
+    vec_simd_kernels = kernels;
+    return kernels;
+}
@@ -549,6 +549,36 @@ void VectorBatch::Pack(const bool* sel)
         PackT<true, true>(sel);
 }
 
+/*
+ * @Description	: Pack the rows of a batch in selection-vector mode, for consumers
+ *				  that need dense data.
+ */
+void VectorBatch::Compact()
+{
+    if (!m_checkSel)
+        return;
+
+    Pack(m_sel);
+    m_checkSel = false;
+}
+
+/*
+ * @Description	: Count the rows that survive the selection vector.
+ * @return		: m_rows if the batch is not in selection-vector mode.
+ */
+int VectorBatch::SelectedRows()
+{
+    int rows = 0;
+
+    if (!m_checkSel)
+        return m_rows;
+
+    for (int i = 0; i < m_rows; i++)
+        rows += m_sel[i] ? 1 : 0;
+
+    return rows;
+}
+
 void VectorBatch::CreateSysColContainer(MemoryContext cxt, List* sys_var_list)
 {
     ListCell* c = NULL;
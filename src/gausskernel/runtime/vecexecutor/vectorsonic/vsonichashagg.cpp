@@ -433,6 +433,12 @@ SonicHashAgg::SonicHashAgg(VecAggState* runtime, int arrSize) : SonicHash(arrSiz
     /* binding build function */
     BindingFp();
 
+    /*
+     * buildAggTblBatch leaves the filtered rows of a selection vector out of
+     * the hash table, the codegened aggregation does not know about it.
+     */
+    outerPlanState(runtime)->vec_accept_sel = (runtime->jitted_sonicbatchagg == NULL);
+
     if (m_runtime->ss.ps.instrument) {
         m_runtime->ss.ps.instrument->sorthashinfo.hashtable_expand_times = 0;
     }
@@ -1338,7 +1344,9 @@ void SonicHashAgg::buildAggTblBatch(VectorBatch* batch)
     instr_time start_time;
     int krows = 0;
     int miss_idx = 0;
+    int skipped = 0;
     errno_t rc = 0;
+    const bool* sel = SelectionVector(batch);
 
     uint32* hash_val = NULL;
     uint32 hash_loc;
@@ -1359,6 +1367,13 @@ void SonicHashAgg::buildAggTblBatch(VectorBatch* batch)
 
     /* seperate tuples that missed and matched */
     for (i = 0; i < rows; i++) {
+        /* a filtered row gets no location, the agg functions skip it */
+        if (sel != NULL && !sel[i]) {
+            m_loc[i] = 0;
+            skipped++;
+            continue;
+        }
+
         hash_loc = hash_val[i] & mask;
 
         if (!useSegHashTable) {
@@ -1412,7 +1427,7 @@ void SonicHashAgg::buildAggTblBatch(VectorBatch* batch)
         m_suspectNum = krows;
     }
 
-    Assert(m_missNum + matched == rows);
+    Assert(m_missNum + matched + skipped == rows);
 
     /* last we got the miss list, we must insert into the hashtable. */
     bool keymatch = true;
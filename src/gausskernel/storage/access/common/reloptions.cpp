@@ -85,6 +85,7 @@ static relopt_bool boolRelOpts[] = {
     {{"multi_zall", "segmente all word from long words in zhparser text search praser", RELOPT_KIND_ZHPARSER}, false},
     {{"ignore_enable_hadoop_env", "ignore enable_hadoop_env option", RELOPT_KIND_HEAP}, false},
     {{"hashbucket", "Enables hashbucket in this relation", RELOPT_KIND_HEAP}, false},
+    {{"cu_sketch", "Keeps a bloom filter and a distinct count sketch of every CU", RELOPT_KIND_HEAP}, false},
     {{"on_commit_delete_rows", "global temp table on commit options", RELOPT_KIND_HEAP}, true},
     /* list terminator */
     {{NULL}}};
@@ -1361,7 +1362,8 @@ static void tsstore_tbl_check_compression_option(List* options)
 void ForbidToSetOptionsForRowTbl(List* options)
 {
     /* row relation's unsupported options */
-    static const char* unsupported[] = {"max_batchrow", "deltarow_threshold", "partial_cluster_rows", "compresslevel"};
+    static const char* unsupported[] = {
+        "max_batchrow", "deltarow_threshold", "partial_cluster_rows", "compresslevel", "cu_sketch"};
 
     /* check relation's options for row table */
     ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "row relation");
@@ -1410,7 +1412,8 @@ void forbid_to_set_options_for_timeseries_tbl(List* options)
 		"max_batchrow",
 		"deltarow_threshold",
 		"partial_cluster_rows",
-		"compresslevel"
+		"compresslevel",
+		"cu_sketch"
 	};
 
 	ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "timeseries relation");
@@ -1503,6 +1506,7 @@ bytea* default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         {"end_ctid_internal", RELOPT_TYPE_STRING, offsetof(StdRdOptions, end_ctid_internal)},
         {"user_catalog_table", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, user_catalog_table)},
         {"hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket)},
+        {"cu_sketch", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, cu_sketch)},
         {"on_commit_delete_rows", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, on_commit_delete_rows)},
         {"wait_clean_gpi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_gpi)}};
 
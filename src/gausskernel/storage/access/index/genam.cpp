@@ -104,6 +104,7 @@ IndexScanDesc RelationGetIndexScan(Relation index_relation, int nkeys, int norde
         scan->orderByData = NULL;
 
     scan->xs_want_itup = false; /* may be set later */
+    scan->parallel_scan = NULL; /* may be set later */
 
     /*
      * During recovery we ignore killed tuples and don't bother to kill them
@@ -16,6 +16,10 @@
  *		index_close		- close an index relation
  *		index_beginscan - start a scan of an index with amgettuple
  *		index_beginscan_bitmap - start a scan of an index with amgetbitmap
+ *		index_parallelscan_estimate - estimate shared memory for parallel scan
+ *		index_parallelscan_initialize - initialize parallel scan
+ *		index_parallelscan_attach - join a scan to a parallel scan
+ *		index_parallelrescan  - (re)start a parallel scan of an index
  *		index_rescan	- restart a scan of an index
  *		index_endscan	- end a scan
  *		index_insert	- insert an index tuple into a relation
@@ -67,12 +71,14 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/nbtree.h"
 #include "access/relscan.h"
 #include "access/transam.h"
 #include "access/tableam.h"
 #include "access/xlog.h"
 #include "catalog/index.h"
 #include "catalog/catalog.h"
+#include "catalog/pg_am.h"
 #include "pgstat.h"
 #include "replication/bcm.h"
 #include "replication/dataqueue.h"
@@ -289,6 +295,73 @@ IndexScanDesc index_beginscan_bitmap(Relation index_relation, Snapshot snapshot,
     return scan;
 }
 
+/*
+ * index_parallelscan_estimate - estimate shared memory for parallel scan
+ *
+ * Parallel scans are only supported by btree.  There is no pg_am entry for
+ * them, so the planner checks the access method before generating a
+ * parallel-aware index path, and we check it again here.
+ */
+Size index_parallelscan_estimate(Relation index_relation)
+{
+    RELATION_CHECKS;
+
+    if (index_relation->rd_rel->relam != BTREE_AM_OID) {
+        ereport(ERROR,
+            (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("index \"%s\" does not support parallel scans", RelationGetRelationName(index_relation))));
+    }
+
+    return add_size(MAXALIGN(sizeof(ParallelIndexScanDescData)), btestimateparallelscan());
+}
+
+/*
+ * index_parallelscan_initialize - initialize parallel scan
+ *
+ * The caller has allocated index_parallelscan_estimate() bytes at target.
+ */
+void index_parallelscan_initialize(Relation heap_relation, Relation index_relation, ParallelIndexScanDesc target)
+{
+    RELATION_CHECKS;
+
+    target->ps_relid = RelationGetRelid(heap_relation);
+    target->ps_indexid = RelationGetRelid(index_relation);
+    target->ps_offset = MAXALIGN(sizeof(ParallelIndexScanDescData));
+
+    btinitparallelscan(ParallelIndexScanGetAMState(target));
+}
+
+/*
+ * index_parallelscan_attach - make a scan take part in a parallel scan
+ *
+ * Must be called before the first tuple is fetched; from then on the scan
+ * only returns the tuples of the index pages it claimed from pscan.
+ */
+void index_parallelscan_attach(IndexScanDesc scan, ParallelIndexScanDesc pscan)
+{
+    SCAN_CHECKS;
+
+    Assert(RelationGetRelid(scan->indexRelation) == pscan->ps_indexid);
+    Assert(scan->heapRelation == NULL || RelationGetRelid(scan->heapRelation) == pscan->ps_relid);
+
+    scan->parallel_scan = pscan;
+}
+
+/*
+ * index_parallelrescan - (re)start a parallel scan of an index
+ *
+ * Resets the shared scan position.  Only the leader may call this, while no
+ * workers are running.
+ */
+void index_parallelrescan(IndexScanDesc scan)
+{
+    SCAN_CHECKS;
+
+    if (scan->parallel_scan != NULL) {
+        btparallelrescan(scan);
+    }
+}
+
 /*
  * index_beginscan_internal --- common code for index_beginscan variants
  */
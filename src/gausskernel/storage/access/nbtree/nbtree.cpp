@@ -27,6 +27,7 @@
 #include "storage/indexfsm.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
+#include "storage/shm_condvar.h"
 #include "storage/smgr.h"
 #include "tcop/tcopprot.h"
 #include "utils/aiomem.h"
@@ -48,6 +49,38 @@ typedef struct {
     MemoryContext pagedelcontext;
 } BTVacState;
 
+/*
+ * BTPARALLEL_NOT_INITIALIZED indicates that the scan has not started.
+ *
+ * BTPARALLEL_ADVANCING indicates that some process is advancing the scan to
+ * a new page; others must wait.
+ *
+ * BTPARALLEL_IDLE indicates that no backend is currently advancing the scan
+ * to a new page; some process can start doing that.
+ *
+ * BTPARALLEL_DONE indicates that the scan is complete (including error exit).
+ */
+typedef enum {
+    BTPARALLEL_NOT_INITIALIZED,
+    BTPARALLEL_ADVANCING,
+    BTPARALLEL_IDLE,
+    BTPARALLEL_DONE
+} BTPS_State;
+
+/*
+ * BTParallelScanDescData contains btree specific shared information required
+ * for parallel scan.
+ */
+typedef struct BTParallelScanDescData {
+    BlockNumber btps_scanPage;      /* latest or next page to be scanned */
+    BTPS_State btps_pageStatus;     /* indicates whether next page is available
+                                     * for scan. see above for possible states */
+    ShmConditionVariable btps_cv;   /* protects the fields above, used to
+                                     * synchronize parallel scan */
+} BTParallelScanDescData;
+
+typedef struct BTParallelScanDescData* BTParallelScanDesc;
+
 static void btbuildCallback(
     Relation index, HeapTuple htup, Datum* values, const bool* isnull, bool tupleIsAlive, void* state);
 static void btvacuumscan(IndexVacuumInfo* info, IndexBulkDeleteResult* stats, IndexBulkDeleteCallback callback,
@@ -505,6 +538,132 @@ Datum btrescan(PG_FUNCTION_ARGS)
     PG_RETURN_VOID();
 }
 
+/*
+ *	btestimateparallelscan() -- estimate storage for BTParallelScanDescData
+ */
+Size btestimateparallelscan(void)
+{
+    return sizeof(BTParallelScanDescData);
+}
+
+/*
+ *	btinitparallelscan() -- initialize BTParallelScanDesc for parallel btree scan
+ */
+void btinitparallelscan(void* target)
+{
+    BTParallelScanDesc bt_target = (BTParallelScanDesc)target;
+
+    ShmCondVarInit(&bt_target->btps_cv);
+    bt_target->btps_scanPage = InvalidBlockNumber;
+    bt_target->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
+}
+
+/*
+ *	btparallelrescan() -- reset parallel scan
+ *
+ * Called by the leader while no worker is attached to the scan.
+ */
+void btparallelrescan(IndexScanDesc scan)
+{
+    ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+
+    Assert(parallel_scan != NULL);
+
+    BTParallelScanDesc btscan = (BTParallelScanDesc)ParallelIndexScanGetAMState(parallel_scan);
+
+    ShmCondVarLock(&btscan->btps_cv);
+    btscan->btps_scanPage = InvalidBlockNumber;
+    btscan->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
+    ShmCondVarUnlock(&btscan->btps_cv);
+}
+
+/*
+ * _bt_parallel_seize() -- Begin the process of advancing the scan to a new
+ *		page.  Other scans must wait until we call _bt_parallel_release() or
+ *		_bt_parallel_done().
+ *
+ * The return value is true if we successfully seized the scan and false
+ * if we did not.  The latter case occurs if no pages remain.
+ *
+ * If the return value is true, *pageno returns the next or current page
+ * of the scan (depending on the scan direction).  An invalid block number
+ * means the scan hasn't yet started, and P_NONE means we've reached the end.
+ * The first time a participant in the scan reaches the end of the scan, it
+ * will return true and set *pageno to P_NONE; after that, further attempts
+ * to seize the scan will return false.
+ */
+bool _bt_parallel_seize(IndexScanDesc scan, BlockNumber* pageno)
+{
+    ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+    BTParallelScanDesc btscan = (BTParallelScanDesc)ParallelIndexScanGetAMState(parallel_scan);
+    bool status = true;
+
+    *pageno = P_NONE;
+
+    ShmCondVarLock(&btscan->btps_cv);
+    while (btscan->btps_pageStatus == BTPARALLEL_ADVANCING) {
+        ShmCondVarWait(&btscan->btps_cv);
+    }
+    if (btscan->btps_pageStatus == BTPARALLEL_DONE) {
+        /* We're done with this set of scankeys */
+        status = false;
+    } else {
+        /* We have successfully seized control of the scan for advancing it */
+        btscan->btps_pageStatus = BTPARALLEL_ADVANCING;
+        *pageno = btscan->btps_scanPage;
+    }
+    ShmCondVarUnlock(&btscan->btps_cv);
+
+    return status;
+}
+
+/*
+ * _bt_parallel_release() -- Complete the process of advancing the scan to a
+ *		new page.  We now have the new value btps_scanPage; some other backend
+ *		can now begin advancing the scan.
+ */
+void _bt_parallel_release(IndexScanDesc scan, BlockNumber scan_page)
+{
+    ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+    BTParallelScanDesc btscan = (BTParallelScanDesc)ParallelIndexScanGetAMState(parallel_scan);
+
+    ShmCondVarLock(&btscan->btps_cv);
+    btscan->btps_scanPage = scan_page;
+    btscan->btps_pageStatus = BTPARALLEL_IDLE;
+    ShmCondVarBroadcast(&btscan->btps_cv);
+    ShmCondVarUnlock(&btscan->btps_cv);
+}
+
+/*
+ * _bt_parallel_done() -- Mark the parallel scan as complete.
+ *
+ * When there are no pages left to scan, this function should be called to
+ * notify other workers.  Otherwise, they might wait forever for the scan to
+ * advance to the next page.
+ */
+void _bt_parallel_done(IndexScanDesc scan)
+{
+    ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+
+    /* Do nothing, for non-parallel scans */
+    if (parallel_scan == NULL) {
+        return;
+    }
+
+    BTParallelScanDesc btscan = (BTParallelScanDesc)ParallelIndexScanGetAMState(parallel_scan);
+
+    /*
+     * Mark the parallel scan as done, unless some other process did so
+     * already.
+     */
+    ShmCondVarLock(&btscan->btps_cv);
+    if (btscan->btps_pageStatus != BTPARALLEL_DONE) {
+        btscan->btps_pageStatus = BTPARALLEL_DONE;
+        ShmCondVarBroadcast(&btscan->btps_cv);
+    }
+    ShmCondVarUnlock(&btscan->btps_cv);
+}
+
 /*
  *	btendscan() -- close down a scan
  */
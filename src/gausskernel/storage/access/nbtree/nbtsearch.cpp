@@ -32,6 +32,7 @@
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum);
 static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid);
 static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
+static bool _bt_parallel_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir);
 static Buffer _bt_walk_left(Relation rel, Buffer buf);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
 
@@ -486,8 +487,45 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
      * Quit now if _bt_preprocess_keys() discovered that the scan keys can
      * never be satisfied (eg, x == 1 AND x > 2).
      */
-    if (!so->qual_ok)
+    if (!so->qual_ok) {
+        _bt_parallel_done(scan);
         return false;
+    }
+
+    /*
+     * For parallel scans, get the starting page from shared state. If the
+     * scan has not started, proceed to find out first leaf page in the usual
+     * way while keeping other participating processes waiting.  If the scan
+     * has already begun, use the page number from the shared structure.
+     *
+     * Parallel scans are forward only and do not support array keys; the
+     * planner never generates such a partial path.
+     */
+    if (scan->parallel_scan != NULL) {
+        BlockNumber blkno;
+
+        if (!ScanDirectionIsForward(dir) || so->numArrayKeys != 0) {
+            ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("parallel index scan supports only forward scans without array keys")));
+        }
+
+        if (!_bt_parallel_seize(scan, &blkno))
+            return false;
+        if (blkno == P_NONE) {
+            _bt_parallel_done(scan);
+            return false;
+        }
+        if (blkno != InvalidBlockNumber) {
+            so->currPos.moreLeft = false;
+            so->currPos.moreRight = true;
+            so->numKilled = 0;      /* just paranoia */
+            so->markItemIndex = -1; /* ditto */
+            if (!_bt_parallel_readnextpage(scan, blkno, dir))
+                return false;
+            goto readcomplete;
+        }
+    }
 
     /* ----------
      * Examine the scan keys to discover where we need to start the scan.
@@ -681,8 +719,10 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
              */
             ScanKey subkey = (ScanKey)DatumGetPointer(cur->sk_argument);
             Assert(subkey->sk_flags & SK_ROW_MEMBER);
-            if (subkey->sk_flags & SK_ISNULL)
+            if (subkey->sk_flags & SK_ISNULL) {
+                _bt_parallel_done(scan);
                 return false;
+            }
             scankeys[i] = *subkey;
 
             /*
@@ -892,6 +932,7 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
          * because nothing finer to lock exists.
          */
         PredicateLockRelation(rel, scan->xs_snapshot);
+        _bt_parallel_done(scan);
         return false;
     } else
         PredicateLockPage(rel, BufferGetBlockNumber(buf), scan->xs_snapshot);
@@ -943,6 +984,7 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
             return false;
     }
 
+readcomplete:
     /* Drop the lock, but not pin, on the current page */
     LockBuffer(so->currPos.buf, BUFFER_LOCK_UNLOCK);
 
@@ -1063,6 +1105,15 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
     minoff = P_FIRSTDATAKEY(opaque);
     maxoff = PageGetMaxOffsetNumber(page);
 
+    /*
+     * In a parallel scan, let the next participant move on to the right
+     * sibling while we read this page.
+     */
+    if (scan->parallel_scan != NULL) {
+        Assert(ScanDirectionIsForward(dir));
+        _bt_parallel_release(scan, opaque->btpo_next);
+    }
+
     /*
      * we must save the page's right-link while scanning it; this tells us
      * where to step right to after we're done with these items.  There is no
@@ -1216,6 +1267,15 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
         /* Remember we left a page with data */
         so->currPos.moreLeft = true;
 
+        /* In a parallel scan, the next page to read comes from shared state */
+        if (scan->parallel_scan != NULL) {
+            _bt_relbuf(rel, so->currPos.buf);
+            so->currPos.buf = InvalidBuffer;
+            if (!_bt_parallel_seize(scan, &blkno))
+                return false;
+            return _bt_parallel_readnextpage(scan, blkno, dir);
+        }
+
         for (;;) {
             /* release the previous buffer */
             _bt_relbuf(rel, so->currPos.buf);
@@ -1286,6 +1346,53 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
     return true;
 }
 
+/*
+ *	_bt_parallel_readnextpage() -- Read the next page of a parallel scan
+ *
+ * On entry, we have seized the parallel scan and blkno is the page it is
+ * positioned on; no buffer is held.  Exit conditions are the same as for
+ * _bt_steppage().  Pages that hold no matching items are released to the
+ * other participants one by one, so that they never wait on us for long.
+ */
+static bool _bt_parallel_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
+{
+    BTScanOpaque so = (BTScanOpaque)scan->opaque;
+    Relation rel = scan->indexRelation;
+    Page page;
+    BTPageOpaqueInternal opaque;
+
+    Assert(ScanDirectionIsForward(dir));
+    Assert(!BTScanPosIsValid(so->currPos));
+
+    for (;;) {
+        /* if we're at end of scan, tell the other participants and give up */
+        if (blkno == P_NONE || !so->currPos.moreRight) {
+            _bt_parallel_done(scan);
+            return false;
+        }
+        /* check for interrupts while we're not holding any buffer lock */
+        CHECK_FOR_INTERRUPTS();
+        so->currPos.buf = _bt_getbuf(rel, blkno, BT_READ);
+        /* check for deleted page */
+        page = BufferGetPage(so->currPos.buf);
+        opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+        if (!P_IGNORE(opaque)) {
+            PredicateLockPage(rel, blkno, scan->xs_snapshot);
+            /* this releases the scan, and clears moreRight if we can stop */
+            if (_bt_readpage(scan, dir, P_FIRSTDATAKEY(opaque)))
+                return true;
+        } else {
+            _bt_parallel_release(scan, opaque->btpo_next);
+        }
+
+        /* nope, give the page back and seize the scan again */
+        _bt_relbuf(rel, so->currPos.buf);
+        so->currPos.buf = InvalidBuffer;
+        if (!_bt_parallel_seize(scan, &blkno))
+            return false;
+    }
+}
+
 /*
  * _bt_walk_left() -- step left one page, if possible
  *
@@ -1510,6 +1617,7 @@ static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
          */
         PredicateLockRelation(rel, scan->xs_snapshot);
         so->currPos.buf = InvalidBuffer;
+        _bt_parallel_done(scan);
         return false;
     }
 
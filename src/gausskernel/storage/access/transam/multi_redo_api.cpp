@@ -31,6 +31,7 @@
 
 #include "access/multi_redo_settings.h"
 #include "access/multi_redo_api.h"
+#include "access/redo_prefetch.h"
 #include "access/extreme_rto/dispatcher.h"
 #include "access/parallel_recovery/dispatcher.h"
 #include "access/extreme_rto/page_redo.h"
@@ -98,8 +99,10 @@ bool IsExtremeRtoReadWorkerRunning()
 void DispatchRedoRecord(XLogReaderState* record, List* expectedTLIs, TimestampTz recordXTime)
 {
     if (IsExtremeRedo()) {
+        RedoPrefetchRecord(record);
         extreme_rto::DispatchRedoRecordToFile(record, expectedTLIs, recordXTime);
     } else if (IsParallelRedo()) {
+        RedoPrefetchRecord(record);
         parallel_recovery::DispatchRedoRecordToFile(record, expectedTLIs, recordXTime);
     } else {
         parallel_recovery::ApplyRedoRecord(record, t_thrd.xlog_cxt.redo_oldversion_xlog);
@@ -329,6 +332,7 @@ void** GetXLogInvalidPagesFromWorkers()
 
 void SendRecoveryEndMarkToWorkersAndWaitForFinish(int code)
 {
+    RedoPrefetchShutdown();
     if (IsExtremeRedo()) {
         return extreme_rto::SendRecoveryEndMarkToWorkersAndWaitForFinish(code);
 
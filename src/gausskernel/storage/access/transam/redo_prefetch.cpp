@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_prefetch.cpp
+ *      Read-ahead of the data blocks referenced by WAL records during
+ *      parallel and extreme-RTO recovery.
+ *
+ * With multi-threaded redo the startup thread decodes and dispatches
+ * records well ahead of the page workers that replay them.  We use that
+ * head start to ask the kernel to read the blocks the records touch, so
+ * that page workers find them in the OS cache instead of taking a
+ * synchronous read miss in XLogReadBufferExtended() on a cold cache.
+ *
+ * A block is not prefetched if it is already in shared buffers, if redo
+ * restores it from a full-page image or re-initializes it, or if it was
+ * prefetched a short while ago.  The number of prefetched blocks whose
+ * records are not replayed yet is bounded by recovery_prefetch_window:
+ * every prefetch remembers the end LSN of its record and is retired once
+ * replay has passed it.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/access/transam/redo_prefetch.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/redo_prefetch.h"
+#include "access/redo_statistic.h"
+#include "access/xact.h"
+#include "access/xlog.h"
+#include "commands/dbcommands.h"
+#include "commands/tablespace.h"
+#include "storage/buf_internals.h"
+#include "storage/smgr.h"
+#include "storage/uring.h"
+
+/* the recently prefetched blocks cache is a few times larger than the window */
+static const uint32 PREFETCH_RECENT_PER_WINDOW = 4;
+static const uint32 PREFETCH_RECENT_MIN_SIZE = 64;
+
+typedef struct RedoPrefetcher {
+    uint32 window;         /* max number of prefetched blocks not replayed yet */
+    XLogRecPtr* inflight;  /* ring of record end LSNs of those blocks */
+    uint32 head;           /* oldest entry of the ring */
+    uint32 count;          /* number of entries in the ring */
+    BufferTag* recent;     /* direct-mapped cache of recently prefetched blocks */
+    uint32 recentMask;
+} RedoPrefetcher;
+
+static RedoPrefetcher* RedoPrefetcherCreate(uint32 window)
+{
+    uint32 recentSize = PREFETCH_RECENT_MIN_SIZE;
+    while (recentSize < window * PREFETCH_RECENT_PER_WINDOW) {
+        recentSize <<= 1;
+    }
+
+    RedoPrefetcher* prefetcher = (RedoPrefetcher*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(RedoPrefetcher));
+    prefetcher->window = window;
+    prefetcher->inflight = (XLogRecPtr*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(XLogRecPtr) * window);
+    prefetcher->recent = (BufferTag*)MemoryContextAlloc(t_thrd.top_mem_cxt, sizeof(BufferTag) * recentSize);
+    for (uint32 i = 0; i < recentSize; i++) {
+        CLEAR_BUFFERTAG(prefetcher->recent[i]);
+    }
+    prefetcher->recentMask = recentSize - 1;
+
+    redo_reset_prefetch_stats();
+    ereport(LOG,
+        (errmodule(MOD_REDO),
+            errcode(ERRCODE_LOG),
+            errmsg("[REDO_PREFETCH]data block prefetch started, window:%u blocks", window)));
+    return prefetcher;
+}
+
+/* Forget the prefetched blocks whose records were replayed already. */
+static void RedoPrefetchRetire(RedoPrefetcher* prefetcher)
+{
+    XLogRecPtr replayed = GetXLogReplayRecPtr(NULL);
+    while (prefetcher->count > 0 && XLByteLE(prefetcher->inflight[prefetcher->head], replayed)) {
+        prefetcher->head = (prefetcher->head + 1) % prefetcher->window;
+        prefetcher->count--;
+    }
+}
+
+/*
+ * Records that remove relation files are replayed by another thread; close
+ * our file handles so that we do not keep the unlinked files alive.
+ */
+static void RedoPrefetchCloseDroppedFiles(XLogReaderState* record)
+{
+    RmgrId rmid = XLogRecGetRmid(record);
+    uint8 info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+    if (rmid == RM_XACT_ID) {
+        ColFileNodeRel* xnodes = NULL;
+        int nrels = 0;
+        XactGetRelFiles(record, &xnodes, &nrels);
+        if (nrels > 0) {
+            smgrcloseall();
+        }
+    } else if ((rmid == RM_DBASE_ID && info == XLOG_DBASE_DROP) || (rmid == RM_TBLSPC_ID && info == XLOG_TBLSPC_DROP)) {
+        smgrcloseall();
+    }
+}
+
+/* Prefetch one block, returns true if a read-ahead was issued. */
+static bool RedoPrefetchBlock(RedoPrefetcher* prefetcher, XLogReaderState* record, const DecodedBkpBlock* block)
+{
+    RedoPrefetchStats* stats = &g_instance.comm_cxt.predo_cxt.redoPf.prefetch;
+    BufferTag tag;
+    uint32 hash;
+    LWLock* partitionLock = NULL;
+    int bufId;
+
+    if (block->has_image || (block->flags & BKPBLOCK_WILL_INIT)) {
+        stats->skip_init++;
+        return false;
+    }
+
+    INIT_BUFFERTAG(tag, block->rnode, block->forknum, block->blkno);
+    hash = BufTableHashCode(&tag);
+    BufferTag* recent = &prefetcher->recent[hash & prefetcher->recentMask];
+    if (BUFFERTAGS_PTR_EQUAL(recent, &tag)) {
+        stats->skip_recent++;
+        return false;
+    }
+
+    partitionLock = BufMappingPartitionLock(hash);
+    (void)LWLockAcquire(partitionLock, LW_SHARED);
+    bufId = BufTableLookup(&tag, hash);
+    LWLockRelease(partitionLock);
+    if (bufId >= 0) {
+        *recent = tag;
+        stats->hit++;
+        return false;
+    }
+
+    if (prefetcher->count == prefetcher->window) {
+        RedoPrefetchRetire(prefetcher);
+        if (prefetcher->count == prefetcher->window) {
+            stats->skip_window++;
+            return false;
+        }
+    }
+
+    SMgrRelation reln = smgropen(block->rnode, InvalidBackendId);
+    smgrprefetch(reln, block->forknum, block->blkno);
+
+    *recent = tag;
+    prefetcher->inflight[(prefetcher->head + prefetcher->count) % prefetcher->window] = record->EndRecPtr;
+    prefetcher->count++;
+    stats->miss++;
+    return true;
+}
+
+/*
+ * RedoPrefetchRecord -- issue read-ahead for the data blocks of a record
+ *
+ * Run from the dispatcher before the record is handed to the page workers.
+ * No-op if recovery_prefetch_window is zero.
+ */
+void RedoPrefetchRecord(XLogReaderState* record)
+{
+    RedoPrefetcher* prefetcher = t_thrd.xlog_cxt.redo_prefetcher;
+    bool issued = false;
+
+    if (prefetcher == NULL) {
+        if (g_instance.attr.attr_storage.recovery_prefetch_window <= 0) {
+            return;
+        }
+        prefetcher = RedoPrefetcherCreate((uint32)g_instance.attr.attr_storage.recovery_prefetch_window);
+        t_thrd.xlog_cxt.redo_prefetcher = prefetcher;
+    }
+
+    RedoPrefetchCloseDroppedFiles(record);
+
+    for (int i = 0; i <= record->max_block_id; i++) {
+        DecodedBkpBlock* block = &record->blocks[i];
+        if (!block->in_use) {
+            continue;
+        }
+        issued = RedoPrefetchBlock(prefetcher, record, block) || issued;
+    }
+
+    /* hand queued io_uring hints to the kernel before we may block on a dispatch queue */
+    if (issued) {
+        UringSubmitPending();
+    }
+}
+
+/*
+ * RedoPrefetchShutdown -- release the prefetcher at the end of redo
+ */
+void RedoPrefetchShutdown()
+{
+    RedoPrefetcher* prefetcher = t_thrd.xlog_cxt.redo_prefetcher;
+    char info[REDO_PREFETCH_INFO_BUFFER_SIZE];
+
+    if (prefetcher == NULL) {
+        return;
+    }
+
+    redo_get_prefetch_info_text(info, REDO_PREFETCH_INFO_BUFFER_SIZE);
+    ereport(LOG,
+        (errmodule(MOD_REDO), errcode(ERRCODE_LOG), errmsg("[REDO_PREFETCH]data block prefetch finished, %s", info)));
+
+    /* the files of relations we prefetched may be dropped after recovery */
+    smgrcloseall();
+    pfree_ext(prefetcher->inflight);
+    pfree_ext(prefetcher->recent);
+    pfree_ext(prefetcher);
+    t_thrd.xlog_cxt.redo_prefetcher = NULL;
+}
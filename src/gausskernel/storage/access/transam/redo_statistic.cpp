@@ -217,11 +217,40 @@ void redo_get_worker_info_text(char* info, uint32 max_info_len)
     }
 }
 
+void redo_reset_prefetch_stats()
+{
+    errno_t rc = memset_s(&g_instance.comm_cxt.predo_cxt.redoPf.prefetch,
+        sizeof(RedoPrefetchStats),
+        0,
+        sizeof(RedoPrefetchStats));
+    securec_check(rc, "\0", "\0");
+}
+
+void redo_get_prefetch_info_text(char* info, uint32 max_info_len)
+{
+    RedoPrefetchStats* prefetch = &g_instance.comm_cxt.predo_cxt.redoPf.prefetch;
+    errno_t errorno = snprintf_s(info,
+        max_info_len,
+        max_info_len - 1,
+        "prefetch hit:%lu miss:%lu skip_init:%lu skip_recent:%lu skip_window:%lu",
+        prefetch->hit,
+        prefetch->miss,
+        prefetch->skip_init,
+        prefetch->skip_recent,
+        prefetch->skip_window);
+    securec_check_ss(errorno, "\0", "\0");
+}
+
 Datum redo_get_worker_info()
 {
     Datum value;
-    char* info = (char*)palloc0(sizeof(char) * REDO_WORKER_INFO_BUFFER_SIZE);
+    uint32 info_len = REDO_WORKER_INFO_BUFFER_SIZE + REDO_PREFETCH_INFO_BUFFER_SIZE;
+    char* info = (char*)palloc0(sizeof(char) * info_len);
     redo_get_worker_info_text(info, REDO_WORKER_INFO_BUFFER_SIZE);
+    /* the data block prefetch counters go on a line of their own */
+    errno_t errorno = strcat_s(info, info_len, "\n");
+    securec_check(errorno, "\0", "\0");
+    redo_get_prefetch_info_text(info + strlen(info), info_len - strlen(info));
     value = CStringGetTextDatum(info);
     pfree_ext(info);
     return value;
@@ -298,6 +327,13 @@ void print_stats_file(RedoStatsData* stats)
         (errmodule(MOD_REDO),
             errcode(ERRCODE_LOG),
             errmsg("[REDO_STATS]print_stats_file: redo worker info are as follows :%s", stats->worker_info)));
+
+    char prefetch_info[REDO_PREFETCH_INFO_BUFFER_SIZE];
+    redo_get_prefetch_info_text(prefetch_info, REDO_PREFETCH_INFO_BUFFER_SIZE);
+    ereport(LOG,
+        (errmodule(MOD_REDO),
+            errcode(ERRCODE_LOG),
+            errmsg("[REDO_STATS]print_stats_file: data block %s", prefetch_info)));
 }
 
 void redo_update_stats_file(RedoStatsData* stats)
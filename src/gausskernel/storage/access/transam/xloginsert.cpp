@@ -34,6 +34,7 @@
 #include "pg_trace.h"
 #include "replication/logical.h"
 #include "lz4.h"
+#include "lz4hc.h"
 
 /*
  * For each block reference registered with XLogRegisterBuffer, we fill in
@@ -884,8 +885,15 @@ static bool XLogCompressBackupBlock(char *page, uint16 holeOffset, uint16 holeLe
     * and see if the number of bytes saved by compression is larger than
     * the length of extra data needed for the compressed version of block
     * image.
+    *
+    * LZ4 HC spends more CPU searching for matches but emits the same block
+    * format, so LZ4_decompress_safe() restores either kind of image.
     */
-    len = LZ4_compress_default(source, dest, origLen, BLCKSZ);
+    if (u_sess->attr.attr_storage.wal_compression_level > 0) {
+        len = LZ4_compress_HC(source, dest, origLen, BLCKSZ, u_sess->attr.attr_storage.wal_compression_level);
+    } else {
+        len = LZ4_compress_default(source, dest, origLen, BLCKSZ);
+    }
     if (len >= 0 && len + extraBytes < origLen) {
         /* successful compression */
         *dlen = (uint16) len;
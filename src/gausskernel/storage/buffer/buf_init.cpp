@@ -24,6 +24,9 @@
 #include "storage/cucache_mgr.h"
 #include "pgxc/pgxc.h"
 #include "postmaster/pagewriter.h"
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
 
 const int PAGE_QUEUE_SLOT_MULTI_NBUFFERS = 5;
 
@@ -58,6 +61,30 @@ const int PAGE_QUEUE_SLOT_MULTI_NBUFFERS = 5;
  *		shared refcount isn't increased if a individual backend pins a buffer
  *		multiple times. Check the PrivateRefCount infrastructure in bufmgr.c.
  */
+#ifdef __USE_NUMA
+/*
+ * Bind the memory of every NUMA partition of an array with one entry per
+ * buffer to its node. This must run before the pages are first touched.
+ * Pages straddling two partitions keep the default policy.
+ */
+static void BindBufferPartitionsToNuma(char* base, Size entry_size)
+{
+    Size page_size = (Size)getpagesize();
+
+    for (int i = 0; i < StrategyNumPartitions(); i++) {
+        int buf_id_start;
+        int buf_num;
+
+        StrategyPartitionRange(i, &buf_id_start, &buf_num);
+        uintptr_t begin = TYPEALIGN(page_size, base + buf_id_start * entry_size);
+        uintptr_t end = TYPEALIGN_DOWN(page_size, base + (buf_id_start + buf_num) * entry_size);
+        if (end > begin) {
+            numa_tonode_memory((void*)begin, end - begin, i);
+        }
+    }
+}
+#endif
+
 /*
  * Initialize shared buffer pool
  *
@@ -112,6 +139,14 @@ void InitBufferPool(void)
         (void)MemoryContextSwitchTo(oldcontext);
     }
 
+#ifdef __USE_NUMA
+    /* Place each partition of the buffer pool on its own NUMA node */
+    if (!found_descs && !found_bufs && StrategyNumPartitions() > 1) {
+        BindBufferPartitionsToNuma((char*)t_thrd.storage_cxt.BufferDescriptors, sizeof(BufferDescPadded));
+        BindBufferPartitionsToNuma(t_thrd.storage_cxt.BufferBlocks, BLCKSZ);
+    }
+#endif
+
     if (found_descs || found_bufs || found_buf_ckpt) {
         /* both should be present or neither */
         Assert(found_descs && found_bufs && found_buf_ckpt);
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * buf_trace.cpp
+ *
+ * Capture of the shared buffer access stream.
+ *
+ * While buffer_trace_directory is set, every shared buffer lookup done by
+ * ReadBuffer_common() is appended to a trace file of the current thread, so
+ * that no locking is needed.  Records are batched in memory and written
+ * BUFFER_TRACE_BATCH at a time; the tail is written when tracing is turned
+ * off or the thread exits.  contrib/buftrace_replay interleaves the files of
+ * all threads again and replays them against the replacement policies of
+ * freelist.cpp to compare their hit rates on a recorded workload.
+ *
+ * A failing trace file never fails the query: a WARNING is raised and the
+ * thread stops tracing until buffer_trace_directory is changed.
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/buffer/buf_trace.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "storage/buf_trace.h"
+#include "storage/fd.h"
+#include "storage/ipc.h"
+#include "utils/timestamp.h"
+
+static void BufferTraceOpen(BufferTraceState* state, const char* directory);
+static void BufferTraceClose(BufferTraceState* state);
+static void BufferTraceFlush(BufferTraceState* state);
+static void BufferTraceShutdown(int code, Datum arg);
+
+/*
+ * BufferTraceAccess -- record one lookup of a shared buffer
+ *
+ * Callers check BufferTraceEnabled() first, which keeps the cost of a
+ * disabled trace to one test of the GUC.
+ */
+void BufferTraceAccess(const RelFileNode* rnode, ForkNumber fork_num, BlockNumber block_num, bool hit, bool strategy)
+{
+    BufferTraceState* state = t_thrd.storage_cxt.buffer_trace;
+    const char* directory = u_sess->attr.attr_storage.buffer_trace_directory;
+    BufferTraceRecord* record = NULL;
+
+    if (directory == NULL || directory[0] == '\0') {
+        if (state != NULL) {
+            BufferTraceClose(state);
+        }
+        return;
+    }
+
+    if (state == NULL) {
+        state = (BufferTraceState*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(BufferTraceState));
+        state->fd = -1;
+        t_thrd.storage_cxt.buffer_trace = state;
+        on_proc_exit(BufferTraceShutdown, 0);
+    }
+
+    if (strcmp(state->directory, directory) != 0) {
+        BufferTraceClose(state);
+        BufferTraceOpen(state, directory);
+    }
+
+    if (state->fd < 0) {
+        return;
+    }
+
+    record = &state->records[state->nrecords++];
+    record->spcNode = rnode->spcNode;
+    record->dbNode = rnode->dbNode;
+    record->relNode = rnode->relNode;
+    record->bucketNode = rnode->bucketNode;
+    record->blockNum = block_num;
+    record->forkNum = (uint16)fork_num;
+    record->flags = (hit ? BUFFER_TRACE_HIT : 0) | (strategy ? BUFFER_TRACE_STRATEGY : 0);
+
+    if (state->nrecords == BUFFER_TRACE_BATCH) {
+        BufferTraceFlush(state);
+    }
+}
+
+/*
+ * BufferTraceOpen -- start a new trace file of this thread in directory
+ *
+ * The directory is remembered even if the file can't be created, so that
+ * we warn once rather than on every access.
+ */
+static void BufferTraceOpen(BufferTraceState* state, const char* directory)
+{
+    char path[MAXPGPATH];
+    BufferTraceHeader header;
+    int rc;
+
+    rc = strcpy_s(state->directory, MAXPGPATH, directory);
+    securec_check(rc, "\0", "\0");
+
+    header.magic = BUFFER_TRACE_MAGIC;
+    header.version = BUFFER_TRACE_VERSION;
+    header.record_size = sizeof(BufferTraceRecord);
+    header.nbuffers = g_instance.attr.attr_storage.NBuffers;
+    header.start_time = GetCurrentTimestamp();
+
+    rc = snprintf_s(path, MAXPGPATH, MAXPGPATH - 1, "%s/" BUFFER_TRACE_FILE_PREFIX "%lu_" INT64_FORMAT
+        BUFFER_TRACE_FILE_SUFFIX, directory, t_thrd.proc_cxt.MyProcPid, header.start_time);
+    securec_check_ss(rc, "\0", "\0");
+
+    state->fd = BasicOpenFile(path, O_WRONLY | O_CREAT | O_TRUNC | PG_BINARY, S_IRUSR | S_IWUSR);
+    if (state->fd < 0) {
+        ereport(WARNING, (errcode_for_file_access(), errmsg("could not create buffer trace file \"%s\": %m", path)));
+        return;
+    }
+
+    if (write(state->fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        ereport(WARNING, (errcode_for_file_access(), errmsg("could not write buffer trace file \"%s\": %m", path)));
+        (void)close(state->fd);
+        state->fd = -1;
+    }
+}
+
+/*
+ * BufferTraceClose -- write the pending records and stop tracing
+ */
+static void BufferTraceClose(BufferTraceState* state)
+{
+    if (state->fd >= 0) {
+        BufferTraceFlush(state);
+    }
+    if (state->fd >= 0) {
+        (void)close(state->fd);
+        state->fd = -1;
+    }
+    state->nrecords = 0;
+    state->directory[0] = '\0';
+}
+
+/*
+ * BufferTraceFlush -- write the batched records to the trace file
+ */
+static void BufferTraceFlush(BufferTraceState* state)
+{
+    size_t len = sizeof(BufferTraceRecord) * state->nrecords;
+
+    state->nrecords = 0;
+    if (len == 0) {
+        return;
+    }
+
+    if (write(state->fd, state->records, len) != (ssize_t)len) {
+        ereport(WARNING, (errcode_for_file_access(),
+            errmsg("could not write buffer trace file in \"%s\": %m", state->directory),
+            errhint("Buffer accesses of this thread are no longer traced.")));
+        (void)close(state->fd);
+        state->fd = -1;
+    }
+}
+
+/*
+ * BufferTraceShutdown -- on_proc_exit callback writing the trace tail
+ */
+static void BufferTraceShutdown(int code, Datum arg)
+{
+    if (t_thrd.storage_cxt.buffer_trace != NULL) {
+        BufferTraceClose(t_thrd.storage_cxt.buffer_trace);
+    }
+}
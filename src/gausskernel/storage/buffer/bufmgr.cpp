@@ -56,11 +56,13 @@
 #include "postmaster/postmaster.h"
 #include "service/rpc_client.h"
 #include "storage/buf_internals.h"
+#include "storage/buf_trace.h"
 #include "storage/bufmgr.h"
 #include "storage/ipc.h"
 #include "storage/proc.h"
 #include "storage/smgr.h"
 #include "storage/standby.h"
+#include "storage/uring.h"
 #include "utils/aiomem.h"
 #include "utils/guc.h"
 #include "utils/plog.h"
@@ -723,13 +725,14 @@ static volatile BufferDesc* PageListBufferAlloc(SMgrRelation smgr, char relpersi
     buf_state &= ~(BM_VALID | BM_DIRTY | BM_JUST_DIRTIED | BM_CHECKPOINT_NEEDED | BM_IO_ERROR | BM_PERMANENT);
     if ((relpersistence == RELPERSISTENCE_PERMANENT) ||
         ((relpersistence == RELPERSISTENCE_TEMP) && STMT_RETRY_ENABLED)) {
-        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BM_PERMANENT | StrategyInitialUsage(new_hash);
     } else {
-        buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | StrategyInitialUsage(new_hash);
     }
     UnlockBufHdr(buf, buf_state);
 
     if (old_flags & BM_TAG_VALID) {
+        StrategyRecordEviction(strategy, old_hash);
         BufTableDelete(&old_tag, old_hash);
         if (old_partition_lock != new_partition_lock) {
             LWLockRelease(old_partition_lock);
@@ -2057,6 +2060,9 @@ static Buffer ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumb
             u_sess->instr_cxt.pg_buffer_usage->shared_blks_read++;
             pgstatCountSharedBlocksRead4SessionLevel();
         }
+        if (unlikely(BufferTraceEnabled())) {
+            BufferTraceAccess(&smgr->smgr_rnode.node, fork_num, block_num, found, strategy != NULL);
+        }
     }
 
     /* At this point we do NOT hold any locks.
@@ -2298,6 +2304,7 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
         LWLockRelease(new_partition_lock);
 
         *found = TRUE;
+        StrategyCountHit(buf_id);
 
         if (!valid) {
             /*
@@ -2541,7 +2548,8 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
      * Clearing BM_VALID here is necessary, clearing the dirtybits is just
      * paranoia.  We also reset the usage_count since any recency of use of
      * the old content is no longer relevant.  (The usage_count starts out at
-     * 1 so that the buffer can survive one clock-sweep pass.)
+     * 1 so that the buffer can survive one clock-sweep pass, see
+     * StrategyInitialUsage() for the "2q" policy.)
      *
      * Make sure BM_PERMANENT is set for buffers that must be written at every
      * checkpoint.  Unlogged buffers only need to be written at shutdown
@@ -2553,14 +2561,15 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
                    BUF_USAGECOUNT_MASK);
     if (relpersistence == RELPERSISTENCE_PERMANENT || fork_num == INIT_FORKNUM ||
         ((relpersistence == RELPERSISTENCE_TEMP) && STMT_RETRY_ENABLED)) {
-        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BM_PERMANENT | StrategyInitialUsage(new_hash);
     } else {
-        buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | StrategyInitialUsage(new_hash);
     }
 
     UnlockBufHdr(buf, buf_state);
 
     if (old_flags & BM_TAG_VALID) {
+        StrategyRecordEviction(strategy, old_hash);
         BufTableDelete(&old_tag, old_hash);
         if (old_partition_lock != new_partition_lock) {
             LWLockRelease(old_partition_lock);
@@ -3734,6 +3743,9 @@ void FlushOneBuffer(Buffer buffer)
  */
 void AtEOXact_Buffers(bool isCommit)
 {
+    /* Other backends may wait for the buffers of our io_uring requests, do not go idle with them */
+    UringWaitBatches();
+
     CheckForBufferLeaks();
 
     AtEOXact_LocalBuffers(isCommit);
@@ -3798,6 +3810,7 @@ static void AtProcExit_Buffers(int code, Datum arg)
     UnlockBuffers();
 
     CheckForBufferLeaks();
+    StrategyFlushCounts();
 
     /* localbuf.c needs a chance too */
     AtProcExit_LocalBuffers();
@@ -5787,6 +5800,9 @@ void IssuePendingWritebacks(WritebackContext* context)
         smgrwriteback(reln, tag.forkNum, tag.blockNum, nblocks);
     }
 
+    /* With io_uring the writebacks above were only queued, send them as one batch */
+    UringSubmitPending();
+
     context->nr_pending = 0;
 }
 
@@ -30,6 +30,56 @@
 
 #define INT_ACCESS_ONCE(var) ((int)(*((volatile int*)&(var))))
 
+#define BUFFER_POLICY_IS_2Q() \
+    (g_instance.attr.attr_storage.buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+
+/* number of ghost history entries per buffer under the "2q" policy */
+#define GHOST_ENTRIES_PER_BUFFER 0.5
+
+/* usage count given to a buffer whose tag is found in the ghost history */
+#define GHOST_HIT_USAGE_COUNT 2
+
+/*
+ * Clock sweep state of one NUMA partition of the buffer pool.
+ */
+typedef struct BufferStrategyPartition {
+    /*
+     * Clock sweep hand: index of next buffer to consider grabbing, relative
+     * to buf_id_start. Note that this isn't a concrete buffer - we only ever
+     * increase the value. So, to get an actual buffer, it needs to be used
+     * modulo buf_num.
+     */
+    pg_atomic_uint32 nextVictimBuffer;
+
+    uint32 completePasses; /* Complete cycles of this partition's sweep */
+    int buf_id_start;      /* first buffer of the partition */
+    int buf_num;           /* number of buffers in the partition */
+} BufferStrategyPartition;
+
+/*
+ * Hit and allocation counters of the backends running on one NUMA node,
+ * indexed by the partition of the buffer. Each node only writes its own
+ * row, so the counters do not bounce between sockets.
+ */
+typedef struct BufferPartitionCounters {
+    pg_atomic_uint64 hits[MAX_BUFFER_PARTITIONS];
+    pg_atomic_uint64 allocs[MAX_BUFFER_PARTITIONS];
+} BufferPartitionCounters;
+
+/*
+ * Counts of one thread not yet added to its row of the shared counters. They
+ * are flushed every BUFFER_COUNTS_FLUSH_INTERVAL accesses, when the thread
+ * reports its statistics and at exit, so the hot path of a buffer hit only
+ * touches thread-local memory.
+ */
+#define BUFFER_COUNTS_FLUSH_INTERVAL 1024
+
+typedef struct BufferPartitionCounts {
+    uint64 hits[MAX_BUFFER_PARTITIONS];
+    uint64 allocs[MAX_BUFFER_PARTITIONS];
+    uint32 pending; /* hits and allocs counted since the last flush */
+} BufferPartitionCounts;
+
 /*
  * The shared freelist control information.
  */
@@ -38,17 +88,17 @@ typedef struct BufferStrategyControl {
     slock_t buffer_strategy_lock;
 
     /*
-     * Clock sweep hand: index of next buffer to consider grabbing. Note that
-     * this isn't a concrete buffer - we only ever increase the value. So, to
-     * get an actual buffer, it needs to be used modulo NBuffers.
+     * One clock sweep per NUMA partition of the buffer pool, see
+     * StrategyNumPartitions(). Without NUMA distribution there is a single
+     * partition covering all of NBuffers.
      */
-    pg_atomic_uint32 nextVictimBuffer;
+    int numPartitions;
+    BufferStrategyPartition partitions[MAX_BUFFER_PARTITIONS];
 
     /*
      * Statistics.	These counters should be wide enough that they can't
      * overflow during a single bgwriter cycle.
      */
-    uint32 completePasses;            /* Complete cycles of the clock sweep */
     pg_atomic_uint32 numBufferAllocs; /* Buffers allocated since last reset */
 
     /*
@@ -56,6 +106,18 @@ typedef struct BufferStrategyControl {
      * StrategyNotifyBgWriter.
      */
     int bgwprocno;
+
+    /* Per-node access counters, only maintained with several partitions */
+    BufferPartitionCounters counters[MAX_BUFFER_PARTITIONS];
+
+    /*
+     * Ghost history of the "2q" policy: tag hashes of recently evicted
+     * buffers, direct-mapped by hash so that recording and probing is one
+     * atomic operation. Collisions just forget the older entry. NULL under
+     * the "clock" policy.
+     */
+    int numGhosts;
+    pg_atomic_uint32* ghosts;
 } BufferStrategyControl;
 
 typedef struct
@@ -79,6 +141,7 @@ void PageListBackWrite(uint32* bufList, int32 n,
     int32* bufs_written = NULL,       /* opt written count returned */
     int32* bufs_reusable = NULL);     /* opt reusable count returned */
 static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, uint32* buf_state);
+static int StrategyNumGhosts(void);
 
 static void perform_delay(StrategyDelayStatus *status)
 {
@@ -101,10 +164,10 @@ static void perform_delay(StrategyDelayStatus *status)
 /*
  * ClockSweepTick - Helper routine for StrategyGetBuffer()
  *
- * Move the clock hand one buffer ahead of its current position and return the
- * id of the buffer now under the hand.
+ * Move the clock hand of the partition one buffer ahead of its current
+ * position and return the id of the buffer now under the hand.
  */
-static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
+static inline uint32 ClockSweepTick(BufferStrategyPartition* partition, int max_nbuffer_can_use)
 {
     uint32 victim;
 
@@ -113,7 +176,7 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
      * doing this, this can lead to buffers being returned slightly out of
      * apparent order.
      */
-    victim = pg_atomic_fetch_add_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer, 1);
+    victim = pg_atomic_fetch_add_u32(&partition->nextVictimBuffer, 1);
     if (victim >= (uint32)max_nbuffer_can_use) {
         uint32 original_victim = victim;
 
@@ -146,15 +209,45 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
 
                 wrapped = expected % max_nbuffer_can_use;
 
-                success = pg_atomic_compare_exchange_u32(
-                    &t_thrd.storage_cxt.StrategyControl->nextVictimBuffer, &expected, wrapped);
+                success = pg_atomic_compare_exchange_u32(&partition->nextVictimBuffer, &expected, wrapped);
                 if (success)
-                    t_thrd.storage_cxt.StrategyControl->completePasses++;
+                    partition->completePasses++;
                 SpinLockRelease(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
             }
         }
     }
-    return victim;
+    return partition->buf_id_start + victim;
+}
+
+/*
+ * StrategyThreadCounts - the counts of this thread, NULL without partitions
+ *
+ * Allocated on first use, so this must not be called with a spinlock held.
+ */
+static BufferPartitionCounts* StrategyThreadCounts(void)
+{
+    if (t_thrd.storage_cxt.StrategyControl->numPartitions <= 1) {
+        return NULL;
+    }
+    if (t_thrd.storage_cxt.buffer_partition_counts == NULL) {
+        t_thrd.storage_cxt.buffer_partition_counts =
+            (BufferPartitionCounts*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(BufferPartitionCounts));
+    }
+    return t_thrd.storage_cxt.buffer_partition_counts;
+}
+
+/*
+ * StrategyCountAlloc - account a victim buffer to the partition it came from
+ *
+ * Called with the buffer header spinlock held, counts is the result of
+ * StrategyThreadCounts() taken before.
+ */
+static inline void StrategyCountAlloc(BufferPartitionCounts* counts, int buf_id)
+{
+    if (counts != NULL) {
+        counts->allocs[StrategyBufferPartition(buf_id)]++;
+        counts->pending++;
+    }
 }
 
 /*
@@ -182,6 +275,10 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
     int try_counter;
     uint32 local_buf_state = 0; /* to avoid repeated (de-)referencing */
     int max_buffer_can_use;
+    int partition_id;
+    int partitions_tried;
+    BufferStrategyPartition* partition = NULL;
+    BufferPartitionCounts* counts = NULL;
     bool am_standby = RecoveryInProgress();
     StrategyDelayStatus	retry_lock_status = {0, 0};
     StrategyDelayStatus	retry_buf_status = {0, 0};
@@ -200,6 +297,12 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
         }
     }
 
+    /* The victim is counted with its spinlock held, so flush before */
+    counts = StrategyThreadCounts();
+    if (counts != NULL && counts->pending >= BUFFER_COUNTS_FLUSH_INTERVAL) {
+        StrategyFlushCounts();
+    }
+
     /*
      * If asked, we need to waken the bgwriter. Since we don't want to rely on
      * a spinlock for this we force a read from shared memory once, and then
@@ -238,21 +341,26 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
         buf = get_buf_from_candidate_list(strategy, buf_state);
         if (buf != NULL) {
             (void)pg_atomic_fetch_add_u64(&g_instance.bgwriter_cxt.get_buf_num_candidate_list, 1);
+            StrategyCountAlloc(counts, buf->buf_id);
             return buf;
         }
     }
 
+    /* Sweep the partition of our own NUMA node first */
+    partition_id = StrategyLocalPartition();
+    partitions_tried = 0;
+
 retry:
     /* Nothing on the freelist, so run the "clock sweep" algorithm */
+    partition = &t_thrd.storage_cxt.StrategyControl->partitions[partition_id];
     if (am_standby)
-        max_buffer_can_use =
-            int(g_instance.attr.attr_storage.NBuffers * u_sess->attr.attr_storage.shared_buffers_fraction);
+        max_buffer_can_use = Max(int(partition->buf_num * u_sess->attr.attr_storage.shared_buffers_fraction), 1);
     else
-        max_buffer_can_use = g_instance.attr.attr_storage.NBuffers;
+        max_buffer_can_use = partition->buf_num;
     try_counter = max_buffer_can_use;
     int try_get_loc_times = max_buffer_can_use;
     for (;;) {
-        buf = GetBufferDescriptor(ClockSweepTick(max_buffer_can_use));
+        buf = GetBufferDescriptor(ClockSweepTick(partition, max_buffer_can_use));
         /*
          * If the buffer is pinned, we cannot use it.
          */
@@ -267,6 +375,21 @@ retry:
         }
 
         retry_lock_status.retry_times = 0;
+
+        /*
+         * Under the "2q" policy, an unpinned buffer that was used since the
+         * hand last passed only loses one usage count. New buffers start at
+         * zero, so a page read once by a scan is evicted on the next pass
+         * while pages referenced again survive, as in the A1/Am queues of 2Q.
+         */
+        if (BUFFER_POLICY_IS_2Q() && BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
+            BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0) {
+            local_buf_state -= BUF_USAGECOUNT_ONE;
+            try_counter = max_buffer_can_use;
+            UnlockBufHdr(buf, local_buf_state);
+            continue;
+        }
+
         if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
             (!dw_page_writer_running() || !(local_buf_state & BM_DIRTY))) {
             /* Found a usable buffer */
@@ -274,6 +397,7 @@ retry:
                 AddBufferToRing(strategy, buf);
             *buf_state = local_buf_state;
             (void)pg_atomic_fetch_add_u64(&g_instance.bgwriter_cxt.get_buf_num_clock_sweep, 1);
+            StrategyCountAlloc(counts, buf->buf_id);
             return buf;
         } else if (--try_counter == 0) {
             /*
@@ -285,6 +409,13 @@ retry:
              */
             UnlockBufHdr(buf, local_buf_state);
 
+            /* Take a remote buffer before giving up on the local partition */
+            if (++partitions_tried < t_thrd.storage_cxt.StrategyControl->numPartitions) {
+                partition_id = (partition_id + 1) % t_thrd.storage_cxt.StrategyControl->numPartitions;
+                goto retry;
+            }
+            partitions_tried = 0;
+
             if (am_standby && u_sess->attr.attr_storage.shared_buffers_fraction < 1.0) {
                 ereport(WARNING, (errmsg("no unpinned buffers available")));
                 u_sess->attr.attr_storage.shared_buffers_fraction =
@@ -328,29 +459,38 @@ retry:
  * the higher-order bits of nextVictimBuffer) and the count of recent buffer
  * allocs if non-NULL pointers are passed.	The alloc count is reset after
  * being read.
+ *
+ * With several NUMA partitions, the hands of all partitions are added up
+ * into one virtual hand over NBuffers. That keeps the rate BgBufferSync()
+ * derives from it exact, while its position is only an approximation.
  */
 int StrategySyncStart(uint32* complete_passes, uint32* num_buf_alloc)
 {
-    uint32 next_victim_buffer;
+    BufferStrategyControl* control = t_thrd.storage_cxt.StrategyControl;
+    uint64 total_ticks = 0;
     int result;
 
-    SpinLockAcquire(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
-    next_victim_buffer = pg_atomic_read_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer);
-    result = next_victim_buffer % g_instance.attr.attr_storage.NBuffers;
+    SpinLockAcquire(&control->buffer_strategy_lock);
+    for (int i = 0; i < control->numPartitions; i++) {
+        BufferStrategyPartition* partition = &control->partitions[i];
+        uint32 next_victim_buffer = pg_atomic_read_u32(&partition->nextVictimBuffer);
 
-    if (complete_passes != NULL) {
-        *complete_passes = t_thrd.storage_cxt.StrategyControl->completePasses;
         /*
          * Additionally add the number of wraparounds that happened before
          * completePasses could be incremented. C.f. ClockSweepTick().
          */
-        *complete_passes += next_victim_buffer / (unsigned int)g_instance.attr.attr_storage.NBuffers;
+        total_ticks += (uint64)partition->completePasses * (uint32)partition->buf_num + next_victim_buffer;
+    }
+    result = (int)(total_ticks % (uint32)g_instance.attr.attr_storage.NBuffers);
+
+    if (complete_passes != NULL) {
+        *complete_passes = (uint32)(total_ticks / (uint32)g_instance.attr.attr_storage.NBuffers);
     }
 
     if (num_buf_alloc != NULL) {
-        *num_buf_alloc = pg_atomic_exchange_u32(&t_thrd.storage_cxt.StrategyControl->numBufferAllocs, 0);
+        *num_buf_alloc = pg_atomic_exchange_u32(&control->numBufferAllocs, 0);
     }
-    SpinLockRelease(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
+    SpinLockRelease(&control->buffer_strategy_lock);
     return result;
 }
 
@@ -392,6 +532,11 @@ Size StrategyShmemSize(void)
     /* size of the shared replacement strategy control block */
     size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+    /* size of the ghost history of the "2q" policy */
+    if (BUFFER_POLICY_IS_2Q()) {
+        size = add_size(size, mul_size(StrategyNumGhosts(), sizeof(pg_atomic_uint32)));
+    }
+
     return size;
 }
 
@@ -431,18 +576,239 @@ void StrategyInitialize(bool init)
         Assert(init);
         SpinLockInit(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
 
-        /* Initialize the clock sweep pointer */
-        pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer, 0);
+        /* Initialize the clock sweep pointer of every partition */
+        t_thrd.storage_cxt.StrategyControl->numPartitions = StrategyNumPartitions();
+        for (int i = 0; i < t_thrd.storage_cxt.StrategyControl->numPartitions; i++) {
+            BufferStrategyPartition* partition = &t_thrd.storage_cxt.StrategyControl->partitions[i];
+
+            pg_atomic_init_u32(&partition->nextVictimBuffer, 0);
+            partition->completePasses = 0;
+            StrategyPartitionRange(i, &partition->buf_id_start, &partition->buf_num);
+        }
 
         /* Clear statistics */
-        t_thrd.storage_cxt.StrategyControl->completePasses = 0;
         pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->numBufferAllocs, 0);
+        for (int i = 0; i < MAX_BUFFER_PARTITIONS; i++) {
+            for (int j = 0; j < MAX_BUFFER_PARTITIONS; j++) {
+                pg_atomic_init_u64(&t_thrd.storage_cxt.StrategyControl->counters[i].hits[j], 0);
+                pg_atomic_init_u64(&t_thrd.storage_cxt.StrategyControl->counters[i].allocs[j], 0);
+            }
+        }
 
         /* No pending notification */
         t_thrd.storage_cxt.StrategyControl->bgwprocno = -1;
     } else {
         Assert(!init);
     }
+
+    if (BUFFER_POLICY_IS_2Q()) {
+        int num_ghosts = StrategyNumGhosts();
+        pg_atomic_uint32* ghosts = (pg_atomic_uint32*)ShmemInitStruct(
+            "Buffer Strategy Ghosts", mul_size(num_ghosts, sizeof(pg_atomic_uint32)), &found);
+
+        if (!found) {
+            for (int i = 0; i < num_ghosts; i++) {
+                pg_atomic_init_u32(&ghosts[i], 0);
+            }
+        }
+        t_thrd.storage_cxt.StrategyControl->numGhosts = num_ghosts;
+        t_thrd.storage_cxt.StrategyControl->ghosts = ghosts;
+    } else {
+        t_thrd.storage_cxt.StrategyControl->numGhosts = 0;
+        t_thrd.storage_cxt.StrategyControl->ghosts = NULL;
+    }
+}
+
+/*
+ * StrategyNumGhosts -- number of ghost history entries of the "2q" policy
+ */
+static int StrategyNumGhosts(void)
+{
+    return Max((int)(g_instance.attr.attr_storage.NBuffers * GHOST_ENTRIES_PER_BUFFER), 1);
+}
+
+/*
+ * StrategyInitialUsage -- usage count bits of a buffer just assigned a new tag
+ *
+ * Under the "clock" policy every new buffer starts with one usage count so
+ * that it can survive one pass of the sweep. Under the "2q" policy it starts
+ * at zero, unless the tag was evicted recently: a page coming back while it
+ * is still remembered in the ghost history is one the pool was too small to
+ * hold, so it is admitted as a frequently used page right away.
+ */
+uint32 StrategyInitialUsage(uint32 hashcode)
+{
+    BufferStrategyControl* control = t_thrd.storage_cxt.StrategyControl;
+    pg_atomic_uint32* ghost = NULL;
+    uint32 expected = hashcode | 1;
+
+    if (control->ghosts == NULL) {
+        return BUF_USAGECOUNT_ONE;
+    }
+
+    ghost = &control->ghosts[hashcode % (uint32)control->numGhosts];
+    if (pg_atomic_read_u32(ghost) == expected && pg_atomic_compare_exchange_u32(ghost, &expected, 0)) {
+        return GHOST_HIT_USAGE_COUNT * BUF_USAGECOUNT_ONE;
+    }
+    return 0;
+}
+
+/*
+ * StrategyRecordEviction -- remember the tag of a buffer being replaced
+ *
+ * A buffer reused from the ring of a strategy only held a page of the same
+ * bulk operation, which must not be admitted as frequently used when that
+ * operation is repeated, so it is not remembered.
+ *
+ * The low bit is forced on so that no hash collides with an empty entry.
+ */
+void StrategyRecordEviction(BufferAccessStrategy strategy, uint32 hashcode)
+{
+    BufferStrategyControl* control = t_thrd.storage_cxt.StrategyControl;
+
+    if (strategy != NULL && strategy->current_was_in_ring) {
+        return;
+    }
+    if (control->ghosts != NULL) {
+        pg_atomic_write_u32(&control->ghosts[hashcode % (uint32)control->numGhosts], hashcode | 1);
+    }
+}
+
+/*
+ * StrategyNumPartitions -- number of NUMA partitions of the buffer pool
+ *
+ * The buffer pool is only partitioned when numa_distribute_mode binds the
+ * backends to NUMA nodes; otherwise t_thrd.proc->nodeno says nothing about
+ * where a thread runs. This depends on settings fixed at postmaster start
+ * only, so it can be used before StrategyInitialize().
+ */
+int StrategyNumPartitions(void)
+{
+    int partitions = Min(g_instance.shmem_cxt.numaNodeNum, MAX_BUFFER_PARTITIONS);
+
+    if (partitions <= 1 || g_instance.attr.attr_storage.NBuffers < partitions * MIN_BUFFERS_PER_PARTITION) {
+        return 1;
+    }
+    return partitions;
+}
+
+/*
+ * StrategyPartitionRange -- buffers of one NUMA partition
+ *
+ * Partitions are contiguous ranges of buffer ids of equal size, the last one
+ * also takes the remainder.
+ */
+void StrategyPartitionRange(int partition, int* buf_id_start, int* buf_num)
+{
+    int partitions = StrategyNumPartitions();
+    int avg_num = g_instance.attr.attr_storage.NBuffers / partitions;
+
+    Assert(partition >= 0 && partition < partitions);
+    *buf_id_start = avg_num * partition;
+    *buf_num = avg_num;
+    if (partition == partitions - 1) {
+        *buf_num += g_instance.attr.attr_storage.NBuffers % partitions;
+    }
+}
+
+/*
+ * StrategyBufferPartition -- NUMA partition a buffer belongs to
+ */
+int StrategyBufferPartition(int buf_id)
+{
+    int partitions = t_thrd.storage_cxt.StrategyControl->numPartitions;
+
+    if (partitions <= 1) {
+        return 0;
+    }
+    return Min(buf_id / (g_instance.attr.attr_storage.NBuffers / partitions), partitions - 1);
+}
+
+/*
+ * StrategyLocalPartition -- NUMA partition of the node we are running on
+ */
+int StrategyLocalPartition(void)
+{
+    int partitions = t_thrd.storage_cxt.StrategyControl->numPartitions;
+
+    if (partitions <= 1 || t_thrd.proc == NULL) {
+        return 0;
+    }
+    return t_thrd.proc->nodeno % partitions;
+}
+
+/*
+ * StrategyCountHit -- account a buffer lookup hit for the NUMA statistics
+ */
+void StrategyCountHit(int buf_id)
+{
+    BufferPartitionCounts* counts = StrategyThreadCounts();
+
+    if (counts != NULL) {
+        counts->hits[StrategyBufferPartition(buf_id)]++;
+        if (++counts->pending >= BUFFER_COUNTS_FLUSH_INTERVAL) {
+            StrategyFlushCounts();
+        }
+    }
+}
+
+/*
+ * StrategyFlushCounts -- add the counts of this thread to the shared ones
+ *
+ * They go to the row of the node the thread runs on now.
+ */
+void StrategyFlushCounts(void)
+{
+    BufferPartitionCounts* counts = t_thrd.storage_cxt.buffer_partition_counts;
+    BufferStrategyControl* control = t_thrd.storage_cxt.StrategyControl;
+    BufferPartitionCounters* counters = NULL;
+
+    if (counts == NULL || counts->pending == 0) {
+        return;
+    }
+
+    counters = &control->counters[StrategyLocalPartition()];
+    for (int partition = 0; partition < control->numPartitions; partition++) {
+        if (counts->hits[partition] != 0) {
+            (void)pg_atomic_fetch_add_u64(&counters->hits[partition], counts->hits[partition]);
+            counts->hits[partition] = 0;
+        }
+        if (counts->allocs[partition] != 0) {
+            (void)pg_atomic_fetch_add_u64(&counters->allocs[partition], counts->allocs[partition]);
+            counts->allocs[partition] = 0;
+        }
+    }
+    counts->pending = 0;
+}
+
+/*
+ * StrategyGetPartitionStatus -- hit and allocation counts of one partition
+ *
+ * Accesses are remote when made by a backend bound to another NUMA node.
+ */
+void StrategyGetPartitionStatus(int partition, BufferPartitionStatus* status)
+{
+    BufferStrategyControl* control = t_thrd.storage_cxt.StrategyControl;
+
+    Assert(partition >= 0 && partition < control->numPartitions);
+    status->buf_id_start = control->partitions[partition].buf_id_start;
+    status->buf_num = control->partitions[partition].buf_num;
+    status->hits = 0;
+    status->remote_hits = 0;
+    status->allocs = 0;
+    status->remote_allocs = 0;
+
+    for (int node = 0; node < control->numPartitions; node++) {
+        uint64 hits = pg_atomic_read_u64(&control->counters[node].hits[partition]);
+        uint64 allocs = pg_atomic_read_u64(&control->counters[node].allocs[partition]);
+
+        status->hits += hits;
+        status->allocs += allocs;
+        if (node != partition) {
+            status->remote_hits += hits;
+            status->remote_allocs += allocs;
+        }
+    }
 }
 
 /* ----------------------------------------------------------------
@@ -675,36 +1041,61 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
 {
     BufferDesc* buf = NULL;
     int bgwriter_num = g_instance.bgwriter_cxt.bgwriter_num;
+    int local_partition = StrategyLocalPartition();
     uint32 local_buf_state;
 
     int list_num = bgwriter_num;
     int list_id = random() % list_num;
-    for (int i = 0; i < list_num; i++) {
-        int thread_id = (list_id + i) % list_num;
-        int buf_id = 0;
-        BgWriterProc *bgwriter = &g_instance.bgwriter_cxt.bgwriter_procs[thread_id];
-
-        while (candidate_buf_pop(&buf_id, thread_id)) {
-            buf = GetBufferDescriptor(buf_id);
-            local_buf_state = LockBufHdr(buf);
-
-            if (g_instance.bgwriter_cxt.candidate_free_map[buf_id]) {
-                g_instance.bgwriter_cxt.candidate_free_map[buf_id] = false;
-                if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_DIRTY)) {
-                    if (strategy != NULL) {
-                        AddBufferToRing(strategy, buf);
+
+    /*
+     * The first pass only takes the lists of the bgwriters serving our own
+     * NUMA partition, the second one all the others.
+     */
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < list_num; i++) {
+            int thread_id = (list_id + i) % list_num;
+            int buf_id = 0;
+            BgWriterProc *bgwriter = &g_instance.bgwriter_cxt.bgwriter_procs[thread_id];
+
+            if ((bgwriter->numa_node == local_partition) != (pass == 0)) {
+                continue;
+            }
+
+            while (candidate_buf_pop(&buf_id, thread_id)) {
+                buf = GetBufferDescriptor(buf_id);
+                local_buf_state = LockBufHdr(buf);
+
+                if (g_instance.bgwriter_cxt.candidate_free_map[buf_id]) {
+                    g_instance.bgwriter_cxt.candidate_free_map[buf_id] = false;
+
+                    /*
+                     * Under the "2q" policy a candidate referenced again since
+                     * the bgwriter listed it is aged instead of evicted, the
+                     * bgwriter will offer it again later.
+                     */
+                    if (BUFFER_POLICY_IS_2Q() && BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
+                        BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0) {
+                        local_buf_state -= BUF_USAGECOUNT_ONE;
+                        UnlockBufHdr(buf, local_buf_state);
+                        continue;
+                    }
+
+                    if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_DIRTY)) {
+                        if (strategy != NULL) {
+                            AddBufferToRing(strategy, buf);
+                        }
+                        *buf_state = local_buf_state;
+                        return buf;
                     }
-                    *buf_state = local_buf_state;
-                    return buf;
                 }
-            }
 
-            UnlockBufHdr(buf, local_buf_state);
-        }
+                UnlockBufHdr(buf, local_buf_state);
+            }
 
-        /* The current candidate list is empty, wake up the buffer writer. */
-        if (bgwriter->proc != NULL && bgwriter->is_hibernating) {
-            SetLatch(&bgwriter->proc->procLatch);
+            /* The current candidate list is empty, wake up the buffer writer. */
+            if (bgwriter->proc != NULL && bgwriter->is_hibernating) {
+                SetLatch(&bgwriter->proc->procLatch);
+            }
         }
     }
 	return NULL;
@@ -148,6 +148,7 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
         m_CacheDesc[i].m_compress_lock = LWLockAssign(trancheId);
         m_CacheDesc[i].m_refreshing = false;
         m_CacheDesc[i].m_datablock_size = 0;
+        m_CacheDesc[i].m_compressed_size = 0;
 
         SpinLockInit(&m_CacheDesc[i].m_slot_hdr_lock);
     }
@@ -159,6 +160,15 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
     SpinLockInit(&m_freeList_lock);
     SpinLockInit(&m_memsize_lock);
 
+    /* no compressed tier until InitCompressedTier() */
+    m_compressedMaxSize = 0;
+    m_compressedCurrentSize = 0;
+    m_compressedBlocks = 0;
+    m_compressedHits = 0;
+    m_demotions = 0;
+    m_compressedEvictions = 0;
+    m_evictions = 0;
+
     /* Clock Sweep Starting point  */
     m_csweep = 0;
     m_csweep_lock = CStoreCUCacheSweepLock;
@@ -185,6 +195,20 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
     m_hash = HeapMemInitHash(hash_name, total_slots, total_slots, &info, HASH_ELEM | HASH_FUNCTION | HASH_PARTITION);
 }
 
+/*
+ * @Description: let the clock sweep keep up to compressed_size bytes of column data
+ *    blocks in compressed form only, instead of evicting them. 0 disables it.
+ * @IN compressed_size: memory limit of the compressed tier, part of the cache size
+ * @See also:
+ */
+void CacheMgr::InitCompressedTier(int64 compressed_size)
+{
+    Assert(m_cache_type == MGR_CACHE_TYPE_DATA);
+    Assert(compressed_size >= 0 && compressed_size <= m_cstoreMaxSize);
+
+    m_compressedMaxSize = compressed_size;
+}
+
 /*
  * @Description: destroy all resource of cache instance,
  *	  excluding this instance itself.
@@ -360,8 +384,9 @@ void CacheMgr::DeleteCacheBlock(CacheTag *cacheTag)
 }
 
 /*
- * @Description: use clock-swap algorithm to evict a block
- * @Return: slot id
+ * @Description: use clock-swap algorithm to evict a block, column data blocks that kept
+ *    their compressed image are first demoted to the compressed tier
+ * @Return: slot id, CACHE_BLOCK_INVALID_IDX if the caller should try the free list again
  * @See also:
  */
 CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
@@ -416,10 +441,33 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
                 if (m_CacheDesc[slotId].m_usage_count == 0) {
                     /* skip cache blocks that are in another ring , 1 in my ring,  0 no ring */
                     if (m_CacheDesc[slotId].m_ring_count == 0) {
+                        /*
+                         * A decompressed column CU that kept its compressed image moves
+                         * to the compressed tier instead, and the sweep goes on.
+                         */
+                        if (CacheBlockDemotable_Locked(slotId)) {
+                            m_CacheDesc[slotId].m_flag |= CACHE_BLOCK_IOBUSY;
+                            PinCacheBlock_Locked(slotId);  // Released header lock
+                            DemoteCacheBlock(slotId);
+
+                            /* the memory given back may already be enough for the caller */
+                            if (!CacheFreeListEmpty() && GetCurrentMemSize() + size <= m_cstoreMaxSize) {
+                                UnlockSweep();
+                                return CACHE_BLOCK_INVALID_IDX;
+                            }
+                            CHECK_CACHE_SLOT_STATUS();
+                            continue;
+                        }
+
                         ereport(DEBUG2,
                                 (errmodule(MOD_CACHE), errmsg("evict cache block, solt(%d), flag(%d - %d)", slotId,
                                                               m_CacheDesc[slotId].m_flag, CACHE_BLOCK_INFREE)));
 
+                        if (m_CacheDesc[slotId].m_compressed_size > 0) {
+                            m_compressedEvictions++;
+                        } else {
+                            m_evictions++;
+                        }
                         m_CacheDesc[slotId].m_flag = CACHE_BLOCK_INFREE;  // !Valid
                         PinCacheBlock_Locked(slotId);                     // Released header lock
                         found++;
@@ -466,6 +514,128 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
     return slotId;
 }
 
+/*
+ * @Description: check whether the clock sweep can move a block to the compressed tier:
+ *    a valid column CU that kept its compressed image when it was decompressed, and
+ *    whose compressed image still fits in the compressed tier.
+ * @IN slotId: cache block index, header lock must be held
+ * @Return: true if the block can be demoted
+ * @See also: DataCacheMgr::StartUncompressCU
+ */
+bool CacheMgr::CacheBlockDemotable_Locked(CacheSlotId_t slotId)
+{
+    if (m_CacheDesc[slotId].m_cache_tag.type != CACHE_COlUMN_DATA || m_CacheDesc[slotId].m_flag != CACHE_BLOCK_VALID) {
+        return false;
+    }
+
+    CU *cu = (CU *)(&m_CacheSlots[slotId * m_slot_length]);
+    if (cu->m_cache_compressed || cu->m_compressedBuf == NULL) {
+        return false;
+    }
+
+    /* only the sweep adds blocks to the compressed tier, so this can't overshoot */
+    return m_compressedCurrentSize + cu->GetCompressBufSize() <= m_compressedMaxSize;
+}
+
+/*
+ * @Description: free the decompressed data of a block and keep its compressed image,
+ *    readers finding it meanwhile wait for the IO busy lock and then decompress it again.
+ * @IN slotId: cache block index, pinned and marked IO busy by the clock sweep
+ * @See also:
+ */
+void CacheMgr::DemoteCacheBlock(CacheSlotId_t slotId)
+{
+    CU *cu = (CU *)(&m_CacheSlots[slotId * m_slot_length]);
+    int compressedSize = cu->GetCompressBufSize();
+    int oldSize = 0;
+
+    (void)LWLockAcquire(m_CacheDesc[slotId].m_iobusy_lock, LW_EXCLUSIVE);
+
+    cu->FreeSrcBuf();
+    cu->m_cache_compressed = true;
+
+    LockCacheDescHeader(slotId);
+    oldSize = m_CacheDesc[slotId].m_datablock_size;
+    m_CacheDesc[slotId].m_datablock_size = compressedSize;
+    m_CacheDesc[slotId].m_compressed_size = compressedSize;
+    m_CacheDesc[slotId].m_flag &= ~CACHE_BLOCK_IOBUSY;
+    UnLockCacheDescHeader(slotId);
+    LWLockRelease(m_CacheDesc[slotId].m_iobusy_lock);
+
+    Assert(oldSize >= compressedSize);
+    SpinLockAcquire(&m_memsize_lock);
+    m_cstoreCurrentSize -= oldSize - compressedSize;
+    m_compressedCurrentSize += compressedSize;
+    m_compressedBlocks++;
+    SpinLockRelease(&m_memsize_lock);
+    m_demotions++;
+
+    ereport(DEBUG2, (errmodule(MOD_CACHE), errmsg("demote cache block, slot(%d), size(%d - %d)", slotId, oldSize,
+                                                  compressedSize)));
+    UnPinCacheBlock(slotId);
+}
+
+/*
+ * @Description: take a block out of the compressed tier
+ * @IN slotId: cache block index, pinned by the caller
+ * @IN hit: whether the block leaves the tier because it is decompressed again
+ * @See also:
+ */
+void CacheMgr::ReleaseCompressedTier(CacheSlotId_t slotId, bool hit)
+{
+    int compressedSize = 0;
+
+    LockCacheDescHeader(slotId);
+    compressedSize = m_CacheDesc[slotId].m_compressed_size;
+    m_CacheDesc[slotId].m_compressed_size = 0;
+    UnLockCacheDescHeader(slotId);
+
+    if (compressedSize == 0) {
+        return;
+    }
+
+    SpinLockAcquire(&m_memsize_lock);
+    Assert(m_compressedCurrentSize >= compressedSize && m_compressedBlocks > 0);
+    m_compressedCurrentSize -= compressedSize;
+    m_compressedBlocks--;
+    if (hit) {
+        m_compressedHits++;
+    }
+    SpinLockRelease(&m_memsize_lock);
+}
+
+/*
+ * @Description: a block of the compressed tier has been decompressed again
+ * @IN slotId: cache block index, pinned by the caller
+ * @See also: DataCacheMgr::StartUncompressCU
+ */
+void CacheMgr::LeaveCompressedTier(CacheSlotId_t slotId)
+{
+    ReleaseCompressedTier(slotId, true);
+}
+
+/*
+ * @Description: get the memory used by the cache and its compressed tier, and the
+ *    clock sweep counters, which are read without the sweep lock and may lag.
+ * @OUT stat: statistics
+ * @See also:
+ */
+void CacheMgr::GetCacheTierStat(CacheTierStat *stat)
+{
+    SpinLockAcquire(&m_memsize_lock);
+    stat->cache_size = m_cstoreMaxSize;
+    stat->used_size = m_cstoreCurrentSize;
+    stat->compressed_limit = m_compressedMaxSize;
+    stat->compressed_size = m_compressedCurrentSize;
+    stat->compressed_blocks = m_compressedBlocks;
+    stat->compressed_hits = m_compressedHits;
+    SpinLockRelease(&m_memsize_lock);
+
+    stat->demotions = m_demotions;
+    stat->compressed_evictions = m_compressedEvictions;
+    stat->evictions = m_evictions;
+}
+
 /*
  * @Description:  get an Invalid cache block, first try get from free list cache, if without space,
  * second evict from used cache block, if all cache block are using, return error
@@ -576,6 +746,9 @@ void CacheMgr::FreeCacheBlockMem(CacheSlotId_t slot)
         CU *cu = (CU *)(&m_CacheSlots[slot * m_slot_length]);
         cu->FreeMem<true>();
         cu->Reset();
+        if (m_CacheDesc[slot].m_compressed_size > 0) {
+            ReleaseCompressedTier(slot, false);
+        }
     } else if (m_CacheDesc[slot].m_cache_tag.type == CACHE_ORC_DATA ||
                m_CacheDesc[slot].m_cache_tag.type == CACHE_OBS_DATA) {
         OrcDataValue *orc_data = (OrcDataValue *)(&m_CacheSlots[slot * m_slot_length]);
@@ -608,6 +781,10 @@ int CacheMgr::GetCacheBlockMemSize(CacheSlotId_t slot)
         CU *cu = (CU *)(&m_CacheSlots[slot * m_slot_length]);
         if (!cu->m_cache_compressed) {
             slot_size = cu->GetUncompressBufSize();
+            /* the compressed image kept for the compressed tier */
+            if (cu->m_compressedBuf != NULL) {
+                slot_size += cu->GetCompressBufSize();
+            }
         } else {
             slot_size = cu->GetCompressBufSize();
         }
@@ -926,6 +926,536 @@ int64 DeltaCoder::Decompress(
     return ret;
 }
 
+/*************************************************************************
+ *                  Frame of Reference Bit-packing (PFOR)                 *
+ *************************************************************************/
+// groups are decoded with unaligned 64-bit loads, and 16-byte loads by the
+// AVX2 kernels, which may read past the end of a group. groups closer than
+// this to the end of the input are decoded from a padded copy.
+#define BITPACK_READ_MARGIN 16
+
+// the AVX2 kernels shift a 32-bit window of each value, which holds up to
+// 7 leading bits of the previous value plus the value itself.
+#define BITPACK_SIMD_MAX_WIDTH 25
+
+/* difference from the frame of reference, in the bits of one value */
+template <short eachValSize>
+static FORCE_INLINE uint64 BitpackReadDiff(char* inbuf, unsigned int* inpos, int64 base)
+{
+    uint64 diff = (uint64)readData<eachValSize>(inbuf, inpos) - (uint64)base;
+    return diff & ((~UINT64CONST(0)) >> (64 - eachValSize * 8));
+}
+
+static FORCE_INLINE uint32 BitpackGetWidth(uint64 diff)
+{
+    return (diff == 0) ? 0 : (uint32)(64 - __builtin_clzll(diff));
+}
+
+static FORCE_INLINE uint64 BitpackLoadWord(const unsigned char* p)
+{
+    uint64 word = *(const uint64*)p;
+#ifdef WORDS_BIGENDIAN
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/* value <i> of a group, <width> bits starting at bit (i * width) */
+template <int width>
+static FORCE_INLINE uint64 BitpackExtract(const unsigned char* group, int i)
+{
+    const uint32 bitpos = (uint32)(i * width);
+    const uint32 shift = bitpos & 7;
+    uint64 value = BitpackLoadWord(group + (bitpos >> 3)) >> shift;
+
+    // a value wider than 57 bits may spill into the 9th byte
+    if (width > 57 && shift + width > 64) {
+        value |= (uint64)group[(bitpos >> 3) + sizeof(uint64)] << (64 - shift);
+    }
+    return (width == 64) ? value : (value & ((UINT64CONST(1) << width) - 1));
+}
+
+typedef void (*BitpackUnpackFunc)(const unsigned char* group, uint64* values);
+
+template <int width>
+static void BitpackUnpackGroup(const unsigned char* group, uint64* values)
+{
+    for (int i = 0; i < BITPACK_GROUP; i++) {
+        values[i] = BitpackExtract<width>(group, i);
+    }
+}
+
+#define BITPACK_UNPACK_8(_w)                                                                       \
+    BitpackUnpackGroup<(_w)>, BitpackUnpackGroup<(_w) + 1>, BitpackUnpackGroup<(_w) + 2>,          \
+        BitpackUnpackGroup<(_w) + 3>, BitpackUnpackGroup<(_w) + 4>, BitpackUnpackGroup<(_w) + 5>, \
+        BitpackUnpackGroup<(_w) + 6>, BitpackUnpackGroup<(_w) + 7>
+
+/* indexed by the bit width, the shifts and masks are constant in each one */
+static const BitpackUnpackFunc BitpackUnpackFuncs[sizeof(int64) * 8 + 1] = {BitpackUnpackGroup<0>,
+    BITPACK_UNPACK_8(1),
+    BITPACK_UNPACK_8(9),
+    BITPACK_UNPACK_8(17),
+    BITPACK_UNPACK_8(25),
+    BITPACK_UNPACK_8(33),
+    BITPACK_UNPACK_8(41),
+    BITPACK_UNPACK_8(49),
+    BITPACK_UNPACK_8(57)};
+
+static void BitpackPackGroup(const uint64* values, uint32 width, unsigned char* group)
+{
+    if (width == 0) {
+        return;
+    }
+
+    errno_t rc = memset_s(group, width, 0, width);
+    securec_check(rc, "\0", "\0");
+
+    uint32 bitpos = 0;
+    for (int i = 0; i < BITPACK_GROUP; i++, bitpos += width) {
+        uint32 byte = bitpos >> 3;
+        uint32 written = 8 - (bitpos & 7);
+
+        group[byte] |= (unsigned char)(values[i] << (bitpos & 7));
+        while (written < width) {
+            group[++byte] |= (unsigned char)(values[i] >> written);
+            written += 8;
+        }
+    }
+}
+
+/*
+ * SIMD decoding of whole groups into 4-byte or 8-byte values, for widths up
+ * to BITPACK_SIMD_MAX_WIDTH. A kernel returns how many groups it decoded;
+ * the remaining ones are left to BitpackUnpackFuncs[].
+ */
+typedef uint32 (*BitpackSimdUnpackFunc)(
+    const unsigned char* packed, const unsigned char* inEnd, uint32 width, uint32 ngroups, int64 base, char* outbuf);
+
+typedef struct BitpackSimdKernels {
+    BitpackSimdUnpackFunc unpack32;
+    BitpackSimdUnpackFunc unpack64;
+} BitpackSimdKernels;
+
+static uint32 BitpackUnpackScalar(
+    const unsigned char* packed, const unsigned char* inEnd, uint32 width, uint32 ngroups, int64 base, char* outbuf)
+{
+    return 0;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BITPACK_SIMD_X86
+#include <immintrin.h>
+
+/*
+ * per bit width, the byte shuffle moving the 32-bit window of each value of a
+ * group into its own lane, and the bit shift of the value in that window.
+ * the upper four values are loaded into the upper lane from <hiOffset>.
+ */
+typedef struct BitpackSimdPlan {
+    uint8 shuffle[32];
+    int32 shift[BITPACK_GROUP];
+    uint32 hiOffset;
+} BitpackSimdPlan;
+
+static BitpackSimdPlan BitpackSimdPlans[BITPACK_SIMD_MAX_WIDTH + 1];
+
+static void BitpackInitSimdPlans(void)
+{
+    for (uint32 width = 1; width <= BITPACK_SIMD_MAX_WIDTH; width++) {
+        BitpackSimdPlan* plan = &BitpackSimdPlans[width];
+
+        plan->hiOffset = (4 * width) >> 3;
+        for (uint32 i = 0; i < BITPACK_GROUP; i++) {
+            uint32 bitpos = i * width;
+            uint32 offset = (bitpos >> 3) - ((i < 4) ? 0 : plan->hiOffset);
+
+            for (uint32 k = 0; k < sizeof(int32); k++) {
+                plan->shuffle[i * sizeof(int32) + k] = (uint8)(offset + k);
+            }
+            plan->shift[i] = (int32)(bitpos & 7);
+        }
+    }
+}
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+static inline __m256i BitpackUnpackAvx2(
+    const unsigned char* group, uint32 hiOffset, __m256i shuffle, __m256i shift, __m256i mask)
+{
+    __m128i lo = _mm_loadu_si128((const __m128i*)group);
+    __m128i hi = _mm_loadu_si128((const __m128i*)(group + hiOffset));
+    __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+    return _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(bytes, shuffle), shift), mask);
+}
+
+static uint32 BitpackUnpack32Avx2(
+    const unsigned char* packed, const unsigned char* inEnd, uint32 width, uint32 ngroups, int64 base, char* outbuf)
+{
+    const BitpackSimdPlan* plan = &BitpackSimdPlans[width];
+    __m256i shuffle = _mm256_loadu_si256((const __m256i*)plan->shuffle);
+    __m256i shift = _mm256_loadu_si256((const __m256i*)plan->shift);
+    __m256i mask = _mm256_set1_epi32((int32)((1U << width) - 1));
+    __m256i vbase = _mm256_set1_epi32((int32)base);
+    uint32 g = 0;
+
+    for (; g < ngroups && packed + width + BITPACK_READ_MARGIN <= inEnd; g++, packed += width) {
+        __m256i values = _mm256_add_epi32(BitpackUnpackAvx2(packed, plan->hiOffset, shuffle, shift, mask), vbase);
+        _mm256_storeu_si256((__m256i*)outbuf, values);
+        outbuf += BITPACK_GROUP * sizeof(int32);
+    }
+    return g;
+}
+
+static uint32 BitpackUnpack64Avx2(
+    const unsigned char* packed, const unsigned char* inEnd, uint32 width, uint32 ngroups, int64 base, char* outbuf)
+{
+    const BitpackSimdPlan* plan = &BitpackSimdPlans[width];
+    __m256i shuffle = _mm256_loadu_si256((const __m256i*)plan->shuffle);
+    __m256i shift = _mm256_loadu_si256((const __m256i*)plan->shift);
+    __m256i mask = _mm256_set1_epi32((int32)((1U << width) - 1));
+    __m256i vbase = _mm256_set1_epi64x(base);
+    uint32 g = 0;
+
+    for (; g < ngroups && packed + width + BITPACK_READ_MARGIN <= inEnd; g++, packed += width) {
+        __m256i values = BitpackUnpackAvx2(packed, plan->hiOffset, shuffle, shift, mask);
+        __m256i lo = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(values)), vbase);
+        __m256i hi = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(values, 1)), vbase);
+
+        _mm256_storeu_si256((__m256i*)outbuf, lo);
+        _mm256_storeu_si256((__m256i*)(outbuf + 4 * sizeof(int64)), hi);
+        outbuf += BITPACK_GROUP * sizeof(int64);
+    }
+    return g;
+}
+
+#pragma GCC pop_options
+
+#endif /* BITPACK_SIMD_X86 */
+
+static BitpackSimdKernels BitpackSimdTable;
+static const BitpackSimdKernels* volatile BitpackSimd = NULL;
+
+/* pick the kernels for this CPU on first use, see also vec_simd_choose() */
+static const BitpackSimdKernels* BitpackSimdChoose(void)
+{
+    BitpackSimdKernels* kernels = &BitpackSimdTable;
+
+    if (BitpackSimd != NULL) {
+        return BitpackSimd;
+    }
+
+    kernels->unpack32 = BitpackUnpackScalar;
+    kernels->unpack64 = BitpackUnpackScalar;
+#ifdef BITPACK_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        BitpackInitSimdPlans();
+        kernels->unpack32 = BitpackUnpack32Avx2;
+        kernels->unpack64 = BitpackUnpack64Avx2;
+    }
+#endif
+
+    pg_memory_barrier();
+    BitpackSimd = kernels;
+    return kernels;
+}
+
+#define BITPACK_SIMD() (likely(BitpackSimd != NULL) ? BitpackSimd : BitpackSimdChoose())
+
+template <short eachValSize>
+void BitpackCoder::InnerAnalyze(char* inbuf, int insize, uint32* widthCounts)
+{
+    unsigned int inpos = 0;
+
+    while ((int)inpos < insize) {
+        ++widthCounts[BitpackGetWidth(BitpackReadDiff<eachValSize>(inbuf, &inpos, m_base))];
+    }
+}
+
+// Analyze
+//	inbuf: the input data buffer
+//  insize: the size of inbuf
+//  minVal: the min value of all the input values
+// return the size of the compressed data with the best width.
+int BitpackCoder::Analyze(char* inbuf, int insize, int64 minVal)
+{
+    uint32 widthCounts[sizeof(int64) * 8 + 1] = {0};
+    const uint32 nvalues = (uint32)(insize / m_eachValSize);
+    const int64 exceptionSize = sizeof(uint32) + m_eachValSize;
+    int64 bestSize = (int64)BitpackGroupsSize((int64)nvalues, (int64)m_eachValSize * 8);
+    uint32 fitted = 0;
+
+    Assert(insize > 0 && (insize % m_eachValSize) == 0);
+    m_base = minVal;
+    m_bitWidth = m_eachValSize * 8;
+    m_exceptionsCount = 0;
+
+    switch (m_eachValSize) {
+        case sizeof(char):
+            InnerAnalyze<sizeof(char)>(inbuf, insize, widthCounts);
+            break;
+        case sizeof(int16):
+            InnerAnalyze<sizeof(int16)>(inbuf, insize, widthCounts);
+            break;
+        case 3:
+            InnerAnalyze<3>(inbuf, insize, widthCounts);
+            break;
+        case sizeof(int32):
+            InnerAnalyze<sizeof(int32)>(inbuf, insize, widthCounts);
+            break;
+        case 5:
+            InnerAnalyze<5>(inbuf, insize, widthCounts);
+            break;
+        case 6:
+            InnerAnalyze<6>(inbuf, insize, widthCounts);
+            break;
+        case 7:
+            InnerAnalyze<7>(inbuf, insize, widthCounts);
+            break;
+        case sizeof(int64):
+            InnerAnalyze<sizeof(int64)>(inbuf, insize, widthCounts);
+            break;
+        default:
+            Assert(false);
+            break;
+    }
+
+    // the values wider than the chosen width become exceptions, which cost
+    // their position and raw value. take the width giving the smallest size.
+    for (uint32 width = 0; width < (uint32)m_eachValSize * 8; width++) {
+        fitted += widthCounts[width];
+        int64 size = (int64)BitpackGroupsSize((int64)nvalues, (int64)width) + (nvalues - fitted) * exceptionSize;
+        if (size < bestSize) {
+            bestSize = size;
+            m_bitWidth = width;
+            m_exceptionsCount = nvalues - fitted;
+        }
+    }
+
+    return (int)(sizeof(BitpackHeader) + bestSize);
+}
+
+template <short eachValSize>
+int BitpackCoder::InnerCompress(char* inbuf, char* outbuf, int insize)
+{
+    const uint32 nvalues = (uint32)(insize / eachValSize);
+    BitpackHeader header;
+    unsigned char* packed = (unsigned char*)outbuf + sizeof(BitpackHeader);
+    char* positions = (char*)packed + BitpackGroupsSize(nvalues, m_bitWidth);
+    char* rawValues = positions + sizeof(uint32) * m_exceptionsCount;
+    uint64 values[BITPACK_GROUP];
+    unsigned int inpos = 0;
+    uint32 nexceptions = 0;
+    errno_t rc;
+
+    /* zero the tail padding too, so that equal inputs give equal CU bytes */
+    rc = memset_s(&header, sizeof(BitpackHeader), 0, sizeof(BitpackHeader));
+    securec_check(rc, "\0", "\0");
+    header.m_base = m_base;
+    header.m_valuesCount = nvalues;
+    header.m_exceptionsCount = m_exceptionsCount;
+    header.m_bitWidth = m_bitWidth;
+
+    rc = memcpy_s(outbuf, sizeof(BitpackHeader), &header, sizeof(BitpackHeader));
+    securec_check(rc, "\0", "\0");
+
+    for (uint32 i = 0; i < nvalues; i += BITPACK_GROUP) {
+        for (uint32 j = 0; j < BITPACK_GROUP; j++) {
+            values[j] = 0;
+            if (i + j >= nvalues) {
+                continue;
+            }
+
+            char* rawValue = inbuf + inpos;
+            uint64 diff = BitpackReadDiff<eachValSize>(inbuf, &inpos, m_base);
+            if (BitpackGetWidth(diff) <= m_bitWidth) {
+                values[j] = diff;
+                continue;
+            }
+
+            uint32 position = i + j;
+            Assert(nexceptions < m_exceptionsCount);
+            rc = memcpy_s(positions + sizeof(uint32) * nexceptions, sizeof(uint32), &position, sizeof(uint32));
+            securec_check(rc, "\0", "\0");
+            rc = memcpy_s(rawValues + eachValSize * nexceptions, eachValSize, rawValue, eachValSize);
+            securec_check(rc, "\0", "\0");
+            ++nexceptions;
+        }
+        BitpackPackGroup(values, m_bitWidth, packed);
+        packed += m_bitWidth;
+    }
+    Assert(nexceptions == m_exceptionsCount);
+
+    return (int)((rawValues + eachValSize * nexceptions) - outbuf);
+}
+
+// Compress
+//	inbuf: the input data buffer
+//  outbuf: the output buffer
+//  insize: the size of inbuf
+//  outsize: the sizeof outbuf
+// Analyze() must be called before with the same input.
+int BitpackCoder::Compress(char* inbuf, char* outbuf, int insize, int outsize)
+{
+    int ret = 0;
+    Assert(insize > 0 && (insize % m_eachValSize) == 0);
+    if (unlikely((int64)outsize < (int64)sizeof(BitpackHeader) +
+                                      BitpackGroupsSize((int64)(insize / m_eachValSize), (int64)m_bitWidth) +
+                                      (int64)m_exceptionsCount * (int64)(sizeof(uint32) + m_eachValSize)))
+        return 0;
+
+    switch (m_eachValSize) {
+        case sizeof(char):
+            ret = InnerCompress<sizeof(char)>(inbuf, outbuf, insize);
+            break;
+        case sizeof(int16):
+            ret = InnerCompress<sizeof(int16)>(inbuf, outbuf, insize);
+            break;
+        case 3:
+            ret = InnerCompress<3>(inbuf, outbuf, insize);
+            break;
+        case sizeof(int32):
+            ret = InnerCompress<sizeof(int32)>(inbuf, outbuf, insize);
+            break;
+        case 5:
+            ret = InnerCompress<5>(inbuf, outbuf, insize);
+            break;
+        case 6:
+            ret = InnerCompress<6>(inbuf, outbuf, insize);
+            break;
+        case 7:
+            ret = InnerCompress<7>(inbuf, outbuf, insize);
+            break;
+        case sizeof(int64):
+            ret = InnerCompress<sizeof(int64)>(inbuf, outbuf, insize);
+            break;
+        default:
+            Assert(false);
+            break;
+    }
+    return ret;
+}
+
+template <short eachValSize>
+void BitpackCoder::InnerDecompress(
+    const BitpackHeader* header, const unsigned char* packed, const unsigned char* inEnd, char* outbuf)
+{
+    const uint32 width = header->m_bitWidth;
+    const uint32 nvalues = header->m_valuesCount;
+    const uint64 base = (uint64)header->m_base;
+    const char* positions = (const char*)packed + BitpackGroupsSize(nvalues, width);
+    const char* rawValues = positions + sizeof(uint32) * header->m_exceptionsCount;
+    BitpackUnpackFunc unpack = BitpackUnpackFuncs[width];
+    uint64 values[BITPACK_GROUP];
+    unsigned char padded[sizeof(uint64) * BITPACK_GROUP + BITPACK_READ_MARGIN];
+    unsigned int outpos = 0;
+    uint32 ngroups = nvalues / BITPACK_GROUP;
+    uint32 g = 0;
+    uint32 done = 0;
+    errno_t rc;
+
+    if (width == 0) {
+        for (done = 0; done < nvalues; done++) {
+            writeData<eachValSize>(outbuf, &outpos, (int64)base);
+        }
+    } else {
+        // most of the groups of the integer, date and timestamp columns go here
+        if ((eachValSize == sizeof(int32) || eachValSize == sizeof(int64)) && width <= BITPACK_SIMD_MAX_WIDTH) {
+            const BitpackSimdKernels* simd = BITPACK_SIMD();
+            g = (eachValSize == sizeof(int32)) ? simd->unpack32(packed, inEnd, width, ngroups, (int64)base, outbuf)
+                                               : simd->unpack64(packed, inEnd, width, ngroups, (int64)base, outbuf);
+            packed += g * width;
+            outpos += g * BITPACK_GROUP * eachValSize;
+        }
+
+        for (; g < ngroups && packed + width + BITPACK_READ_MARGIN <= inEnd; g++, packed += width) {
+            unpack(packed, values);
+            for (int i = 0; i < BITPACK_GROUP; i++) {
+                writeData<eachValSize>(outbuf, &outpos, (int64)(values[i] + base));
+            }
+        }
+
+        // the last groups, including a partial one
+        for (done = g * BITPACK_GROUP; done < nvalues; done += BITPACK_GROUP, packed += width) {
+            rc = memset_s(padded, sizeof(padded), 0, sizeof(padded));
+            securec_check(rc, "\0", "\0");
+            rc = memcpy_s(padded, sizeof(padded), packed, width);
+            securec_check(rc, "\0", "\0");
+
+            unpack(padded, values);
+            for (uint32 i = 0; i < BITPACK_GROUP && done + i < nvalues; i++) {
+                writeData<eachValSize>(outbuf, &outpos, (int64)(values[i] + base));
+            }
+        }
+    }
+
+    // patch the exceptions
+    for (uint32 i = 0; i < header->m_exceptionsCount; i++) {
+        uint32 position = 0;
+        rc = memcpy_s(&position, sizeof(uint32), positions + sizeof(uint32) * i, sizeof(uint32));
+        securec_check(rc, "\0", "\0");
+        Assert(position < nvalues);
+        rc = memcpy_s(outbuf + eachValSize * position, eachValSize, rawValues + eachValSize * i, eachValSize);
+        securec_check(rc, "\0", "\0");
+    }
+}
+
+// Decompress
+//	inbuf: the compressed data buffer
+//  outbuf: the output buffer
+//  insize: the size of inbuf
+//  outsize: the sizeof outbuf
+// return the size of the raw data.
+int BitpackCoder::Decompress(char* inbuf, char* outbuf, int insize, int outsize)
+{
+    BitpackHeader header;
+    const unsigned char* packed = (const unsigned char*)inbuf + sizeof(BitpackHeader);
+    const unsigned char* inEnd = (const unsigned char*)inbuf + insize;
+
+    Assert(insize >= (int)sizeof(BitpackHeader));
+    errno_t rc = memcpy_s(&header, sizeof(BitpackHeader), inbuf, sizeof(BitpackHeader));
+    securec_check(rc, "\0", "\0");
+
+    int rawSize = (int)(header.m_valuesCount * m_eachValSize);
+    Assert(header.m_bitWidth <= (uint32)m_eachValSize * 8);
+    Assert(rawSize <= outsize);
+    Assert((int64)sizeof(BitpackHeader) + BitpackGroupsSize((int64)header.m_valuesCount, (int64)header.m_bitWidth) +
+               (int64)header.m_exceptionsCount * (int64)(sizeof(uint32) + m_eachValSize) <= (int64)insize);
+
+    switch (m_eachValSize) {
+        case sizeof(char):
+            InnerDecompress<sizeof(char)>(&header, packed, inEnd, outbuf);
+            break;
+        case sizeof(int16):
+            InnerDecompress<sizeof(int16)>(&header, packed, inEnd, outbuf);
+            break;
+        case 3:
+            InnerDecompress<3>(&header, packed, inEnd, outbuf);
+            break;
+        case sizeof(int32):
+            InnerDecompress<sizeof(int32)>(&header, packed, inEnd, outbuf);
+            break;
+        case 5:
+            InnerDecompress<5>(&header, packed, inEnd, outbuf);
+            break;
+        case 6:
+            InnerDecompress<6>(&header, packed, inEnd, outbuf);
+            break;
+        case 7:
+            InnerDecompress<7>(&header, packed, inEnd, outbuf);
+            break;
+        case sizeof(int64):
+            InnerDecompress<sizeof(int64)>(&header, packed, inEnd, outbuf);
+            break;
+        default:
+            Assert(false);
+            break;
+    }
+    return rawSize;
+}
+
 /*************************************************************************
  *                         Dictionary Compression                         *
  *************************************************************************/
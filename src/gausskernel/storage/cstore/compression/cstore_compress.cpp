@@ -401,11 +401,31 @@ int IntegerCoder::CompressInner(const CompressionArg1& in, CompressionArg2& out)
         }
     }
 
-    // Step3: try to apply LZ4 or Zlib according to CompressLevel
+    // Step3: try to do frame of reference bit-packing. it's bit bound and patches the
+    // outliers, and it's decoded a group of values at a time, so it replaces delta and
+    // RleCoder whenever its result is smaller than theirs.
+    BitpackCoder bitpack(this->m_eachValSize);
+    cmprSize = bitpack.Analyze(in.buf, in.sz, this->m_minVal);
+    if (cmprSize < currInBufSize + ((out.modes & CU_DeltaCompressed) ? (this->m_eachValSize * 2) : 0)) {
+        Assert((Size)cmprSize < tempOutBuf.bufSize);
+        cmprSize = bitpack.Compress(in.buf, tempOutBuf.buf, in.sz, tempOutBuf.bufSize);
+        Assert(cmprSize > 0);
+        rc = memcpy_s(out.buf, cmprSize, tempOutBuf.buf, cmprSize);
+        securec_check(rc, "", "");
+        out.sz = cmprSize;
+        out.modes &= ~(CU_DeltaCompressed | CU_RLECompressed);
+        out.modes |= CU_BitpackCompressed;
+
+        currInBuf = out.buf;
+        currInBufSize = cmprSize;
+    }
+    cmprSize = 0;
+
+    // Step4: try to apply LZ4 or Zlib according to CompressLevel
     // Apply different compression method for compressionLevel
-    // COMPRESS_LOW:    delta compression | RleCoder
-    // COMPRESS_MIDDLE: delta compression | RleCoder | LZ4
-    // COMPRESS_HIGH:   delta compression | RleCoder | Zlib
+    // COMPRESS_LOW:    delta compression | RleCoder, or bit-packing
+    // COMPRESS_MIDDLE: delta compression | RleCoder, or bit-packing | LZ4
+    // COMPRESS_HIGH:   delta compression | RleCoder, or bit-packing | Zlib
     // We can skip LZ4/Zlib compression when level is COMPRESS_MIDDLE or COMPRESS_HIGH
     if (compression == COMPRESS_LOW) {
         BufferHelperFree(&tempOutBuf);
@@ -559,6 +579,22 @@ int IntegerCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionAr
         }
     }
 
+    if ((modes & CU_BitpackCompressed) != 0) {
+        // bit-packing is never applied together with delta or rle.
+        Assert((modes & (CU_DeltaCompressed | CU_RLECompressed)) == 0);
+
+        BitpackCoder bitpack(m_eachValSize);
+        nextOutSize = bitpack.Decompress(nextInBuf, nextOutBuf, nextInSize, out.sz);
+        Assert(nextOutSize > 0 && nextOutSize <= out.sz);
+
+        // prepare input buffer and output buffer for the next compression method
+        if (preparedOk) {
+            swapBuf(nextInBuf, nextOutBuf, nextInSize, nextOutSize);
+        } else {
+            prepareSwapBuf(nextInBuf, nextOutBuf, nextInSize, nextOutSize, tmpBuf.buf, out.sz, preparedOk);
+        }
+    }
+
     if ((modes & CU_RLECompressed) != 0) {
         // case 1: both delta and rle methods are applied to, the value size is inValSize,
         //         which is the size of DELTA value.
@@ -856,7 +892,7 @@ int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg
     int outSize = dict->Decompress((char*)m_dicCodes, m_dicCodesNum * sizeof(DicCodeType), out.buf, out.sz);
     delete dict;
 
-    if (m_dicCodes) {
+    if (m_dicCodes && !m_keep_dic_codes) {
         pfree(m_dicCodes);
         m_dicCodes = NULL;
     }
@@ -864,6 +900,16 @@ int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg
     return outSize;
 }
 
+DicCodeType* StringCoder::TakeDicCodes(_out_ int* codesNum)
+{
+    DicCodeType* codes = m_dicCodes;
+
+    *codesNum = m_dicCodesNum;
+    m_dicCodes = NULL;
+    m_dicCodesNum = 0;
+    return codes;
+}
+
 ///
 /// DeltaPlusRLEv2 Implements
 ///
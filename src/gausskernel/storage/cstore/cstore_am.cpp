@@ -47,6 +47,7 @@
 #include "storage/cstore_compress.h"
 #include "utils/tqual.h"
 #include "access/sysattr.h"
+#include "executor/executor.h"
 #include "executor/instrument.h"
 #include "utils/date.h"
 #include "utils/rel.h"
@@ -55,6 +56,7 @@
 #include "vecexecutor/vecnodes.h"
 #include "vecexecutor/vecnoderowtovector.h"
 #include "access/cstore_roughcheck_func.h"
+#include "access/cstore_sketch.h"
 #include "utils/snapmgr.h"
 #include "catalog/storage.h"
 #include "miscadmin.h"
@@ -64,6 +66,7 @@
 #include "securec_check.h"
 #include "commands/tablespace.h"
 #include "workload/workload.h"
+#include "utils/atomic.h"
 
 #ifdef PGXC
 #include "pgxc/pgxc.h"
@@ -87,6 +90,11 @@
 
 #define CSTORE_MIN_PREFETCH_COUNT 8
 
+/* a parallel scan hands out at least this many chunks per participant */
+#define CSTORE_PARALLEL_CHUNKS_PER_PARTICIPANT 16
+/* and claims no more than this many CU IDs at a time */
+#define CSTORE_PARALLEL_MAX_CU_CHUNK 8U
+
 #define InitFillColFunction(i, attlen)                                            \
     do {                                                                          \
         m_colFillFunArrary[i].colFillFun[0] = &CStore::FillVector<false, attlen>; \
@@ -126,8 +134,16 @@ CStore::CStore()
       m_delMaskCUId(InValidCUID),
       m_cursor(0),
       m_rowCursorInCU(0),
+      m_batchRows(BatchMaxSize),
       m_startCUID(0),
       m_endCUID(0),
+      m_parallelScan(NULL),
+      m_claimEndCUID(0),
+      m_dictFilters(NULL),
+      m_dictSel(NULL),
+      m_dictSelValid(false),
+      m_dictFilterCxt(NULL),
+      m_sketchKeys(NIL),
       m_hasDeadRow(false),
       m_needRCheck(false),
       m_onlyConstCol(false),
@@ -397,6 +413,10 @@ CStore::~CStore()
     m_relation = NULL;
     m_fillMinMaxFunc = NULL;
     m_sysColId = NULL;
+    m_dictFilters = NULL;
+    m_dictSel = NULL;
+    m_dictFilterCxt = NULL;
+    m_sketchKeys = NIL;
 }
 
 void CStore::Destroy()
@@ -960,13 +980,48 @@ bool CStore::NeedLoadCUDesc(int32& cudesc_idx)
 // So we load CUdesc once for max_loaded_cudesc
 void CStore::LoadCUDescIfNeed()
 {
-    uint32 last_load_num = 0;
     int32 cudesc_idx = 0;  // cudesc_idx set 0 when  buffer io, and  set to m_NumCUDescIdx when adio
 
     if (!NeedLoadCUDesc(cudesc_idx)) {
         return;
     }
 
+    if (likely(m_parallelScan == NULL)) {
+        LoadCUDescBatch(cudesc_idx);
+        return;
+    }
+
+    /*
+     * Parallel scan: go on with the CU range claimed last, and claim the next
+     * one from the shared cursor once it yields nothing more.  This participant
+     * is done when all the ranges are claimed.
+     */
+    for (;;) {
+        uint32 next_cuid = OnlySysOrConstCol() ? m_virtualCUDescInfo->nextCUID : m_CUDescInfo[0]->nextCUID;
+        if (m_claimEndCUID != 0 && next_cuid <= m_claimEndCUID) {
+            LoadCUDescBatch(cudesc_idx);
+            if (m_NumLoadCUDesc > 0) {
+                return;
+            }
+        }
+
+        if (!ClaimParallelCURange()) {
+            m_NumLoadCUDesc = 0;
+            m_NumCUDescIdx = 0;
+            return;
+        }
+    }
+}
+
+/*
+ * @Description: load the next batch of CUDesc of all accessed columns
+ * @Param[IN] cudesc_idx: first slot of m_CUDescIdx to fill
+ * @See also: LoadCUDescIfNeed
+ */
+void CStore::LoadCUDescBatch(int32 cudesc_idx)
+{
+    uint32 last_load_num = 0;
+
     m_NumLoadCUDesc = 0;
 
     Assert(m_perScanMemCnxt);
@@ -1120,6 +1175,278 @@ void CStore::SetScanRange()
     m_endCUID = endCUID;
 }
 
+/*
+ * @Description: set up the shared state of a parallel scan from the CU range
+ *     of this scan.  A chunk is small enough for the ranges to be spread
+ *     evenly over the participants, and large enough for the claims not to
+ *     cost more than the CUDesc index scans they save.
+ * @Param[OUT] pscan: shared scan state
+ * @Param[IN] nparticipants: number of workers plus the leader
+ * @See also: ClaimParallelCURange
+ */
+void CStore::InitParallelScanDesc(ParallelCStoreScanDesc pscan, int nparticipants) const
+{
+    uint32 cuCount = (m_endCUID >= m_startCUID) ? (m_endCUID - m_startCUID + 1) : 0;
+    uint32 chunk = cuCount / ((uint32)Max(nparticipants, 1) * CSTORE_PARALLEL_CHUNKS_PER_PARTICIPANT);
+
+    pscan->startCUID = m_startCUID;
+    pscan->endCUID = m_endCUID;
+    pscan->cuChunk = Min(Max(chunk, 1), CSTORE_PARALLEL_MAX_CU_CHUNK);
+    pg_atomic_write_u32(&pscan->nextCUID, m_startCUID);
+    pg_atomic_write_u32(&pscan->deltaClaimed, 0);
+}
+
+/*
+ * @Description: make this scan take its CUs from a shared parallel scan state.
+ *     Only buffered IO scans can do so, ADIO prefetches past the claimed range.
+ * @Param[IN] pscan: shared scan state, NULL to scan the whole range again
+ */
+void CStore::SetParallelScan(ParallelCStoreScanDesc pscan)
+{
+    Assert(pscan == NULL || !g_instance.attr.attr_storage.enable_adio_function);
+
+    m_parallelScan = pscan;
+    m_claimEndCUID = 0;
+}
+
+/*
+ * @Description: evaluate the given quals per dictionary item of the CUs read.
+ *     Each filter is hooked to the column it tests, which is read before the
+ *     qual runs, never late.
+ * @Param[IN] filters: list of CStoreDictFilter, living as long as the scan
+ * @Return: false if some filter could not be hooked, and then none is
+ */
+bool CStore::SetDictFilters(List* filters)
+{
+    ListCell* lc = NULL;
+    CStoreDictFilter** dictFilters = NULL;
+
+    Assert(m_dictFilters == NULL);
+    if (filters == NIL || m_colNum == 0) {
+        return false;
+    }
+
+    AutoContextSwitch newMemCnxt(m_scanMemContext);
+    dictFilters = (CStoreDictFilter**)palloc0(sizeof(CStoreDictFilter*) * m_colNum);
+
+    foreach (lc, filters) {
+        CStoreDictFilter* filter = (CStoreDictFilter*)lfirst(lc);
+        int seq = 0;
+
+        while (seq < m_colNum && (m_colId[seq] != filter->attno - 1 || IsLateRead(seq))) {
+            ++seq;
+        }
+        if (seq == m_colNum || dictFilters[seq] != NULL) {
+            pfree(dictFilters);
+            return false;
+        }
+
+        filter->cuId = InValidCUID;
+        filter->cuEncoded = false;
+        filter->rowMatch = (bool*)palloc(sizeof(bool) * DefaultFullCUSize);
+        dictFilters[seq] = filter;
+    }
+
+    m_dictFilters = dictFilters;
+    m_dictSel = (bool*)palloc(sizeof(bool) * BatchMaxSize);
+    m_dictFilterCxt = AllocSetContextCreate(m_scanMemContext,
+        "cstore dictionary filter",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    return true;
+}
+
+/*
+ * @Description: probe the CU sketches with the constants of equality quals
+ *     during rough check.  The CUDescs of their columns are loaded with the
+ *     sketches from then on.
+ * @Param[IN] keys: list of CStoreSketchKey, living as long as the scan
+ * @Return: false if some key is on a column the scan does not read, and
+ *     then none is used
+ */
+bool CStore::SetSketchKeys(List* keys)
+{
+    ListCell* lc = NULL;
+
+    Assert(m_sketchKeys == NIL);
+    if (keys == NIL || m_colNum == 0) {
+        return false;
+    }
+
+    foreach (lc, keys) {
+        CStoreSketchKey* key = (CStoreSketchKey*)lfirst(lc);
+        int seq = 0;
+
+        while (seq < m_colNum && m_colId[seq] != key->attno - 1) {
+            ++seq;
+        }
+        if (seq == m_colNum) {
+            return false;
+        }
+        key->seq = seq;
+    }
+
+    foreach (lc, keys) {
+        m_CUDescInfo[((CStoreSketchKey*)lfirst(lc))->seq]->loadSketch = true;
+    }
+    m_sketchKeys = keys;
+    return true;
+}
+
+/*
+ * @Description: the rows of the batch filled last that pass the dictionary
+ *     filters, in the layout of VectorBatch::m_sel.
+ * @Return: NULL if no filter is set, or some CU of the batch is not
+ *     dictionary encoded and the whole qual has to run
+ */
+const bool* CStore::GetDictFilterSel() const
+{
+    return m_dictSelValid ? m_dictSel : NULL;
+}
+
+/*
+ * @Description: forget the CU the dictionary filters were evaluated for.
+ */
+void CStore::ResetDictFilters()
+{
+    if (m_dictFilters == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < m_colNum; ++i) {
+        if (m_dictFilters[i] != NULL) {
+            m_dictFilters[i]->cuId = InValidCUID;
+        }
+    }
+}
+
+/*
+ * @Description: evaluate the clauses of a dictionary filter on one value.
+ */
+static bool DictFilterMatch(CStoreDictFilter* filter, Datum value)
+{
+    for (int i = 0; i < filter->nclauses; ++i) {
+        CStoreDictClause* clause = filter->clauses + i;
+        bool match = false;
+
+        for (int j = 0; j < clause->nconsts && !match; ++j) {
+            Datum result = clause->varOnLeft
+                               ? FunctionCall2Coll(&clause->opFunc, clause->collation, value, clause->consts[j])
+                               : FunctionCall2Coll(&clause->opFunc, clause->collation, clause->consts[j], value);
+            match = DatumGetBool(result);
+        }
+        if (!match) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @Description: evaluate a dictionary filter for all the rows of a CU. The
+ *     clauses run once per dictionary code, the rows sharing a code (a run
+ *     of RLE included) take its result. NULL rows never match.
+ */
+void CStore::BuildDictFilterRows(CStoreDictFilter* filter, CUDesc* cuDescPtr, CU* cuPtr)
+{
+    const DicCodeType* codes = cuPtr->m_dicCodes;
+    int codesNum = cuPtr->m_dicCodesSize / (int)sizeof(DicCodeType);
+    int rows = cuDescPtr->row_count;
+    bool hasNull = cuPtr->HasNullValue();
+    int next = 0;
+
+    filter->cuId = cuDescPtr->cu_id;
+    filter->cuEncoded = (codes != NULL && cuPtr->m_offset != NULL && rows <= (int)DefaultFullCUSize);
+    if (!filter->cuEncoded) {
+        return;
+    }
+
+    AutoContextSwitch dictCnxt(m_dictFilterCxt);
+
+    // result of each code, -1 until it is evaluated
+    int8* codeMatch = (int8*)palloc(sizeof(int8) * (PG_UINT16_MAX + 1));
+    errno_t rc = memset_s(codeMatch, sizeof(int8) * (PG_UINT16_MAX + 1), -1, sizeof(int8) * (PG_UINT16_MAX + 1));
+    securec_check(rc, "\0", "\0");
+
+    for (int row = 0; row < rows; ++row) {
+        if (hasNull && cuPtr->IsNull(row)) {
+            filter->rowMatch[row] = false;
+            continue;
+        }
+        if (unlikely(next == codesNum)) {
+            Assert(false);
+            filter->cuEncoded = false;
+            break;
+        }
+
+        DicCodeType code = codes[next++];
+        if (codeMatch[code] < 0) {
+            Datum value = PointerGetDatum(cuPtr->m_srcData + cuPtr->m_offset[row]);
+            codeMatch[code] = DictFilterMatch(filter, value) ? 1 : 0;
+        }
+        filter->rowMatch[row] = (codeMatch[code] != 0);
+    }
+    Assert(!filter->cuEncoded || next == codesNum);
+
+    MemoryContextReset(m_dictFilterCxt);
+}
+
+/*
+ * @Description: AND the dictionary filter of a column into m_dictSel for the
+ *     rows ToVector() has just put in the batch.
+ */
+template <bool hasDeadRow>
+void CStore::FillDictFilterSel(CStoreDictFilter* filter, CUDesc* cuDescPtr, CU* cuPtr, int leftRows)
+{
+    if (filter->cuId != cuDescPtr->cu_id) {
+        BuildDictFilterRows(filter, cuDescPtr, cuPtr);
+    }
+    if (!filter->cuEncoded) {
+        m_dictSelValid = false;
+    }
+    if (!m_dictSelValid) {
+        return;
+    }
+
+    const bool* rowMatch = filter->rowMatch;
+    int pos = 0;
+    for (int i = 0; i < leftRows && pos < BatchMaxSize; ++i) {
+        uint32 row = (uint32)(i + m_rowCursorInCU);
+
+        if (hasDeadRow && ((m_cuDelMask[row >> 3] & (1 << (row % 8))) != 0)) {
+            continue;
+        }
+        m_dictSel[pos] = m_dictSel[pos] && rowMatch[row];
+        ++pos;
+    }
+}
+
+/*
+ * @Description: claim the next range of CU IDs from the shared cursor and
+ *     point all the CUDesc loaders at its start.
+ * @Return: false if all the ranges have been claimed
+ */
+bool CStore::ClaimParallelCURange()
+{
+    ParallelCStoreScanDesc pscan = m_parallelScan;
+    uint32 start = pg_atomic_fetch_add_u32(&pscan->nextCUID, pscan->cuChunk);
+
+    if (start > pscan->endCUID) {
+        m_claimEndCUID = 0;
+        return false;
+    }
+
+    m_claimEndCUID = Min(start + pscan->cuChunk - 1, pscan->endCUID);
+    for (int i = 0; i < m_colNum; ++i) {
+        m_CUDescInfo[i]->Reset(start);
+    }
+    if (OnlySysOrConstCol()) {
+        m_virtualCUDescInfo->Reset(start);
+    }
+    return true;
+}
+
 void CStore::RefreshCursor(int row, int deadRows)
 {
     int cuRowCount = 0;
@@ -1174,6 +1501,65 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
     return hitCU;
 }
 
+/*
+ * @Description: cudesc rough check against the runtime bloom filters pushed
+ *      down by a hash join, see ExecGetRuntimeFilter
+ * @Param[IN] state: cstore scan state
+ * @Param[IN] cuDescIdx: index of load cudesc info
+ * @Return: true--hit, false--not hit
+ */
+bool CStore::RoughCheckRuntimeFilter(CStoreScanState* state, int cuDescIdx)
+{
+    Form_pg_attribute* attrs = m_relation->rd_att->attrs;
+    ListCell* lc = NULL;
+    int i = 0;
+
+    foreach (lc, state->ps.plan->var_list) {
+        Var* var = (Var*)lfirst(lc);
+        filter::BloomFilter* bf = ExecGetRuntimeFilter(&state->ps, i++);
+
+        if (bf == NULL) {
+            continue;
+        }
+
+        for (int seq = 0; seq < m_colNum; seq++) {
+            if (m_colId[seq] != var->varattno - 1) {
+                continue;
+            }
+
+            CUDesc* cudesc = &(m_CUDescInfo[seq]->cuDescArray[cuDescIdx]);
+            if (!RoughCheckRuntimeFilterCU(cudesc, attrs[m_colId[seq]]->atttypid, bf)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * @Description: cudesc rough check against the bloom filters of the CU
+ *      sketches, see SetSketchKeys
+ * @Param[IN] cuDescIdx: index of load cudesc info
+ * @Return: true--hit, false--not hit
+ */
+bool CStore::RoughCheckSketch(int cuDescIdx)
+{
+    ListCell* lc = NULL;
+
+    foreach (lc, m_sketchKeys) {
+        CStoreSketchKey* key = (CStoreSketchKey*)lfirst(lc);
+        CUDesc* cudesc = &(m_CUDescInfo[key->seq]->cuDescArray[cuDescIdx]);
+
+        if (cudesc->cu_sketch != NULL && !CUSketchMayContain(cudesc->cu_sketch, key->hashes, key->nhashes)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1181,6 +1567,9 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     PlanState* planstate = (PlanState*)state;
     uint32 curLoadNum;
     uint32 lastLoadNum;
+    bool hasScanKey = (nkeys != 0 && scanKey != NULL);
+    bool hasRuntimeFilter = (planstate->plan->var_list != NIL);
+    bool hasSketchKey = (m_sketchKeys != NIL);
 
     // m_needRCheck is true means these CUs alreay done the rough check
     // m_colNum == 0 means not have normal columns
@@ -1188,7 +1577,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    if (likely((!hasScanKey && !hasRuntimeFilter && !hasSketchKey) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1214,7 +1603,16 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     lastLoadNum = m_CUDescInfo[0]->lastLoadNum;
     curLoadNum = m_CUDescInfo[0]->curLoadNum;
     for (int i = (int)lastLoadNum; i != (int)curLoadNum; IncLoadCuDescIdx(i), IncLoadCuDescIdx(cudesc_idx_tmp)) {
-        hitCU = RoughCheck(scanKey, nkeys, i);
+        hitCU = !hasScanKey || RoughCheck(scanKey, nkeys, i);
+        if (hitCU && hasSketchKey) {
+            hitCU = RoughCheckSketch(i);
+        }
+        if (hitCU && hasRuntimeFilter && !RoughCheckRuntimeFilter(state, i)) {
+            hitCU = false;
+            if (planstate->instrument) {
+                planstate->instrument->bloomFilterBlocks++;
+            }
+        }
         if (hitCU) {
             // fliter CU not hit
             ADIO_RUN()
@@ -1265,6 +1663,7 @@ void CStore::InitReScan()
 {
     /* Set scan cu range */
     SetScanRange();
+    m_claimEndCUID = 0;
     for (int i = 0; i < m_colNum; ++i) {
         m_CUDescInfo[i]->Reset(m_startCUID);
     }
@@ -1306,6 +1705,8 @@ void CStore::InitReScan()
     m_laterReadCtidColIdx = -1;
 
     m_needRCheck = false;
+
+    ResetDictFilters();
 }
 
 void CStore::InitPartReScan(Relation rel)
@@ -1334,6 +1735,9 @@ void CStore::InitPartReScan(Relation rel)
         CFileNode cFileNode(m_relation->rd_node, m_relation->rd_att->attrs[i]->attnum, MAIN_FORKNUM);
         m_cuStorage[i] = New(CurrentMemoryContext) CUStorage(cFileNode);
     }
+
+    // CU IDs are only unique inside one partition
+    ResetDictFilters();
 }
 
 // FORCE_INLINE
@@ -1375,6 +1779,26 @@ void CStore::SetTiming(CStoreScanState* state)
     m_timing_on = (NULL != ((ScanState*)state)->ps.instrument && ((ScanState*)state)->ps.instrument->need_timer);
 }
 
+void CStore::SetBatchRows(int rows)
+{
+    Assert(rows > 0);
+    m_batchRows = Min(rows, BatchMaxSize);
+}
+
+/*
+ * Rows left in the current CU, cut at m_batchRows when the plan asked for
+ * batches smaller than BatchMaxSize.  Dead rows are counted too, so every
+ * column of the batch reads the same range of the CU.
+ */
+int CStore::LeftRowsInBatch(const CUDesc* cuDescPtr) const
+{
+    int leftRows = cuDescPtr->row_count - m_rowCursorInCU;
+
+    if (unlikely(m_batchRows < BatchMaxSize))
+        leftRows = Min(leftRows, m_batchRows);
+    return leftRows;
+}
+
 void CStore::ScanByTids(_in_ CStoreIndexScanState* state, _in_ VectorBatch* idxOut, _out_ VectorBatch* vbout)
 {
     Assert(state && idxOut && vbout);
@@ -1589,8 +2013,11 @@ HeapTuple CStore::FormCudescTuple(_in_ CUDesc* pCudesc, _in_ TupleDesc pCudescTu
     pTupVals[CUDescCUMagicAttr - 1] = UInt32GetDatum(pCudesc->magic);
     Assert(pTupVals[CUDescCUMagicAttr - 1] > 0);
 
-    // add attribute extra and set null flag.
-    pTupNulls[CUDescCUExtraAttr - 1] = true;
+    // attribute extra keeps the CU sketch, if one was built.
+    if (pCudesc->cu_sketch != NULL)
+        pTupVals[CUDescCUExtraAttr - 1] = PointerGetDatum(pCudesc->cu_sketch);
+    else
+        pTupNulls[CUDescCUExtraAttr - 1] = true;
 
     return heap_form_tuple(pCudescTupDesc, pTupVals, pTupNulls);
 }
@@ -2164,7 +2591,9 @@ bool CStore::LoadCUDesc(
         F_OIDGE,
         UInt32GetDatum(loadCUDescInfoPtr->nextCUID));
 
-    ScanKeyInit(&key[2], (AttrNumber)CUDescCUIDAttr, BTLessEqualStrategyNumber, F_OIDLE, UInt32GetDatum(m_endCUID));
+    /* a parallel scan stops at the end of the CU range it has claimed */
+    ScanKeyInit(&key[2], (AttrNumber)CUDescCUIDAttr, BTLessEqualStrategyNumber, F_OIDLE,
+        UInt32GetDatum((m_parallelScan != NULL && m_claimEndCUID != 0) ? m_claimEndCUID : m_endCUID));
 
     snapShot = (snapShot == NULL) ? GetActiveSnapshot() : snapShot;
 
@@ -2220,6 +2649,7 @@ bool CStore::LoadCUDesc(
         cuDescArray[loadCUDescInfoPtr->curLoadNum].cu_size = cu_size;
         cuDescArray[loadCUDescInfoPtr->curLoadNum].xmin = HeapTupleGetRawXmin(tup);
         cuDescArray[loadCUDescInfoPtr->curLoadNum].cu_id = cu_id;
+        cuDescArray[loadCUDescInfoPtr->curLoadNum].cu_sketch = NULL;
         loadCUDescInfoPtr->nextCUID = cu_id;
 
         /* Parallel scan CU divide. */
@@ -2276,6 +2706,12 @@ bool CStore::LoadCUDesc(
         cuDescArray[loadCUDescInfoPtr->curLoadNum].magic = DatumGetUInt32(values[CUDescCUMagicAttr - 1]);
         Assert(!isnull[CUDescCUMagicAttr - 1]);
 
+        /* Put the sketch into cudesc->cu_sketch if the scan probes it */
+        if (loadCUDescInfoPtr->loadSketch && !isnull[CUDescCUExtraAttr - 1]) {
+            cuDescArray[loadCUDescInfoPtr->curLoadNum].cu_sketch =
+                (text*)PG_DETOAST_DATUM_COPY(values[CUDescCUExtraAttr - 1]);
+        }
+
         found = true;
 
         IncLoadCuDescIdx(*(int*)&loadCUDescInfoPtr->curLoadNum);
@@ -2315,6 +2751,14 @@ int CStore::FillVecBatch(_out_ VectorBatch* vecBatchOut)
     this->m_cuDescIdx = idx;
     bool hasCtidForLateRead = false;
 
+    // the dictionary filters AND their results into m_dictSel while their
+    // columns are filled
+    if (m_dictFilters != NULL) {
+        errno_t rc = memset_s(m_dictSel, sizeof(bool) * BatchMaxSize, true, sizeof(bool) * BatchMaxSize);
+        securec_check(rc, "", "");
+        m_dictSelValid = true;
+    }
+
     /* Step 1: fill normal columns if need */
     for (i = 0; i < m_colNum; ++i) {
         int colIdx = m_colId[i];
@@ -2365,7 +2809,7 @@ int CStore::FillVecBatch(_out_ VectorBatch* vecBatchOut)
     if (unlikely(m_onlyConstCol)) {
         // We only set row count
         CUDesc* cuDescPtr = m_virtualCUDescInfo->cuDescArray + idx;
-        int liveRows = 0, leftSize = cuDescPtr->row_count - m_rowCursorInCU;
+        int liveRows = 0, leftSize = LeftRowsInBatch(cuDescPtr);
         ScalarVector* vec = vecBatchOut->m_arr;
         errno_t rc = memset_s(vec->m_flag, sizeof(uint8) * BatchMaxSize, 0, sizeof(uint8) * BatchMaxSize);
         securec_check(rc, "", "");
@@ -2407,9 +2851,15 @@ int CStore::FillVector(_in_ int seq, _in_ CUDesc* cuDescPtr, _out_ ScalarVector*
     securec_check(rc, "", "");
 
     // step 1: Caculate how many rows left
-    int leftRows = cuDescPtr->row_count - this->m_rowCursorInCU;
+    int leftRows = this->LeftRowsInBatch(cuDescPtr);
     Assert(leftRows > 0);
 
+    // the dictionary filter of the column needs a stored CU, see step 5
+    CStoreDictFilter* dictFilter = (attlen == -1 && this->m_dictFilters != NULL) ? this->m_dictFilters[seq] : NULL;
+    if (dictFilter != NULL && (cuDescPtr->IsNullCU() || cuDescPtr->IsSameValCU())) {
+        this->m_dictSelValid = false;
+    }
+
     // step 2: CU is filled with all NULL values
     if (cuDescPtr->IsNullCU()) {
         for (int i = 0; i < leftRows && pos < BatchMaxSize; ++i) {
@@ -2471,6 +2921,9 @@ int CStore::FillVector(_in_ int seq, _in_ CUDesc* cuDescPtr, _out_ ScalarVector*
     // step 5: CUToVector
     pos = cuPtr->ToVector<attlen, hasDeadRow>(
         vec, leftRows, this->m_rowCursorInCU, this->m_scanPosInCU[seq], deadRows, this->m_cuDelMask);
+    if (dictFilter != NULL) {
+        this->FillDictFilterSel<hasDeadRow>(dictFilter, cuDescPtr, cuPtr, leftRows);
+    }
 
     if (IsValidCacheSlotID(slotId)) {
         // CU is pinned
@@ -3018,7 +3471,7 @@ int CStore::FillTidForLateRead(_in_ CUDesc* cuDescPtr, _out_ ScalarVector* vec)
 {
     Assert(cuDescPtr && vec);
     uint32 cur_cuid = cuDescPtr->cu_id;
-    int leftSize = cuDescPtr->row_count - m_rowCursorInCU;
+    int leftSize = LeftRowsInBatch(cuDescPtr);
     int pos = 0, deadRows = 0;
     Assert(leftSize > 0);
 
@@ -3044,7 +3497,7 @@ int CStore::FillSysColVector(_in_ int colIdx, _in_ CUDesc* cuDescPtr, _out_ Scal
 {
     Assert(cuDescPtr && vec);
     uint32 cur_cuid = cuDescPtr->cu_id;
-    int leftSize = cuDescPtr->row_count - m_rowCursorInCU;
+    int leftSize = LeftRowsInBatch(cuDescPtr);
     int pos = 0, deadRows = 0;
     Assert(leftSize > 0);
 
@@ -3854,6 +4307,7 @@ bool CStore::IsDeadRow(uint32 cuid, uint32 row) const
 
 void CStore::RunScan(_in_ CStoreScanState* state, _out_ VectorBatch* vecBatchOut)
 {
+    m_dictSelValid = false;
     (this->*m_scanFunc)(state, vecBatchOut);
 }
 
@@ -4358,6 +4812,15 @@ void ScanDeltaStore(CStoreScanState* node, VectorBatch* outBatch, List* indexqua
     if (u_sess->stream_cxt.smp_id != 0)
         return;
 
+    /* For a parallel scan below Gather, the first participant to get here scans it. */
+    if (node->m_parallelScan != NULL && !node->m_deltaScanOwner) {
+        if (pg_atomic_exchange_u32(&node->m_parallelScan->deltaClaimed, 1) != 0) {
+            node->ss_deltaScanEnd = true;
+            return;
+        }
+        node->m_deltaScanOwner = true;
+    }
+
     bool hasIndexFilter = (list_length(indexqual) > 0);
     HeapTuple tuple = NULL;
     TupleTableSlot* slot = node->ss_ScanTupleSlot;
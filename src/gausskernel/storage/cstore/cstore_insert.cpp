@@ -44,6 +44,7 @@
 #include "storage/lmgr.h"
 #include "storage/cucache_mgr.h"
 #include "access/cstore_insert.h"
+#include "access/cstore_sketch.h"
 #include "pgxc/pgxc.h"
 #include "utils/tqual.h"
 #include "utils/memutils.h"
@@ -1472,6 +1473,12 @@ CU* CStoreInsert::FormCU(int col, bulkload_rows* batchRowPtr, CUDesc* cuDescPtr)
     }
     cuDescPtr->row_count = batchRowPtr->m_rows_curnum;
 
+    // the sketch is saved with the CUDesc and freed with the batch memory
+    if (RelationGetCUSketch(m_relation) && CUSketchTypeSupported(attrs[col]->atttypid)) {
+        cuDescPtr->cu_sketch =
+            CUSketchBuild(attrs[col]->atttypid, &batchRowPtr->m_vectors[col], batchRowPtr->m_rows_curnum);
+    }
+
     return cuPtr;
 }
 
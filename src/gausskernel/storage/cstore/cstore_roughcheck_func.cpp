@@ -22,6 +22,7 @@
  * ---------------------------------------------------------------------------------------
  */
 #include "access/cstore_roughcheck_func.h"
+#include "executor/executor.h"
 #include "utils/date.h"
 #include "utils/timestamp.h"
 #include "catalog/pg_collation.h"
@@ -414,3 +415,44 @@ bool RoughCheckAllThrough(CUDesc* cudesc, Datum arg)
 {
     return true;
 }
+
+/*
+ * Rough check an integer CU against a runtime bloom filter pushed down by a
+ * hash join.  The CU misses if its min/max range does not overlap the build
+ * side's, or if it holds one value only and the filter does not include it.
+ */
+bool RoughCheckRuntimeFilterCU(CUDesc* cudesc, Oid typeOid, filter::BloomFilter* bf)
+{
+    int64 min = 0;
+    int64 max = 0;
+    int64 bfMin = 0;
+    int64 bfMax = 0;
+
+    if (cudesc->IsNullCU() || cudesc->IsNoMinMaxCU())
+        return true;
+
+    switch (typeOid) {
+        case INT2OID:
+            min = *(int16*)cudesc->cu_min;
+            max = *(int16*)cudesc->cu_max;
+            break;
+        case INT4OID:
+            min = *(int32*)cudesc->cu_min;
+            max = *(int32*)cudesc->cu_max;
+            break;
+        case INT8OID:
+            min = *(int64*)cudesc->cu_min;
+            max = *(int64*)cudesc->cu_max;
+            break;
+        default:
+            return true;
+    }
+
+    if (ExecRuntimeFilterRange(bf, &bfMin, &bfMax) && (max < bfMin || min > bfMax))
+        return false;
+
+    if (min == max)
+        return bf->includeLong(min);
+
+    return true;
+}
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * cstore_sketch.cpp
+ *      per-CU bloom filters and distinct count sketches
+ *
+ * Min/max rough check can't prune a CU whose range covers the constant of an
+ * equality qual, which is the common case for high cardinality columns that
+ * are not loaded in order.  With cu_sketch set, CStoreInsert builds a bloom
+ * filter of the values of every CU of a supported type next to a HyperLogLog
+ * of them, and saves both in the CUDesc.  The scan probes the bloom filters
+ * with the constants of "col = const" and "col IN (...)" quals after the
+ * min/max check, and ANALYZE merges the HyperLogLogs of all CUs of a column
+ * into its distinct count.
+ *
+ * Values are hashed so that values equal under the equality operators
+ * CStore probes with (see exec_cstore_init_sketch_keys) hash alike: integers
+ * of any width as int64, varlenas as their bytes.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/cstore/cstore_sketch.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <math.h>
+
+#include "access/cstore_sketch.h"
+#include "access/genam.h"
+#include "access/hash.h"
+#include "access/heapam.h"
+#include "cstore.h"
+#include "storage/cu.h"
+#include "utils/date.h"
+#include "utils/fmgroids.h"
+#include "utils/rel.h"
+#include "utils/timestamp.h"
+
+/* size of the HyperLogLog state of the given register width, see initHyperLogLog */
+#define CUSketchHLLSize(width) (((Size)1 << (width)) + 1)
+
+#define CUSketchBloomSize(header) ((Size)(header)->bloomBits / BITS_PER_BYTE)
+
+static bool CUSketchGetHeader(const text* sketch, CUSketchHeader* header);
+static void CUSketchBloomAdd(uint8* bloom, const CUSketchHeader* header, uint32 hash);
+static bool CUSketchBloomTest(const uint8* bloom, const CUSketchHeader* header, uint32 hash);
+
+/*
+ * @Description: whether CUs of the type get a sketch.  Only types whose
+ *     equality is the equality of their binary values are supported.
+ */
+bool CUSketchTypeSupported(Oid typeOid)
+{
+    switch (typeOid) {
+        case INT2OID:
+        case INT4OID:
+        case INT8OID:
+        case DATEOID:
+        case TIMEOID:
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+        case TEXTOID:
+        case VARCHAROID:
+        case BYTEAOID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * @Description: hash a value for the sketches.
+ * @Param[IN] typeOid: type of the value, CUSketchTypeSupported()
+ * @Param[IN] value: not-null value
+ */
+uint32 CUSketchHashValue(Oid typeOid, Datum value)
+{
+    int64 intValue = 0;
+
+    switch (typeOid) {
+        case INT2OID:
+            intValue = DatumGetInt16(value);
+            break;
+        case INT4OID:
+            intValue = DatumGetInt32(value);
+            break;
+        case DATEOID:
+            intValue = DatumGetDateADT(value);
+            break;
+        case INT8OID:
+        case TIMEOID:
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+            intValue = DatumGetInt64(value);
+            break;
+        default: {
+            struct varlena* data = PG_DETOAST_DATUM_PACKED(value);
+            uint32 hash = DatumGetUInt32(hash_any((unsigned char*)VARDATA_ANY(data), VARSIZE_ANY_EXHDR(data)));
+
+            if ((Pointer)data != DatumGetPointer(value)) {
+                pfree(data);
+            }
+            return hash;
+        }
+    }
+
+    return DatumGetUInt32(hash_any((unsigned char*)&intValue, sizeof(int64)));
+}
+
+/*
+ * @Description: build the sketch of the values of a CU.
+ * @Param[IN] typeOid: type of the column, CUSketchTypeSupported()
+ * @Param[IN] vector: values of the CU
+ * @Param[IN] rows: number of values
+ * @Return: the sketch, NULL if all the values are NULL
+ */
+text* CUSketchBuild(Oid typeOid, bulkload_vector* vector, int rows)
+{
+    bulkload_vector_iter iter;
+    hyperLogLogState hll;
+    CUSketchHeader header;
+    Datum value = 0;
+    bool isnull = false;
+    int nvalues = 0;
+
+    Assert(CUSketchTypeSupported(typeOid));
+    if (vector->m_values_nulls.m_all_null) {
+        return NULL;
+    }
+
+    uint32* hashes = (uint32*)palloc(sizeof(uint32) * rows);
+    initHyperLogLog(&hll, CU_SKETCH_HLL_BWIDTH);
+
+    iter.begin(vector, rows);
+    while (iter.not_end()) {
+        iter.next(&value, &isnull);
+        if (isnull) {
+            continue;
+        }
+        hashes[nvalues] = CUSketchHashValue(typeOid, value);
+        addHyperLogLog(&hll, hashes[nvalues]);
+        nvalues++;
+    }
+
+    if (nvalues == 0) {
+        freeHyperLogLog(&hll);
+        pfree(hashes);
+        return NULL;
+    }
+
+    header.magic = CU_SKETCH_MAGIC;
+    header.version = CU_SKETCH_VERSION;
+    header.hllWidth = CU_SKETCH_HLL_BWIDTH;
+    header.bloomHashes = 0;
+    header.bloomBits = 0;
+    header.nvalues = (uint32)nvalues;
+
+    /* size the bloom filter for the distinct values, not for the rows */
+    double ndistinct = Min(Max(estimateHyperLogLog(&hll), 1.0), (double)nvalues);
+    if (ndistinct * CU_SKETCH_BLOOM_MIN_BITS_PER_VALUE <= CU_SKETCH_BLOOM_MAX_BITS) {
+        uint32 bits = CU_SKETCH_BLOOM_MIN_BITS;
+
+        while (bits < ndistinct * CU_SKETCH_BLOOM_BITS_PER_VALUE && bits < CU_SKETCH_BLOOM_MAX_BITS) {
+            bits <<= 1;
+        }
+
+        /* m / n * ln 2 hash functions give the lowest false positive rate */
+        int nhashes = (int)rint(bits / ndistinct * M_LN2);
+        header.bloomHashes = (uint8)Min(Max(nhashes, 1), CU_SKETCH_BLOOM_MAX_HASHES);
+        header.bloomBits = bits;
+    }
+
+    Size size = VARHDRSZ + sizeof(CUSketchHeader) + hll.arrSize + CUSketchBloomSize(&header);
+    text* sketch = (text*)palloc0(size);
+    char* ptr = VARDATA(sketch);
+    SET_VARSIZE(sketch, size);
+
+    errno_t rc = memcpy_s(ptr, sizeof(CUSketchHeader), &header, sizeof(CUSketchHeader));
+    securec_check(rc, "\0", "\0");
+    ptr += sizeof(CUSketchHeader);
+    rc = memcpy_s(ptr, hll.arrSize, hll.hashesArr, hll.arrSize);
+    securec_check(rc, "\0", "\0");
+    ptr += hll.arrSize;
+
+    if (header.bloomHashes > 0) {
+        for (int i = 0; i < nvalues; i++) {
+            CUSketchBloomAdd((uint8*)ptr, &header, hashes[i]);
+        }
+    }
+
+    freeHyperLogLog(&hll);
+    pfree(hashes);
+    return sketch;
+}
+
+/*
+ * @Description: probe the bloom filter of a CU sketch.
+ * @Param[IN] sketch: sketch of the CU
+ * @Param[IN] hashes: CUSketchHashValue() of the values looked for
+ * @Param[IN] nhashes: number of hashes
+ * @Return: false if the CU holds none of the values for sure
+ */
+bool CUSketchMayContain(const text* sketch, const uint32* hashes, int nhashes)
+{
+    CUSketchHeader header;
+
+    if (!CUSketchGetHeader(sketch, &header) || header.bloomHashes == 0) {
+        return true;
+    }
+
+    const uint8* bloom = (const uint8*)VARDATA_ANY(sketch) + sizeof(CUSketchHeader) + CUSketchHLLSize(header.hllWidth);
+    for (int i = 0; i < nhashes; i++) {
+        if (CUSketchBloomTest(bloom, &header, hashes[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @Description: estimate the distinct values of a column from the
+ *     HyperLogLogs of its CUs.  Rows deleted since their CU was written
+ *     still count, rows of the delta table don't.
+ * @Param[IN] rel: column table, not partitioned
+ * @Param[IN] attnum: attribute number of the column
+ * @Param[IN] snapshot: snapshot to read the CUDescs with
+ * @Param[OUT] ndistinct: the estimate
+ * @Return: false if some CU holding values has no sketch
+ */
+bool CUSketchEstimateDistinct(Relation rel, AttrNumber attnum, Snapshot snapshot, double* ndistinct)
+{
+    ScanKeyData key;
+    HeapTuple tup = NULL;
+    hyperLogLogState hll;
+    hyperLogLogState cuHll;
+    bool covered = true;
+    bool found = false;
+
+    Relation cudesc_rel = heap_open(rel->rd_rel->relcudescrelid, AccessShareLock);
+    Relation idx_rel = index_open(cudesc_rel->rd_rel->relcudescidx, AccessShareLock);
+    TupleDesc cudesc_tupdesc = RelationGetDescr(cudesc_rel);
+
+    ScanKeyInit(&key, (AttrNumber)CUDescColIDAttr, BTEqualStrategyNumber, F_INT4EQ, Int32GetDatum(attnum));
+    SysScanDesc cudesc_scan = systable_beginscan_ordered(cudesc_rel, idx_rel, snapshot, 1, &key);
+
+    initHyperLogLog(&hll, CU_SKETCH_HLL_BWIDTH);
+    while ((tup = systable_getnext_ordered(cudesc_scan, ForwardScanDirection)) != NULL) {
+        bool isnull = false;
+        CUSketchHeader header;
+
+        uint32 cuId = DatumGetUInt32(fastgetattr(tup, CUDescCUIDAttr, cudesc_tupdesc, &isnull));
+        uint32 cuMode = (uint32)DatumGetInt32(fastgetattr(tup, CUDescCUModeAttr, cudesc_tupdesc, &isnull));
+        if (IsDicVCU(cuId) || (cuMode & CU_MODE_LOWMASK) == CU_FULL_NULL) {
+            continue;
+        }
+
+        Datum value = fastgetattr(tup, CUDescCUExtraAttr, cudesc_tupdesc, &isnull);
+        text* sketch = isnull ? NULL : DatumGetTextPP(value);
+        if (sketch == NULL || !CUSketchGetHeader(sketch, &header) || header.hllWidth != CU_SKETCH_HLL_BWIDTH) {
+            covered = false;
+            break;
+        }
+
+        cuHll = hll;
+        cuHll.hashesArr = (uint8*)VARDATA_ANY(sketch) + sizeof(CUSketchHeader);
+        mergeHyperLogLog(&hll, &cuHll);
+        found = true;
+
+        if ((Pointer)sketch != DatumGetPointer(value)) {
+            pfree(sketch);
+        }
+    }
+
+    systable_endscan_ordered(cudesc_scan);
+    index_close(idx_rel, AccessShareLock);
+    heap_close(cudesc_rel, AccessShareLock);
+
+    if (covered && found) {
+        *ndistinct = estimateHyperLogLog(&hll);
+    }
+    freeHyperLogLog(&hll);
+
+    return covered && found;
+}
+
+/*
+ * Copy out the header of a sketch, checking that the sketch is as long as
+ * the header says.  Sketches written by another version are ignored.
+ */
+static bool CUSketchGetHeader(const text* sketch, CUSketchHeader* header)
+{
+    Size size = VARSIZE_ANY_EXHDR(sketch);
+
+    if (size < sizeof(CUSketchHeader)) {
+        return false;
+    }
+
+    errno_t rc = memcpy_s(header, sizeof(CUSketchHeader), VARDATA_ANY(sketch), sizeof(CUSketchHeader));
+    securec_check(rc, "\0", "\0");
+
+    if (header->magic != CU_SKETCH_MAGIC || header->version != CU_SKETCH_VERSION || header->hllWidth < 4 ||
+        header->hllWidth > 16) {
+        return false;
+    }
+
+    return size == sizeof(CUSketchHeader) + CUSketchHLLSize(header->hllWidth) + CUSketchBloomSize(header);
+}
+
+/*
+ * The bloom filter bits of a hash are taken by double hashing,
+ * h1 + i * h2 for the i-th hash function, h2 being odd so that all the
+ * bits can be reached.
+ */
+static void CUSketchBloomAdd(uint8* bloom, const CUSketchHeader* header, uint32 hash)
+{
+    uint32 mask = header->bloomBits - 1;
+    uint32 step = DatumGetUInt32(hash_uint32(hash)) | 1;
+
+    for (int i = 0; i < header->bloomHashes; i++) {
+        uint32 bit = hash & mask;
+
+        bloom[bit / BITS_PER_BYTE] |= (uint8)(1 << (bit % BITS_PER_BYTE));
+        hash += step;
+    }
+}
+
+static bool CUSketchBloomTest(const uint8* bloom, const CUSketchHeader* header, uint32 hash)
+{
+    uint32 mask = header->bloomBits - 1;
+    uint32 step = DatumGetUInt32(hash_uint32(hash)) | 1;
+
+    for (int i = 0; i < header->bloomHashes; i++) {
+        uint32 bit = hash & mask;
+
+        if ((bloom[bit / BITS_PER_BYTE] & (1 << (bit % BITS_PER_BYTE))) == 0) {
+            return false;
+        }
+        hash += step;
+    }
+    return true;
+}
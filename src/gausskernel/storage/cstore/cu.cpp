@@ -77,6 +77,7 @@ void CUDesc::Reset()
     cu_pointer = 0;
     magic = 0;
     xmin = 0;
+    cu_sketch = NULL;
 }
 
 FORCE_INLINE
@@ -171,6 +172,8 @@ void CU::Reset()
     m_bpNullCompressedSize = 0;
     m_offset = NULL;
     m_offsetSize = 0;
+    m_dicCodes = NULL;
+    m_dicCodesSize = 0;
     m_cuSizeExcludePadding = 0;
 
     m_tmpinfo = NULL;
@@ -330,6 +333,13 @@ bool CU::CheckCrc()
     return isSame;
 }
 
+bool CU::CompressedBufIsEncrypted() const
+{
+    uint16 tmpMode = *(uint16*)(m_compressedBuf + sizeof(m_crc) + sizeof(m_magic));
+
+    return (tmpMode & CU_ENCRYPT) != 0;
+}
+
 bool CU::CheckMagic(uint32 magic) const
 {
     bool is_same = true;
@@ -994,7 +1004,11 @@ void CU::UnCompressData(char* buf, int rowCount)
             } else {
                 // String Type Decompress
                 StringCoder strDecoder;
+                strDecoder.m_keep_dic_codes = true;
                 err_code = strDecoder.Decompress(in, out);
+                if (err_code > 0) {
+                    this->KeepDicCodes(strDecoder);
+                }
             }
         }
 
@@ -1037,6 +1051,28 @@ void CU::UnCompressData(char* buf, int rowCount)
     return;
 }
 
+/*
+ * Keep the dictionary codes decoded by strDecoder for the predicates evaluated
+ * on dictionary items. They live as long as m_srcBuf, so they are allocated the
+ * same way.
+ */
+void CU::KeepDicCodes(StringCoder& strDecoder)
+{
+    int codesNum = 0;
+    DicCodeType* codes = strDecoder.TakeDicCodes(&codesNum);
+
+    if (codes == NULL) {
+        return;
+    }
+
+    Assert(this->m_dicCodes == NULL);
+    this->m_dicCodesSize = (int32)(sizeof(DicCodeType) * codesNum);
+    this->m_dicCodes = (DicCodeType*)CStoreMemAlloc::Palloc(this->m_dicCodesSize, !this->m_inCUCache);
+    errno_t rc = memcpy_s(this->m_dicCodes, this->m_dicCodesSize, codes, this->m_dicCodesSize);
+    securec_check(rc, "\0", "\0");
+    pfree(codes);
+}
+
 template <bool bpcharType>
 void CU::DeFormNumberStringCU()
 {
@@ -1600,6 +1636,12 @@ void CU::FreeSrcBuf()
     }
     m_offset = NULL;
     m_offsetSize = 0;
+
+    if (m_dicCodes) {
+        CStoreMemAlloc::Pfree(m_dicCodes, !m_inCUCache);
+    }
+    m_dicCodes = NULL;
+    m_dicCodesSize = 0;
 }
 
 FORCE_INLINE
@@ -1625,7 +1667,7 @@ int CU::GetCompressBufSize() const
 FORCE_INLINE
 int CU::GetUncompressBufSize() const
 {
-    return m_srcBufSize + m_offsetSize;
+    return m_srcBufSize + m_offsetSize + m_dicCodesSize;
 }
 
 FORCE_INLINE
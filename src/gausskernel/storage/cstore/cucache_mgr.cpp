@@ -34,6 +34,12 @@ int CUCacheMode = 1;
 
 #define BUILD_BUG_ON_CONDITION(condition) ((void)sizeof(char[1 - 2 * (condition)]))
 
+/*
+ * A decompressed CU keeps its compressed image for the compressed tier only if
+ * dropping the decompressed data would save at least this much memory.
+ */
+#define CU_COMPRESSED_TIER_MIN_RATIO 2
+
 DataCacheMgr* DataCacheMgr::m_data_cache = NULL;
 
 /*
@@ -91,6 +97,8 @@ void DataCacheMgr::NewSingletonInstance(void)
     SpinLockInit(&m_data_cache->m_adio_write_cache_lock);
     /* init or reset this instance */
     m_data_cache->m_cache_mgr->Init(cache_size, BLCKSZ, MGR_CACHE_TYPE_DATA, Max(sizeof(CU), sizeof(OrcDataValue)));
+    m_data_cache->m_cache_mgr->InitCompressedTier(
+        cache_size / 100 * g_instance.attr.attr_storage.cstore_compressed_cache_percent);
     ereport(LOG, (errmodule(MOD_CACHE), errmsg("set data cache  size(%ld)", cache_size)));
 }
 
@@ -470,22 +478,31 @@ CUUncompressedRetCode DataCacheMgr::StartUncompressCU(
         }                       \
     } while (0)
 
+    /* Encrypted CU data is decrypted in place, so it can't be decompressed twice. */
+    bool keepCompressed = m_cache_mgr->CompressedTierEnabled() && !cuPtr->CompressedBufIsEncrypted();
+
     /* Always presume compressed disk and uncompressed cache. */
     UNCOMPRESS_TRACE(TRACK_START(planNodeId, UNCOMPRESS_CU));
     cuPtr->UnCompress(cuDescPtr->row_count, cuDescPtr->magic);
     UNCOMPRESS_TRACE(TRACK_END(planNodeId, UNCOMPRESS_CU));
 
-    /* Do not put the compressedBuf in the cache
-     * In the future we may have compressed data in the cache or let the
-     * caller choose, but for now we just keep the uncompressed data.
+    /*
+     * Keep the compressedBuf next to the uncompressed data only if the cache has
+     * a compressed tier and the CU compresses well, then the clock sweep can drop
+     * the uncompressed data instead of the whole CU. See CacheMgr::EvictCacheBlock().
      */
-    cuPtr->FreeCompressBuf();
+    int cu_uncompress_size = cuPtr->GetUncompressBufSize();
+    if (keepCompressed && cu_uncompress_size >= cuDescPtr->cu_size * CU_COMPRESSED_TIER_MIN_RATIO) {
+        cu_uncompress_size += cuDescPtr->cu_size;
+    } else {
+        cuPtr->FreeCompressBuf();
+    }
 
     /* Adjust the allocation reservation to take into account
      * compression or expansion.
      */
-    int cu_uncompress_size = cuPtr->GetUncompressBufSize();
     m_cache_mgr->AdjustCacheMem(slotId, cuDescPtr->cu_size, cu_uncompress_size);
+    m_cache_mgr->LeaveCompressedTier(slotId);
     m_cache_mgr->RealeseCompressLock(slotId);
 
     TerminateCU(false);
@@ -505,6 +522,16 @@ int64 DataCacheMgr::GetCurrentMemSize()
         return 0;
 }
 
+/*
+ * @Description: get the memory used by the data cache and its compressed tier
+ * @OUT stat: statistics
+ * @See also:
+ */
+void DataCacheMgr::GetCacheTierStat(CacheTierStat* stat)
+{
+    m_cache_mgr->GetCacheTierStat(stat);
+}
+
 /*
  * @Description: DataBlockWaitIO
  * If the CU is IOBUSY then go to sleep waiting on the IO busy lock.
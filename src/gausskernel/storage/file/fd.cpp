@@ -91,6 +91,7 @@
 #include "storage/vfd.h"
 #include "storage/ipc.h"
 #include "storage/shmem.h"
+#include "storage/uring.h"
 #include "threadpool/threadpool.h"
 #include "utils/guc.h"
 #include "utils/plog.h"
@@ -1173,6 +1174,9 @@ static void DataFileIdCloseFile(Vfd* vfdP)
 {
     DataFileIdCacheEntry* entry = NULL;
 
+    /* Hints queued in our ring may refer to this fd, they must go out while it is still ours */
+    UringSubmitPending();
+
     /*
      * Do not use thread-share fd cache when:
      *  1. vfd is not in fd cache;
@@ -1830,11 +1834,11 @@ void FileClose(File file)
  * FilePrefetch - initiate asynchronous read of a given range of the file.
  * The logical seek position is unaffected.
  *
- * Currently the only implementation of this function is using posix_fadvise
- * which is the simplest standardized interface that accomplishes this.
- * We could add an implementation using libaio in the future; but note that
- * this API is inappropriate for libaio, which wants to have a buffer provided
- * to read into.
+ * The implementation uses posix_fadvise which is the simplest standardized
+ * interface that accomplishes this.  With enable_io_uring the advice is only
+ * queued in the io_uring of this thread, so that a burst of prefetches costs
+ * one system call; note that this API is inappropriate for libaio, which
+ * wants to have a buffer provided to read into.
  */
 int FilePrefetch(File file, off_t offset, int amount, uint32 wait_event_info)
 {
@@ -1854,6 +1858,11 @@ int FilePrefetch(File file, off_t offset, int amount, uint32 wait_event_info)
     if (returnCode < 0)
         return returnCode;
 
+    if (UringIsEnabled()) {
+        UringPrefetch(u_sess->storage_cxt.VfdCache[file].fd, offset, amount);
+        return 0;
+    }
+
     pgstat_report_waitevent(wait_event_info);
     returnCode = posix_fadvise(u_sess->storage_cxt.VfdCache[file].fd, offset, amount, POSIX_FADV_WILLNEED);
     pgstat_report_waitevent(WAIT_EVENT_END);
@@ -1889,6 +1898,14 @@ void FileWriteback(File file, off_t offset, off_t nbytes)
     if (returnCode < 0)
         return;
 
+    if (UringIsEnabled()) {
+        /* pg_flush_data() is a no-op without fsync, keep it that way */
+        if (u_sess->attr.attr_storage.enableFsync) {
+            UringWriteback(u_sess->storage_cxt.VfdCache[file].fd, offset, nbytes);
+        }
+        return;
+    }
+
     pg_flush_data(u_sess->storage_cxt.VfdCache[file].fd, offset, nbytes);
 }
 
@@ -1916,6 +1933,9 @@ int FilePRead(File file, char* buffer, int amount, off_t offset, uint32 wait_eve
     if (u_sess->attr.attr_resource.use_workload_manager && u_sess->attr.attr_resource.enable_logical_io_statistics)
         IOStatistics(IO_TYPE_READ, 1, amount);
 
+    /* Queued prefetches must not wait behind a read we are about to block on */
+    UringSubmitPending();
+
 retry:
 
     PROFILING_MDIO_START();
@@ -2169,6 +2189,31 @@ static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dLis
     return submitCount;
 }
 
+/*
+ * @Description: dispatch a list without the completer threads, used when AioCompltrIsInline().
+ *  The list goes to the io_uring of this thread, which runs the completer callback of the
+ *  request type for each request once it is reaped, see UringWaitBatches().  Requests the
+ *  ring does not take are done right here with pread/pwrite.
+ * @Param[IN] dList: aio desc list, vfds already replaced by kernel fds
+ * @Param[IN] dListCount: aio desc list count
+ * @Param[IN] reqType: completer type of the list
+ * @Return: number of requests dispatched
+ */
+template <typename dlistType>
+static int FileAsyncSubmitInline(dlistType dList, int dListCount, AioCompltrType reqType)
+{
+    AioCallback_t callback = ComptrCallback(reqType);
+    struct iocb** iocbs = (struct iocb**)dList;
+    int submitted = UringSubmitIocbBatch(iocbs, dListCount, callback);
+
+    /* The callbacks may release the descriptors, do not touch them afterwards */
+    for (int i = submitted; i < dListCount; i++) {
+        (void)callback((void*)iocbs[i], UringSyncIocb(iocbs[i]));
+    }
+
+    return dListCount;
+}
+
 /*
  * @Description: row store async read api
  * @Param[IN] dList:aio desc list
@@ -2202,6 +2247,10 @@ int FileAsyncRead(AioDispatchDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
+    if (AioCompltrIsInline()) {
+        return FileAsyncSubmitInline<AioDispatchDesc_t**>(dList, dn, dList[0]->blockDesc.reqType);
+    }
+
     /*
      * Dispatch the dList
      * If there are too many on the system queue then retry.
@@ -2255,6 +2304,10 @@ int FileAsyncWrite(AioDispatchDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
+    if (AioCompltrIsInline()) {
+        return FileAsyncSubmitInline<AioDispatchDesc_t**>(dList, dn, dList[0]->blockDesc.reqType);
+    }
+
     io_context_t aio_context = CompltrContext(dList[0]->blockDesc.reqType, 0);
 
     returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(aio_context, dList, dn);
@@ -2320,6 +2373,10 @@ int FileAsyncCURead(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
+    if (AioCompltrIsInline()) {
+        return FileAsyncSubmitInline<AioDispatchCUDesc_t**>(dList, dn, dList[0]->cuDesc.reqType);
+    }
+
     io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
 
     returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
@@ -2365,6 +2422,10 @@ int FileAsyncCUWrite(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
+    if (AioCompltrIsInline()) {
+        return FileAsyncSubmitInline<AioDispatchCUDesc_t**>(dList, dn, dList[0]->cuDesc.reqType);
+    }
+
     io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
 
     returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
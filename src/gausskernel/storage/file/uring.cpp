@@ -0,0 +1,874 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * uring.cpp
+ *
+ * io_uring backend for the virtual file descriptor layer.
+ *
+ * Every thread that does I/O through fd.cpp lazily sets up its own ring the
+ * first time it needs one, so no locking is needed around the submission and
+ * completion queues.  The ring is driven through the raw system calls to avoid
+ * a dependency on liburing, which is not part of our third party libraries.
+ *
+ * Two kinds of work go through the ring:
+ *
+ * 1. Hints (POSIX_FADV_WILLNEED prefetch and sync_file_range writeback).
+ *    They are only queued and reach the kernel in a single io_uring_enter()
+ *    once the queue fills up or the caller is about to block on a real read,
+ *    so a prefetch burst of N pages costs one system call instead of N.
+ *    Their completions are reaped opportunistically and otherwise ignored.
+ *
+ * 2. ADIO iocb batches (page list prefetch/backwrite and CU read/write).
+ *    They are submitted together and the submitting thread returns right
+ *    away, as it would with the AIO completer threads.  The completions are
+ *    reaped, and the completer callbacks run, when the thread next touches
+ *    the ring, and at the latest before it waits for a lock that may be held
+ *    on behalf of one of its requests (see UringWaitBatches()), ends its
+ *    transaction or exits.  The bgwriter additionally registers the shared
+ *    buffer pool with the ring so that its page writes use the fixed buffer
+ *    opcodes and skip the per-request page pinning in the kernel.
+ *
+ * Only opcodes of the first io_uring kernel (5.1) are used for the batches,
+ * READV/WRITEV and their fixed buffer variants.  The hint opcodes came later
+ * and are probed for when the ring is set up.
+ *
+ * Because fds of the VFD layer are shared between threads through the data
+ * file id cache, queued hints must reach the kernel before the reference the
+ * queuing thread holds on the fd is dropped; see DataFileIdCloseFile().
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/file/uring.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "miscadmin.h"
+#include "postmaster/aiocompleter.h"
+#include "storage/barrier.h"
+#include "storage/fd.h"
+#include "storage/ipc.h"
+#include "storage/uring.h"
+#include "utils/memutils.h"
+
+#ifdef USE_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/* The io_uring syscall numbers are shared by all architectures */
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+/* IORING_OP_FADVISE and IORING_REGISTER_PROBE came with the same kernel headers as IORING_FEAT_RW_CUR_POS */
+#ifdef IORING_FEAT_RW_CUR_POS
+#define URING_HAS_FADVISE
+#define URING_HAS_PROBE
+#endif
+
+/* The kernel refuses to register a single buffer larger than 1GB */
+#define URING_MAX_FIXED_BUFFER_SIZE ((Size)1024 * 1024 * 1024)
+
+/* user_data of queued hints, batch requests carry their index in the batch plus one */
+#define URING_HINT_USER_DATA 0
+
+/* io_uring_enter() calls retried while the kernel is short of resources */
+#define URING_MAX_BUSY_RETRIES 100
+
+/* An ADIO request in flight, its slot index plus one is the user_data of its sqe */
+typedef struct UringRequest {
+    struct iocb* cb;
+    int (*callback)(void*, long);
+    struct iovec iov; /* read by the kernel until the request completes */
+} UringRequest;
+
+typedef struct UringContext {
+    int ring_fd;
+
+    /* submission queue */
+    void* sq_ring_ptr;
+    size_t sq_ring_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_ring_mask;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    unsigned sq_entries;
+
+    /* completion queue */
+    void* cq_ring_ptr;
+    size_t cq_ring_size;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_ring_mask;
+    struct io_uring_cqe* cqes;
+    unsigned cq_entries;
+
+    unsigned local_tail;   /* tail of prepared but unpublished sqes */
+    unsigned to_submit;    /* published sqes not yet passed to the kernel */
+    unsigned hints_queued; /* hints whose completion has not been reaped */
+    bool fadvise_ok;       /* kernel supports IORING_OP_FADVISE */
+    bool writeback_ok;     /* kernel supports IORING_OP_SYNC_FILE_RANGE */
+
+    /* ADIO requests, sq_entries slots */
+    UringRequest* requests;
+    int* free_slots; /* stack of free slot indexes */
+    int nfree;
+    int inflight;
+
+    /* fixed buffers, covering the shared buffer pool in 1GB pieces */
+    bool fixed_tried;
+    int nfixed;
+    char* fixed_base;
+    Size fixed_size;
+} UringContext;
+
+static int uring_setup(unsigned entries, struct io_uring_params* params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int uring_register(int fd, unsigned opcode, const void* arg, unsigned nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void UringDestroy(UringContext* ring)
+{
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        (void)munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring_ptr != NULL && ring->cq_ring_ptr != MAP_FAILED && ring->cq_ring_ptr != ring->sq_ring_ptr) {
+        (void)munmap(ring->cq_ring_ptr, ring->cq_ring_size);
+    }
+    if (ring->sq_ring_ptr != NULL && ring->sq_ring_ptr != MAP_FAILED) {
+        (void)munmap(ring->sq_ring_ptr, ring->sq_ring_size);
+    }
+    if (ring->ring_fd >= 0) {
+        (void)close(ring->ring_fd);
+    }
+    if (ring->requests != NULL) {
+        pfree(ring->requests);
+    }
+    if (ring->free_slots != NULL) {
+        pfree(ring->free_slots);
+    }
+    pfree(ring);
+}
+
+static void UringAtProcExit(int code, Datum arg)
+{
+    UringContext* ring = t_thrd.storage_cxt.uring_cxt;
+
+    if (ring == NULL) {
+        return;
+    }
+
+    /* Let queued hints reach the kernel, and our ADIO requests finish, the ring itself dies with the thread */
+    UringSubmitPending();
+    UringWaitBatches();
+    t_thrd.storage_cxt.uring_cxt = NULL;
+    UringDestroy(ring);
+}
+
+/*
+ * @Description: find out which hint opcodes the kernel supports.  Kernels
+ *  before 5.6 cannot be probed, they know sync_file_range from 5.2 on but not
+ *  fadvise; a sync_file_range they do not know disables itself on its first
+ *  -EINVAL completion.
+ */
+static void UringProbeOpcodes(UringContext* ring)
+{
+#ifdef URING_HAS_PROBE
+    Size len = offsetof(struct io_uring_probe, ops) + IORING_OP_LAST * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*)palloc0(len);
+
+    if (uring_register(ring->ring_fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) >= 0) {
+        ring->fadvise_ok = IORING_OP_FADVISE < probe->ops_len &&
+                           (probe->ops[IORING_OP_FADVISE].flags & IO_URING_OP_SUPPORTED) != 0;
+        ring->writeback_ok = IORING_OP_SYNC_FILE_RANGE < probe->ops_len &&
+                             (probe->ops[IORING_OP_SYNC_FILE_RANGE].flags & IO_URING_OP_SUPPORTED) != 0;
+    } else {
+        ring->fadvise_ok = false;
+        ring->writeback_ok = true;
+    }
+    pfree(probe);
+#else
+    ring->fadvise_ok = false;
+    ring->writeback_ok = true;
+#endif
+}
+
+/*
+ * @Description: create the ring of the current thread
+ * @Return: the ring, or NULL if the kernel does not support io_uring
+ */
+static UringContext* UringCreate(void)
+{
+    struct io_uring_params params;
+    UringContext* ring = NULL;
+    errno_t rc;
+
+    rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    ring = (UringContext*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(UringContext));
+    ring->ring_fd = uring_setup((unsigned)g_instance.attr.attr_storage.io_uring_queue_depth, &params);
+    if (ring->ring_fd < 0) {
+        ereport(LOG, (errmodule(MOD_ADIO), errmsg("io_uring_setup() failed, fall back to synchronous I/O: %m")));
+        pfree(ring);
+        return NULL;
+    }
+
+    ring->sq_entries = params.sq_entries;
+    ring->cq_entries = params.cq_entries;
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_ring_size = Max(ring->sq_ring_size, ring->cq_ring_size);
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+#endif
+
+    ring->sq_ring_ptr = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring->ring_fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring_ptr == MAP_FAILED) {
+        goto map_failed;
+    }
+
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring_ptr = ring->sq_ring_ptr;
+    } else
+#endif
+    {
+        ring->cq_ring_ptr = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            ring->ring_fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring_ptr == MAP_FAILED) {
+            goto map_failed;
+        }
+    }
+
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        goto map_failed;
+    }
+
+    ring->sq_head = (unsigned*)((char*)ring->sq_ring_ptr + params.sq_off.head);
+    ring->sq_tail = (unsigned*)((char*)ring->sq_ring_ptr + params.sq_off.tail);
+    ring->sq_ring_mask = (unsigned*)((char*)ring->sq_ring_ptr + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)((char*)ring->sq_ring_ptr + params.sq_off.array);
+    ring->cq_head = (unsigned*)((char*)ring->cq_ring_ptr + params.cq_off.head);
+    ring->cq_tail = (unsigned*)((char*)ring->cq_ring_ptr + params.cq_off.tail);
+    ring->cq_ring_mask = (unsigned*)((char*)ring->cq_ring_ptr + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)((char*)ring->cq_ring_ptr + params.cq_off.cqes);
+    ring->local_tail = *ring->sq_tail;
+
+    ring->requests = (UringRequest*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(UringRequest) * ring->sq_entries);
+    ring->free_slots = (int*)MemoryContextAlloc(t_thrd.top_mem_cxt, sizeof(int) * ring->sq_entries);
+    for (unsigned i = 0; i < ring->sq_entries; i++) {
+        ring->free_slots[ring->nfree++] = (int)(ring->sq_entries - 1 - i);
+    }
+
+    UringProbeOpcodes(ring);
+
+    on_proc_exit(UringAtProcExit, 0);
+    return ring;
+
+map_failed:
+    ereport(LOG, (errmodule(MOD_ADIO), errmsg("could not map io_uring queues, fall back to synchronous I/O: %m")));
+    UringDestroy(ring);
+    return NULL;
+}
+
+/*
+ * @Description: get the ring of the current thread, creating it on first use
+ * @Return: the ring, or NULL if io_uring is disabled or not supported
+ */
+static UringContext* UringGetContext(void)
+{
+    if (!g_instance.attr.attr_storage.enable_io_uring || t_thrd.storage_cxt.uring_unavailable) {
+        return NULL;
+    }
+
+    if (t_thrd.storage_cxt.uring_cxt == NULL) {
+        t_thrd.storage_cxt.uring_cxt = UringCreate();
+        if (t_thrd.storage_cxt.uring_cxt == NULL) {
+            t_thrd.storage_cxt.uring_unavailable = true;
+        }
+    }
+
+    return t_thrd.storage_cxt.uring_cxt;
+}
+
+/*
+ * Only the bgwriter registers the buffer pool: it is the one long lived thread
+ * whose page writes go through ADIO batches (PageRangeBackWrite() from
+ * BgBufferSync()).  The pagewriter and checkpointer flush through the double
+ * write batches and smgrwrite(), and registering pins every page of the pool
+ * in the kernel, which is too expensive to do in each backend.
+ */
+static bool UringWantsFixedBuffers(void)
+{
+    return t_thrd.role == BGWRITER;
+}
+
+static void UringRegisterBufferPool(UringContext* ring)
+{
+    Size pool_size = (Size)g_instance.attr.attr_storage.NBuffers * BLCKSZ;
+    int nchunks;
+    struct iovec* iovecs = NULL;
+
+    ring->fixed_tried = true;
+    if (!UringWantsFixedBuffers() || t_thrd.storage_cxt.BufferBlocks == NULL || pool_size == 0) {
+        return;
+    }
+
+    nchunks = (int)((pool_size + URING_MAX_FIXED_BUFFER_SIZE - 1) / URING_MAX_FIXED_BUFFER_SIZE);
+    iovecs = (struct iovec*)palloc(sizeof(struct iovec) * nchunks);
+    for (int i = 0; i < nchunks; i++) {
+        Size offset = (Size)i * URING_MAX_FIXED_BUFFER_SIZE;
+        iovecs[i].iov_base = t_thrd.storage_cxt.BufferBlocks + offset;
+        iovecs[i].iov_len = Min(URING_MAX_FIXED_BUFFER_SIZE, pool_size - offset);
+    }
+
+    if (uring_register(ring->ring_fd, IORING_REGISTER_BUFFERS, iovecs, (unsigned)nchunks) < 0) {
+        /* Most likely RLIMIT_MEMLOCK, the plain opcodes still work */
+        ereport(LOG,
+            (errmodule(MOD_ADIO),
+                errmsg("could not register shared buffers with io_uring, using unregistered I/O: %m")));
+    } else {
+        ring->nfixed = nchunks;
+        ring->fixed_base = t_thrd.storage_cxt.BufferBlocks;
+        ring->fixed_size = pool_size;
+    }
+    pfree(iovecs);
+}
+
+/*
+ * @Description: find the registered buffer that fully contains [buf, buf + len)
+ * @Return: buffer index, -1 if the range is not in the shared buffer pool
+ */
+static int UringFixedBufferIndex(UringContext* ring, const char* buf, Size len)
+{
+    Size offset;
+    int index;
+
+    if (ring->nfixed == 0 || buf < ring->fixed_base || buf + len > ring->fixed_base + ring->fixed_size) {
+        return -1;
+    }
+
+    offset = (Size)(buf - ring->fixed_base);
+    index = (int)(offset / URING_MAX_FIXED_BUFFER_SIZE);
+    if ((offset + len - 1) / URING_MAX_FIXED_BUFFER_SIZE != (Size)index) {
+        return -1;
+    }
+    return index;
+}
+
+/* Return the next free sqe, or NULL when the submission queue is full */
+static struct io_uring_sqe* UringGetSqe(UringContext* ring)
+{
+    unsigned head;
+    struct io_uring_sqe* sqe = NULL;
+    errno_t rc;
+
+    head = *(volatile unsigned*)ring->sq_head;
+    pg_read_barrier();
+    if (ring->local_tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+
+    sqe = &ring->sqes[ring->local_tail & *ring->sq_ring_mask];
+    rc = memset_s(sqe, sizeof(struct io_uring_sqe), 0, sizeof(struct io_uring_sqe));
+    securec_check(rc, "\0", "\0");
+    return sqe;
+}
+
+/* Publish the prepared sqe at local_tail to the kernel visible tail */
+static void UringQueueSqe(UringContext* ring)
+{
+    unsigned index = ring->local_tail & *ring->sq_ring_mask;
+
+    ring->sq_array[index] = index;
+    ring->local_tail++;
+    pg_write_barrier();
+    *(volatile unsigned*)ring->sq_tail = ring->local_tail;
+    ring->to_submit++;
+}
+
+/*
+ * @Description: consume all available completions.  The completer callback of
+ *  an ADIO request runs as soon as its completion is consumed, with the queue
+ *  head already moved past it, so that the callback may use the ring again.
+ *  Requests the kernel refused as unsupported are done with pread/pwrite.
+ * @Return: number of ADIO completions consumed
+ */
+static int UringReapCompletions(UringContext* ring)
+{
+    int reaped = 0;
+
+    for (;;) {
+        unsigned head = *(volatile unsigned*)ring->cq_head;
+        struct io_uring_cqe* cqe = NULL;
+        __u64 user_data;
+        long res;
+
+        pg_read_barrier();
+        if (head == *(volatile unsigned*)ring->cq_tail) {
+            break;
+        }
+
+        cqe = &ring->cqes[head & *ring->cq_ring_mask];
+        user_data = cqe->user_data;
+        res = cqe->res;
+        pg_memory_barrier();
+        *(volatile unsigned*)ring->cq_head = head + 1;
+
+        if (user_data == URING_HINT_USER_DATA) {
+            Assert(ring->hints_queued > 0);
+            ring->hints_queued--;
+            /* Hint opcodes not known to the kernel disable themselves for this ring */
+            if (res == -EINVAL) {
+                ring->fadvise_ok = false;
+                ring->writeback_ok = false;
+            }
+        } else {
+            int slot = (int)(user_data - 1);
+            UringRequest* req = &ring->requests[slot];
+            struct iocb* cb = req->cb;
+            int (*callback)(void*, long) = req->callback;
+
+            req->cb = NULL;
+            ring->free_slots[ring->nfree++] = slot;
+            ring->inflight--;
+            reaped++;
+
+            if (res == -EINVAL || res == -EOPNOTSUPP) {
+                res = UringSyncIocb(cb);
+            }
+            (void)callback((void*)cb, res);
+        }
+    }
+
+    return reaped;
+}
+
+/*
+ * @Description: pass published sqes to the kernel and optionally wait
+ * @Return: io_uring_enter() result, negative errno on failure
+ */
+static int UringEnter(UringContext* ring, unsigned min_complete)
+{
+    int ret;
+    unsigned flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+
+    for (;;) {
+        ret = uring_enter(ring->ring_fd, ring->to_submit, min_complete, flags);
+        if (ret >= 0) {
+            ring->to_submit -= (unsigned)ret;
+            return ret;
+        }
+        if (errno != EINTR) {
+            /* EAGAIN and EBUSY mean the caller must reap completions first */
+            return -errno;
+        }
+    }
+}
+
+/*
+ * @Description: stop using the ring of the current thread after io_uring_enter()
+ *  failed with something else than a lack of resources.  The sqes the kernel has
+ *  not taken yet are withdrawn, later I/O of the thread goes the synchronous way.
+ * @Return: number of sqes withdrawn
+ */
+static unsigned UringDisable(UringContext* ring, int err)
+{
+    unsigned withdrawn = ring->to_submit;
+
+    /* Without SQPOLL the kernel only reads the submission queue in io_uring_enter() */
+    ring->local_tail -= withdrawn;
+    pg_write_barrier();
+    *(volatile unsigned*)ring->sq_tail = ring->local_tail;
+    ring->to_submit = 0;
+    t_thrd.storage_cxt.uring_unavailable = true;
+
+    ereport(LOG,
+        (errmodule(MOD_ADIO),
+            errmsg("io_uring_enter() failed, fall back to synchronous I/O: %s, withdrawn(%u)", strerror(-err),
+                withdrawn)));
+    return withdrawn;
+}
+
+/* Check that one more request in flight cannot overflow the completion queue */
+static bool UringHasCompletionRoom(UringContext* ring)
+{
+    return ring->hints_queued + (unsigned)ring->inflight < ring->cq_entries;
+}
+
+/* Make room for one more sqe, flushing and reaping what is already queued */
+static struct io_uring_sqe* UringGetSqeForHint(UringContext* ring)
+{
+    struct io_uring_sqe* sqe = NULL;
+
+    (void)UringReapCompletions(ring);
+    if (!UringHasCompletionRoom(ring)) {
+        return NULL;
+    }
+
+    sqe = UringGetSqe(ring);
+    if (sqe == NULL) {
+        (void)UringEnter(ring, 0);
+        sqe = UringGetSqe(ring);
+    }
+    return sqe;
+}
+
+#endif /* USE_IO_URING */
+
+/*
+ * @Description: Check whether the kernel lets this process set up an io_uring,
+ *  by creating a small ring and closing it again
+ * @Return: true if io_uring_setup() succeeds
+ */
+bool UringProbe(void)
+{
+#ifdef USE_IO_URING
+    struct io_uring_params params;
+    int fd;
+    errno_t rc;
+
+    rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    fd = uring_setup(URING_MIN_QUEUE_DEPTH, &params);
+    if (fd < 0) {
+        ereport(LOG, (errmodule(MOD_ADIO), errmsg("io_uring_setup() failed: %m")));
+        return false;
+    }
+    (void)close(fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ * @Description: Check whether I/O of the current thread should use io_uring
+ * @Return: true if enable_io_uring is set and the kernel supports it
+ */
+bool UringIsEnabled(void)
+{
+#ifdef USE_IO_URING
+    return UringGetContext() != NULL;
+#else
+    return false;
+#endif
+}
+
+/*
+ * @Description: queue a POSIX_FADV_WILLNEED hint for the given range
+ * @Param[IN] fd: kernel fd, must stay open until the hint is submitted
+ * @Param[IN] offset: start of the range
+ * @Param[IN] nbytes: length of the range
+ * @See also: UringSubmitPending
+ */
+void UringPrefetch(int fd, off_t offset, off_t nbytes)
+{
+#ifdef USE_IO_URING
+    UringContext* ring = UringGetContext();
+    struct io_uring_sqe* sqe = NULL;
+
+    if (ring == NULL || !ring->fadvise_ok || (sqe = UringGetSqeForHint(ring)) == NULL) {
+#if defined(USE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+        (void)posix_fadvise(fd, offset, nbytes, POSIX_FADV_WILLNEED);
+#endif
+        return;
+    }
+
+#ifdef URING_HAS_FADVISE
+    sqe->opcode = IORING_OP_FADVISE;
+    sqe->fd = fd;
+    sqe->off = (__u64)offset;
+    sqe->len = (__u32)nbytes;
+    sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+    sqe->user_data = URING_HINT_USER_DATA;
+    UringQueueSqe(ring);
+    ring->hints_queued++;
+#endif
+#endif
+}
+
+/*
+ * @Description: queue a sync_file_range(SYNC_FILE_RANGE_WRITE) for the given range
+ * @Param[IN] fd: kernel fd, must stay open until the hint is submitted
+ * @Param[IN] offset: start of the range
+ * @Param[IN] nbytes: length of the range
+ * @See also: UringSubmitPending
+ */
+void UringWriteback(int fd, off_t offset, off_t nbytes)
+{
+#ifdef USE_IO_URING
+    UringContext* ring = UringGetContext();
+    struct io_uring_sqe* sqe = NULL;
+
+    if (ring == NULL || !ring->writeback_ok || (sqe = UringGetSqeForHint(ring)) == NULL) {
+        pg_flush_data(fd, offset, nbytes);
+        return;
+    }
+
+    sqe->opcode = IORING_OP_SYNC_FILE_RANGE;
+    sqe->fd = fd;
+    sqe->off = (__u64)offset;
+    sqe->len = (__u32)nbytes;
+    sqe->sync_range_flags = SYNC_FILE_RANGE_WRITE;
+    sqe->user_data = URING_HINT_USER_DATA;
+    UringQueueSqe(ring);
+    ring->hints_queued++;
+#endif
+}
+
+/*
+ * @Description: hand all queued hints of the current thread to the kernel
+ *  without waiting for them, and run the callbacks of the ADIO requests that
+ *  completed meanwhile.  Must be called before the thread gives up the fds
+ *  the hints refer to, and before it blocks on a synchronous read.
+ * @Return: 0, or the negative errno of io_uring_enter(), in which case the
+ *  hints not submitted are dropped and the thread stops using io_uring
+ */
+int UringSubmitPending(void)
+{
+#ifdef USE_IO_URING
+    UringContext* ring = t_thrd.storage_cxt.uring_cxt;
+    int retries = 0;
+
+    if (ring == NULL) {
+        return 0;
+    }
+
+    (void)UringReapCompletions(ring);
+    while (ring->to_submit > 0) {
+        int ret = UringEnter(ring, 0);
+
+        if ((ret == -EAGAIN || ret == -EBUSY) && retries++ < URING_MAX_BUSY_RETRIES) {
+            /* The kernel is out of resources, let completions drain and retry */
+            pg_usleep(1000);
+            (void)UringReapCompletions(ring);
+        } else if (ret < 0) {
+            ring->hints_queued -= UringDisable(ring, ret);
+            return ret;
+        }
+    }
+#endif
+    return 0;
+}
+
+#ifdef USE_IO_URING
+/*
+ * @Description: take a free request slot and prepare the sqe of an iocb in it
+ * @Return: the slot
+ */
+static int UringPrepareIocb(UringContext* ring, struct io_uring_sqe* sqe, struct iocb* cb, int (*callback)(void*, long))
+{
+    int slot = ring->free_slots[--ring->nfree];
+    UringRequest* req = &ring->requests[slot];
+    bool is_write = (cb->aio_lio_opcode == IO_CMD_PWRITE);
+    int fixed_index = UringFixedBufferIndex(ring, (char*)cb->u.c.buf, (Size)cb->u.c.nbytes);
+
+    Assert(cb->aio_lio_opcode == IO_CMD_PREAD || cb->aio_lio_opcode == IO_CMD_PWRITE);
+    req->cb = cb;
+    req->callback = callback;
+    if (fixed_index >= 0) {
+        sqe->opcode = is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->addr = (__u64)(uintptr_t)cb->u.c.buf;
+        sqe->len = (__u32)cb->u.c.nbytes;
+        sqe->buf_index = (__u16)fixed_index;
+    } else {
+        req->iov.iov_base = cb->u.c.buf;
+        req->iov.iov_len = (size_t)cb->u.c.nbytes;
+        sqe->opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->addr = (__u64)(uintptr_t)&req->iov;
+        sqe->len = 1;
+    }
+    sqe->fd = cb->aio_fildes;
+    sqe->off = (__u64)cb->u.c.offset;
+    sqe->user_data = (__u64)(slot + 1);
+    UringQueueSqe(ring);
+    ring->inflight++;
+
+    return slot;
+}
+#endif /* USE_IO_URING */
+
+/*
+ * @Description: submit a batch of iocbs prepared for libaio without waiting for
+ *  them.  The callback runs for each request once it completes, from whatever
+ *  call of the thread reaps the ring next, see UringWaitBatches().
+ * @Param[IN] iocbs: requests prepared with io_prep_pread/io_prep_pwrite on kernel fds
+ * @Param[IN] count: number of requests
+ * @Param[IN] callback: completer callback of the requests, gets the iocb and the
+ *  bytes transferred or negative errno
+ * @Return: number of requests the kernel took, from the start of iocbs.  Less than
+ *  count when io_uring is unavailable or failed, the caller does the rest itself.
+ */
+int UringSubmitIocbBatch(struct iocb** iocbs, int count, int (*callback)(void*, long))
+{
+#ifdef USE_IO_URING
+    UringContext* ring = UringGetContext();
+    int* slots = NULL;
+    int queued = 0;
+    int submitted = 0;
+    int retries = 0;
+
+    if (ring == NULL) {
+        return 0;
+    }
+
+    /* Queued hints first, so that to_submit counts the sqes of this batch only */
+    if (UringSubmitPending() < 0) {
+        return 0;
+    }
+
+    if (!ring->fixed_tried) {
+        UringRegisterBufferPool(ring);
+    }
+
+    slots = (int*)palloc(sizeof(int) * count);
+    while (submitted < count) {
+        int ret;
+
+        /* fill the submission queue as far as it goes */
+        while (queued < count && ring->nfree > 0 && UringHasCompletionRoom(ring)) {
+            struct io_uring_sqe* sqe = UringGetSqe(ring);
+
+            if (sqe == NULL) {
+                break;
+            }
+            slots[queued] = UringPrepareIocb(ring, sqe, iocbs[queued], callback);
+            queued++;
+        }
+
+        /* Out of room, wait for one of the requests in flight to make some */
+        ret = UringEnter(ring, (queued < count) ? 1 : 0);
+        if (ret >= 0) {
+            submitted = queued - (int)ring->to_submit;
+            retries = 0;
+        } else if ((ret == -EAGAIN || ret == -EBUSY) && retries++ < URING_MAX_BUSY_RETRIES) {
+            /* Insufficient resources, reap what is done and try again */
+            pg_usleep(1000);
+        } else {
+            /*
+             * The requests withdrawn are left to the caller, but those already
+             * submitted own their buffers until they complete as usual.
+             */
+            int withdrawn = (int)UringDisable(ring, ret);
+
+            for (int i = queued - withdrawn; i < queued; i++) {
+                ring->requests[slots[i]].cb = NULL;
+                ring->free_slots[ring->nfree++] = slots[i];
+                ring->inflight--;
+            }
+            submitted = queued - withdrawn;
+            break;
+        }
+        (void)UringReapCompletions(ring);
+    }
+    pfree(slots);
+
+    return submitted;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * @Description: wait for the ADIO requests the current thread has in flight and
+ *  run their callbacks.  Submitting a request disowns the buffer or CU locks it
+ *  holds, and only this thread can release them again, so it must come here
+ *  before it waits for such a lock, ends its transaction or goes to sleep.
+ */
+void UringWaitBatches(void)
+{
+#ifdef USE_IO_URING
+    UringContext* ring = t_thrd.storage_cxt.uring_cxt;
+
+    if (ring == NULL) {
+        return;
+    }
+
+    (void)UringReapCompletions(ring);
+    while (ring->inflight > 0) {
+        if (UringEnter(ring, 1) < 0) {
+            pg_usleep(1000);
+        }
+        (void)UringReapCompletions(ring);
+    }
+#endif
+}
+
+/*
+ * @Description: Check whether the current thread has ADIO requests in flight
+ * @Return: true if UringWaitBatches() has something to wait for
+ */
+bool UringBatchesInFlight(void)
+{
+#ifdef USE_IO_URING
+    UringContext* ring = t_thrd.storage_cxt.uring_cxt;
+
+    return ring != NULL && ring->inflight > 0;
+#else
+    return false;
+#endif
+}
+
+/*
+ * @Description: do an iocb prepared for libaio with pread/pwrite
+ * @Param[IN] cb: request on a kernel fd
+ * @Return: bytes transferred, or negative errno
+ */
+long UringSyncIocb(struct iocb* cb)
+{
+    ssize_t rc;
+
+    do {
+        if (cb->aio_lio_opcode == IO_CMD_PWRITE) {
+            rc = pwrite(cb->aio_fildes, cb->u.c.buf, cb->u.c.nbytes, cb->u.c.offset);
+        } else {
+            rc = pread(cb->aio_fildes, cb->u.c.buf, cb->u.c.nbytes, cb->u.c.offset);
+        }
+    } while (rc < 0 && errno == EINTR);
+
+    return (rc < 0) ? -errno : (long)rc;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * shm_barrier.cpp
+ *        Phased barrier for the threads of one parallel query.
+ *
+ * The last participant to arrive at a barrier advances the phase, wakes
+ * everybody up and is told that it was "elected", so exactly one thread can
+ * do serial work (such as resetting a shared hash table) between phases.
+ * If a phase is completed by a participant detaching instead, one of the
+ * waiters is elected in its place.
+ * Waiters wake up periodically so that query cancel and worker termination
+ * are still honoured while blocked.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/ipc/shm_barrier.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "miscadmin.h"
+#include "storage/shm_barrier.h"
+
+static bool BarrierWaitForPhaseChange(Barrier* barrier, int start_phase);
+
+/*
+ * Initialize this barrier.  num_workers is the number of participants that
+ * are known to be attached from the start; others may use BarrierAttach.
+ */
+void BarrierInit(Barrier* barrier, int num_workers)
+{
+    ShmCondVarInit(&barrier->cv);
+    barrier->phase = 0;
+    barrier->participants = num_workers;
+    barrier->arrived = 0;
+    barrier->elect_waiter = false;
+}
+
+void BarrierDestroy(Barrier* barrier)
+{
+    ShmCondVarDestroy(&barrier->cv);
+}
+
+/*
+ * Arrive at this barrier and wait for all other attached participants to
+ * arrive too.  Returns true for exactly one participant in each phase.
+ */
+bool BarrierArriveAndWait(Barrier* barrier)
+{
+    bool elected = false;
+    int start_phase;
+
+    ShmCondVarLock(&barrier->cv);
+    start_phase = barrier->phase;
+    if (++barrier->arrived == barrier->participants) {
+        elected = true;
+        barrier->arrived = 0;
+        barrier->phase = start_phase + 1;
+        barrier->elect_waiter = false;
+        ShmCondVarBroadcast(&barrier->cv);
+    }
+    ShmCondVarUnlock(&barrier->cv);
+
+    if (!elected) {
+        elected = BarrierWaitForPhaseChange(barrier, start_phase);
+    }
+
+    return elected;
+}
+
+/*
+ * Arrive at this barrier and detach from it without waiting.  Returns true
+ * if this was the last participant attached.
+ */
+bool BarrierArriveAndDetach(Barrier* barrier)
+{
+    return BarrierDetach(barrier);
+}
+
+/*
+ * Like BarrierArriveAndDetach, but the last participant stays attached and
+ * moves on to the next phase alone.  Returns true for that participant.
+ */
+bool BarrierArriveAndDetachExceptLast(Barrier* barrier)
+{
+    ShmCondVarLock(&barrier->cv);
+    if (barrier->participants == 1) {
+        barrier->arrived = 0;
+        barrier->phase++;
+        barrier->elect_waiter = false;
+        ShmCondVarUnlock(&barrier->cv);
+        return true;
+    }
+    ShmCondVarUnlock(&barrier->cv);
+
+    (void)BarrierDetach(barrier);
+    return false;
+}
+
+/*
+ * Attach to a barrier, returning the current phase.  The caller must not
+ * assume that any work of that phase is still to be done.
+ */
+int BarrierAttach(Barrier* barrier)
+{
+    int phase;
+
+    ShmCondVarLock(&barrier->cv);
+    ++barrier->participants;
+    phase = barrier->phase;
+    ShmCondVarUnlock(&barrier->cv);
+
+    return phase;
+}
+
+/*
+ * Detach from a barrier.  If everybody still attached has already arrived,
+ * the phase is advanced on their behalf and one of them is elected, not the
+ * detaching participant.  Returns true if no participant is left attached.
+ */
+bool BarrierDetach(Barrier* barrier)
+{
+    bool last;
+
+    ShmCondVarLock(&barrier->cv);
+    Assert(barrier->participants > 0);
+    --barrier->participants;
+    last = (barrier->participants == 0);
+    if (barrier->arrived > 0 && barrier->arrived == barrier->participants) {
+        barrier->arrived = 0;
+        barrier->phase++;
+        barrier->elect_waiter = true;
+        ShmCondVarBroadcast(&barrier->cv);
+    }
+    ShmCondVarUnlock(&barrier->cv);
+
+    return last;
+}
+
+int BarrierPhase(Barrier* barrier)
+{
+    int phase;
+
+    ShmCondVarLock(&barrier->cv);
+    phase = barrier->phase;
+    ShmCondVarUnlock(&barrier->cv);
+
+    return phase;
+}
+
+int BarrierParticipants(Barrier* barrier)
+{
+    int participants;
+
+    ShmCondVarLock(&barrier->cv);
+    participants = barrier->participants;
+    ShmCondVarUnlock(&barrier->cv);
+
+    return participants;
+}
+
+/*
+ * Sleep until the phase moves past start_phase, returning true if we were
+ * elected by a detaching participant.
+ */
+static bool BarrierWaitForPhaseChange(Barrier* barrier, int start_phase)
+{
+    bool elected = false;
+
+    ShmCondVarLock(&barrier->cv);
+    while (barrier->phase == start_phase) {
+        ShmCondVarWait(&barrier->cv);
+    }
+    if (barrier->elect_waiter) {
+        barrier->elect_waiter = false;
+        elected = true;
+    }
+    ShmCondVarUnlock(&barrier->cv);
+
+    return elected;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * shm_condvar.cpp
+ *        Interruptible condition variable for the threads of one parallel query.
+ *
+ * Waiters wake up periodically so that query cancel and worker termination
+ * are still honoured while blocked.  The mutex is never held across
+ * CHECK_FOR_INTERRUPTS, so an error raised there cannot leave it locked.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/ipc/shm_condvar.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <sys/time.h>
+
+#include "miscadmin.h"
+#include "storage/shm_condvar.h"
+
+/* How long a waiter sleeps before re-checking for interrupts, in microseconds */
+#define CONDVAR_WAIT_INTERVAL_US 10000L
+
+void ShmCondVarInit(ShmConditionVariable* cv)
+{
+    (void)pthread_mutex_init(&cv->mutex, NULL);
+    (void)pthread_cond_init(&cv->cond, NULL);
+}
+
+void ShmCondVarDestroy(ShmConditionVariable* cv)
+{
+    (void)pthread_cond_destroy(&cv->cond);
+    (void)pthread_mutex_destroy(&cv->mutex);
+}
+
+void ShmCondVarLock(ShmConditionVariable* cv)
+{
+    (void)pthread_mutex_lock(&cv->mutex);
+}
+
+void ShmCondVarUnlock(ShmConditionVariable* cv)
+{
+    (void)pthread_mutex_unlock(&cv->mutex);
+}
+
+/*
+ * Sleep until woken up or until the wait interval has passed.  The caller
+ * must hold the lock, and holds it again on return; it is expected to
+ * re-test its condition in a loop.
+ */
+void ShmCondVarWait(ShmConditionVariable* cv)
+{
+    struct timeval now;
+    struct timespec deadline;
+
+    (void)gettimeofday(&now, NULL);
+    long usec = now.tv_usec + CONDVAR_WAIT_INTERVAL_US;
+    deadline.tv_sec = now.tv_sec + usec / 1000000L;
+    deadline.tv_nsec = (usec % 1000000L) * 1000L;
+
+    (void)pthread_cond_timedwait(&cv->cond, &cv->mutex, &deadline);
+
+    (void)pthread_mutex_unlock(&cv->mutex);
+    CHECK_FOR_INTERRUPTS();
+    (void)pthread_mutex_lock(&cv->mutex);
+}
+
+/*
+ * Wake up all waiters.  The caller should hold the lock while changing the
+ * state the waiters test, but need not hold it here.
+ */
+void ShmCondVarBroadcast(ShmConditionVariable* cv)
+{
+    (void)pthread_cond_broadcast(&cv->cond);
+}
@@ -89,6 +89,7 @@
 #include "storage/s_lock.h"
 #include "storage/spin.h"
 #include "storage/cucache_mgr.h"
+#include "storage/uring.h"
 #include "utils/atomic.h"
 #include "instruments/instr_event.h"
 #include "tsan_annotation.h"
@@ -137,6 +138,7 @@ static const char *BuiltinTrancheNames[] = {
     "InstrUserLockId",
     "GPCMappingLock",
     "GPCPrepareMappingLock",
+    "PgStatTabLock",
     "BufferIOLock",
     "BufferContentLock",
     "DataCacheLock",
@@ -516,6 +518,10 @@ static void InitializeLWLocks(int numLocks)
         LWLockInitialize(&lock->lock, LWTRANCHE_GPC_PREPARE_MAPPING);
     }
 
+    for (id = 0; id < NUM_PGSTAT_TAB_PARTITIONS; id++, lock++) {
+        LWLockInitialize(&lock->lock, LWTRANCHE_PGSTAT_TAB);
+    }
+
     Assert((lock - t_thrd.shemem_ptr_cxt.mainLWLockArray) == NumFixedLWLocks);
 
     for (id = NumFixedLWLocks; id < numLocks; id++, lock++) {
@@ -1207,6 +1213,18 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
             break; /* got the lock */
         }
 
+        /*
+         * ADIO requests this thread submitted to its io_uring hold buffer and
+         * CU locks that only we release when reaping them, so complete them
+         * before going to sleep on what may be one of those locks.
+         */
+        if (UringBatchesInFlight()) {
+            forget_lwlock_acquire();
+            UringWaitBatches();
+            remember_lwlock_acquire(lock);
+            continue;
+        }
+
         /*
          * Ok, at this point we couldn't grab the lock on the first try. We
          * cannot simply queue ourselves to the end of the list and wait to be
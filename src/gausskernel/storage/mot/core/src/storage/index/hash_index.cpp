@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a lock-free hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mot_configuration.h"
+#include "mm_global_api.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+// multiplier and finalizer constants of the 64-bit Murmur3 hash
+static constexpr uint64_t HASH_MULTIPLIER = 0xff51afd7ed558ccdULL;
+static constexpr uint64_t HASH_FINAL_MULTIPLIER = 0xc4ceb9fe1a85ec53ULL;
+static constexpr uint32_t HASH_SHIFT = 33;
+
+static inline uint64_t HashMix(uint64_t h)
+{
+    h ^= h >> HASH_SHIFT;
+    h *= HASH_MULTIPLIER;
+    h ^= h >> HASH_SHIFT;
+    h *= HASH_FINAL_MULTIPLIER;
+    h ^= h >> HASH_SHIFT;
+    return h;
+}
+
+inline uint64_t HashPrimaryIndex::HashKey(const uint8_t* keyBuf) const
+{
+    uint64_t h = m_keyLength;
+    uint32_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= m_keyLength; i += sizeof(uint64_t)) {
+        h = HashMix(h ^ *reinterpret_cast<const uint64_t*>(keyBuf + i));
+    }
+
+    if (i < m_keyLength) {
+        uint64_t tail = 0;
+        for (uint32_t j = 0; i + j < m_keyLength; ++j) {
+            tail |= ((uint64_t)keyBuf[i + j]) << (j * 8);
+        }
+        h = HashMix(h ^ tail);
+    }
+
+    return h;
+}
+
+bool HashPrimaryIndex::InitPools()
+{
+    uint32_t bucketCount = MOTConfiguration::MIN_HASH_INDEX_BUCKETS;
+    while (bucketCount < GetGlobalConfiguration().m_hashIndexBuckets) {
+        bucketCount <<= 1;
+    }
+
+    // one segment per NUMA node, rounded down to a power of two
+    uint32_t segmentCount = 1;
+    uint32_t segmentShift = 0;
+    while ((segmentCount << 1) <= GetGlobalConfiguration().m_numaNodes && (segmentCount << 1) <= MEM_MAX_NUMA_NODES) {
+        segmentCount <<= 1;
+        ++segmentShift;
+    }
+
+    m_bucketCount = bucketCount;
+    m_bucketMask = bucketCount - 1;
+    m_segmentCount = segmentCount;
+    m_segmentShift = __builtin_ctz(bucketCount) - segmentShift;
+
+    uint64_t segmentSize = sizeof(std::atomic<uint64_t>) * (bucketCount / segmentCount);
+    for (uint32_t i = 0; i < m_segmentCount; ++i) {
+        m_segments[i] = (std::atomic<uint64_t>*)MemGlobalAllocAlignedOnNode(segmentSize, CACHE_LINE_SIZE, (int)i);
+        if (m_segments[i] == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Initialize Index",
+                "Failed to allocate %" PRIu64 " bytes for hash bucket segment %u on NUMA node %u",
+                segmentSize,
+                i,
+                i);
+            return false;  // safe cleanup in DestroyPools()
+        }
+        errno_t erc = memset_s(m_segments[i], segmentSize, 0, segmentSize);
+        securec_check(erc, "\0", "\0");
+    }
+
+    // nodes are allocated from the local NUMA node of the inserting thread
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + ALIGN8(m_keyLength), false);
+    if (!m_nodePool) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return false;  // safe cleanup in DestroyPools()
+    }
+
+    return true;
+}
+
+void HashPrimaryIndex::DestroyPools()
+{
+    if (m_nodePool) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+
+    for (uint32_t i = 0; i < MEM_MAX_NUMA_NODES; ++i) {
+        if (m_segments[i] != nullptr) {
+            MemGlobalFree(m_segments[i]);
+            m_segments[i] = nullptr;
+        }
+    }
+    m_segmentCount = 0;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    if (!GetUnique()) {
+        MOT_REPORT_ERROR(MOT_ERROR_INVALID_ARG, "Initialize Index", "Hash index %s must be unique", m_name.c_str());
+        return RC_ERROR;
+    }
+
+    if (!InitPools()) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index pools");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    MOT_LOG_DEBUG(
+        "Initialized hash index %s with %u buckets in %u segments", m_name.c_str(), m_bucketCount, m_segmentCount);
+    m_initialized = true;
+    return RC_OK;
+}
+
+bool HashPrimaryIndex::FindNode(std::atomic<uint64_t>* head, uint64_t hashCode, const uint8_t* keyBuf,
+    std::atomic<uint64_t>*& prev, HashNode*& curr)
+{
+retry:
+    prev = head;
+    curr = reinterpret_cast<HashNode*>(prev->load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (next & HASH_NODE_REMOVED) {
+            // help unlinking a removed node; whoever unlinks it retires it
+            uint64_t expected = reinterpret_cast<uint64_t>(curr);
+            if (!prev->compare_exchange_strong(expected, next & ~HASH_NODE_REMOVED, std::memory_order_acq_rel)) {
+                goto retry;
+            }
+            RetireNode(curr);
+            curr = reinterpret_cast<HashNode*>(next & ~HASH_NODE_REMOVED);
+            continue;
+        }
+
+        if (NodeMatches(curr, hashCode, keyBuf)) {
+            return true;
+        }
+        prev = &curr->m_next;
+        curr = reinterpret_cast<HashNode*>(next);
+    }
+
+    return false;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::LookupNode(uint64_t hashCode, const uint8_t* keyBuf) const
+{
+    // Operation does not modify the chain, removed nodes are skipped
+    std::atomic<uint64_t>* head = GetBucket(hashCode & m_bucketMask);
+    HashNode* curr = reinterpret_cast<HashNode*>(head->load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (!(next & HASH_NODE_REMOVED) && NodeMatches(curr, hashCode, keyBuf)) {
+            return curr;
+        }
+        curr = reinterpret_cast<HashNode*>(next & ~HASH_NODE_REMOVED);
+    }
+
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::NextNode(uint32_t& bucket, const HashNode* node) const
+{
+    HashNode* curr = nullptr;
+    if (node != nullptr) {
+        curr = reinterpret_cast<HashNode*>(node->m_next.load(std::memory_order_acquire) & ~HASH_NODE_REMOVED);
+    } else if (bucket < m_bucketCount) {
+        curr = reinterpret_cast<HashNode*>(GetBucket(bucket)->load(std::memory_order_acquire));
+    }
+
+    for (;;) {
+        while (curr != nullptr) {
+            uint64_t next = curr->m_next.load(std::memory_order_acquire);
+            if (!(next & HASH_NODE_REMOVED)) {
+                return curr;
+            }
+            curr = reinterpret_cast<HashNode*>(next & ~HASH_NODE_REMOVED);
+        }
+
+        if (++bucket >= m_bucketCount) {
+            return nullptr;
+        }
+        curr = reinterpret_cast<HashNode*>(GetBucket(bucket)->load(std::memory_order_acquire));
+    }
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    gcSession->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateFromPoolCallBack, m_nodePool->m_size);
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hashCode = HashKey(keyBuf);
+    std::atomic<uint64_t>* head = GetBucket(hashCode & m_bucketMask);
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    HashNode* node = nullptr;
+
+    inserted = false;
+    for (;;) {
+        if (FindNode(head, hashCode, keyBuf, prev, curr)) {
+            // key mapping already exists in unique index
+            if (node != nullptr) {
+                m_nodePool->Release(node);
+            }
+            return curr->m_sentinel;
+        }
+
+        if (node == nullptr) {
+            node = m_nodePool->Alloc<HashNode>();
+            if (node == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash node");
+                return nullptr;
+            }
+            node->m_sentinel = sentinel;
+            node->m_hashCode = hashCode;
+            errno_t erc = memcpy_s(node->m_keyBuf, ALIGN8(m_keyLength), keyBuf, m_keyLength);
+            securec_check(erc, "\0", "\0");
+        }
+        node->m_next.store(0, std::memory_order_relaxed);
+
+        // append at the chain tail; fails if the tail was removed or another node was appended
+        uint64_t expected = 0;
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<uint64_t>(node), std::memory_order_acq_rel)) {
+            inserted = true;
+            return nullptr;
+        }
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    HashNode* node = LookupNode(HashKey(keyBuf), keyBuf);
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hashCode = HashKey(keyBuf);
+    std::atomic<uint64_t>* head = GetBucket(hashCode & m_bucketMask);
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+
+    for (;;) {
+        if (!FindNode(head, hashCode, keyBuf, prev, curr)) {
+            return nullptr;
+        }
+
+        // logical removal: mark the next pointer so no node can be appended after this one
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if ((next & HASH_NODE_REMOVED) ||
+            !curr->m_next.compare_exchange_strong(next, next | HASH_NODE_REMOVED, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        Sentinel* sentinel = curr->m_sentinel;
+
+        // physical removal, otherwise let the search unlink it
+        uint64_t expected = reinterpret_cast<uint64_t>(curr);
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+            RetireNode(curr);
+        } else {
+            (void)FindNode(head, hashCode, keyBuf, prev, curr);
+        }
+
+        return sentinel;
+    }
+}
+
+HashPrimaryIndex::HashIterator* HashPrimaryIndex::CreateIterator(bool pointQuery) const
+{
+    uint8_t* keyBuf = new (std::nothrow) uint8_t[sizeof(Key) + ALIGN8(m_keyLength)];
+    if (keyBuf == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to allocate iterator key");
+        return nullptr;
+    }
+
+    HashIterator* itr = new (std::nothrow) HashIterator(this, keyBuf, pointQuery);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create iterator");
+        delete[] keyBuf;
+        return nullptr;
+    }
+
+    return itr;
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t bucketBytes = sizeof(std::atomic<uint64_t>) * (uint64_t)m_bucketCount;
+    res += bucketBytes;
+    netto += bucketBytes;
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    HashIterator* itr = CreateIterator(false);
+    if (itr != nullptr) {
+        uint32_t bucket = 0;
+        HashNode* node = NextNode(bucket, nullptr);
+        itr->SetNode(bucket, node);
+    }
+
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashIterator* itr = CreateIterator(true);
+    if (itr == nullptr) {
+        found = false;
+        return nullptr;
+    }
+
+    // only exact-match lookups are supported, a range boundary search yields an invalid iterator
+    HashNode* node = nullptr;
+    if (matchKey) {
+        const uint8_t* keyBuf = key->GetKeyBuf();
+        node = LookupNode(HashKey(keyBuf), keyBuf);
+    }
+    found = (node != nullptr);
+    itr->SetNode(node);
+
+    return itr;
+}
+}  // namespace MOT
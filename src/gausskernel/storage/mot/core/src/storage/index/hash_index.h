@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a lock-free hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+#include "index.h"
+#include "index_base.h"
+#include "utilities.h"
+#include "mm_def.h"
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Primary index implementation using a lock-free hash table.
+ * @detail The table has a fixed number of buckets, each holding a lock-free linked list of nodes
+ * (Harris-Michael list, unordered). A node is logically removed by marking the low bit of its
+ * next pointer and is then unlinked by any thread passing by; unlinked nodes are handed over to
+ * the GC, so concurrent readers never touch reclaimed memory. The bucket array is split in
+ * equal segments, one per NUMA node, and nodes are allocated from the inserting thread's local
+ * NUMA node. The index supports unique keys and exact-match lookups only. Iteration from
+ * @ref Begin() visits all keys in no particular order.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A single key mapping in a bucket chain.
+     */
+    struct HashNode {
+        /** @var The next node in the chain. The low bit marks this node as removed. */
+        std::atomic<uint64_t> m_next;
+
+        /** @var The sentinel mapped by the key. */
+        Sentinel* m_sentinel;
+
+        /** @var The hash code of the key. */
+        uint64_t m_hashCode;
+
+        /** @var The key buffer (index key length, aligned to 8 bytes). */
+        uint8_t m_keyBuf[0];
+    };
+
+    /** @var Mark bit of a removed node. */
+    static constexpr uint64_t HASH_NODE_REMOVED = 0x1;
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator implementation for a primary hash index. An iterator returned by
+     * @ref Search() is a point iterator, which becomes invalid on the first call to @ref Next().
+     * An iterator returned by @ref Begin() visits all buckets.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param index The iterated index.
+         * @param keyBuf Buffer for the iterated key, owned by the iterator.
+         * @param pointQuery Specifies whether this is a point iterator.
+         */
+        HashIterator(const HashPrimaryIndex* index, uint8_t* keyBuf, bool pointQuery)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+              m_index(index),
+              m_keyBuf(keyBuf),
+              m_key(new (keyBuf) Key(index->GetKeyLength())),
+              m_node(nullptr),
+              m_bucket(0),
+              m_pointQuery(pointQuery)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            if (m_keyBuf != nullptr) {
+                m_key->~Key();
+                delete[] m_keyBuf;
+                m_keyBuf = nullptr;
+                m_key = nullptr;
+            }
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Queries whether this iterator is valid.
+         * @return True if the iterator is valid.
+         */
+        virtual bool IsValid() const
+        {
+            return m_node != nullptr;
+        }
+
+        /**
+         * @brief Invalidates the iterator such that subsequent calls to isValid() return false.
+         */
+        virtual void Invalidate()
+        {
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return m_key;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next()
+        {
+            if (m_pointQuery) {
+                m_node = nullptr;
+            } else {
+                SetNode(m_index->NextNode(m_bucket, m_node));
+            }
+        }
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Hash index iterators are not bidirectional.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+        /**
+         * @brief Positions the iterator on a node.
+         * @param node The node, or null to invalidate the iterator.
+         */
+        inline void SetNode(HashNode* node)
+        {
+            m_node = node;
+            if (node != nullptr) {
+                errno_t erc =
+                    memcpy_s(m_key->GetKeyBuf(), ALIGN8(m_key->GetKeyLength()), node->m_keyBuf, m_key->GetKeyLength());
+                securec_check(erc, "\0", "\0");
+            }
+        }
+
+        /**
+         * @brief Positions a full scan iterator on a node in a bucket.
+         * @param bucket The bucket of the node.
+         * @param node The node, or null to invalidate the iterator.
+         */
+        inline void SetNode(uint32_t bucket, HashNode* node)
+        {
+            m_bucket = bucket;
+            SetNode(node);
+        }
+
+    private:
+        /** @var The iterated index. */
+        const HashPrimaryIndex* m_index;
+
+        /** @var The buffer holding the key object. */
+        uint8_t* m_keyBuf;
+
+        /** @var A copy of the currently iterated key. */
+        Key* m_key;
+
+        /** @var The currently iterated node. */
+        HashNode* m_node;
+
+        /** @var The bucket of the currently iterated node (full scan only). */
+        uint32_t m_bucket;
+
+        /** @var Specifies whether this is a point iterator. */
+        bool m_pointQuery;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_bucketCount(0),
+          m_bucketMask(0),
+          m_segmentCount(0),
+          m_segmentShift(0),
+          m_initialized(false)
+    {
+        for (uint32_t i = 0; i < MEM_MAX_NUMA_NODES; ++i) {
+            m_segments[i] = nullptr;
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        m_initialized = false;
+        DestroyPools();
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Destroy all memory pools and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyPools();
+
+        return IndexInitImpl(NULL);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for a key in the index.
+     * @detail Only exact-match lookups are supported. The resulting iterator is positioned on the
+     * key if it exists, and otherwise it is invalid.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocate memory from pools.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to allocated memory.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateFromPoolCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Memory pool for nodes. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Bucket array segments, one per NUMA node. */
+    std::atomic<uint64_t>* m_segments[MEM_MAX_NUMA_NODES];
+
+    /** @var The total number of buckets (power of two). */
+    uint32_t m_bucketCount;
+
+    /** @var Mask for computing a bucket from a hash code. */
+    uint32_t m_bucketMask;
+
+    /** @var The number of bucket array segments. */
+    uint32_t m_segmentCount;
+
+    /** @var Shift for computing the segment of a bucket. */
+    uint32_t m_segmentShift;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    /**
+     * @brief Init bucket array and node pool.
+     * @return True if succeeded otherwise false.
+     * @note In case of failure it is the responsibility of the caller to call @ref DestroyPools().
+     */
+    bool InitPools();
+
+    /**
+     * @brief Destroy bucket array and node pool.
+     */
+    void DestroyPools();
+
+    /** @brief Computes the hash code of a key buffer. */
+    inline uint64_t HashKey(const uint8_t* keyBuf) const;
+
+    /** @brief Retrieves the head of the chain of a bucket. */
+    inline std::atomic<uint64_t>* GetBucket(uint32_t bucket) const
+    {
+        return &m_segments[bucket >> m_segmentShift][bucket & ((1U << m_segmentShift) - 1)];
+    }
+
+    /** @brief Queries whether a node holds the given key. */
+    inline bool NodeMatches(const HashNode* node, uint64_t hashCode, const uint8_t* keyBuf) const
+    {
+        return (node->m_hashCode == hashCode) && (memcmp(node->m_keyBuf, keyBuf, m_keyLength) == 0);
+    }
+
+    /**
+     * @brief Searches a bucket chain for a key, unlinking any removed node on the way.
+     * @param head The head of the bucket chain.
+     * @param hashCode The hash code of the key.
+     * @param keyBuf The key buffer.
+     * @param[out] prev The link pointing to the resulting node (or the chain tail if not found).
+     * @param[out] curr The node holding the key, or null if not found.
+     * @return True if the key was found.
+     */
+    bool FindNode(std::atomic<uint64_t>* head, uint64_t hashCode, const uint8_t* keyBuf,
+        std::atomic<uint64_t>*& prev, HashNode*& curr);
+
+    /**
+     * @brief Searches a bucket chain for a key without modifying the chain.
+     * @return The node holding the key, or null if not found.
+     */
+    HashNode* LookupNode(uint64_t hashCode, const uint8_t* keyBuf) const;
+
+    /**
+     * @brief Retrieves the next live node in a full scan order.
+     * @param[in,out] bucket The bucket of the current node, updated to the bucket of the result.
+     * @param node The current node, or null to start scanning at the given bucket.
+     * @return The next node, or null if the scan is done.
+     */
+    HashNode* NextNode(uint32_t& bucket, const HashNode* node) const;
+
+    /** @brief Hands an unlinked node over to the GC. */
+    void RetireNode(HashNode* node);
+
+    /** @brief Allocates an iterator with its own key buffer. */
+    HashIterator* CreateIterator(bool pointQuery) const;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -112,6 +112,46 @@ extern size_t ReadFile(int fd, char* data, size_t len)
     return (size_t)bytesRead;
 }
 
+extern bool ReadFileFully(int fd, char* data, size_t len)
+{
+    size_t total = 0;
+    while (total < len) {
+        ssize_t bytesRead = read(fd, (void*)(data + total), len - total);
+        if (bytesRead == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MOT_REPORT_SYSTEM_ERROR(read,
+                "N/A",
+                "Failed to read %u bytes into %p from file descriptor %d",
+                (unsigned)(len - total),
+                data + total,
+                fd);
+            return false;
+        }
+        if (bytesRead == 0) {
+            MOT_LOG_ERROR("Premature end of file descriptor %d: read %u bytes out of %u",
+                fd,
+                (unsigned)total,
+                (unsigned)len);
+            return false;
+        }
+        total += (size_t)bytesRead;
+    }
+    return true;
+}
+
+extern bool GetFileSize(int fd, uint64_t& size)
+{
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        MOT_REPORT_SYSTEM_ERROR(fstat, "N/A", "Failed to get the size of file descriptor %d", fd);
+        return false;
+    }
+    size = (uint64_t)fileStat.st_size;
+    return true;
+}
+
 extern int FlushFile(int fd)
 {
     int rc = fdatasync(fd);
@@ -102,6 +102,23 @@ extern size_t WriteFile(int fd, char* data, size_t len);
  */
 extern size_t ReadFile(int fd, char* data, size_t len);
 
+/**
+ * @brief Reads exactly len bytes from a file fd, retrying on short reads.
+ * @param fd The file descriptor to read from.
+ * @param data A pointer to the data buffer to read to.
+ * @param len The number of bytes to read
+ * @return Boolean value denoting success or failure (error or premature end of file).
+ */
+extern bool ReadFileFully(int fd, char* data, size_t len);
+
+/**
+ * @brief A wrapper function that retrieves the size of a file fd.
+ * @param fd The file descriptor to query.
+ * @param[out] size The size of the file in bytes.
+ * @return Boolean value denoting success or failure.
+ */
+extern bool GetFileSize(int fd, uint64_t& size);
+
 /**
  * @brief A wrapper function that flushes a file fd.
  * @param fd The file descriptor to flush.
@@ -179,6 +179,9 @@ constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr uint32_t MOTConfiguration::DEFAULT_HASH_INDEX_BUCKETS;
+constexpr uint32_t MOTConfiguration::MIN_HASH_INDEX_BUCKETS;
+constexpr uint32_t MOTConfiguration::MAX_HASH_INDEX_BUCKETS;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -505,6 +508,7 @@ MOTConfiguration::MOTConfiguration()
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_hashIndexBuckets(DEFAULT_HASH_INDEX_BUCKETS),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_totalMemoryMb(DEFAULT_TOTAL_MEMORY_MB),
@@ -604,6 +608,7 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseUint32(name, "hash_index_buckets", value, &m_hashIndexBuckets)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -1006,6 +1011,11 @@ void MOTConfiguration::LoadConfig()
         UPDATE_BOOL_CFG(
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
         UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
+        UPDATE_INT_CFG(m_hashIndexBuckets,
+            "hash_index_buckets",
+            DEFAULT_HASH_INDEX_BUCKETS,
+            MIN_HASH_INDEX_BUCKETS,
+            MAX_HASH_INDEX_BUCKETS);
     }
 
     // general configuration
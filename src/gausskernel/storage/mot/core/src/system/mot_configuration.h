@@ -364,6 +364,9 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var The number of buckets in each hash index. */
+    uint32_t m_hashIndexBuckets;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -678,6 +681,11 @@ public:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var The default number of buckets in each hash index. */
+    static constexpr uint32_t DEFAULT_HASH_INDEX_BUCKETS = 1048576;
+    static constexpr uint32_t MIN_HASH_INDEX_BUCKETS = 1024;
+    static constexpr uint32_t MAX_HASH_INDEX_BUCKETS = 1073741824;
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
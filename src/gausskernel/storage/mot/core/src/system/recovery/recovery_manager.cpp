@@ -30,6 +30,7 @@
 #include "checkpoint_utils.h"
 #include "checkpoint_manager.h"
 #include "spin_lock.h"
+#include "cycles.h"
 #include "transaction_buffer_iterator.h"
 #include "mot_engine.h"
 
@@ -176,14 +177,6 @@ bool RecoveryManager::GetTask(uint32_t& tableId, uint32_t& seg)
     return ret;
 }
 
-uint32_t RecoveryManager::HaveTasks()
-{
-    m_tasksLock.lock();
-    bool noMoreTasks = m_tasksList.empty();
-    m_tasksLock.unlock();
-    return !noMoreTasks;
-}
-
 bool RecoveryManager::RecoverTableMetadata(uint32_t tableId)
 {
     RC status = RC_OK;
@@ -235,93 +228,195 @@ bool RecoveryManager::RecoverTableMetadata(uint32_t tableId)
     return (status == RC_OK);
 }
 
-bool RecoveryManager::RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t tid, char* keyData, char* entryData,
-    uint64_t& maxCsn, SurrogateState& sState)
+RecoveryManager::RecoverySegment* RecoveryManager::LoadSegment(uint32_t tableId, uint32_t seg)
 {
-    RC status = RC_OK;
     int fd = -1;
-    Table* table = nullptr;
-
-    if (!GetRecoveryManager()->FetchTable(tableId, table)) {
-        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "RecoveryManager::recoverTableRows", "Table %llu does not exist", tableId);
-        return false;
-    }
-
     std::string fileName;
     CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
-        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to open file: %s", fileName.c_str());
-        return false;
+        MOT_LOG_ERROR("RecoveryManager::loadSegment: failed to open file: %s", fileName.c_str());
+        return nullptr;
     }
 
+    uint64_t fileSize = 0;
+    if (!CheckpointUtils::GetFileSize(fd, fileSize) || fileSize < sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("RecoveryManager::loadSegment: file: %s is too short (%lu bytes)", fileName.c_str(), fileSize);
+        CheckpointUtils::CloseFile(fd);
+        return nullptr;
+    }
+
+    RecoverySegment* segment = new (std::nothrow) RecoverySegment();
+    if (segment == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Recovery Manager Load Segment", "Failed to allocate segment object");
+        CheckpointUtils::CloseFile(fd);
+        return nullptr;
+    }
+    segment->m_id = tableId;
+    segment->m_seg = seg;
+    segment->m_dataLen = fileSize - sizeof(CheckpointUtils::FileHeader);
+    segment->m_data = nullptr;
+
     CheckpointUtils::FileHeader fileHeader;
-    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader));
-    if (reader != sizeof(CheckpointUtils::FileHeader)) {
-        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read file header, reader %lu", reader);
+    if (!CheckpointUtils::ReadFileFully(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader))) {
+        MOT_LOG_ERROR("RecoveryManager::loadSegment: failed to read file header: %s", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
-        return false;
+        FreeSegment(segment);
+        return nullptr;
     }
 
     if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
-        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: file: %s is corrupted", fileName.c_str());
+        MOT_LOG_ERROR("RecoveryManager::loadSegment: file: %s is corrupted", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
+        FreeSegment(segment);
+        return nullptr;
+    }
+    segment->m_exId = fileHeader.m_exId;
+    segment->m_numOps = fileHeader.m_numOps;
+
+    if (segment->m_dataLen > 0) {
+        segment->m_data = (char*)malloc(segment->m_dataLen);
+        if (segment->m_data == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Recovery Manager Load Segment",
+                "Failed to allocate %lu bytes for file: %s",
+                segment->m_dataLen,
+                fileName.c_str());
+            CheckpointUtils::CloseFile(fd);
+            FreeSegment(segment);
+            return nullptr;
+        }
+        if (!CheckpointUtils::ReadFileFully(fd, segment->m_data, segment->m_dataLen)) {
+            MOT_LOG_ERROR("RecoveryManager::loadSegment: failed to read file: %s", fileName.c_str());
+            CheckpointUtils::CloseFile(fd);
+            FreeSegment(segment);
+            return nullptr;
+        }
+    }
+
+    CheckpointUtils::CloseFile(fd);
+    return segment;
+}
+
+void RecoveryManager::FreeSegment(RecoverySegment* segment)
+{
+    if (segment->m_data != nullptr) {
+        free(segment->m_data);
+    }
+    delete segment;
+}
+
+bool RecoveryManager::PushSegment(RecoverySegment* segment)
+{
+    std::unique_lock<std::mutex> lock(m_segmentLock);
+    while (m_segmentQueue.size() >= m_maxQueuedSegments) {
+        if (m_checkpointWorkerStop) {
+            return false;
+        }
+        (void)m_segmentNotFull.wait_for(lock, std::chrono::milliseconds(SEGMENT_QUEUE_WAIT_MILLIS));
+    }
+    m_segmentQueue.push_back(segment);
+    m_segmentNotEmpty.notify_one();
+    return true;
+}
+
+RecoveryManager::RecoverySegment* RecoveryManager::PopSegment()
+{
+    std::unique_lock<std::mutex> lock(m_segmentLock);
+    while (m_segmentQueue.empty()) {
+        if (m_activeReaders == 0 || m_checkpointWorkerStop) {
+            return nullptr;
+        }
+        (void)m_segmentNotEmpty.wait_for(lock, std::chrono::milliseconds(SEGMENT_QUEUE_WAIT_MILLIS));
+    }
+    RecoverySegment* segment = m_segmentQueue.front();
+    m_segmentQueue.pop_front();
+    m_segmentNotFull.notify_one();
+    return segment;
+}
+
+void RecoveryManager::ClearSegmentQueue()
+{
+    std::lock_guard<std::mutex> lock(m_segmentLock);
+    while (!m_segmentQueue.empty()) {
+        FreeSegment(m_segmentQueue.front());
+        m_segmentQueue.pop_front();
+    }
+}
+
+void RecoveryManager::ReportCheckpointProgress(uint64_t startTime, bool isFinal)
+{
+    double seconds = CpuCyclesLevelTime::CyclesToSeconds(CpuCyclesLevelTime::Rdtsc() - startTime);
+    double megaBytes = (double)m_recoveredBytes / MEGA_BYTE;
+    double throughput = (seconds > 0.0) ? (megaBytes / seconds) : 0.0;
+    MOT_LOG_INFO("RecoverFromCheckpoint: %s %lu/%lu segments, %lu rows, %.2f MB in %.2f seconds (%.2f MB/sec)",
+        isFinal ? "recovered" : "progress",
+        (uint64_t)m_recoveredSegments,
+        m_totalSegments,
+        (uint64_t)m_recoveredRows,
+        megaBytes,
+        seconds,
+        throughput);
+}
+
+bool RecoveryManager::RecoverTableRows(RecoverySegment* segment, uint32_t tid, uint64_t& maxCsn, SurrogateState& sState)
+{
+    RC status = RC_OK;
+    Table* table = nullptr;
+    uint32_t tableId = segment->m_id;
+
+    if (!GetRecoveryManager()->FetchTable(tableId, table)) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "RecoveryManager::recoverTableRows", "Table %llu does not exist", tableId);
         return false;
     }
 
     uint64_t tableExId = table->GetTableExId();
-    if (tableExId != fileHeader.m_exId) {
-        MOT_LOG_ERROR(
-            "RecoveryManager::recoverTableRows: exId mismatch: my %lu - pkt %lu", tableExId, fileHeader.m_exId);
+    if (tableExId != segment->m_exId) {
+        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: exId mismatch: my %lu - pkt %lu", tableExId, segment->m_exId);
         return false;
     }
 
+    // rows are parsed in place from the loaded segment, key and row data are copied by InsertRowFromCheckpoint
     CheckpointUtils::EntryHeader entry;
-    for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
+    uint64_t offset = 0;
+    uint64_t rows = 0;
+    for (uint64_t i = 0; i < segment->m_numOps; i++) {
         if (IsRecoveryMemoryLimitReached(m_numWorkers)) {
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             status = RC_ERROR;
             break;
         }
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "RecoveryManager::recoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+        if (segment->m_dataLen - offset < sizeof(CheckpointUtils::EntryHeader)) {
+            MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read entry header (elem: %lu / %lu), "
+                          "offset %lu, size %lu",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                segment->m_numOps,
+                offset,
+                segment->m_dataLen);
             status = RC_ERROR;
             break;
         }
+        errno_t erc = memcpy_s(&entry,
+            sizeof(CheckpointUtils::EntryHeader),
+            segment->m_data + offset,
+            sizeof(CheckpointUtils::EntryHeader));
+        securec_check(erc, "\0", "\0");
+        offset += sizeof(CheckpointUtils::EntryHeader);
 
-        if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE) {
+        if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE ||
+            segment->m_dataLen - offset < (uint64_t)entry.m_keyLen + entry.m_dataLen) {
             MOT_LOG_ERROR("RecoveryManager::recoverTableRows: invalid entry (elem: %lu / %lu), keyLen %u, dataLen %u",
                 i,
-                fileHeader.m_numOps,
+                segment->m_numOps,
                 entry.m_keyLen,
                 entry.m_dataLen);
             status = RC_ERROR;
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
-            MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
-            break;
-        }
-
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
-            break;
-        }
+        char* keyData = segment->m_data + offset;
+        offset += entry.m_keyLen;
+        char* entryData = segment->m_data + offset;
+        offset += entry.m_dataLen;
 
         InsertRowFromCheckpoint(table,
             keyData,
@@ -341,19 +436,64 @@ bool RecoveryManager::RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t
         MOT_LOG_DEBUG("Inserted into table %u row with CSN %" PRIu64, tableId, entry.m_csn);
         if (entry.m_csn > maxCsn)
             maxCsn = entry.m_csn;
+        ++rows;
+    }
+
+    if (status == RC_OK && offset != segment->m_dataLen) {
+        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: table %u:%u has %lu bytes after its %lu entries, size %lu",
+            tableId,
+            segment->m_seg,
+            segment->m_dataLen - offset,
+            segment->m_numOps,
+            segment->m_dataLen);
+        status = RC_ERROR;
     }
-    CheckpointUtils::CloseFile(fd);
 
+    m_recoveredRows += rows;
+    m_recoveredBytes += offset;
     MOT_LOG_DEBUG("[%u] RecoveryManager::recoverTableRows table %u:%u, %lu rows recovered (%s)",
         tid,
         tableId,
-        seg,
-        fileHeader.m_numOps,
+        segment->m_seg,
+        rows,
         status == RC_OK ? "OK" : "Error");
 
     return (status == RC_OK);
 }
 
+void RecoveryManager::CpReaderFunc()
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+    MOT_LOG_DEBUG("RecoveryManager::readerFunc start on cpu %lu", sched_getcpu());
+
+    while (GetRecoveryManager()->GetCheckpointWorkerStop() == false) {
+        uint32_t tableId = 0;
+        uint32_t seg = 0;
+        if (!GetTask(tableId, seg)) {
+            break;
+        }
+        RecoverySegment* segment = LoadSegment(tableId, seg);
+        if (segment == nullptr) {
+            MOT_LOG_ERROR("RecoveryManager::readerFunc failed to load segment %u of table %u", seg, tableId);
+            GetRecoveryManager()->OnError(MOT::RecoveryManager::ErrCodes::CP_RECOVERY,
+                "RecoveryManager::readerFunc failed to read table: ",
+                std::to_string(tableId).c_str());
+            break;
+        }
+        if (!PushSegment(segment)) {
+            FreeSegment(segment);
+            break;
+        }
+    }
+
+    if (--m_activeReaders == 0) {
+        // wake up idle workers so they notice the end of input
+        std::lock_guard<std::mutex> lock(m_segmentLock);
+        m_segmentNotEmpty.notify_all();
+    }
+    MOT_LOG_DEBUG("RecoveryManager::readerFunc end on cpu %lu", sched_getcpu());
+}
+
 void RecoveryManager::CpWorkerFunc()
 {
     // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
@@ -373,45 +513,31 @@ void RecoveryManager::CpWorkerFunc()
     if (sState.IsValid() == false) {
         GetRecoveryManager()->OnError(MOT::RecoveryManager::ErrCodes::SURROGATE,
             "RecoveryManager::workerFunc failed to allocate surrogate state");
+        --m_activeWorkers;
         return;
     }
 
-    char* keyData = (char*)malloc(MAX_KEY_SIZE);
-    if (keyData == nullptr) {
-        GetRecoveryManager()->OnError(
-            MOT::RecoveryManager::ErrCodes::CP_RECOVERY, "RecoveryManager::workerFunc: failed to allocate key buffer");
-        return;
-    }
-
-    char* entryData = (char*)malloc(MAX_TUPLE_SIZE);
-    if (entryData == nullptr) {
-        GetRecoveryManager()->OnError(
-            MOT::RecoveryManager::ErrCodes::CP_RECOVERY, "RecoveryManager::workerFunc: failed to allocate row buffer");
-        free(keyData);
-        return;
-    }
     MOT_LOG_DEBUG("RecoveryManager::workerFunc start [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
 
     uint64_t maxCsn = 0;
     while (GetRecoveryManager()->GetCheckpointWorkerStop() == false) {
-        uint32_t tableId = 0;
-        uint32_t seg = 0;
-        if (GetTask(tableId, seg)) {
-            if (!RecoverTableRows(tableId, seg, MOTCurrThreadId, keyData, entryData, maxCsn, sState)) {
-                MOT_LOG_ERROR("RecoveryManager::workerFunc recovery of table %lu's data failed", tableId);
-                GetRecoveryManager()->OnError(MOT::RecoveryManager::ErrCodes::CP_RECOVERY,
-                    "RecoveryManager::workerFunc failed to recover table: ",
-                    std::to_string(tableId).c_str());
-                break;
-            }
-        } else {
+        RecoverySegment* segment = PopSegment();
+        if (segment == nullptr) {
+            break;
+        }
+        uint32_t tableId = segment->m_id;
+        bool recovered = RecoverTableRows(segment, MOTCurrThreadId, maxCsn, sState);
+        FreeSegment(segment);
+        if (!recovered) {
+            MOT_LOG_ERROR("RecoveryManager::workerFunc recovery of table %lu's data failed", tableId);
+            GetRecoveryManager()->OnError(MOT::RecoveryManager::ErrCodes::CP_RECOVERY,
+                "RecoveryManager::workerFunc failed to recover table: ",
+                std::to_string(tableId).c_str());
             break;
         }
+        ++m_recoveredSegments;
     }
 
-    free(keyData);
-    free(entryData);
-
     GetRecoveryManager()->SetCsnIfGreater(maxCsn);
     if (!sState.IsEmpty()) {
         GetRecoveryManager()->AddSurrogateArrayToList(sState);
@@ -419,6 +545,7 @@ void RecoveryManager::CpWorkerFunc()
 
     GetSessionManager()->DestroySessionContext(sessionContext);
     engine->OnCurrentThreadEnding();
+    --m_activeWorkers;
     MOT_LOG_DEBUG("RecoveryManager::workerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
 }
 
@@ -497,14 +624,37 @@ bool RecoveryManager::RecoverFromCheckpoint()
         }
     }
 
+    // readers load segment files into memory while workers insert the rows of already loaded segments
+    m_numReaders = (m_numWorkers + WORKERS_PER_CHECKPOINT_READER - 1) / WORKERS_PER_CHECKPOINT_READER;
+    m_maxQueuedSegments = m_numWorkers * QUEUED_SEGMENTS_PER_WORKER;
+    m_totalSegments = m_tasksList.size();
+    m_recoveredSegments = 0;
+    m_recoveredRows = 0;
+    m_recoveredBytes = 0;
+    m_activeReaders = m_numReaders;
+    m_activeWorkers = m_numWorkers;
+    MOT_LOG_INFO("RecoverFromCheckpoint: recovering %lu segments using %u readers and %u workers",
+        m_totalSegments,
+        m_numReaders,
+        m_numWorkers);
+
+    uint64_t startTime = CpuCyclesLevelTime::Rdtsc();
     std::vector<std::thread> recoveryThreadPool;
+    for (uint32_t i = 0; i < m_numReaders; ++i) {
+        recoveryThreadPool.push_back(std::thread(&RecoveryManager::CpReaderFunc, this));
+    }
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         recoveryThreadPool.push_back(std::thread(&RecoveryManager::CpWorkerFunc, this));
     }
 
     MOT_LOG_DEBUG("RecoveryManager:: waiting for all tasks to finish");
-    while (HaveTasks() && m_checkpointWorkerStop == false) {
+    uint32_t secondsSinceReport = 0;
+    while (m_activeWorkers > 0 && m_checkpointWorkerStop == false) {
         sleep(1);
+        if (++secondsSinceReport == CHECKPOINT_PROGRESS_INTERVAL_SECONDS) {
+            ReportCheckpointProgress(startTime, false);
+            secondsSinceReport = 0;
+        }
     }
 
     MOT_LOG_DEBUG("RecoveryManager:: tasks finished (%s)", m_errorSet ? "error" : "ok");
@@ -513,6 +663,8 @@ bool RecoveryManager::RecoverFromCheckpoint()
             worker.join();
         }
     }
+    ClearSegmentQueue();
+    ReportCheckpointProgress(startTime, true);
 
     if (m_errorSet) {
         MOT_LOG_ERROR("RecoveryManager:: failed to recover from checkpoint, tasks finished with error");
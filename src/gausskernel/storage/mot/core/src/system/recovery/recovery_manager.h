@@ -27,6 +27,7 @@
 
 #include <set>
 #include <vector>
+#include <condition_variable>
 #include "checkpoint_ctrlfile.h"
 #include "redo_log_global.h"
 #include "transaction_buffer_iterator.h"
@@ -171,6 +172,32 @@ private:
         uint32_t m_maxSegments;
     };
 
+    /**
+     * @struct RecoverySegment
+     * @brief A checkpoint segment file that was loaded into memory
+     * by a reader and awaits a worker to insert its rows.
+     */
+    struct RecoverySegment {
+        uint32_t m_id;
+        uint32_t m_seg;
+        uint64_t m_exId;
+        uint64_t m_numOps;
+        char* m_data;
+        uint64_t m_dataLen;
+    };
+
+    /** @var The number of workers served by a single checkpoint reader. */
+    static constexpr uint32_t WORKERS_PER_CHECKPOINT_READER = 4;
+
+    /** @var The number of loaded segments that may wait in the queue per worker. */
+    static constexpr uint32_t QUEUED_SEGMENTS_PER_WORKER = 2;
+
+    /** @var Time in milliseconds a reader or worker waits on the segment queue before re-checking for errors. */
+    static constexpr uint32_t SEGMENT_QUEUE_WAIT_MILLIS = 100;
+
+    /** @var Interval in seconds between checkpoint recovery progress reports. */
+    static constexpr uint32_t CHECKPOINT_PROGRESS_INTERVAL_SECONDS = 10;
+
 public:
     RecoveryManager()
         : m_logStats(nullptr),
@@ -180,6 +207,14 @@ public:
           m_lsn(0),
           m_lastReplayLsn(0),
           m_numWorkers(GetGlobalConfiguration().m_checkpointRecoveryWorkers),
+          m_numReaders(0),
+          m_maxQueuedSegments(0),
+          m_activeReaders(0),
+          m_activeWorkers(0),
+          m_totalSegments(0),
+          m_recoveredSegments(0),
+          m_recoveredRows(0),
+          m_recoveredBytes(0),
           m_tid(0),
           m_maxRecoveredCsn(0),
           m_enableLogStats(GetGlobalConfiguration().m_enableLogRecoveryStats),
@@ -203,24 +238,72 @@ private:
     bool RecoverFromCheckpoint();
 
     /**
-     * @brief Implements the a checkpoint recovery worker
+     * @brief Implements a checkpoint recovery reader. Readers load whole
+     * segment files into memory and hand them over to the workers through
+     * the segment queue, so file I/O overlaps with row insertion.
+     */
+    void CpReaderFunc();
+
+    /**
+     * @brief Implements the a checkpoint recovery worker. Workers consume
+     * loaded segments from the segment queue and insert their rows.
      */
     void CpWorkerFunc();
 
     /**
-     * @brief Reads and inserts rows from a checkpoint file
-     * @param tableId The table id to recover.
-     * @param seg Segment file number to recover from.
+     * @brief Inserts the rows of a checkpoint segment that was loaded into memory
+     * @param segment The loaded segment to recover.
      * @param tid The current thread id
-     * @param keyData The key buffer to use.
-     * @param entryData The row buffer to use.
      * @param maxCsn The returned maxCsn encountered during the recovery.
      * @param sState Surrogate key state structure that will be filled
      * during the recovery
      * @return Boolean value denoting success or failure.
      */
-    bool RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t tid, char* keyData, char* entryData,
-        uint64_t& maxCsn, SurrogateState& sState);
+    bool RecoverTableRows(RecoverySegment* segment, uint32_t tid, uint64_t& maxCsn, SurrogateState& sState);
+
+    /**
+     * @brief Reads a whole checkpoint segment file into memory and
+     * validates its header.
+     * @param tableId The table id to load.
+     * @param seg Segment file number to load.
+     * @return The loaded segment, or nullptr on failure.
+     */
+    RecoverySegment* LoadSegment(uint32_t tableId, uint32_t seg);
+
+    /**
+     * @brief Frees a loaded segment and its data buffer.
+     * @param segment The segment to free.
+     */
+    static void FreeSegment(RecoverySegment* segment);
+
+    /**
+     * @brief Pushes a loaded segment into the segment queue, waiting while
+     * the queue is full.
+     * @param segment The segment to push.
+     * @return Boolean value denoting if the segment was queued, or false if
+     * recovery was stopped meanwhile.
+     */
+    bool PushSegment(RecoverySegment* segment);
+
+    /**
+     * @brief Pops a loaded segment from the segment queue, waiting while the
+     * queue is empty and readers are still active.
+     * @return The segment, or nullptr if there is no more input or recovery
+     * was stopped.
+     */
+    RecoverySegment* PopSegment();
+
+    /**
+     * @brief Frees all segments left in the segment queue.
+     */
+    void ClearSegmentQueue();
+
+    /**
+     * @brief Reports checkpoint recovery progress to the log.
+     * @param startTime The time in which the recovery of table rows started.
+     * @param isFinal Specifies whether this is the final summary.
+     */
+    void ReportCheckpointProgress(uint64_t startTime, bool isFinal);
 
     /**
      * @brief Reads and creates a table's defenition from a checkpoint
@@ -247,12 +330,6 @@ private:
      */
     int FillTasksFromMapFile();
 
-    /**
-     * @brief Checks if there are any more tasks left in the queue
-     * @return Int value where 0 means failure and 1 success
-     */
-    uint32_t HaveTasks();
-
     /**
      * @brief Recovers the in process two phase commit related transactions
      * from the checkpoint data file.
@@ -1070,6 +1147,30 @@ private:
 
     uint32_t m_numWorkers;
 
+    uint32_t m_numReaders;
+
+    uint32_t m_maxQueuedSegments;
+
+    std::list<RecoverySegment*> m_segmentQueue;
+
+    std::mutex m_segmentLock;
+
+    std::condition_variable m_segmentNotEmpty;
+
+    std::condition_variable m_segmentNotFull;
+
+    std::atomic<uint32_t> m_activeReaders;
+
+    std::atomic<uint32_t> m_activeWorkers;
+
+    uint64_t m_totalSegments;
+
+    std::atomic<uint64_t> m_recoveredSegments;
+
+    std::atomic<uint64_t> m_recoveredRows;
+
+    std::atomic<uint64_t> m_recoveredBytes;
+
     std::atomic<uint32_t> m_tid;
 
     std::atomic<uint64_t> m_maxRecoveredCsn;
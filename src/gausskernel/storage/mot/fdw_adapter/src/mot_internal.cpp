@@ -1588,8 +1588,21 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* index, ::TransactionId tid)
         // Use the default index tree flavor from configuration file
         indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
         flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+    } else if (strcmp(index->accessMethod, "hash") == 0) {
+        // Hash indexes serve exact-match lookups on the whole key, so they must be unique. The primary index
+        // is also used for full table scans and stays a tree index.
+        if (!index->unique || index->primary) {
+            ereport(ERROR,
+                (errmodule(MOD_MOT),
+                    errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("MOT supports HASH indexes only as unique secondary indexes")));
+            return MOT::RC_ERROR;
+        }
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+        flavor = DEFAULT_TREE_FLAVOR;
     } else {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+        ereport(ERROR,
+            (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE (btree or btree_art) or unique HASH only")));
         return MOT::RC_ERROR;
     }
 
@@ -2831,6 +2844,12 @@ inline double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash indexes can only serve a point lookup on the whole key
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH &&
+        !(m_end == -1 && m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT)) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
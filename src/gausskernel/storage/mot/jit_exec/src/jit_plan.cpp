@@ -243,6 +243,10 @@ public:
         // if no expression was collected, this is an invalid scan (we do not support full scans yet)
         int column_count = _index_op_count;
         if (_index_op_count == 0) {
+            if (_index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                MOT_LOG_TRACE("RangeScanExpressionCollector(): Disqualifying query - full scan on hash index");
+                return;
+            }
             MOT_LOG_TRACE("RangeScanExpressionCollector(): no expression was collected, assuming full scan");
             _index_scan->_scan_type = JIT_INDEX_SCAN_FULL;
             _index_scan->_column_count = 0;
@@ -301,6 +305,13 @@ public:
             }
         }
 
+        // hash indexes can only serve point queries
+        if ((scan_type != JIT_INDEX_SCAN_POINT) &&
+            (_index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH)) {
+            MOT_LOG_TRACE("RangeScanExpressionCollector(): Disqualifying query - range scan on hash index");
+            return;
+        }
+
         // final step: verify we have no holes in the columns according to the expected scan type
         if (!ScanHasHoles(scan_type)) {
             _index_scan->_scan_type = scan_type;
@@ -164,6 +164,7 @@ static char* _mdfd_segpath(const SMgrRelation reln, ForkNumber forknum, BlockNum
 static MdfdVec* _mdfd_openseg(SMgrRelation reln, ForkNumber forkno, BlockNumber segno, int oflags);
 static MdfdVec* _mdfd_getseg(
     SMgrRelation reln, ForkNumber forkno, BlockNumber blkno, bool skipFsync, ExtensionBehavior behavior);
+static MdfdVec* _mdfd_getseg_if_exists(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno);
 static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdVec* seg);
 
 /*
@@ -626,7 +627,19 @@ void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
     off_t seekpos;
     MdfdVec* v = NULL;
 
-    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    /*
+     * During recovery the block may belong to a file that is dropped or not
+     * created yet further on in the WAL, and _mdfd_getseg() would pad out
+     * missing segments.  A prefetch is only a hint, so skip it instead.
+     */
+    if (t_thrd.xlog_cxt.InRecovery) {
+        v = _mdfd_getseg_if_exists(reln, forknum, blocknum);
+        if (v == NULL) {
+            return;
+        }
+    } else {
+        v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    }
 
     seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
@@ -2214,7 +2227,38 @@ static MdfdVec* _mdfd_getseg(
     }
     return v;
 }
-    
+
+/*
+ *  _mdfd_getseg_if_exists() -- Find the segment of the relation holding the
+ *      specified block, without creating or padding out any segment.
+ *
+ * Returns NULL if the relation or the segment does not exist.
+ */
+static MdfdVec* _mdfd_getseg_if_exists(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno)
+{
+    MdfdVec* v = mdopen(reln, forknum, EXTENSION_RETURN_NULL);
+    BlockNumber targetseg;
+    BlockNumber nextsegno;
+
+    if (v == NULL) {
+        return NULL;
+    }
+
+    targetseg = blkno / ((BlockNumber)RELSEG_SIZE);
+    for (nextsegno = 1; nextsegno <= targetseg; nextsegno++) {
+        Assert(nextsegno == v->mdfd_segno + 1);
+
+        if (v->mdfd_chain == NULL) {
+            v->mdfd_chain = _mdfd_openseg(reln, forknum, nextsegno, 0);
+            if (v->mdfd_chain == NULL) {
+                return NULL;
+            }
+        }
+        v = v->mdfd_chain;
+    }
+    return v;
+}
+
 /*
  * Get number of blocks present in a single disk file
  */
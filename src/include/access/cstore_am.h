@@ -48,10 +48,12 @@ struct LoadCUDescCtl : public BaseObject {
     uint32 lastLoadNum;
     uint32 nextCUID;
     CUDesc *cuDescArray;
+    bool loadSketch; /* load CUDesc::cu_sketch too */
 
     LoadCUDescCtl(uint32 startCUID)
     {
         Reset(startCUID);
+        loadSketch = false;
         cuDescArray = (CUDesc *)palloc0(sizeof(CUDesc) * u_sess->attr.attr_storage.max_loaded_cudesc);
     }
 
@@ -80,6 +82,61 @@ struct LoadCUDescCtl : public BaseObject {
     }
 };
 
+/*
+ * Shared state of a parallel-aware CStoreScan below Gather.
+ * Every participant claims cuChunk CU IDs at a time from nextCUID until
+ * [startCUID, endCUID] is used up, so a participant that is done early keeps
+ * taking CUs instead of idling at the end of a fixed slice.
+ */
+typedef struct ParallelCStoreScanDescData {
+    int plan_node_id;              /* used by the workers to find their scan */
+    uint32 startCUID;              /* first CU ID of the scan */
+    uint32 endCUID;                /* last CU ID of the scan */
+    uint32 cuChunk;                /* CU IDs claimed at a time */
+    pg_atomic_uint32 nextCUID;     /* first CU ID not claimed yet */
+    pg_atomic_uint32 deltaClaimed; /* set by the participant scanning the delta table */
+} ParallelCStoreScanDescData;
+
+typedef ParallelCStoreScanDescData *ParallelCStoreScanDesc;
+
+/*
+ * A qual clause "column op const" or "column op ANY (const array)" on a
+ * varlena column whose operator is immutable and strict.  On a dictionary
+ * encoded CU it is evaluated once per dictionary item instead of once per
+ * row, see CStore::FillDictFilterSel().
+ */
+typedef struct CStoreDictClause {
+    FmgrInfo opFunc;   /* operator function */
+    Oid collation;     /* input collation of the operator */
+    bool varOnLeft;    /* the column is the left argument */
+    int nconsts;       /* 1 for OpExpr, the not-null array elements for ANY */
+    Datum *consts;
+} CStoreDictClause;
+
+/* The dictionary filter of one column: the AND of its clauses */
+typedef struct CStoreDictFilter {
+    AttrNumber attno;          /* column of the clauses */
+    int nclauses;
+    CStoreDictClause *clauses;
+
+    /* result of the clauses for each row of the CU last filtered */
+    uint32 cuId;               /* InValidCUID if none */
+    bool cuEncoded;            /* the CU has dictionary codes, else rowMatch is unset */
+    bool *rowMatch;            /* DefaultFullCUSize entries */
+} CStoreDictFilter;
+
+/*
+ * A qual clause "column = const" or "column = ANY (const array)" whose
+ * constants are looked for in the bloom filters of the CU sketches, see
+ * CStore::RoughCheckSketch().
+ */
+typedef struct CStoreSketchKey {
+    AttrNumber attno; /* column of the clause */
+    int seq;          /* index of the column in m_colId, set by SetSketchKeys */
+    int nhashes;      /* CUSketchHashValue() of the not-null constants */
+    uint32 *hashes;
+} CStoreSketchKey;
+
 struct CStoreScanState;
 typedef CStoreScanState *CStoreScanDesc;
 
@@ -162,6 +219,9 @@ public:
     // update cstore scan timing flag
     void SetTiming(CStoreScanState *state);
 
+    // limit the rows of CU read into one batch, at most BatchMaxSize
+    void SetBatchRows(int rows);
+
     // CStore scan : pass vector to VE.
     void ScanByTids(_in_ CStoreIndexScanState *state, _in_ VectorBatch *idxOut, _out_ VectorBatch *vbout);
     void CStoreScanWithCU(_in_ CStoreScanState *state, BatchCUData *tmpCUData, _in_ bool isVerify = false);
@@ -220,9 +280,27 @@ public:
     /* Set CU range for scan in redistribute. */
     void SetScanRange();
 
+    /* Parallel scan below Gather: share the CU range of this scan, or scan a shared one. */
+    void InitParallelScanDesc(ParallelCStoreScanDesc pscan, int nparticipants) const;
+    void SetParallelScan(ParallelCStoreScanDesc pscan);
+
+    /*
+     * Quals evaluated per dictionary item while the batch is filled. The
+     * selection of the last batch filled is NULL if some CU of it could not
+     * be filtered that way.
+     */
+    bool SetDictFilters(List *filters);
+    const bool *GetDictFilterSel() const;
+
+    /* Equality quals probed against the CU sketches during rough check. */
+    bool SetSketchKeys(List *keys);
+
     // Judge whether dead row
     bool IsDeadRow(uint32 cuid, uint32 row) const;
 
+    // Rows of the current CU the next batch covers
+    int LeftRowsInBatch(const CUDesc *cuDescPtr) const;
+
     void CUListPrefetch();
     void CUPrefetch(CUDesc *cudesc, int col, AioDispatchCUDesc_t **dList, int &count, File *vfdList);
 
@@ -246,6 +324,8 @@ private:  // private methods.
     // if we load all CUDesc once, the memory will not enough.
     // So we load CUdesc once for max_loaded_cudesc
     void LoadCUDescIfNeed();
+    void LoadCUDescBatch(int32 cudesc_idx);
+    bool ClaimParallelCURange();
 
     // Do RoughCheck if need
     // elimiate CU by min/max value of CU.
@@ -273,9 +353,16 @@ private:  // private methods.
     bool NeedLoadCUDesc(int32 &cudesc_idx);
     void IncLoadCuDescIdx(int &idx) const;
     bool RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
+    bool RoughCheckRuntimeFilter(CStoreScanState *state, int cuDescIdx);
+    bool RoughCheckSketch(int cuDescIdx);
 
     void FillColMinMax(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
 
+    template <bool hasDeadRow>
+    void FillDictFilterSel(CStoreDictFilter *filter, CUDesc *cuDescPtr, CU *cuPtr, int leftRows);
+    void BuildDictFilterRows(CStoreDictFilter *filter, CUDesc *cuDescPtr, CU *cuPtr);
+    void ResetDictFilters();
+
     inline TransactionId GetCUXmin(uint32 cuid);
 
     // only called by GetCUData()
@@ -370,11 +457,27 @@ private:
     int m_cursor;
     int m_rowCursorInCU;
 
+    // rows of a CU read into one batch, dead rows included
+    int m_batchRows;
+
     uint32 m_startCUID; /* scan start CU ID. */
     uint32 m_endCUID;   /* scan end CU ID. */
 
+    ParallelCStoreScanDesc m_parallelScan; /* shared CU cursor of a parallel scan, or NULL */
+    uint32 m_claimEndCUID;                 /* last CU ID of the range claimed from it, 0 if none */
+
     unsigned char m_cuDelMask[MaxDelBitmapSize];
 
+    // dictionary filters indexed like m_colId, NULL if the column has none,
+    // and the selection they computed for the batch being filled
+    CStoreDictFilter **m_dictFilters;
+    bool *m_dictSel;
+    bool m_dictSelValid;
+    MemoryContext m_dictFilterCxt;
+
+    // list of CStoreSketchKey, NIL if no qual probes the CU sketches
+    List *m_sketchKeys;
+
     // whether dead rows exist
     bool m_hasDeadRow;
     // Is need do rough check
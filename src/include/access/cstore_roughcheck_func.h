@@ -30,9 +30,11 @@
 #include "knl/knl_variable.h"
 #include "access/cstoreskey.h"
 #include "storage/cu.h"
+#include "utils/bloom_filter.h"
 
 typedef bool (*RoughCheckFunc)(CUDesc *cudesc, Datum arg);
 
 RoughCheckFunc GetRoughCheckFunc(Oid typeOid, int strategy, Oid collation);
+bool RoughCheckRuntimeFilterCU(CUDesc *cudesc, Oid typeOid, filter::BloomFilter *bf);
 
 #endif /* CSTORE_ROUGHCHECK_FUNC_H */
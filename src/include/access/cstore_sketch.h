@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * cstore_sketch.h
+ *        Bloom filter and distinct count sketch of the values of one CU, kept
+ *        in the extra attribute of its CUDesc tuple when the table is created
+ *        WITH (cu_sketch = on).
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/access/cstore_sketch.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef CSTORE_SKETCH_H
+#define CSTORE_SKETCH_H
+
+#include "access/cstore_vector.h"
+#include "lib/hyperloglog.h"
+#include "utils/relcache.h"
+#include "utils/snapshot.h"
+
+/*
+ * A sketch is a text datum made of one CUSketchHeader, the arrSize bytes of
+ * a HyperLogLog state and bloomBits / 8 bytes of bloom filter.  Sketches of
+ * CUs whose values are too many distinct ones for CU_SKETCH_BLOOM_MAX_BITS
+ * keep the HyperLogLog only.
+ */
+#define CU_SKETCH_MAGIC 0x48534355 /* "UCSH" */
+#define CU_SKETCH_VERSION 1
+
+#define CU_SKETCH_HLL_BWIDTH 9 /* 512 registers, about 4.6% standard error */
+#define CU_SKETCH_BLOOM_MIN_BITS 512
+#define CU_SKETCH_BLOOM_MAX_BITS 32768 /* keeps the CUDesc tuple within a page */
+#define CU_SKETCH_BLOOM_BITS_PER_VALUE 10
+#define CU_SKETCH_BLOOM_MIN_BITS_PER_VALUE 5 /* below this the filter prunes too few CUs */
+#define CU_SKETCH_BLOOM_MAX_HASHES 8
+
+typedef struct CUSketchHeader {
+    uint32 magic;      /* CU_SKETCH_MAGIC */
+    uint16 version;    /* CU_SKETCH_VERSION */
+    uint8 hllWidth;    /* register width of the HyperLogLog */
+    uint8 bloomHashes; /* hash functions of the bloom filter, 0 if there is none */
+    uint32 bloomBits;  /* bits of the bloom filter, a power of 2 */
+    uint32 nvalues;    /* not-null values the sketch was built from */
+} CUSketchHeader;
+
+extern bool CUSketchTypeSupported(Oid typeOid);
+extern uint32 CUSketchHashValue(Oid typeOid, Datum value);
+extern text* CUSketchBuild(Oid typeOid, bulkload_vector* vector, int rows);
+extern bool CUSketchMayContain(const text* sketch, const uint32* hashes, int nhashes);
+extern bool CUSketchEstimateDistinct(Relation rel, AttrNumber attnum, Snapshot snapshot, double* ndistinct);
+
+#endif /* CSTORE_SKETCH_H */
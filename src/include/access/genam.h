@@ -81,6 +81,7 @@ typedef bool (*IndexBulkDeleteCallback)(ItemPointer itemptr, void* state, Oid pa
 /* struct definitions appear in relscan.h */
 typedef struct IndexScanDescData* IndexScanDesc;
 typedef struct SysScanDescData* SysScanDesc;
+typedef struct ParallelIndexScanDescData* ParallelIndexScanDesc;
 
 /*
  * Enumeration specifying the type of uniqueness check to perform in
@@ -128,6 +129,11 @@ extern bool index_insert(Relation indexRelation, Datum* values, const bool* isnu
 extern IndexScanDesc index_beginscan(
     Relation heapRelation, Relation indexRelation, Snapshot snapshot, int nkeys, int norderbys);
 extern IndexScanDesc index_beginscan_bitmap(Relation indexRelation, Snapshot snapshot, int nkeys);
+extern Size index_parallelscan_estimate(Relation indexRelation);
+extern void index_parallelscan_initialize(
+    Relation heapRelation, Relation indexRelation, ParallelIndexScanDesc target);
+extern void index_parallelscan_attach(IndexScanDesc scan, ParallelIndexScanDesc pscan);
+extern void index_parallelrescan(IndexScanDesc scan);
 extern void index_rescan(IndexScanDesc scan, ScanKey keys, int nkeys, ScanKey orderbys, int norderbys);
 extern void index_endscan(IndexScanDesc scan);
 extern void index_markpos(IndexScanDesc scan);
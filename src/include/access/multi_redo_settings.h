@@ -30,6 +30,8 @@
 static const int MOST_FAST_RECOVERY_LIMIT = 20;
 static const int MAX_PARSE_WORKERS = 16;
 static const int MAX_REDO_WORKERS_PER_PARSE = 8;
+/* if you change MAX_RECOVERY_PREFETCH_WINDOW, remember to change recovery_prefetch_window in cluster_guc.conf */
+static const int MAX_RECOVERY_PREFETCH_WINDOW = 65536;
 
 
 
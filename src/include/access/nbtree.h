@@ -680,6 +680,12 @@ extern Datum btbulkdelete(PG_FUNCTION_ARGS);
 extern Datum btvacuumcleanup(PG_FUNCTION_ARGS);
 extern Datum btcanreturn(PG_FUNCTION_ARGS);
 extern Datum btoptions(PG_FUNCTION_ARGS);
+extern Size btestimateparallelscan(void);
+extern void btinitparallelscan(void* target);
+extern void btparallelrescan(IndexScanDesc scan);
+extern bool _bt_parallel_seize(IndexScanDesc scan, BlockNumber* pageno);
+extern void _bt_parallel_release(IndexScanDesc scan, BlockNumber scan_page);
+extern void _bt_parallel_done(IndexScanDesc scan);
 /* 
  * this is the interface of merge 2 or more index for btree index
  * we also have similar interfaces for other kind of indexes, like hash/gist/gin
@@ -64,9 +64,12 @@ extern const RedoStatsViewObj g_redoViewArr[REDO_VIEW_COL_SIZE];
 extern void redo_fill_redo_event();
 extern void redo_refresh_stats(uint64 speed);
 extern void redo_unlink_stats_file();
+extern void redo_reset_prefetch_stats();
+extern void redo_get_prefetch_info_text(char* info, uint32 max_info_len);
 
 static const uint64 US_TRANSFER_TO_S = (1000000);
 static const uint64 BYTES_TRANSFER_KBYTES = (1024);
+static const uint32 REDO_PREFETCH_INFO_BUFFER_SIZE = 128;
 
 WaitEventIO redo_get_event_type_by_wait_type(uint32 type);
 char* redo_get_name_by_wait_type(uint32 type);
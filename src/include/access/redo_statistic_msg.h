@@ -45,6 +45,15 @@ typedef enum RedoWaitStats {
     WAIT_REDO_NUM
 } RedoWaitStats;
 
+/* Data block prefetch during parallel recovery, see redo_prefetch.cpp */
+typedef struct RedoPrefetchStats {
+    uint64 hit;         /* block was already in shared buffers */
+    uint64 miss;        /* block was not in shared buffers, a read-ahead was issued */
+    uint64 skip_init;   /* redo restores or re-initializes the block without reading it */
+    uint64 skip_recent; /* block was prefetched a short while ago */
+    uint64 skip_window; /* too many prefetched blocks are not replayed yet */
+} RedoPrefetchStats;
+
 /* Redo statistics */
 typedef struct RedoStatsData {
     XLogRecPtr redo_start_ptr;
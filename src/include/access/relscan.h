@@ -42,6 +42,22 @@ typedef struct ParallelHeapScanDescData {
     char phs_snapshot_data[FLEXIBLE_ARRAY_MEMBER];
 } ParallelHeapScanDescData;
 
+/*
+ * Shared state for parallel index scan.
+ *
+ * Like the heap version, each participant keeps its own IndexScanDesc and
+ * all of them point to this structure.  The access method keeps its shared
+ * scan position right behind it, at ps_offset; only btree supports this.
+ */
+typedef struct ParallelIndexScanDescData {
+    int plan_node_id; /* used to identify speicific plan */
+    Oid ps_relid;     /* OID of the heap relation */
+    Oid ps_indexid;   /* OID of the index relation */
+    Size ps_offset;   /* offset of the access method specific state */
+} ParallelIndexScanDescData;
+
+#define ParallelIndexScanGetAMState(pscan) ((void*)((char*)(pscan) + (pscan)->ps_offset))
+
 /* ----------------------------------------------------------------
  *				 Scan State Information
  * ----------------------------------------------------------------
@@ -162,6 +178,8 @@ typedef struct IndexScanDescData {
     bool xactStartedInRecovery; /* prevents killing/seeing killed
                                  * tuples */
 
+    ParallelIndexScanDesc parallel_scan; /* parallel index scan information */
+
     /* index access method's private state */
     void* opaque; /* access-method-specific info */
 
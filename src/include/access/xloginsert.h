@@ -29,6 +29,13 @@
 #define XLR_NORMAL_MAX_BLOCK_ID 4
 #define XLR_NORMAL_RDATAS 20
 
+/*
+ * Highest value of wal_compression_level.  Level 0 compresses full-page
+ * images with plain LZ4, levels above it use LZ4 HC; both produce the same
+ * block format, so replay does not care which one was used.
+ */
+#define MAX_WAL_COMPRESSION_LEVEL 12
+
 /* flags for XLogRegisterBuffer */
 #define REGBUF_FORCE_IMAGE 0x01 /* force a full-page image */
 #define REGBUF_NO_IMAGE 0x02    /* don't take a full-page image */
@@ -82,7 +82,9 @@ typedef struct XLogRecordBlockHeader {
  * When wal_compression is enabled, a full page image which "hole" was
  * removed is additionally compressed using LZ4 compression algorithm.
  * This can reduce the WAL volume, but at some extra cost of CPU spent
- * on the compression during WAL logging.
+ * on the compression during WAL logging.  wal_compression_level > 0
+ * selects LZ4 HC, which trades more CPU for a smaller image; its output
+ * is an ordinary LZ4 block, so it needs no flag of its own.
  */
 typedef struct XLogRecordBlockImageHeader {
     union {
@@ -271,6 +271,10 @@ extern TupleTableSlot* ExecProject(ProjectionInfo* projInfo, ExprDoneCond* isDon
 extern TupleTableSlot* ExecScan(ScanState* node, ExecScanAccessMtd accessMtd, ExecScanRecheckMtd recheckMtd);
 extern void ExecAssignScanProjectionInfo(ScanState* node);
 extern void ExecScanReScan(ScanState* node);
+extern filter::BloomFilter* ExecGetRuntimeFilter(PlanState* node, int i);
+extern bool ExecRuntimeFilterMayMatch(filter::BloomFilter* bf, Datum value, Oid type_id);
+extern bool ExecRuntimeFilterRange(filter::BloomFilter* bf, int64* min_val, int64* max_val);
+extern bool ExecRuntimeFilterPassTuple(ScanState* node, TupleTableSlot* slot);
 
 /*
  * prototypes from functions in execTuples.c
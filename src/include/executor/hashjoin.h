@@ -16,6 +16,9 @@
 
 #include "nodes/execnodes.h"
 #include "storage/buffile.h"
+#include "storage/sharedfileset.h"
+#include "storage/shm_barrier.h"
+#include "utils/atomic.h"
 
 /* ----------------------------------------------------------------
  *				hash-join hash table structures
@@ -179,6 +182,88 @@ typedef struct HashJoinTableData {
     int64 maxMem;           /* batch auto spread mem */
     int spreadNum;          /* auto spread times */
     int64* spill_size;
+
+    /* shared state if this is a parallel-aware hash join, else NULL */
+    struct ParallelHashJoinState* parallel_state;
+    int participant;          /* index of this participant in parallel_state */
+    int outerFileParticipant; /* writer of the outer batch file being read */
+    int outerFileSeq;         /* and which of its files for the batch it is */
+    BufFile* overflowFile;    /* tuples of the current batch that did not fit */
 } HashJoinTableData;
 
+/* ----------------------------------------------------------------
+ *				parallel-aware hash join
+ *
+ * In a parallel-aware hash join all participants (the leader and each
+ * worker) build one hash table together and then probe it with their own
+ * share of the outer relation.  The bucket array and the tuples of the
+ * current batch live in shared memory contexts owned by the parallel
+ * context, and tuples are pushed onto buckets with compare-and-swap, so the
+ * build needs no locking.
+ *
+ * nbatch is first chosen when the shared state is set up, from the whole
+ * inner relation estimate and the combined work_mem of all participants.
+ * Tuples of later batches are written to shared BufFiles per batch and
+ * participant ("i<batch>.p<n>.<seq>" for the inner side, "o<batch>.p<n>.<seq>"
+ * for the outer side), so that any participant can load or probe any part
+ * of a batch later on.  A participant writes a new file whenever it has to
+ * add tuples to a batch after closing its previous file for that batch.
+ *
+ * If the tuples of the batch being loaded outgrow spaceAllowed, the ones
+ * that do not fit are kept aside in a private overflow file, and once the
+ * load is complete nbatch is doubled: the elected participant doubles it
+ * and empties the buckets, then every participant moves the tuples of its
+ * own chunks and its overflow file either back into the table or out to
+ * the file of their new batch.  This repeats until the batch fits, or until
+ * a split no longer moves any tuple out.  Tuples written to batch files
+ * under a smaller nbatch are moved on when their batch is loaded or probed,
+ * as in a serial hash join.
+ *
+ * Participants synchronize on build_barrier.  Phase 0 builds the hash table
+ * for batch 0 from the inner plan and phase 1 probes it with the outer plan,
+ * unless the table has to grow first, which takes three more phases per
+ * doubling.  Each later batch then takes three phases (plus any growth): the
+ * elected participant resets the table, everybody loads the inner batch
+ * files, and everybody probes with the outer batch files.  Batches that
+ * cannot produce any result are skipped by every participant in the same
+ * way, without touching the barrier.  The leader stops participating after
+ * batch 0 unless it is alone, because it also has to drain the workers'
+ * tuple queues and waiting for them at a barrier could deadlock.
+ * ----------------------------------------------------------------
+ */
+#define PHJ_PHASE_BUILD 0
+#define PHJ_PHASE_PROBE_FIRST 1
+
+typedef struct ParallelHashJoinState {
+    int plan_node_id;  /* plan node this state belongs to */
+    int nparticipants; /* max number of participants: workers + leader */
+    int nbuckets;      /* # buckets in the shared hash table */
+    int log2_nbuckets; /* its log2 */
+    int nbatch;        /* number of batches, doubled when a batch overflows */
+    bool growEnabled;  /* may nbatch still be doubled? */
+
+    Barrier build_barrier; /* synchronizes the phases described above */
+
+    struct HashJoinTupleData** buckets; /* shared bucket array */
+    MemoryContext hashCxt;              /* shared context holding the buckets */
+    MemoryContext batchCxt;             /* shared context for the current batch */
+
+    pg_atomic_uint64 totalTuples;   /* # tuples obtained from inner plan */
+    pg_atomic_uint32 nextInnerFile; /* next inner batch file to load */
+    pg_atomic_uint32 nextOuterFile; /* next outer batch file to probe */
+
+    Size spaceAllowed;             /* budget for the tuples of one batch */
+    pg_atomic_uint64 spaceUsed;    /* tuple chunks of the current batch */
+    pg_atomic_uint32 growBatches;  /* set when a tuple did not fit */
+    pg_atomic_uint64 ntuplesMoved; /* tuples the last doubling moved out */
+
+    /* # batch files written, indexed by batch * nparticipants + participant */
+    int* innerFileCount;
+    int* outerFileCount;
+
+    SharedFileSet fileset; /* batch files */
+} ParallelHashJoinState;
+
+#define PHJ_FILE_INDEX(pstate, batchno, participant) ((batchno) * (pstate)->nparticipants + (participant))
+
 #endif /* HASHJOIN_H */
@@ -14,6 +14,7 @@
 #ifndef NODEBITMAPHEAPSCAN_H
 #define NODEBITMAPHEAPSCAN_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern BitmapHeapScanState* ExecInitBitmapHeapScan(BitmapHeapScan* node, EState* estate, int eflags);
@@ -21,4 +22,9 @@ extern TupleTableSlot* ExecBitmapHeapScan(BitmapHeapScanState* node);
 extern void ExecEndBitmapHeapScan(BitmapHeapScanState* node);
 extern void ExecReScanBitmapHeapScan(BitmapHeapScanState* node);
 
+/* parallel scan support */
+extern void ExecBitmapHeapInitializeDSM(BitmapHeapScanState* node, ParallelContext* pcxt, int nodeid);
+extern void ExecBitmapHeapReInitializeDSM(BitmapHeapScanState* node, ParallelContext* pcxt);
+extern void ExecBitmapHeapInitializeWorker(BitmapHeapScanState* node, void* context);
+
 #endif /* NODEBITMAPHEAPSCAN_H */
@@ -27,9 +27,15 @@ extern void ExecEndHash(HashState* node);
 extern void ExecReScanHash(HashState* node);
 
 extern HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNulls);
+extern HashJoinTable ExecParallelHashTableCreate(
+    Hash* node, List* hashOperators, bool keepNulls, struct ParallelHashJoinState* pstate);
+extern void ExecParallelHashTableReset(struct ParallelHashJoinState* pstate);
+extern void ExecParallelHashIncreaseNumBatches(struct ParallelHashJoinState* pstate);
+extern uint64 ExecParallelHashRepartition(HashJoinTable hashtable);
 extern void ExecHashTableDestroy(HashJoinTable hashtable);
 extern void ExecHashTableInsert(HashJoinTable hashtable, TupleTableSlot* slot, uint32 hashvalue, int planid, int dop,
     Instrumentation* instrument = NULL);
+extern void ExecParallelHashTableInsert(HashJoinTable hashtable, TupleTableSlot* slot, uint32 hashvalue);
 extern bool ExecHashGetHashValue(HashJoinTable hashtable, ExprContext* econtext, List* hashkeys, bool outer_tuple,
     bool keep_nulls, uint32* hashvalue);
 extern void ExecHashGetBucketAndBatch(HashJoinTable hashtable, uint32 hashvalue, int* bucketno, int* batchno);
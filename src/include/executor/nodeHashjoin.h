@@ -14,6 +14,7 @@
 #ifndef NODEHASHJOIN_H
 #define NODEHASHJOIN_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 #include "storage/buffile.h"
 
@@ -24,5 +25,9 @@ extern void ExecReScanHashJoin(HashJoinState* node);
 extern void ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue, BufFile** fileptr);
 extern void ExecEarlyFreeHashJoin(HashJoinState* node);
 extern void ExecReSetHashJoin(HashJoinState* node);
+extern void ExecHashJoinInitializeDSM(HashJoinState* node, ParallelContext* pcxt, int nodeid);
+extern void ExecHashJoinInitializeWorker(HashJoinState* node, void* context);
+extern void ExecParallelHashJoinSaveTuple(
+    HashJoinTable hashtable, MinimalTuple tuple, uint32 hashvalue, int batchno, bool inner);
 
 #endif /* NODEHASHJOIN_H */
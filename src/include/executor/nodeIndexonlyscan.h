@@ -14,6 +14,7 @@
 #ifndef NODEINDEXONLYSCAN_H
 #define NODEINDEXONLYSCAN_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern IndexOnlyScanState* ExecInitIndexOnlyScan(IndexOnlyScan* node, EState* estate, int eflags);
@@ -23,4 +24,10 @@ extern void ExecIndexOnlyMarkPos(IndexOnlyScanState* node);
 extern void ExecIndexOnlyRestrPos(IndexOnlyScanState* node);
 extern void ExecReScanIndexOnlyScan(IndexOnlyScanState* node);
 extern void StoreIndexTuple(TupleTableSlot* slot, IndexTuple itup, TupleDesc itupdesc);
+
+/* parallel scan support */
+extern void ExecIndexOnlyScanEstimate(IndexOnlyScanState* node, ParallelContext* pcxt);
+extern void ExecIndexOnlyScanInitializeDSM(IndexOnlyScanState* node, ParallelContext* pcxt, int nodeid);
+extern void ExecIndexOnlyScanReInitializeDSM(IndexOnlyScanState* node, ParallelContext* pcxt);
+extern void ExecIndexOnlyScanInitializeWorker(IndexOnlyScanState* node, void* context);
 #endif /* NODEINDEXONLYSCAN_H */
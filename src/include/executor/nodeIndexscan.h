@@ -14,6 +14,8 @@
 #ifndef NODEINDEXSCAN_H
 #define NODEINDEXSCAN_H
 
+#include "access/genam.h"
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern IndexScanState* ExecInitIndexScan(IndexScan* node, EState* estate, int eflags);
@@ -23,6 +25,12 @@ extern void ExecIndexMarkPos(IndexScanState* node);
 extern void ExecIndexRestrPos(IndexScanState* node);
 extern void ExecReScanIndexScan(IndexScanState* node);
 
+/* parallel scan support */
+extern void ExecIndexScanEstimate(IndexScanState* node, ParallelContext* pcxt);
+extern void ExecIndexScanInitializeDSM(IndexScanState* node, ParallelContext* pcxt, int nodeid);
+extern void ExecIndexScanReInitializeDSM(IndexScanState* node, ParallelContext* pcxt);
+extern void ExecIndexScanInitializeWorker(IndexScanState* node, void* context);
+
 /*
  * These routines are exported to share code with nodeIndexonlyscan.c and
  * nodeBitmapIndexscan.c
@@ -35,5 +43,9 @@ extern bool ExecIndexEvalArrayKeys(ExprContext* econtext, IndexArrayKeyInfo* arr
 extern bool ExecIndexAdvanceArrayKeys(IndexArrayKeyInfo* arrayKeys, int numArrayKeys);
 extern void ExecInitPartitionForIndexScan(IndexScanState* indexstate, EState* estate);
 extern void ExecInitPartitionForIndexOnlyScan(IndexOnlyScanState* indexstate, EState* estate);
+extern ParallelIndexScanDesc ExecIndexInitParallelScan(
+    ScanState* node, Relation index, Size pscan_len, ParallelContext* pcxt, int nodeid);
+extern ParallelIndexScanDesc ExecIndexFindParallelScan(ScanState* node, void* context);
+extern void ExecIndexAttachParallelScan(AbsIdxScanDesc scandesc, ParallelIndexScanDesc piscan);
 
 #endif /* NODEINDEXSCAN_H */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * instr_histogram.h
+ *        log-linear histogram of response times, for percentiles
+ *
+ * Values below 2 * 2^LATENCY_HIST_SUB_BITS get a bucket each, every power of
+ * two above is split into 2^LATENCY_HIST_SUB_BITS buckets of equal width, so a
+ * percentile read from the histogram is within 1/16 of the exact one.  Values
+ * of 2^LATENCY_HIST_MAX_BITS and above all go to the last bucket.
+ *
+ * IDENTIFICATION
+ *        src/include/instruments/instr_histogram.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef INSTR_HISTOGRAM_H
+#define INSTR_HISTOGRAM_H
+
+#include "utils/atomic.h"
+
+#define LATENCY_HIST_SUB_BITS 3
+#define LATENCY_HIST_MAX_BITS 36 /* about 19 hours in microseconds */
+#define LATENCY_HIST_BUCKETS ((LATENCY_HIST_MAX_BITS - LATENCY_HIST_SUB_BITS + 1) << LATENCY_HIST_SUB_BITS)
+
+typedef struct LatencyHistogram {
+    pg_atomic_uint64 counts[LATENCY_HIST_BUCKETS];
+} LatencyHistogram;
+
+extern int LatencyHistogramBucket(int64 value);
+extern int64 LatencyHistogramBucketValue(int bucket);
+
+/* for a histogram many backends add to */
+extern void LatencyHistogramAdd(LatencyHistogram* hist, int64 value);
+/* for a histogram only the calling backend adds to */
+extern void LatencyHistogramAddLocal(LatencyHistogram* hist, int64 value);
+extern void LatencyHistogramReset(LatencyHistogram* hist);
+
+extern uint64 LatencyHistogramMerge(uint64* counts, const LatencyHistogram* hist);
+extern int64 LatencyHistogramPercentile(const uint64* counts, uint64 total, int percentile);
+
+/* per-backend response time histograms, merged by the percentile thread */
+extern void InitSqlRTHistograms(void);
+extern void pgstat_update_sql_rt_histogram(int64 rt);
+extern uint64 pgstat_fetch_sql_rt_histogram(uint64* counts);
+
+#endif
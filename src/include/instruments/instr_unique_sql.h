@@ -103,11 +103,16 @@ extern int GetUniqueSQLTrackType();
         A.t_blocks_hit = B.t_blocks_hit - C.t_blocks_hit;                \
     }
 
+/* most statements a session counts before adding them to the shared unique sql entry */
+#define UNIQUE_SQL_MAX_BATCH_SIZE 64
+
 #define IS_UNIQUE_SQL_TRACK_TOP ((IS_PGXC_COORDINATOR || IS_SINGLE_NODE) && GetUniqueSQLTrackType() == UNIQUE_SQL_TRACK_TOP)
 
 void InitUniqueSQL();
 void UpdateUniqueSQLStat(Query* query, const char* sql, int64 elapse_start_time,
     PgStat_TableCounts* agg_table_count = NULL, int64 timeInfo[] = NULL);
+void FlushUniqueSQLStat();
+void CheckUniqueSQLStatFlush();
 void ResetUniqueSQLString();
 
 void instr_unique_sql_register_hook();
@@ -49,9 +49,16 @@ typedef struct knl_instance_attr_common {
     bool Logging_collector;
     bool allowSystemTableMods;
     bool enable_thread_pool;
+    bool enable_thread_pool_stealing;
+    bool enable_thread_pool_latency_class;
+    bool enable_pgstat_shared_memory;
 	bool enable_global_plancache;
     int max_files_per_process;
+    int thread_pool_steal_remote_penalty;
+    int thread_pool_short_request_time;
+    int thread_pool_latency_class_aging;
     int pgstat_track_activity_query_size;
+    int pgstat_shared_memory_tables;
     int GtmHostPortArray[MAX_GTM_HOST_NUM];
     int MaxDataNodes;
     int max_changes_in_memory;
@@ -48,6 +48,7 @@ typedef struct knl_instance_attr_storage {
     bool enable_gtm_free;
     bool comm_cn_dn_logic_conn;
     bool enable_adio_function;
+    bool enable_io_uring;
     bool enable_access_server_directory;
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
@@ -58,6 +59,7 @@ typedef struct knl_instance_attr_storage {
     int DataQueueBufSize;
     int NBuffers;
     int cstore_buffers;
+    int cstore_compressed_cache_percent;
     int MaxSendSize;
     int max_prepared_xacts;
     int max_locks_per_xact;
@@ -75,11 +77,14 @@ typedef struct knl_instance_attr_storage {
     int max_recovery_parallelism;
     int recovery_parse_workers;
     int recovery_redo_workers_per_paser_worker;
+    int recovery_prefetch_window;
     int pagewriter_thread_num;
     int bgwriter_thread_num;
+    int io_uring_queue_depth;
     int real_recovery_parallelism;
     int batch_redo_num;
     int remote_read_mode;
+    int buffer_replacement_policy;
     int advance_xlog_file_num;
     int gtm_option;
     int max_keep_log_seg;
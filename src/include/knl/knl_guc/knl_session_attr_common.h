@@ -166,6 +166,7 @@ typedef struct knl_session_attr_common {
 
     /* instrumentation guc parameters */
     int instr_unique_sql_count;
+    int instr_unique_sql_batch_size;
     bool enable_instr_cpu_timer;
     int unique_sql_track_type;
     bool enable_instr_track_wait;
@@ -181,6 +182,7 @@ typedef struct knl_session_attr_common {
     int upgrade_mode;
     int wdr_snapshot_query_timeout;
     int dn_heartbeat_interval;
+    int session_latency_class;
 } knl_session_attr_common;
 
 #endif /* SRC_INCLUDE_KNL_KNL_SESSION_ATTR_COMMON_H_ */
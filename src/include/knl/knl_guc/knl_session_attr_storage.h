@@ -114,6 +114,7 @@ typedef struct knl_session_attr_storage {
     int checkpoint_flush_after;
     int CheckPointWaitTimeOut;
     int WalWriterDelay;
+    int wal_compression_level;
     int wal_sender_timeout;
     int CommitDelay;
     int partition_lock_upgrade_timeout;
@@ -163,6 +164,7 @@ typedef struct knl_session_attr_storage {
     char* ReplConnInfoArr[GUC_MAX_REPLNODE_NUM];
     char* PrimarySlotName;
     char* logging_module;
+    char* buffer_trace_directory;
     char* Inplace_upgrade_next_system_object_oids;
     int resource_track_log;
     int guc_synchronous_commit;
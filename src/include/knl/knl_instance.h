@@ -172,11 +172,16 @@ typedef struct knl_g_stat_context {
     /* unique sql */
     MemoryContext UniqueSqlContext;
     HTAB* UniqueSQLHashtbl;
+    bool unique_sql_elapse_hist; /* entries carry an elapse time histogram */
 
     /* user logon/logout stat */
     MemoryContext InstrUserContext;
     HTAB* InstrUserHTAB;
 
+    /* table statistics kept in shared memory, with enable_pgstat_shared_memory */
+    MemoryContext PgStatTabContext;
+    HTAB* PgStatTabHTAB;
+
     /* workload trx stat */
     HTAB* workload_info_hashtbl;
 
@@ -185,6 +190,7 @@ typedef struct knl_g_stat_context {
     volatile bool force_process;
     int64 RTPERCENTILE[NUM_PERCENTILE_COUNT];
     struct SqlRTInfoArray* sql_rt_info_array;
+    struct LatencyHistogram* sql_rt_histograms; /* one per backend id, see instr_histogram.cpp */
 
     /* Set at the following cases:
      1. the cluster occures ha action
@@ -396,6 +402,7 @@ typedef struct {
     RedoWaitInfo wait_info[WAIT_REDO_NUM];
     uint32 speed_according_seg;
     XLogRecPtr local_max_lsn;
+    RedoPrefetchStats prefetch;
 } RedoPerf;
 
 
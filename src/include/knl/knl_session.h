@@ -1235,6 +1235,8 @@ typedef struct knl_u_stat_context {
 
     struct HTAB* pgStatDBHash;
     struct TabStatusArray* pgStatTabList;
+    /* table entries copied from shared memory in this transaction */
+    struct HTAB* pgStatTabSnapshot;
 
     /*
      * BgWriter global statistics counters (unused in other processes).
@@ -1687,11 +1689,20 @@ typedef struct knl_u_unique_sql_context {
      * - is_top_unique_sql to false
      */
     bool is_top_unique_sql;
+
+    /*
+     * counters of unique sqls this session has not added to the shared
+     * entries yet, they are added every instr_unique_sql_batch_size
+     * statements and when the session goes idle, see FlushUniqueSQLStat
+     */
+    struct HTAB* pending_stat_hash;
+    TimestampTz pending_flush_time;
 } knl_u_unique_sql_context;
 
 typedef struct knl_u_percentile_context {
     struct SqlRTInfo* LocalsqlRT;
     int LocalCounter;
+    uint64* LastRTHistogram; /* merged response time histogram at the last calculation */
 } knl_u_percentile_context;
 
 typedef struct knl_u_user_login_context {
@@ -2035,6 +2046,7 @@ typedef struct knl_u_ext_fdw_context {
 
 /* Info need to pass from leader to worker */
 struct ParallelHeapScanDescData;
+struct ParallelIndexScanDescData;
 typedef uint64 XLogRecPtr;
 typedef struct ParallelQueryInfo {
     struct SharedExecutorInstrumentation *instrumentation;
@@ -2047,6 +2059,14 @@ typedef struct ParallelQueryInfo {
     int eflags;
     int pscan_num;
     ParallelHeapScanDescData **pscan;
+    int phj_num;
+    struct ParallelHashJoinState **phjstate;
+    int piscan_num;
+    ParallelIndexScanDescData **piscan;
+    int pbms_num;
+    struct ParallelBitmapHeapState **pbmstate;
+    int pcstore_num;
+    struct ParallelCStoreScanDescData **pcstore;
 } ParallelQueryInfo;
 
 struct BTShared;
@@ -2133,12 +2153,28 @@ enum knl_session_status {
     KNL_SESS_CLOSERAW,  // not initialize and
 };
 
+/* how the thread pool orders the session against others waiting for a worker */
+typedef enum {
+    SESSION_LATENCY_AUTO = 0, /* by how long the last request of the session took */
+    SESSION_LATENCY_SHORT,    /* served before long sessions */
+    SESSION_LATENCY_LONG
+} SessionLatencyClass;
+
 typedef struct knl_session_context {
     volatile knl_session_status status;
     Dlelem elem;
 
     ThreadId attachPid;
 
+    /* thread pool group whose listener owns the connection of this session */
+    class ThreadPoolGroup* thread_pool_group;
+    /* when the session was queued for a thread pool worker */
+    TimestampTz ready_time;
+    /* when a thread pool worker took the session up */
+    TimestampTz attach_time;
+    /* latency class the thread pool queues the session with, short or long */
+    SessionLatencyClass latency_class;
+
     MemoryContext top_mem_cxt;
     MemoryContext cache_mem_cxt;
     MemoryContext top_transaction_mem_cxt;
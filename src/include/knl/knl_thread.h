@@ -721,6 +721,8 @@ typedef struct knl_t_xlog_context {
     struct XLogwrtResult* LogwrtResult;
     bool needImmediateCkp;
     int redoItemIdx;
+    /* data block read-ahead of the dispatcher, see access/transam/redo_prefetch.cpp */
+    struct RedoPrefetcher* redo_prefetcher;
 
 #ifndef ENABLE_MULTIPLE_NODES
     /* redo RM_STANDBY_ID record committing csn's transaction id */
@@ -2322,6 +2324,10 @@ typedef struct knl_t_storage_context {
 
     /* Pointers to shared state */
     struct BufferStrategyControl* StrategyControl;
+    /* buffer access trace of this thread, see buf_trace.cpp */
+    struct BufferTraceState* buffer_trace;
+    /* NUMA partition hits and allocs not yet flushed, see freelist.cpp */
+    struct BufferPartitionCounts* buffer_partition_counts;
     /* remember global block slot in progress */
     CacheSlotId_t CacheBlockInProgressIO;
     CacheSlotId_t CacheBlockInProgressUncompress;
@@ -2474,6 +2480,9 @@ typedef struct knl_t_storage_context {
     /* reserve `1000' for thread-private file id */
     int max_userdatafiles;
 
+    /* io_uring of this thread, see storage/file/uring.cpp */
+    struct UringContext* uring_cxt;
+    bool uring_unavailable;
 } knl_t_storage_context;
 
 typedef struct knl_t_port_context {
@@ -65,6 +65,7 @@ public:
     void Remove(Dlelem* e);
     void AddTail(Dlelem* e);
     Dlelem* RemoveHead();
+    Dlelem* RemoveHeadIf(bool (*cond)(Dlelem* e, void* arg), void* arg);
     bool IsEmpty();
 
 private:
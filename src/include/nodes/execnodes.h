@@ -22,6 +22,7 @@
 #include "nodes/params.h"
 #include "nodes/plannodes.h"
 #include "storage/pagecompress.h"
+#include "storage/shm_condvar.h"
 #include "utils/bloom_filter.h"
 #include "utils/reltrigger.h"
 #include "utils/sortsupport.h"
@@ -1220,6 +1221,8 @@ typedef struct PlanState {
     bool ps_TupFromTlist;               /* state flag for processing set-valued functions in targetlist */
 
     bool vectorized;  // is vectorized?
+    bool vec_accept_sel; /* parent takes our batches in selection-vector mode */
+    int vec_batch_rows;  /* max rows per output batch, 0 means vector_batch_size */
 
     MemoryContext nodeContext; /* Memory Context for this Node */
 
@@ -1589,6 +1592,7 @@ typedef struct {
  *		RuntimeContext	   expr context for evaling runtime Skeys
  *		RelationDesc	   index relation descriptor
  *		ScanDesc		   index scan descriptor
+ *		PscanLen		   size of parallel index scan descriptor
  * ----------------
  */
 typedef struct IndexScanState {
@@ -1607,6 +1611,7 @@ typedef struct IndexScanState {
     List* iss_IndexPartitionList;
     LOCKMODE lockMode;
     Relation iss_CurrentIndexPartition;
+    Size iss_PscanLen;
 } IndexScanState;
 
 /* ----------------
@@ -1625,6 +1630,7 @@ typedef struct IndexScanState {
  *		ScanDesc		   index scan descriptor
  *		VMBuffer		   buffer in use for visibility map testing, if any
  *		HeapFetches		   number of tuples we were forced to fetch from heap
+ *		PscanLen		   size of parallel index-only scan descriptor
  * ----------------
  */
 typedef struct IndexOnlyScanState {
@@ -1645,6 +1651,7 @@ typedef struct IndexOnlyScanState {
     List* ioss_IndexPartitionList;
     LOCKMODE lockMode;
     Relation ioss_CurrentIndexPartition;
+    Size ioss_PscanLen;
 } IndexOnlyScanState;
 
 /* ----------------
@@ -1681,6 +1688,38 @@ typedef struct BitmapIndexScanState {
     Relation biss_CurrentIndexPartition;
 } BitmapIndexScanState;
 
+/* ----------------
+ *	 SharedBitmapState information
+ *
+ *		PBM_INITIAL			initial state
+ *		PBM_INPROGRESS		TIDBitmap creation is in progress
+ *		PBM_FINISHED		TIDBitmap creation is complete
+ * ----------------
+ */
+typedef enum {
+    PBM_INITIAL,
+    PBM_INPROGRESS,
+    PBM_FINISHED
+} SharedBitmapState;
+
+/* ----------------
+ *	 ParallelBitmapHeapState information
+ *
+ *		plan_node_id	   used to identify specific plan
+ *		bitmapCxt		   shared memory context holding the shared iteration state
+ *		cv				   protects state, and is signaled once it changes
+ *		state			   current state of the TIDBitmap
+ *		tbmiterator		   shared iteration state over the TIDBitmap
+ * ----------------
+ */
+typedef struct ParallelBitmapHeapState {
+    int plan_node_id;
+    MemoryContext bitmapCxt;
+    ShmConditionVariable cv;
+    SharedBitmapState state;
+    TBMSharedIteratorState* tbmiterator;
+} ParallelBitmapHeapState;
+
 /* ----------------
  *	 BitmapHeapScanState information
  *
@@ -1691,6 +1730,8 @@ typedef struct BitmapIndexScanState {
  *		prefetch_iterator  iterator for prefetching ahead of current page
  *		prefetch_pages	   # pages prefetch iterator is ahead of current
  *		prefetch_target    target prefetch distance
+ *		shared_tbmiterator	   shared iterator, in a parallel bitmap heap scan
+ *		pstate			   shared state for parallel bitmap scan
  * ----------------
  */
 typedef struct BitmapHeapScanState {
@@ -1703,6 +1744,8 @@ typedef struct BitmapHeapScanState {
     int prefetch_pages;
     int prefetch_target;
     GPIScanDesc gpi_scan;  /* global partition index scan use information */
+    TBMSharedIterator* shared_tbmiterator;
+    ParallelBitmapHeapState* pstate;
 } BitmapHeapScanState;
 
 /* ----------------
@@ -2083,6 +2126,9 @@ typedef struct HashJoinState {
     bool hj_OuterNotEmpty;
     bool hj_streamBothSides;
     bool hj_rebuildHashtable;
+    struct ParallelHashJoinState* hj_ParallelState; /* shared state for parallel-aware join */
+    bool hj_ParallelAttached;                       /* attached to hj_ParallelState's barrier? */
+    MemoryContext hj_BloomFilterCxt;                /* runtime bloom filters pushed to the outer side */
 } HashJoinState;
 
 /* ----------------------------------------------------------------
@@ -2484,7 +2530,8 @@ TupleTableSlot* ExecMakeTupleSlot(HeapTuple tuple, HeapScanDesc heapScan, TupleT
  */
 inline bool BitmapNodeNeedSwitchPartRel(BitmapHeapScanState* node)
 {
-    return tbm_is_global(node->tbm) && GPIScanCheckPartOid(node->gpi_scan, node->tbmres->partitionOid);
+    /* a parallel scan keeps no private bitmap, and never scans partitions */
+    return node->tbm != NULL && tbm_is_global(node->tbm) && GPIScanCheckPartOid(node->gpi_scan, node->tbmres->partitionOid);
 }
 
 extern bool reset_scan_qual(Relation currHeapRel, ScanState *node);
@@ -1117,6 +1117,7 @@ typedef struct Agg {
     bool is_sonichash;    /* allowed to use sonic hash routine or not */
     bool is_dummy;        /* just for coop analysis, if true, agg node does nothing */
     uint32 skew_optimize; /* skew optimize method for agg */
+    bool is_partial;      /* partial agg below a Gather, emits transition values */
 } Agg;
 
 /* ----------------
@@ -33,6 +33,10 @@ typedef struct TIDBitmap TIDBitmap;
 /* Likewise, TBMIterator is private */
 typedef struct TBMIterator TBMIterator;
 
+/* ... and so are the shared iteration state and its per-participant iterator */
+typedef struct TBMSharedIteratorState TBMSharedIteratorState;
+typedef struct TBMSharedIterator TBMSharedIterator;
+
 /* Result structure for tbm_iterate */
 typedef struct {
     BlockNumber blockno; /* page number containing tuples */
@@ -59,6 +63,10 @@ extern bool tbm_is_empty(const TIDBitmap* tbm);
 extern TBMIterator* tbm_begin_iterate(TIDBitmap* tbm);
 extern TBMIterateResult* tbm_iterate(TBMIterator* iterator);
 extern void tbm_end_iterate(TBMIterator* iterator);
+extern TBMSharedIteratorState* tbm_prepare_shared_iterate(TIDBitmap* tbm, MemoryContext mcxt);
+extern TBMSharedIterator* tbm_attach_shared_iterate(TBMSharedIteratorState* istate);
+extern TBMIterateResult* tbm_shared_iterate(TBMSharedIterator* iterator);
+extern void tbm_end_shared_iterate(TBMSharedIterator* iterator);
 extern bool tbm_is_global(const TIDBitmap* tbm);
 extern void tbm_set_global(TIDBitmap* tbm, bool isGlobal);
 #endif /* TIDBITMAP_H */
@@ -99,6 +99,7 @@ extern Plan* create_direct_righttree(
     PlannerInfo* root, Plan* subplan, List* distinctList, List* uniq_exprs, ExecNodes* target_exec_nodes);
 extern HashJoin* create_direct_hashjoin(
     PlannerInfo* root, Plan* outerPlan, Plan* innerPlan, List* tlist, List* joinClauses, JoinType joinType);
+extern Gather* make_gather(List* qptlist, List* qpqual, int nworkers, bool single_copy, Plan* subplan);
 extern BaseResult* make_result(PlannerInfo* root, List* tlist, Node* resconstantqual, Plan* subplan, List* qual = NIL);
 extern Material* make_material(Plan* lefttree, bool materialize_all = false);
 extern int find_node_in_targetlist(Node* node, List* targetlist);
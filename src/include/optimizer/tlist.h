@@ -18,6 +18,7 @@
 
 extern TargetEntry* tlist_member(Node* node, List* targetlist);
 extern TargetEntry* tlist_member_ignore_relabel(Node* node, List* targetlist);
+extern TargetEntry* tlist_member_split_aggref(Aggref* aggref, List* targetlist, bool* nested_agg);
 #ifdef STREAMPLAN
 extern TargetEntry* tlist_member_except_aggref(
     Node* node, List* targetlist, bool* nested_agg, bool* nested_relabeltype);
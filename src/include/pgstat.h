@@ -737,6 +737,24 @@ typedef struct PgStat_StatTabEntry {
     uint64 autovac_status;
 } PgStat_StatTabEntry;
 
+/* ----------
+ * PgStat_ShmTabEntry			A table entry of the shared memory hash that
+ *								replaces the collector's per-database table
+ *								hashes with enable_pgstat_shared_memory.
+ * ----------
+ */
+typedef struct PgStat_ShmTabKey {
+    Oid databaseid; /* InvalidOid for shared tables */
+    PgStat_StatTabKey tablekey;
+} PgStat_ShmTabKey;
+
+typedef struct PgStat_ShmTabEntry {
+    PgStat_ShmTabKey key; /* hash key (must be first) */
+    PgStat_StatTabEntry tabentry;
+} PgStat_ShmTabEntry;
+
+#define ENABLE_PGSTAT_SHARED_MEMORY (g_instance.attr.attr_common.enable_pgstat_shared_memory)
+
 /* ----------
  * PgStat_StatFuncEntry			The collector's data per function
  * ----------
@@ -1282,6 +1300,7 @@ extern Size BackendStatusShmemSize(void);
 extern void CreateSharedBackendStatus(void);
 
 extern void pgstat_init(void);
+extern void InitPgStatShmTab(void);
 extern ThreadId pgstat_start(void);
 extern void pgstat_reset_all(void);
 extern void allow_immediate_pgstat_restart(void);
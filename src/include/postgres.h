@@ -662,7 +662,14 @@ typedef Datum* DatumPtr;
 #define DatumGetInt64(X) (*((int64*)DatumGetPointer(X)))
 #endif
 
+/*
+ * BatchMaxSize is the compile-time capacity of a VectorBatch and of every
+ * per-batch array in the vector engine.  How many rows a plan node actually
+ * puts into a batch is chosen at run time (GUC vector_batch_size, possibly
+ * lowered per node), between VEC_MIN_BATCH_ROWS and BatchMaxSize.
+ */
 #define BatchMaxSize 1000
+#define VEC_MIN_BATCH_ROWS 16
 /*
  * Int64GetDatum
  *		Returns datum representation for a 64-bit integer.
@@ -92,6 +92,9 @@ typedef struct AioDispatchCUDesc {
     AioCUDesc_t cuDesc;
 } AioDispatchCUDesc_t;
 
+/* Completer callback to handle the AIO event */
+typedef int (*AioCallback_t)(void*, long);
+
 /* GUC options */
 extern int AioCompltrSets;
 extern int AioCompltrEvents;
@@ -100,6 +103,8 @@ extern void AioCompltrMain(int ac, char** av);
 extern void AioCompltrStop(int signal);
 extern int AioCompltrStart(void);
 extern bool AioCompltrIsReady(void);
+extern bool AioCompltrIsInline(void);
+extern AioCallback_t ComptrCallback(AioCompltrType reqType);
 extern io_context_t CompltrContext(AioCompltrType reqType, int h);
 extern short CompltrPriority(AioCompltrType reqType);
 
@@ -65,6 +65,7 @@ typedef struct BgWriterProc {
     int *cand_buf_list;   /* thread candidate buffer list */
     volatile int cand_list_size;     /* thread candidate list max size */
     volatile int buf_id_start;     /* buffer id start loc */
+    int numa_node;                 /* NUMA partition the range lies in, or -1 */
     pg_atomic_uint64 head;
     pg_atomic_uint64 tail;
     bool need_flush;
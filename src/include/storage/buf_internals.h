@@ -288,6 +288,23 @@ typedef struct CkptSortItem {
     int buf_id;
 } CkptSortItem;
 
+/*
+ * When the backends are bound to NUMA nodes (numa_distribute_mode = 'all'),
+ * the buffer pool is split into one contiguous partition per node, each with
+ * its own clock sweep hand and its own bgwriters. See freelist.cpp.
+ */
+#define MAX_BUFFER_PARTITIONS 16
+#define MIN_BUFFERS_PER_PARTITION 1024
+
+typedef struct BufferPartitionStatus {
+    int buf_id_start;     /* first buffer of the partition */
+    int buf_num;          /* number of buffers in the partition */
+    uint64 hits;          /* lookups that found a buffer of the partition */
+    uint64 remote_hits;   /* ... made from another NUMA node */
+    uint64 allocs;        /* victim buffers taken from the partition */
+    uint64 remote_allocs; /* ... for a backend on another NUMA node */
+} BufferPartitionStatus;
+
 const int NUM_BUFFER_FREE_LIST = 1031;
 
 typedef struct BufFreeListHash {
@@ -322,6 +339,16 @@ extern void StrategyNotifyBgWriter(int bgwprocno);
 extern Size StrategyShmemSize(void);
 extern void StrategyInitialize(bool init);
 
+extern int StrategyNumPartitions(void);
+extern void StrategyPartitionRange(int partition, int* buf_id_start, int* buf_num);
+extern int StrategyBufferPartition(int buf_id);
+extern int StrategyLocalPartition(void);
+extern void StrategyCountHit(int buf_id);
+extern void StrategyFlushCounts(void);
+extern void StrategyGetPartitionStatus(int partition, BufferPartitionStatus* status);
+extern uint32 StrategyInitialUsage(uint32 hashcode);
+extern void StrategyRecordEviction(BufferAccessStrategy strategy, uint32 hashcode);
+
 /* buf_table.c */
 extern Size BufTableShmemSize(int size);
 extern void InitBufTable(int size);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * buf_trace.h
+ *        Trace of shared buffer accesses, written by the backends when
+ *        buffer_trace_directory is set and replayed by contrib/buftrace_replay.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/storage/buf_trace.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef BUF_TRACE_H
+#define BUF_TRACE_H
+
+/*
+ * Every thread writes its own file "buftrace_<thread id>_<timestamp>.trc"
+ * made of one BufferTraceHeader followed by BufferTraceRecords, in the byte
+ * order of the server.
+ */
+#define BUFFER_TRACE_MAGIC 0x43525442 /* "BTRC" */
+#define BUFFER_TRACE_VERSION 1
+#define BUFFER_TRACE_FILE_PREFIX "buftrace_"
+#define BUFFER_TRACE_FILE_SUFFIX ".trc"
+
+typedef struct BufferTraceHeader {
+    uint32 magic;       /* BUFFER_TRACE_MAGIC */
+    uint32 version;     /* BUFFER_TRACE_VERSION */
+    uint32 record_size; /* sizeof(BufferTraceRecord) */
+    int32 nbuffers;     /* shared_buffers of the traced server */
+    int64 start_time;   /* TimestampTz the trace was started at */
+} BufferTraceHeader;
+
+/* flags of a BufferTraceRecord */
+#define BUFFER_TRACE_HIT 0x0001      /* the block was found in the pool */
+#define BUFFER_TRACE_STRATEGY 0x0002 /* read through a ring buffer strategy */
+
+typedef struct BufferTraceRecord {
+    uint32 spcNode;
+    uint32 dbNode;
+    uint32 relNode;
+    int32 bucketNode;
+    uint32 blockNum;
+    uint16 forkNum;
+    uint16 flags;
+} BufferTraceRecord;
+
+#ifndef FRONTEND
+
+#define BUFFER_TRACE_BATCH 256
+
+/* per-thread trace file, see buf_trace.cpp */
+typedef struct BufferTraceState {
+    int fd;                    /* -1 if the trace could not be written */
+    int nrecords;              /* records waiting in records[] */
+    char directory[MAXPGPATH]; /* buffer_trace_directory traced to, or "" */
+    BufferTraceRecord records[BUFFER_TRACE_BATCH];
+} BufferTraceState;
+
+#define BufferTraceEnabled()                                                        \
+    ((u_sess->attr.attr_storage.buffer_trace_directory != NULL &&                   \
+         u_sess->attr.attr_storage.buffer_trace_directory[0] != '\0') ||            \
+        (t_thrd.storage_cxt.buffer_trace != NULL &&                                 \
+            t_thrd.storage_cxt.buffer_trace->directory[0] != '\0'))
+
+extern void BufferTraceAccess(const RelFileNode* rnode, ForkNumber fork_num, BlockNumber block_num, bool hit,
+    bool strategy);
+
+#endif /* FRONTEND */
+
+#endif /* BUF_TRACE_H */
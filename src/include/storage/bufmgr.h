@@ -40,6 +40,12 @@ typedef enum BufferAccessStrategyType {
     BAS_VACUUM     /* VACUUM */
 } BufferAccessStrategyType;
 
+/* Possible values of buffer_replacement_policy */
+typedef enum BufferReplacementPolicy {
+    BUFFER_REPLACEMENT_CLOCK, /* evict any unpinned buffer under the hand */
+    BUFFER_REPLACEMENT_2Q     /* usage-count sweep with ghost admission */
+} BufferReplacementPolicy;
+
 /* Possible modes for ReadBufferExtended() */
 typedef enum {
     RBM_NORMAL,                /* Normal read */
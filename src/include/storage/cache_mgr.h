@@ -121,11 +121,31 @@ typedef struct CacheDesc {
      */
     bool m_refreshing;
 
+    /*
+     * The size of a column data block the clock sweep has demoted to the
+     * compressed tier, 0 when the block is not in it.  The next access
+     * decompresses it again instead of reading it from disk.
+     */
+    int m_compressed_size;
+
     slock_t m_slot_hdr_lock;
 
     CacheFlags m_flag;
 } CacheDesc;
 
+/* statistics of the compressed tier of a cache, see CacheMgr::GetCacheTierStat() */
+typedef struct CacheTierStat {
+    int64 cache_size;            /* memory limit of the whole cache */
+    int64 used_size;             /* memory used by the whole cache */
+    int64 compressed_limit;      /* memory limit of the compressed tier */
+    int64 compressed_size;       /* memory used by the compressed tier */
+    int64 compressed_blocks;     /* blocks in the compressed tier */
+    uint64 demotions;            /* blocks the clock sweep moved to the compressed tier */
+    uint64 compressed_hits;      /* blocks decompressed again from the compressed tier */
+    uint64 compressed_evictions; /* blocks evicted from the compressed tier */
+    uint64 evictions;            /* blocks evicted without passing through the compressed tier */
+} CacheTierStat;
+
 int CacheMgrNumLocks(int64 cache_size, uint32 each_block_size);
 int64 CacheMgrCalcSizeByType(MgrCacheType type);
 
@@ -139,6 +159,15 @@ public:
     void Init(int64 cache_size, uint32 each_block_size, MgrCacheType type, uint32 each_slot_length);
     void Destroy(void);
 
+    /* compressed tier of column data blocks */
+    void InitCompressedTier(int64 compressed_size);
+    bool CompressedTierEnabled() const
+    {
+        return m_compressedMaxSize > 0;
+    }
+    void LeaveCompressedTier(CacheSlotId_t slotId);
+    void GetCacheTierStat(CacheTierStat *stat);
+
     /* operate cache block */
     void InitCacheBlockTag(CacheTag *cacheTag, int32 type, const void *key, int32 length) const;
     CacheSlotId_t FindCacheBlock(CacheTag *cacheTag, bool first_enter_block);
@@ -206,6 +235,9 @@ private:
     /* internal block operate */
     CacheSlotId_t EvictCacheBlock(int size, int retryNum);
     CacheSlotId_t GetFreeCacheBlock(int size);
+    bool CacheBlockDemotable_Locked(CacheSlotId_t slotId);
+    void DemoteCacheBlock(CacheSlotId_t slotId);
+    void ReleaseCompressedTier(CacheSlotId_t slotId, bool hit);
 
     /* memory operate */
     bool ReserveCacheMem(int size);
@@ -254,6 +286,18 @@ private:
 
     /* protect memory size counter */
     slock_t m_memsize_lock;
+
+    /*
+     * Compressed tier.  The sizes and the hits are protected by m_memsize_lock,
+     * the clock sweep counters by m_csweep_lock.
+     */
+    int64 m_compressedMaxSize;
+    int64 m_compressedCurrentSize;
+    int64 m_compressedBlocks;
+    uint64 m_compressedHits;
+    uint64 m_demotions;
+    uint64 m_compressedEvictions;
+    uint64 m_evictions;
 };
 
 #endif  // define
@@ -264,6 +264,62 @@ private:
     short m_outValSize;
 };
 
+/* Bitpack Data In Disk
+ *
+ * m_base:            frame of reference, the min value of all values.
+ * m_valuesCount:     how many values are packed.
+ * m_exceptionsCount: how many values are patched from the exception list.
+ * m_bitWidth:        bits of each packed value, [0, 64].
+ *
+ * the header is followed by the packed groups and then the exception list.
+ * a group holds BITPACK_GROUP values of (value - m_base) in m_bitWidth bits each,
+ * so it's m_bitWidth bytes; the last group is padded with zero. values whose
+ * difference needs more than m_bitWidth bits are packed as 0, their positions
+ * (uint32) and then their raw values follow the groups.
+ */
+typedef struct BitpackHeader {
+    int64 m_base;
+    uint32 m_valuesCount;
+    uint32 m_exceptionsCount;
+    uint32 m_bitWidth;
+} BitpackHeader;
+
+#define BITPACK_GROUP 8
+#define BitpackGroupsSize(_nvalues, _width) ((((_nvalues) + BITPACK_GROUP - 1) / BITPACK_GROUP) * (_width))
+
+// Frame of reference bit-packing with patched exceptions (PFOR)
+//
+class BitpackCoder : public BaseObject {
+public:
+    BitpackCoder(short eachValSize) : m_eachValSize(eachValSize), m_base(0), m_bitWidth(0), m_exceptionsCount(0)
+    {}
+    virtual ~BitpackCoder()
+    {}
+
+    // choose the bit width giving the smallest output for these values, and
+    // return the size Compress() will need. <minVal> is the frame of reference.
+    //
+    int Analyze(char* inbuf, int insize, int64 minVal);
+    int Compress(char* inbuf, char* outbuf, int insize, int outsize);
+    int Decompress(char* inbuf, char* outbuf, int insize, int outsize);
+
+private:
+    template <short eachValSize>
+    void InnerAnalyze(char* inbuf, int insize, uint32* widthCounts);
+
+    template <short eachValSize>
+    int InnerCompress(char* inbuf, char* outbuf, int insize);
+
+    template <short eachValSize>
+    void InnerDecompress(const BitpackHeader* header, const unsigned char* packed, const unsigned char* inEnd,
+        char* outbuf);
+
+    short m_eachValSize;
+    int64 m_base;
+    uint32 m_bitWidth;
+    uint32 m_exceptionsCount;
+};
+
 typedef uint16 DicCodeType;
 
 /* Dictionary Data In Disk
@@ -137,16 +137,23 @@ public:
     virtual ~StringCoder()
     {}
 
-    StringCoder() : m_adopt_rle(true), m_adopt_dict(true), m_dicCodes(NULL), m_dicCodesNum(0)
+    StringCoder()
+        : m_adopt_rle(true), m_adopt_dict(true), m_keep_dic_codes(false), m_dicCodes(NULL), m_dicCodesNum(0)
     {}
 
     int Compress(_in_ CompressionArg1& in, _in_ CompressionArg2& out);
     int Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg1& out);
 
+    /* hand over the dictionary codes kept by Decompress(), the caller pfree()s them */
+    DicCodeType* TakeDicCodes(_out_ int* codesNum);
+
     /* optimizing flags */
     bool m_adopt_rle;
     bool m_adopt_dict;
 
+    /* keep the dictionary codes after Decompress() for TakeDicCodes() */
+    bool m_keep_dic_codes;
+
 private:
     /* inner implement for compress api */
     template <bool adopt_dict>
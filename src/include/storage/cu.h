@@ -29,6 +29,7 @@
 #include "vecexecutor/vectorbatch.h"
 #include "cstore.h"
 #include "storage/cstore_mem_alloc.h"
+#include "storage/compress_kits.h"
 #include "utils/datum.h"
 #include "storage/lwlock.h"
 
@@ -148,6 +149,12 @@ struct CUDesc : public BaseObject {
      */
     uint32 magic;
 
+    /*
+     * Bloom filter and HyperLogLog of the CU values kept in the extra
+     * attribute, see cstore_sketch.h. NULL if none was built or loaded.
+     */
+    text* cu_sketch;
+
 public:
     CUDesc();
     ~CUDesc();
@@ -204,6 +211,8 @@ struct cu_tmp_compress_info {
  * |      Padding Data      |                              |
  * +------------------------+                              -
  */
+class StringCoder;
+
 class CU : public BaseObject {
 public:
     /* Source buffer: nulls bitmap + source data. */
@@ -221,6 +230,13 @@ public:
     /* support with accessing datum randomly after loading CU data */
     int32* m_offset;
 
+    /*
+     * dictionary codes of the not-null values of a dictionary encoded CU,
+     * kept after loading CU data so that a predicate can be evaluated once
+     * per dictionary item. NULL for the other CUs.
+     */
+    DicCodeType* m_dicCodes;
+
     /* temp info about CU compression */
     cu_tmp_compress_info* m_tmpinfo;
 
@@ -231,6 +247,9 @@ public:
     /* the number of m_offset items */
     int32 m_offsetSize;
 
+    /* the size of m_dicCodes in bytes */
+    int32 m_dicCodesSize;
+
     /* source buffer size. */
     uint32 m_srcBufSize;
 
@@ -299,6 +318,11 @@ public:
      */
     bool CheckCrc();
 
+    /*
+     *  Whether the compressed buffer holds encrypted data, which UnCompress() decrypts in place
+     */
+    bool CompressedBufIsEncrypted() const;
+
     /*
      *	Generate CRC code
      */
@@ -409,6 +433,8 @@ private:
     template <bool char_type>
     void DeFormNumberStringCU();
 
+    void KeepDicCodes(StringCoder& strDecoder);
+
     bool IsNumericDscaleCompress() const;
 
     // encrypt cu data
@@ -524,6 +550,15 @@ void CU::FreeMem()
         this->m_offset = NULL;
         this->m_offsetSize = 0;
     }
+    if (this->m_dicCodes) {
+        if (!freeByCUCacheMgr) {
+            CStoreMemAlloc::Pfree(this->m_dicCodes, !this->m_inCUCache);
+        } else {
+            free(this->m_dicCodes);
+        }
+        this->m_dicCodes = NULL;
+        this->m_dicCodesSize = 0;
+    }
 }
 
 #endif
@@ -121,6 +121,7 @@ public:
     bool DataBlockWaitIO(int cuSlotId);
     void DataBlockCompleteIO(int cuSlotId);
     int64 GetCurrentMemSize();
+    void GetCacheTierStat(CacheTierStat* stat);
     void PrintDataCacheSlotLeakWarning(CacheSlotId_t slotId);
 
     void AbortCU(CacheSlotId_t slot);
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * shm_barrier.h
+ *        Phased barrier for the threads of one parallel query.
+ *
+ * A barrier lets a dynamic set of participants march through a sequence of
+ * numbered phases together.  Participants may attach at any time and learn
+ * the current phase, and may detach without waiting for the others.  The
+ * barrier object lives in memory shared by the leader and its workers (the
+ * parallel context's shared memory context).
+ *
+ * IDENTIFICATION
+ *        src/include/storage/shm_barrier.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef SHM_BARRIER_H
+#define SHM_BARRIER_H
+
+#include "storage/shm_condvar.h"
+
+typedef struct Barrier {
+    ShmConditionVariable cv;
+    int phase;         /* phase counter */
+    int participants;  /* the number of participants attached */
+    int arrived;       /* the number of participants that have arrived */
+    bool elect_waiter; /* phase was completed by a detach, elect a waiter */
+} Barrier;
+
+extern void BarrierInit(Barrier* barrier, int num_workers);
+extern void BarrierDestroy(Barrier* barrier);
+extern bool BarrierArriveAndWait(Barrier* barrier);
+extern bool BarrierArriveAndDetach(Barrier* barrier);
+extern bool BarrierArriveAndDetachExceptLast(Barrier* barrier);
+extern int BarrierAttach(Barrier* barrier);
+extern bool BarrierDetach(Barrier* barrier);
+extern int BarrierPhase(Barrier* barrier);
+extern int BarrierParticipants(Barrier* barrier);
+
+#endif /* SHM_BARRIER_H */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * shm_condvar.h
+ *        Interruptible condition variable for the threads of one parallel query.
+ *
+ * The condition variable carries its own mutex, which also protects whatever
+ * shared state the waiters are testing:
+ *
+ *      ShmCondVarLock(cv);
+ *      while (!condition)
+ *          ShmCondVarWait(cv);
+ *      ... use the state ...
+ *      ShmCondVarUnlock(cv);
+ *
+ * The object lives in memory shared by the leader and its workers (the
+ * parallel context's shared memory context).
+ *
+ * IDENTIFICATION
+ *        src/include/storage/shm_condvar.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef SHM_CONDVAR_H
+#define SHM_CONDVAR_H
+
+#include <pthread.h>
+
+typedef struct ShmConditionVariable {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} ShmConditionVariable;
+
+extern void ShmCondVarInit(ShmConditionVariable* cv);
+extern void ShmCondVarDestroy(ShmConditionVariable* cv);
+extern void ShmCondVarLock(ShmConditionVariable* cv);
+extern void ShmCondVarUnlock(ShmConditionVariable* cv);
+extern void ShmCondVarWait(ShmConditionVariable* cv);
+extern void ShmCondVarBroadcast(ShmConditionVariable* cv);
+
+#endif /* SHM_CONDVAR_H */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * uring.h
+ *        io_uring based batched I/O backend used by storage/file/fd.cpp.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/storage/uring.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef URING_H
+#define URING_H
+
+#include <libaio.h>
+
+/*
+ * io_uring is only usable when the kernel headers know about it; otherwise
+ * every entry point below degrades to "not enabled" and callers keep using
+ * the synchronous / libaio paths.
+ */
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define USE_IO_URING
+#endif
+#endif
+
+/* Minimum and maximum of the io_uring_queue_depth GUC */
+#define URING_MIN_QUEUE_DEPTH 8
+#define URING_MAX_QUEUE_DEPTH 4096
+
+/*
+ * Each thread lazily owns one ring.  Hints (prefetch / writeback) are only
+ * queued and go to the kernel in one io_uring_enter() call per batch, while
+ * the iocb batches built for ADIO are submitted at once and reaped by the
+ * same thread later, so no completer thread is needed when io_uring is enabled.
+ */
+extern bool UringProbe(void);
+extern bool UringIsEnabled(void);
+extern void UringPrefetch(int fd, off_t offset, off_t nbytes);
+extern void UringWriteback(int fd, off_t offset, off_t nbytes);
+extern int UringSubmitPending(void);
+extern int UringSubmitIocbBatch(struct iocb** iocbs, int count, int (*callback)(void*, long));
+extern void UringWaitBatches(void);
+extern bool UringBatchesInFlight(void);
+extern long UringSyncIocb(struct iocb* cb);
+
+#endif /* URING_H */
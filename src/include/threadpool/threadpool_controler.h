@@ -68,6 +68,9 @@ public:
     void SetThreadPoolInfo();
     int GetThreadNum();
     ThreadPoolStat* GetThreadPoolStat(uint32* num);
+    ThreadPoolQueueStat* GetThreadPoolQueueStat(uint32* num);
+    knl_session_context* StealSession(ThreadPoolGroup* thief);
+    bool LendSession(ThreadPoolGroup* home, knl_session_context* session);
     bool StayInAttachMode();
     void ReBindStreamThread(ThreadId tid) const;
     void CloseAllSessions();
@@ -88,6 +91,7 @@ public:
 
 private:
     ThreadPoolGroup* FindThreadGroupWithLeastSession();
+    ThreadPoolGroup* GetStealGroup(ThreadPoolGroup* home, int idx);
     void ParseAttr();
     void ParseBindCpu();
     int ParseRangeStr(char* attr, bool* arr, int totalNum, char* bindtype);
@@ -33,6 +33,13 @@
 #define NUM_THREADPOOL_STATUS_ELEM 7
 #define STATUS_INFO_SIZE 256
 
+/*
+ * Queueing delay histogram of a thread group: bucket 0 counts sessions that
+ * found a free worker at once, bucket i those that waited less than 2^i us,
+ * and the last bucket the rest.
+ */
+#define THREAD_QUEUE_TIME_BUCKETS 24
+
 typedef enum { WORKER_SLOT_UNUSE = 0, WORKER_SLOT_INUSE } WorkerSlotStatus;
 
 typedef struct WorkerStatus {
@@ -57,6 +64,14 @@ typedef struct ThreadPoolStat {
     char sessionInfo[STATUS_INFO_SIZE];
 } ThreadPoolStat;
 
+typedef struct ThreadPoolQueueStat {
+    int groupId;
+    int numaId;
+    uint64 stolenSessions; /* sessions of other groups served by our workers */
+    uint64 lentSessions;   /* sessions of ours served by workers of other groups */
+    uint64 queueTime[THREAD_QUEUE_TIME_BUCKETS];
+} ThreadPoolQueueStat;
+
 class ThreadPoolGroup : public BaseObject {
 public:
     ThreadPoolListener* m_listener;
@@ -75,7 +90,11 @@ public:
     void WaitReady();
     float4 GetSessionPerThread();
     void GetThreadPoolGroupStat(ThreadPoolStat* stat);
+    void GetThreadPoolGroupQueueStat(ThreadPoolQueueStat* stat);
     bool IsGroupHang();
+    void RecordQueueTime(TimestampTz readyTime);
+    bool CanStealFrom(ThreadPoolGroup* home, int penalty);
+    void RecordStolenSession(ThreadPoolGroup* home);
 
     inline ThreadPoolListener* GetListener()
     {
@@ -128,6 +147,10 @@ private:
     volatile int m_waitServeSessionCount;  // wait for worker to server
     volatile int m_processTaskCount;
 
+    volatile uint64 m_stolenSessionCount;
+    volatile uint64 m_lentSessionCount;
+    volatile uint64 m_queueTimeHist[THREAD_QUEUE_TIME_BUCKETS];
+
     int m_groupId;
     int m_numaId;
     int m_groupCpuNum;
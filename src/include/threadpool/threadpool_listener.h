@@ -42,6 +42,8 @@ public:
     void CreateEpoll();
     void NotifyReady();
     bool TryFeedWorker(ThreadPoolWorker* worker);
+    knl_session_context* GetReadySession();
+    bool WakeUpFreeWorker(knl_session_context* session);
     void AddNewSession(knl_session_context* session);
     void WaitTask();
     void DelSessionFromEpoll(knl_session_context* session);
@@ -67,6 +69,7 @@ private:
 
     DllistWithLock* m_freeWorkerList;
     DllistWithLock* m_readySessionList;
+    DllistWithLock* m_shortReadySessionList; /* short sessions, with enable_thread_pool_latency_class */
     DllistWithLock* m_idleSessionList;
 };
 
@@ -49,6 +49,23 @@ typedef enum {
     BS_FINALMERGE
 } BatchSortStatus;
 
+/*
+ * How the leading sort key is mapped onto an unsigned 64-bit value whose
+ * order matches the sort order, which lets the in-memory sort use a radix
+ * sort and the heap comparisons skip the fmgr call for the leading key.
+ * The abbreviated kinds map the abbreviated key, so ties on them still have
+ * to be broken by the full comparator.
+ */
+typedef enum {
+    BS_NORMKEY_NONE = 0,
+    BS_NORMKEY_INT16,
+    BS_NORMKEY_INT32,
+    BS_NORMKEY_INT64,
+    BS_NORMKEY_UINT32,
+    BS_NORMKEY_ABBREV_UNSIGNED,
+    BS_NORMKEY_ABBREV_NUMERIC
+} BatchSortNormKeyKind;
+
 /*
  * Private state of a batchsort operation.
  */
@@ -116,6 +133,11 @@ public:
      */
     int m_bound;
 
+    /*
+     * normalized key kind of the leading sort key when it is not abbreviated
+     */
+    BatchSortNormKeyKind m_normKeyKind;
+
     MultiColumnsData m_unsortColumns;
 
     bool* m_isSortKey;
@@ -219,6 +241,10 @@ public:
 
     void SortInMem();
 
+    BatchSortNormKeyKind GetInMemNormKeyKind();
+
+    bool RadixSortInMem(BatchSortNormKeyKind kind);
+
     int GetSortMergeOrder();
 
     void InitTapes();
@@ -349,7 +375,12 @@ template <bool abbrevSortOptimize>
 void putbatch(Batchsortstate* state, VectorBatch* batch, int start, int end)
 {
     int64 memorySize = 0;
+    const bool* sel = SelectionVector(batch);
+
     for (int row = start; row < end; ++row) {
+        if (sel != NULL && !sel[row])
+            continue;
+
         MultiColumns multiColumn = state->CopyMultiColumn<abbrevSortOptimize>(batch, row);
 
         if (abbrevSortOptimize) {
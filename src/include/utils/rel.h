@@ -285,6 +285,7 @@ typedef struct StdRdOptions {
     bool ignore_enable_hadoop_env; /* ignore enable_hadoop_env */
     bool user_catalog_table;       /* use as an additional catalog relation */
     bool hashbucket;        /* enable hash bucket for this relation */
+    bool cu_sketch;         /* keep a sketch of the values of every CU, see cstore_sketch.h */
 
     /* info for redistribution */
     Oid rel_cn_oid;
@@ -332,6 +332,12 @@ static inline RedisHtlAction RelationGetAppendMode(Relation rel)
                             RelationGetMaxBatchRows(relation)))                                          \
             : RelDefaultPartialClusterRows)
 
+// RelationGetCUSketch
+//    Return the relation's cu_sketch option
+//
+#define RelationGetCUSketch(relation) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->cu_sketch : false)
+
 /* Relation whether create in current xact */
 static inline bool RelationCreateInCurrXact(Relation rel)
 {
@@ -42,7 +42,13 @@
         econtext->ecxt_aggbatch = m_aggbatch;                                  \
     }
 
+/* rows a node puts into one output batch, never more than BatchMaxSize */
+#define VecBatchRows(node) \
+    ((node)->vec_batch_rows > 0 ? (node)->vec_batch_rows : u_sess->attr.attr_sql.vector_batch_size)
+
 extern VectorBatch* VectorEngine(PlanState* node);
+extern void ExecSetVecBatchRows(PlanState* node, int rows);
+extern int ExecVecProbeBatchRows(int outerCols, int innerCols);
 extern VectorBatch* ExecVecProject(ProjectionInfo* projInfo, bool selReSet = true, ExprDoneCond* isDone = NULL);
 extern ExprState* ExecInitVecExpr(Expr* node, PlanState* parent);
 
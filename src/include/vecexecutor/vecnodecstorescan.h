@@ -25,6 +25,7 @@
 #ifndef VECNODECSTORESCAN_H
 #define VECNODECSTORESCAN_H
 
+#include "access/parallel.h"
 #include "vecexecutor/vecnodes.h"
 #include "nodes/plannodes.h"
 #include "access/cstoreskey.h"
@@ -46,6 +47,9 @@ extern void ExecEndCStoreScan(CStoreScanState* node, bool indexFlag);
 extern void ExecEndDfsScan(DfsScanState* node);
 extern void ExecReSetRuntimeKeys(CStoreScanState* node);
 extern void ExecReScanCStoreScan(CStoreScanState* node);
+extern void ExecCStoreScanInitializeDSM(CStoreScanState* node, ParallelContext* pcxt, int nodeid);
+extern void ExecCStoreScanReInitializeDSM(CStoreScanState* node, ParallelContext* pcxt);
+extern void ExecCStoreScanInitializeWorker(CStoreScanState* node, void* context);
 extern void ExecCStoreBuildScanKeys(CStoreScanState* state, List* quals, CStoreScanKey* scankeys, int* numScanKeys);
 extern void ExecReScanCStoreIndexScan(CStoreIndexScanState* node);
 
@@ -232,6 +232,12 @@ typedef struct CStoreScanState : ScanState {
     vecqual_func jitted_vecqual;
 
     bool m_isReplicaTable; /* If it is a replication table? */
+
+    ParallelCStoreScanDesc m_parallelScan; /* shared state of a parallel-aware scan, or NULL */
+    bool m_deltaScanOwner;                 /* this participant scans the delta table */
+
+    bool m_hasDictFilter;     /* CStore evaluates part of the qual per dictionary item */
+    List* m_dictResidualQual; /* the rest of the qual, run on the rows CStore selects */
 } CStoreScanState;
 
 typedef struct DfsScanState : ScanState {
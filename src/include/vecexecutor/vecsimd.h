@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * vecsimd.h
+ *        SIMD kernels for the vector engine primitives, chosen at runtime.
+ *
+ * The kernels work on blocks of VEC_SIMD_BLOCK rows.  The null flags and the
+ * selection vector of a block are tested a 64-bit word at a time; a block
+ * whose rows are all selected and not null is done with SIMD instructions,
+ * any other block falls back to the row-at-a-time code.  The AVX-512, AVX2
+ * and SSE4.2 versions are compiled into the same binary, and the best one
+ * the CPU supports is picked on first use.
+ *
+ * IDENTIFICATION
+ *        src/include/vecexecutor/vecsimd.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef VECSIMD_H
+#define VECSIMD_H
+
+#include "fmgr.h"
+#include "vecexecutor/vectorbatch.h"
+
+/* rows per SIMD block: one 64-bit word of null flags or selection bools */
+#define VEC_SIMD_BLOCK 8
+
+typedef enum VecSimdLevel {
+    VEC_SIMD_SCALAR = 0,
+    VEC_SIMD_SSE42,
+    VEC_SIMD_AVX2,
+    VEC_SIMD_AVX512
+} VecSimdLevel;
+
+/* How the two arguments of a comparison are stored in their ScalarValues */
+typedef enum VecSimdArgKind {
+    VEC_SIMD_INT64_INT64 = 0,
+    VEC_SIMD_INT32_INT32,
+    VEC_SIMD_INT32_INT64,
+    VEC_SIMD_INT64_INT32,
+    VEC_SIMD_FLOAT8_FLOAT8,
+    VEC_SIMD_ARG_KINDS
+} VecSimdArgKind;
+
+#define VEC_SIMD_OPS (SOP_GT + 1)
+
+/*
+ * Compare nvalues rows of two vectors into a boolean result vector.  Rows
+ * not in pselection (if given) are left untouched, as in the scalar code.
+ */
+typedef void (*VecSimdCmpFunc)(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1,
+    const uint8* pflags2, const bool* pselection, ScalarValue* presult, uint8* pflag, int nvalues);
+
+/* Add or subtract two int8 vectors; returns true if any selected row overflowed */
+typedef bool (*VecSimdArithFunc)(const ScalarValue* parg1, const ScalarValue* parg2, const uint8* pflags1,
+    const uint8* pflags2, const bool* pselection, ScalarValue* presult, uint8* pflag, int nvalues);
+
+/*
+ * AND a boolean qual result into a selection vector, a null result counting
+ * as resultForNull.  Returns true if any row is still selected.
+ */
+typedef bool (*VecSimdQualFunc)(const ScalarValue* pval, const uint8* pflag, bool* psel, int nrows, bool resultForNull);
+
+typedef struct VecSimdKernels {
+    VecSimdLevel level;
+    VecSimdCmpFunc cmp[VEC_SIMD_ARG_KINDS][VEC_SIMD_OPS];
+    VecSimdArithFunc int8_add;
+    VecSimdArithFunc int8_sub;
+    VecSimdQualFunc qual_to_selection;
+} VecSimdKernels;
+
+extern const VecSimdKernels* volatile vec_simd_kernels;
+extern const VecSimdKernels* vec_simd_choose(void);
+
+#define VEC_SIMD() (likely(vec_simd_kernels != NULL) ? vec_simd_kernels : vec_simd_choose())
+
+/* Map the C types a primitive is instantiated with onto a VecSimdArgKind */
+template <typename Datatype1, typename Datatype2>
+inline VecSimdArgKind vec_simd_int_arg_kind()
+{
+    if (sizeof(Datatype1) == sizeof(int32))
+        return (sizeof(Datatype2) == sizeof(int32)) ? VEC_SIMD_INT32_INT32 : VEC_SIMD_INT32_INT64;
+    return (sizeof(Datatype2) == sizeof(int32)) ? VEC_SIMD_INT64_INT32 : VEC_SIMD_INT64_INT64;
+}
+
+#endif /* VECSIMD_H */
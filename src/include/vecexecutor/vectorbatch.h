@@ -354,7 +354,12 @@ public:
     //
     int m_cols;
 
-    // Shall we check the selection vector.
+    // Shall we check the selection vector.  When set the batch is in
+    // selection-vector mode: rows whose m_sel entry is false have been
+    // filtered out but still occupy their slot, and m_rows counts the slots.
+    // Producers leave a filtered batch this way instead of packing it when
+    // their parent accepts it (PlanState::vec_accept_sel); otherwise it is
+    // compacted on the way out of VectorEngine.
     //
     bool m_checkSel;
 
@@ -435,6 +440,14 @@ public:
     /* Optimzed Pack function for later read. later read cols and ctid col*/
     void OptimizePackForLateRead(const bool* sel, List* lateVars, int ctidColIdx);
 
+    // Leave selection-vector mode by packing the selected rows
+    //
+    void Compact();
+
+    // Number of live rows, honoring the selection vector
+    //
+    int SelectedRows();
+
     // SysColumns
     //
     void CreateSysColContainer(MemoryContext cxt, List* sysVarList);
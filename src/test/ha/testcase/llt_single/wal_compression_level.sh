@@ -0,0 +1,51 @@
+#!/bin/sh
+#the shell is to test replay of full-page images compressed with LZ4 HC:
+#update every page of a table after a checkpoint at a non-default
+#wal_compression_level, then check the rows after crash recovery of the
+#primary and on the standby
+
+source ./standby_env.sh
+
+function test_1()
+{
+check_instance
+
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists wal_compression_level_t; CREATE TABLE wal_compression_level_t(id INT, name TEXT);
+							insert into wal_compression_level_t select i, repeat('x', 100) from generate_series(1, 100000) i;
+							checkpoint;"
+
+#the first change of each page after the checkpoint writes its full-page image
+gsql -d $db -p $dn1_primary_port -c "set wal_compression = on; set wal_compression_level = 9;
+							update wal_compression_level_t set name = name || 'y';"
+
+kill_primary
+start_primary
+
+check_replication_setup
+wait_catchup_finish
+
+#test the update results on dn1_primary
+if [ $(gsql -d $db -p $dn1_primary_port -c "select count(1), sum(length(name)) from wal_compression_level_t;" | grep "100000 | 10100000" | wc -l) -eq 1 ]; then
+	echo "replay success on dn1_primary wal_compression_level_t"
+else
+	echo "replay $failed_keyword on dn1_primary wal_compression_level_t"
+	exit 1
+fi
+
+#test the update results on dn1_standby
+if [ $(gsql -d $db -p $dn1_standby_port -m -c "select count(1), sum(length(name)) from wal_compression_level_t;" | grep "100000 | 10100000" | wc -l) -eq 1 ]; then
+	echo "replay success on dn1_standby wal_compression_level_t"
+else
+	echo "replay $failed_keyword on dn1_standby wal_compression_level_t"
+	exit 1
+fi
+}
+
+function tear_down()
+{
+sleep 1
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists wal_compression_level_t;"
+}
+
+test_1
+tear_down
@@ -0,0 +1,9 @@
+# Tests run by fastcheck_single_feature, with make_fastcheck_single_feature_postgresql.conf
+test: io_uring
+test: buffer_2q
+test: pgstat_shared_memory
+test: unique_sql_flush
+test: cu_cache_tier
+test: recovery_prefetch_window
+test: threadpool_queue_stat
+test: unique_sql_rt_percentile
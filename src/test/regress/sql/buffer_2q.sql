@@ -0,0 +1,16 @@
+-- The feature run starts the server with buffer_replacement_policy 2q and
+-- shared_buffers small enough for a seqscan of the table below to go through
+-- a ring.  Pages reused from the ring must not come back as frequently used
+-- ones when the scan is repeated.
+show buffer_replacement_policy;
+create table buffer_2q_scan (a int, b char(500)) with (fillfactor = 10);
+insert into buffer_2q_scan select i, 'x' from generate_series(1, 2000) i;
+-- rewrite the table behind the buffer pool, so that only the scans load it
+vacuum full buffer_2q_scan;
+select pg_relation_size('buffer_2q_scan') / 8192 as blocks;
+select count(*), sum(a) from buffer_2q_scan;
+select count(*), sum(a) from buffer_2q_scan;
+select count(*), sum(a) from buffer_2q_scan;
+select count(*) > 0 as resident, sum(case when usage_count > 1 then 1 else 0 end) as protected
+    from pg_buffercache_pages() where relfilenode = pg_relation_filenode('buffer_2q_scan');
+drop table buffer_2q_scan;
@@ -0,0 +1,6 @@
+-- Without numa_distribute_mode the buffer pool is a single partition, for which
+-- no hits or allocations are counted.
+select numa_node, buffers = (select setting::int from pg_settings where name = 'shared_buffers') as all_buffers,
+       hits, remote_hits, allocs, remote_allocs
+    from local_buffer_numa_stat();
+select count(*) from dbe_perf.global_buffer_numa_status;
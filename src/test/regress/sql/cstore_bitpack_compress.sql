@@ -0,0 +1,40 @@
+--
+-- frame of reference bit-packing of integer, date and timestamp CUs
+--
+create schema cstore_bitpack;
+set current_schema = cstore_bitpack;
+
+-- small ranges, a sparse outlier column (patched exceptions), booleans and an
+-- all-equal column
+create table bitpack_row(i int, a int4, b int8, c date, d timestamp, e bool, f int2, g int8);
+insert into bitpack_row select i, i % 1000 - 500, case when i % 997 = 0 then i * 100000000000 else i % 16 end,
+    '2020-01-01'::date + i % 366, '2020-01-01 00:00:00'::timestamp + i * interval '1 second', i % 3 = 0, i % 100, 42
+    from generate_series(1, 10000) i;
+
+create table bitpack_low(i int, a int4, b int8, c date, d timestamp, e bool, f int2, g int8)
+    with (orientation = column, compression = low);
+create table bitpack_middle(i int, a int4, b int8, c date, d timestamp, e bool, f int2, g int8)
+    with (orientation = column, compression = middle);
+create table bitpack_high(i int, a int4, b int8, c date, d timestamp, e bool, f int2, g int8)
+    with (orientation = column, compression = high);
+insert into bitpack_low select * from bitpack_row;
+insert into bitpack_middle select * from bitpack_row;
+insert into bitpack_high select * from bitpack_row;
+
+select count(*) from (select * from bitpack_low except all select * from bitpack_row) x;
+select count(*) from (select * from bitpack_row except all select * from bitpack_low) x;
+select count(*) from (select * from bitpack_middle except all select * from bitpack_row) x;
+select count(*) from (select * from bitpack_row except all select * from bitpack_middle) x;
+select count(*) from (select * from bitpack_high except all select * from bitpack_row) x;
+select count(*) from (select * from bitpack_row except all select * from bitpack_high) x;
+
+select sum(a), sum(b), max(b), sum(f), sum(g) from bitpack_low;
+select i, b from bitpack_middle where i % 997 = 0 order by i limit 3;
+select count(*) from bitpack_high where e and f < 10;
+
+-- a CU shorter than one group of values
+create table bitpack_short(a int4, b int8) with (orientation = column);
+insert into bitpack_short values (-3, 9000000000), (5, 9000000001), (-1, 9000000007);
+select * from bitpack_short order by a;
+
+drop schema cstore_bitpack cascade;
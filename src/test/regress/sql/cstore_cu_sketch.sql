@@ -0,0 +1,53 @@
+--
+-- bloom filters and distinct count sketches of the CUs of column tables
+--
+create schema cstore_cu_sketch;
+set current_schema = cstore_cu_sketch;
+
+create function sketch_count(rel regclass) returns bigint as $$
+declare
+    n bigint;
+begin
+    execute 'select count(extra) from cstore.pg_cudesc_' || rel::oid into n;
+    return n;
+end;
+$$ language plpgsql;
+
+-- b and t are scattered over every CU, so min/max can't prune them
+create table sketch_row(i int, b bigint, t text, d date);
+insert into sketch_row select i, (i * 7919) % 20000, 'k' || ((i * 7919) % 20000), date '2020-01-01' + i % 300
+    from generate_series(1, 20000) i;
+
+create table sketch_col(i int, b bigint, t text, d date) with (orientation = column, cu_sketch = on);
+create table sketch_plain(i int, b bigint, t text, d date) with (orientation = column);
+insert into sketch_col select * from sketch_row where i <= 5000;
+insert into sketch_col select * from sketch_row where i > 5000 and i <= 10000;
+insert into sketch_col select * from sketch_row where i > 10000 and i <= 15000;
+insert into sketch_col select * from sketch_row where i > 15000;
+insert into sketch_plain select * from sketch_row;
+delete from sketch_col where i % 10 = 1;
+
+select sketch_count('sketch_col');
+select sketch_count('sketch_plain');
+
+-- equality and IN quals, of the column type or not
+select count(*) from sketch_col where b = 15838;
+select count(*) from sketch_col where b = 15838::bigint;
+select count(*) from sketch_col where 3757 = b;
+select count(*) from sketch_col where b in (15838, 3757, 99999, null);
+select count(*) from sketch_col where b = 7919;
+select count(*) from sketch_col where t = 'k3757';
+select count(*) from sketch_col where t in ('k15838', 'nope');
+select count(*) from sketch_col where d = date '2020-01-05';
+select count(*) from sketch_col where i = 4322 and b = (4322 * 7919) % 20000;
+select i, b, t from sketch_col where t = 'k15838' or b = 3757 order by i;
+
+-- the sketches feed the distinct counts of ANALYZE
+analyze sketch_col;
+select attname, n_distinct = -1 as unique, n_distinct between 250 and 400 as about_300 from pg_stats
+    where schemaname = 'cstore_cu_sketch' and tablename = 'sketch_col' order by attname;
+
+-- row tables have no CU
+create table sketch_bad(i int) with (cu_sketch = on);
+
+drop schema cstore_cu_sketch cascade;
@@ -0,0 +1,40 @@
+--
+-- quals evaluated once per dictionary item of dictionary encoded CUs
+--
+create schema cstore_dict_filter;
+set current_schema = cstore_dict_filter;
+
+create table dict_row(i int, s text, v varchar(20), u text);
+insert into dict_row select i, case when i % 50 = 0 then null else (array['alpha', 'beta', 'gamma', 'delta'])[i % 4 + 1] end,
+    'v' || (i % 7), 'u' || i from generate_series(1, 10000) i;
+
+create table dict_col(i int, s text, v varchar(20), u text) with (orientation = column);
+create table dict_low(i int, s text, v varchar(20), u text) with (orientation = column, compression = low);
+insert into dict_col select * from dict_row;
+insert into dict_low select * from dict_row;
+delete from dict_col where i % 10 = 1;
+delete from dict_low where i % 10 = 1;
+
+-- equality, IN, LIKE prefix and the other strict operators, NULLs never match
+select count(*) from dict_col where s = 'beta';
+select count(*) from dict_col where s in ('alpha', 'gamma', null);
+select count(*) from dict_col where s like 'de%';
+select count(*) from dict_col where s <> 'alpha';
+select count(*) from dict_col where s is null;
+
+-- several filtered columns, and clauses left to the qual
+select count(*) from dict_col where s = 'beta' and v = 'v3';
+select count(*) from dict_col where 'gamma' = s and i < 1000;
+select count(*) from dict_col where s = 'beta' and u like 'u1%';
+select i, s, v from dict_col where s = 'delta' and v = 'v1' order by i limit 5;
+
+-- CUs without dictionary fall back to the whole qual
+select count(*) from dict_low where s = 'beta';
+select count(*) from dict_low where s = 'beta' and v = 'v3';
+
+set enable_cstore_dict_filter = off;
+select count(*) from dict_col where s = 'beta';
+select count(*) from dict_col where s = 'beta' and v = 'v3';
+reset enable_cstore_dict_filter;
+
+drop schema cstore_dict_filter cascade;
@@ -0,0 +1,12 @@
+-- The feature run starts the server with cstore_compressed_cache_percent 25, so
+-- a quarter of the CU cache may hold CUs in compressed form only.
+show cstore_compressed_cache_percent;
+create table cu_cache_tier_t (a int, b int) with (orientation = column);
+insert into cu_cache_tier_t select i, i % 97 from generate_series(1, 100000) i;
+select count(*), sum(a), sum(b) from cu_cache_tier_t;
+select cache_size > 0 as sized, used_size > 0 as used,
+       compressed_limit = cache_size / 100 * current_setting('cstore_compressed_cache_percent')::int as limit_follows_percent,
+       compressed_size <= compressed_limit as within_limit
+    from local_cu_cache_stat();
+select count(*) from dbe_perf.global_cu_cache_status;
+drop table cu_cache_tier_t;
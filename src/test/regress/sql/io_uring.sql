@@ -0,0 +1,28 @@
+-- The feature run starts the server with enable_io_uring on, so prefetch and
+-- writeback hints go through the io_uring of each thread.
+show enable_io_uring;
+show io_uring_queue_depth;
+create table io_uring_row (a int, b text) with (fillfactor = 50);
+create index io_uring_row_a on io_uring_row (a);
+insert into io_uring_row select i, repeat('x', 100) || i from generate_series(1, 20000) i;
+checkpoint;
+select count(*), sum(a), sum(length(b)) from io_uring_row;
+update io_uring_row set a = a + 1 where a % 2 = 0;
+checkpoint;
+select count(*), sum(a), sum(length(b)) from io_uring_row;
+-- bitmap heap scans prefetch the heap blocks they will read
+set effective_io_concurrency = 8;
+set enable_seqscan = off;
+set enable_indexscan = off;
+select count(*), sum(a) from io_uring_row where a between 1000 and 5000;
+reset effective_io_concurrency;
+reset enable_seqscan;
+reset enable_indexscan;
+vacuum full io_uring_row;
+select count(*), sum(a), sum(length(b)) from io_uring_row;
+create table io_uring_col (a int, b int) with (orientation = column);
+insert into io_uring_col select i, i % 97 from generate_series(1, 100000) i;
+checkpoint;
+select count(*), sum(a), sum(b) from io_uring_col;
+drop table io_uring_row;
+drop table io_uring_col;
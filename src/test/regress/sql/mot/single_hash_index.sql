@@ -0,0 +1,22 @@
+create foreign table mm_hash (k integer not null, v integer not null, w integer);
+create index mm_hash_nonunique on mm_hash using hash (v);
+create unique index mm_hash_k on mm_hash using hash (k);
+create unique index mm_hash_kv on mm_hash using hash (k, v);
+insert into mm_hash select i, i * 2, i % 7 from generate_series(1, 1000) as i;
+
+insert into mm_hash values (42, 1, 1);
+select * from mm_hash where k = 42;
+select * from mm_hash where k = 42 and v = 84;
+select * from mm_hash where k = 1001;
+
+update mm_hash set w = 100 where k = 500;
+select * from mm_hash where k = 500;
+delete from mm_hash where k = 500;
+select * from mm_hash where k = 500;
+insert into mm_hash values (500, 1000, 0);
+select * from mm_hash where k = 500;
+
+select count(*), sum(v) from mm_hash where k < 10;
+select count(*), sum(k) from mm_hash;
+
+drop foreign table mm_hash;
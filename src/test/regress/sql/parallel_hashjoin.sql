@@ -11,6 +11,7 @@ set parallel_setup_cost = 1;
 set min_parallel_table_scan_size=0;
 set parallel_tuple_cost = 0.01;
 set enable_nestloop=off;
+set enable_parallel_hash=off;
 
 explain (costs off) select * from parallel_hashjoin_test_a left outer join parallel_hashjoin_test_b on parallel_hashjoin_test_a.id = parallel_hashjoin_test_b.id where parallel_hashjoin_test_a.id < 10 order by parallel_hashjoin_test_a.id;
 select * from parallel_hashjoin_test_a left outer join parallel_hashjoin_test_b on parallel_hashjoin_test_a.id = parallel_hashjoin_test_b.id where parallel_hashjoin_test_a.id < 10 order by parallel_hashjoin_test_a.id;
@@ -18,8 +19,37 @@ select * from parallel_hashjoin_test_a left outer join parallel_hashjoin_test_b
 explain (costs off)select * from parallel_hashjoin_test_a right outer join parallel_hashjoin_test_b on parallel_hashjoin_test_a.id = parallel_hashjoin_test_b.id order by parallel_hashjoin_test_a.id;
 select * from parallel_hashjoin_test_a right outer join parallel_hashjoin_test_b on parallel_hashjoin_test_a.id = parallel_hashjoin_test_b.id order by parallel_hashjoin_test_a.id;
 
+-- Parallel-aware hash join: all participants build one shared hash table.
+set enable_parallel_hash=on;
+explain (costs off) select count(*) from parallel_hashjoin_test_a a join parallel_hashjoin_test_a b on a.id = b.id;
+select count(*) from parallel_hashjoin_test_a a join parallel_hashjoin_test_a b on a.id = b.id;
+select count(*) from parallel_hashjoin_test_a a left join parallel_hashjoin_test_b b on a.id = b.id where b.id is null;
+
+
+-- With a small work_mem the shared hash table is built in several batches, and
+-- the rows of the skewed key 1 do not fit in one of them.  The parallel join
+-- must give the same result as a serial one.
+create table parallel_hashjoin_test_c (id int, v int);
+create table parallel_hashjoin_test_d (id int, v int);
+insert into parallel_hashjoin_test_c select n, n % 97 from generate_series(1,20000) n;
+insert into parallel_hashjoin_test_d select case when n % 4 = 0 then 1 else n end, n % 89 from generate_series(1,20000) n;
+analyse parallel_hashjoin_test_c;
+analyse parallel_hashjoin_test_d;
+set work_mem = '64kB';
+set enable_mergejoin = off;
+explain (costs off) select count(*), count(d.id), sum(c.v * 100 + coalesce(d.v, 0)) from parallel_hashjoin_test_c c left join parallel_hashjoin_test_d d on c.id = d.id;
+select count(*), count(d.id), sum(c.v * 100 + coalesce(d.v, 0)) from parallel_hashjoin_test_c c left join parallel_hashjoin_test_d d on c.id = d.id;
+set max_parallel_workers_per_gather = 0;
+select count(*), count(d.id), sum(c.v * 100 + coalesce(d.v, 0)) from parallel_hashjoin_test_c c left join parallel_hashjoin_test_d d on c.id = d.id;
+reset max_parallel_workers_per_gather;
+reset enable_mergejoin;
+reset work_mem;
+drop table parallel_hashjoin_test_c;
+drop table parallel_hashjoin_test_d;
+
 reset parallel_setup_cost;
 reset min_parallel_table_scan_size;
 reset parallel_tuple_cost;
 reset enable_nestloop;
+reset enable_parallel_hash;
 
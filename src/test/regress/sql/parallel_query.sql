@@ -32,6 +32,45 @@ select count(*) from parallel_t1 where a > 5000;
 select count(*) from parallel_t1 where a < 5000;
 select count(*) from parallel_t1 where a <> 5000;
 
+--parallel plan for index scan
+create table parallel_t2(a int, b int);
+insert into parallel_t2 select n, n % 10 from generate_series(1,100000) n;
+create index parallel_t2_idx on parallel_t2(a);
+analyze parallel_t2;
+set min_parallel_index_scan_size=0;
+set enable_seqscan=off;
+set enable_bitmapscan=off;
+explain (costs off) select count(*) from parallel_t2 where a > 5000;
+explain (costs off) select count(b) from parallel_t2 where a > 5000;
+select count(*) from parallel_t2 where a > 5000;
+select count(b) from parallel_t2 where a > 5000;
+select sum(b) from parallel_t2 where a > 5000 and a < 60000;
+
+--parallel plan for bitmap heap scan
+set enable_indexscan=off;
+set enable_bitmapscan=on;
+explain (costs off) select count(b) from parallel_t2 where a > 5000;
+select count(b) from parallel_t2 where a > 5000;
+select sum(b) from parallel_t2 where a > 5000 and a < 60000;
+reset min_parallel_index_scan_size;
+reset enable_seqscan;
+reset enable_indexscan;
+reset enable_bitmapscan;
+
+--partial aggregation in the workers, finalized above the gather
+explain (costs off) select b, count(*), sum(a), avg(a) from parallel_t2 group by b order by b;
+select b, count(*), sum(a), avg(a) from parallel_t2 group by b order by b;
+drop table parallel_t2;
+
+--parallel plan for column store scan, the workers claim CUs from a shared cursor
+create table parallel_t3(a int, b int) with (orientation = column);
+insert into parallel_t3 select n, n % 10 from generate_series(1,100000) n;
+analyze parallel_t3;
+explain (costs off) select count(*) from parallel_t3 where a > 5000;
+select count(*) from parallel_t3 where a > 5000;
+select sum(a), count(b) from parallel_t3;
+drop table parallel_t3;
+
 --clean up
 drop table parallel_t1;
 reset force_parallel_mode;
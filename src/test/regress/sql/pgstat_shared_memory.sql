@@ -0,0 +1,17 @@
+-- The feature run starts the server with enable_pgstat_shared_memory on, so the
+-- table counts of a session are in shared memory once it reports them, without
+-- going through the statistics collector.
+show enable_pgstat_shared_memory;
+show pgstat_shared_memory_tables;
+create table pgstat_shm_t (a int);
+insert into pgstat_shm_t select generate_series(1, 100);
+update pgstat_shm_t set a = a + 1 where a <= 30;
+delete from pgstat_shm_t where a > 90;
+-- counts are reported when the session goes idle, at most every 500ms
+select pg_sleep(0.6);
+select pg_stat_get_tuples_inserted('pgstat_shm_t'::regclass) as inserted,
+       pg_stat_get_tuples_updated('pgstat_shm_t'::regclass) as updated,
+       pg_stat_get_tuples_deleted('pgstat_shm_t'::regclass) as deleted,
+       pg_stat_get_live_tuples('pgstat_shm_t'::regclass) as live,
+       pg_stat_get_dead_tuples('pgstat_shm_t'::regclass) as dead;
+drop table pgstat_shm_t;
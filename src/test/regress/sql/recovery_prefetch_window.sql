@@ -0,0 +1,6 @@
+-- The feature run starts the server with recovery_prefetch_window 512.
+show recovery_prefetch_window;
+select context, min_val, max_val, boot_val from pg_settings where name = 'recovery_prefetch_window';
+-- It can only be changed with a restart.
+set recovery_prefetch_window = 1024;
+show recovery_prefetch_window;
@@ -0,0 +1,12 @@
+-- session_latency_class picks the queue a session is served from, so only
+-- superusers may move a session out of the automatic classification.
+show session_latency_class;
+set session_latency_class = short;
+show session_latency_class;
+reset session_latency_class;
+create role session_latency_user password 'Test@Mpp';
+set role session_latency_user password 'Test@Mpp';
+set session_latency_class = short;
+show session_latency_class;
+reset role;
+drop role session_latency_user;
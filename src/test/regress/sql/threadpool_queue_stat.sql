@@ -0,0 +1,12 @@
+-- The feature run starts the server with a thread pool of two groups that
+-- steal sessions from each other.
+show enable_thread_pool_stealing;
+select group_id, bind_numa_id from local_threadpool_queue_stat() order by group_id;
+-- Every session a group steals is one lent by another group, and at least this
+-- session has been served.
+select sum(stolen_sessions) = sum(lent_sessions) as balanced,
+       bool_and(stolen_sessions >= 0 and lent_sessions >= 0) as non_negative,
+       sum(served_sessions) > 0 as served,
+       bool_and(coalesce(queue_time_p50_us <= queue_time_p99_us, served_sessions = 0)) as ordered
+    from local_threadpool_queue_stat();
+select count(*) from dbe_perf.global_threadpool_queue_status;
@@ -0,0 +1,11 @@
+-- A session counts the statements of a unique sql it has seen before in its
+-- own pending counters, and adds them to the shared entry when it goes idle,
+-- so they are visible right after the statements ran.
+set instr_unique_sql_batch_size = 16;
+create table unique_sql_flush_t (a int);
+select count(*) from unique_sql_flush_t;
+select count(*) from unique_sql_flush_t;
+select count(*) from unique_sql_flush_t;
+select n_calls from dbe_perf.statement where query like 'select count(*) from unique_sql_flush_t%';
+drop table unique_sql_flush_t;
+reset instr_unique_sql_batch_size;
@@ -0,0 +1,29 @@
+-- Each unique sql keeps a histogram of its elapse times, from which
+-- get_instr_unique_sql_rt_percentile reads the requested percentile.
+create table unique_sql_rt_percentile_t (a int);
+insert into unique_sql_rt_percentile_t select generate_series(1, 1000);
+select count(*) from unique_sql_rt_percentile_t;
+select count(*) from unique_sql_rt_percentile_t;
+select count(*) from unique_sql_rt_percentile_t;
+select count(*) from unique_sql_rt_percentile_t;
+select count(*) from unique_sql_rt_percentile_t;
+select s.n_calls, p0.elapse_time >= 0 as p0_valid,
+       p0.elapse_time <= p50.elapse_time as p0_le_p50,
+       p50.elapse_time <= p90.elapse_time as p50_le_p90,
+       p90.elapse_time <= p99.elapse_time as p90_le_p99,
+       p99.elapse_time <= p100.elapse_time as p99_le_p100
+    from dbe_perf.statement s
+        join get_instr_unique_sql_rt_percentile(0) p0 using (user_id, unique_sql_id)
+        join get_instr_unique_sql_rt_percentile(50) p50 using (user_id, unique_sql_id)
+        join get_instr_unique_sql_rt_percentile(90) p90 using (user_id, unique_sql_id)
+        join get_instr_unique_sql_rt_percentile(99) p99 using (user_id, unique_sql_id)
+        join get_instr_unique_sql_rt_percentile(100) p100 using (user_id, unique_sql_id)
+    where s.query like 'select count(*) from unique_sql_rt_percentile_t%';
+select * from get_instr_unique_sql_rt_percentile(101);
+drop table unique_sql_rt_percentile_t;
+
+-- The feature run calculates the response time percentiles of percentile_values
+-- every second.
+show percentile;
+select pg_sleep(2);
+select "P80" >= 0 as p80_valid, "P80" <= "P95" as p80_le_p95 from get_instr_rt_percentile(0);
@@ -0,0 +1,65 @@
+/*
+ * This file is used to test the vector_batch_size parameter
+ */
+----
+--- Create Table and Insert Data
+----
+create schema vector_batch_size_engine;
+set current_schema=vector_batch_size_engine;
+
+create table vector_batch_size_engine.VEC_BSIZE_TABLE_01
+(
+   col_id	int4
+  ,col_a	int4
+  ,col_b	int8
+) with (orientation=column)  ;
+create table vector_batch_size_engine.VEC_BSIZE_TABLE_02
+(
+   col_a	int4
+  ,col_w	int4
+) with (orientation=column)  ;
+create table vector_batch_size_engine.VEC_BSIZE_ROW_01
+(
+   col_a	int4
+);
+
+insert into vec_bsize_table_01 select i, i % 10, i * 2 from generate_series(1, 3000) as i;
+insert into vec_bsize_table_02 select i, i * 10 from generate_series(0, 9) as i;
+insert into vec_bsize_row_01 select i % 10 from generate_series(1, 2000) as i;
+delete from vec_bsize_table_01 where col_id % 5 = 0;
+analyze vec_bsize_table_01;
+analyze vec_bsize_table_02;
+analyze vec_bsize_row_01;
+
+----
+--- test 1: range of the parameter
+----
+show vector_batch_size;
+set vector_batch_size = 8;
+
+----
+--- test 2: smallest batches
+----
+set vector_batch_size = 16;
+select count(*), sum(col_b) from vec_bsize_table_01;
+select col_a, count(*), sum(col_b) from vec_bsize_table_01 where col_id % 3 = 0 group by col_a order by col_a;
+select col_id, col_a from vec_bsize_table_01 where col_id % 97 = 0 order by col_a, col_id;
+select count(*), sum(t2.col_w) from vec_bsize_table_01 t1 join vec_bsize_table_02 t2 on t1.col_a = t2.col_a where t2.col_a % 2 = 0;
+select count(*), sum(t1.col_b) from vec_bsize_table_01 t1 join vec_bsize_row_01 r on t1.col_a = r.col_a where t1.col_id < 200;
+
+----
+--- test 3: batches not a multiple of the SIMD block
+----
+set vector_batch_size = 333;
+select count(*), sum(col_b) from vec_bsize_table_01;
+select col_a, count(*), sum(col_b) from vec_bsize_table_01 where col_id % 3 = 0 group by col_a order by col_a;
+select col_id, col_a from vec_bsize_table_01 where col_id % 97 = 0 order by col_a, col_id;
+select count(*), sum(t2.col_w) from vec_bsize_table_01 t1 join vec_bsize_table_02 t2 on t1.col_a = t2.col_a where t2.col_a % 2 = 0;
+select count(*), sum(t1.col_b) from vec_bsize_table_01 t1 join vec_bsize_row_01 r on t1.col_a = r.col_a where t1.col_id < 200;
+
+reset vector_batch_size;
+
+----
+--- Clean Resource and Tables
+----
+drop schema vector_batch_size_engine cascade;
@@ -0,0 +1,75 @@
+/*
+ * This file is used to test the runtime bloom filters hash joins push down
+ * to heap and column store scans
+ */
+----
+--- Create Table and Insert Data
+----
+create schema runtime_bloom_filter_engine;
+set current_schema=runtime_bloom_filter_engine;
+
+create table runtime_bloom_filter_engine.RBF_FACT
+(
+   a	int4
+  ,b	int8
+  ,c	int2
+);
+create table runtime_bloom_filter_engine.RBF_FACT_COL
+(
+   a	int4
+  ,b	int8
+  ,c	int2
+) with (orientation=column)  ;
+create table runtime_bloom_filter_engine.RBF_DIM
+(
+   id	int4
+  ,k	int8
+  ,s	int2
+  ,name	text
+);
+
+insert into rbf_fact select i, i % 1000, i % 100 from generate_series(1, 20000) as i;
+insert into rbf_fact values (null, null, null);
+insert into rbf_fact_col select * from rbf_fact;
+insert into rbf_dim select i, i * 7, i, 'd' || i from generate_series(1, 20) as i;
+insert into rbf_dim values (null, null, null, 'null dim');
+analyze rbf_fact;
+analyze rbf_fact_col;
+analyze rbf_dim;
+
+set enable_runtime_bloom_filter = on;
+set enable_nestloop = off;
+set enable_mergejoin = off;
+
+----
+--- test 1: row store outer side
+----
+select count(*), sum(f.a), sum(f.b) from rbf_fact f join rbf_dim d on f.a = d.id;
+select count(*), sum(f.b) from rbf_fact f join rbf_dim d on f.b = d.k;
+select d.s, count(*) from rbf_fact f join rbf_dim d on f.c = d.s where d.s <= 5 group by d.s order by d.s;
+select count(*) from rbf_fact f join rbf_dim d on f.c = d.id;
+select count(*) from rbf_fact f where f.a in (select id from rbf_dim where id > 15);
+select count(*), count(f.a) from rbf_fact f right join rbf_dim d on f.a = d.id;
+select count(*) from rbf_fact f join rbf_dim d on f.a = d.id where d.name = 'none';
+select count(*), sum(f.a) from rbf_fact f join rbf_dim d on f.b = d.k where f.a > 10000;
+
+----
+--- test 2: column store outer side
+----
+select count(*), sum(f.a), sum(f.b) from rbf_fact_col f join rbf_dim d on f.a = d.id;
+select count(*), sum(f.b) from rbf_fact_col f join rbf_dim d on f.b = d.k;
+select d.s, count(*) from rbf_fact_col f join rbf_dim d on f.c = d.s where d.s <= 5 group by d.s order by d.s;
+select count(*) from rbf_fact_col f join rbf_dim d on f.c = d.id;
+select count(*) from rbf_fact_col f where f.a in (select id from rbf_dim where id > 15);
+select count(*), count(f.a) from rbf_fact_col f right join rbf_dim d on f.a = d.id;
+select count(*) from rbf_fact_col f join rbf_dim d on f.a = d.id where d.name = 'none';
+select count(*), sum(f.a) from rbf_fact_col f join rbf_dim d on f.b = d.k where f.a > 10000;
+
+reset enable_runtime_bloom_filter;
+reset enable_nestloop;
+reset enable_mergejoin;
+
+----
+--- Clean Resource and Tables
+----
+drop schema runtime_bloom_filter_engine cascade;
@@ -0,0 +1,49 @@
+/*
+ * This file is used to test batches in selection-vector mode
+ */
+----
+--- Create Table and Insert Data
+----
+create schema vector_selection_engine;
+set current_schema=vector_selection_engine;
+
+create table vector_selection_engine.VEC_SEL_TABLE_01
+(
+   col_id	int4
+  ,col_a	int4
+  ,col_b	int8
+) with (orientation=column)  ;
+create table vector_selection_engine.VEC_SEL_TABLE_02
+(
+   col_a	int4
+  ,col_w	int4
+) with (orientation=column)  ;
+
+insert into vec_sel_table_01 select i, i % 10, i * 2 from generate_series(1, 3000) as i;
+insert into vec_sel_table_02 select i, i * 10 from generate_series(0, 9) as i;
+analyze vec_sel_table_01;
+analyze vec_sel_table_02;
+
+----
+--- test 1: filtered scan under sonic hash agg and sort
+----
+select col_a, count(*), sum(col_b) from vec_sel_table_01 where col_id % 3 = 0 group by col_a order by col_a;
+select col_a, sum(col_b / col_a) from vec_sel_table_01 where col_a <> 0 and col_id % 7 = 0 group by col_a order by col_a;
+select col_id, col_a from vec_sel_table_01 where col_id % 97 = 0 order by col_a, col_id;
+
+----
+--- test 2: filtered scan under hash agg, hash join and sort
+----
+set enable_sonic_hashagg = off;
+set enable_sonic_hashjoin = off;
+select col_a, count(*), sum(col_b) from vec_sel_table_01 where col_id % 3 = 0 group by col_a order by col_a;
+select col_a, sum(col_b / col_a) from vec_sel_table_01 where col_a <> 0 and col_id % 7 = 0 group by col_a order by col_a;
+select count(*), sum(t2.col_w) from vec_sel_table_01 t1 join vec_sel_table_02 t2 on t1.col_a = t2.col_a where t2.col_a % 2 = 0 and t1.col_id < 100;
+
+reset enable_sonic_hashagg;
+reset enable_sonic_hashjoin;
+
+----
+--- Clean Resource and Tables
+----
+drop schema vector_selection_engine cascade;
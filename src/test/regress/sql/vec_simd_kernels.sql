@@ -0,0 +1,51 @@
+/*
+ * This file is used to test the SIMD kernels of the vector engine
+ */
+----
+--- Create Table and Insert Data
+----
+create schema vector_simd_engine;
+set current_schema=vector_simd_engine;
+
+create table vector_simd_engine.VEC_SIMD_TABLE_01
+(
+   col_id	int4
+  ,col_a	int4
+  ,col_b	int8
+  ,col_c	float8
+  ,col_d	int8
+) with (orientation=column)  ;
+
+insert into vec_simd_table_01 select i,
+    case when i % 10 = 0 then null else i % 7 end,
+    case when i % 9 = 0 then null else i % 5 end,
+    case when i % 11 = 0 then 'NaN'::float8 when i % 13 = 0 then null else i % 6 end,
+    case when i % 17 = 0 then null else i * 1000 end
+    from generate_series(1, 200) as i;
+analyze vec_simd_table_01;
+
+----
+--- test 1: comparisons with nulls, NaN and partial blocks
+----
+select count(*) from vec_simd_table_01 where col_a = 3;
+select count(*) from vec_simd_table_01 where col_a <> col_b;
+select count(*) from vec_simd_table_01 where col_b < col_a;
+select count(*) from vec_simd_table_01 where col_b >= 2;
+select count(*) from vec_simd_table_01 where col_d <= 100000;
+select count(*) from vec_simd_table_01 where col_c > 3;
+select count(*) from vec_simd_table_01 where col_c < 'NaN';
+select count(*) from vec_simd_table_01 where col_c = 'NaN';
+select count(*) from vec_simd_table_01 where col_a < 5 and col_b >= 1 and col_c <= 4;
+
+----
+--- test 2: int8 arithmetic and overflow
+----
+select count(*) from vec_simd_table_01 where col_b + col_d > 50000;
+select count(*) from vec_simd_table_01 where col_d - col_b < 50000;
+select count(*) from vec_simd_table_01 where col_d + 9223372036854775000 > 0;
+select count(*) from vec_simd_table_01 where col_b - 9223372036854775807 - 10 < 0;
+
+----
+--- Clean Resource and Tables
+----
+drop schema vector_simd_engine cascade;
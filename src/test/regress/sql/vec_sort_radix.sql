@@ -0,0 +1,25 @@
+--
+-- radix sort of vector sorts whose leading key has a normalized key
+--
+create schema vec_sort_radix;
+set current_schema = vec_sort_radix;
+
+create table radix_col(a int, b bigint, s text, n numeric) with (orientation = column);
+insert into radix_col select case when i % 97 = 0 then null else (i * 7919) % 1000 - 500 end, (i * 31) % 17,
+    'k' || lpad(((i * 7) % 500)::text, 4, '0'), (i * 37) % 1000 - 500 from generate_series(1, 2000) i;
+
+-- single exact key, and ties broken by the following keys
+select a from radix_col order by a offset 1000 limit 5;
+select a from radix_col order by a desc offset 1990 limit 5;
+select a, b from radix_col order by a desc nulls first, b offset 1000 limit 5;
+select b, a from radix_col order by b, a desc offset 1000 limit 5;
+
+-- abbreviated leading keys
+select s, a from radix_col order by s, a offset 1000 limit 5;
+select n, b from radix_col order by n desc, b offset 1000 limit 5;
+
+-- the radix sort orders as the comparator does
+select count(*) from (select a, b, lag(a) over (order by a, b) la, lag(b) over (order by a, b) lb from radix_col) x
+    where la > a or (la = a and lb > b);
+
+drop schema vec_sort_radix cascade;
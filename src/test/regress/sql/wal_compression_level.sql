@@ -0,0 +1,18 @@
+-- wal_compression_level picks LZ4 HC for full-page images from 1 up to 12.
+select context, min_val, max_val, boot_val from pg_settings where name = 'wal_compression_level';
+set wal_compression_level = -1;
+set wal_compression_level = 13;
+set wal_compression_level = 12;
+show wal_compression_level;
+-- Rows written while full-page images are compressed at a non-default level
+-- read back unchanged; their replay is covered by the ha test
+-- llt_single/wal_compression_level.
+set wal_compression = on;
+create table wal_compression_level_t (a int, b text);
+insert into wal_compression_level_t select i, repeat('x', 100) from generate_series(1, 1000) i;
+checkpoint;
+update wal_compression_level_t set b = b || 'y';
+select count(*), sum(length(b)) from wal_compression_level_t;
+drop table wal_compression_level_t;
+reset wal_compression;
+reset wal_compression_level;